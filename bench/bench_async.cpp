@@ -0,0 +1,110 @@
+// Compares the blocking BookingService API (one OS thread per concurrent client) with the
+// coroutine facade (a few EventLoop threads, many suspended clients each).
+// Usage: bench_async [clients=256] [loops=2] [ops_per_client=2000]
+#include "AsyncBookingService.hpp"
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+struct Fixture {
+    BookingService svc;
+    std::vector<long long> shows;
+    std::atomic<long long> nextSeat{0};   // every booking targets a fresh seat, so all succeed
+
+    explicit Fixture(long long bookings) {
+        const long long needed = bookings / BookingService::TOTAL_SEATS + 1;
+        const int side = static_cast<int>(std::sqrt(static_cast<double>(needed))) + 1;
+        std::vector<int> movies, theaters;
+        for (int i = 0; i < side; ++i) {
+            movies.push_back(svc.addMovie("Movie " + std::to_string(i)));
+            theaters.push_back(svc.addTheater("Theater " + std::to_string(i)));
+        }
+        for (int m : movies)
+            for (int t : theaters)
+                if (static_cast<long long>(shows.size()) < needed) shows.push_back(svc.createShow(m, t));
+    }
+
+    std::pair<long long, std::string> claimSeat() {
+        const long long n = nextSeat.fetch_add(1);
+        return {shows[static_cast<std::size_t>(n / BookingService::TOTAL_SEATS)],
+                BookingService::seatLabelFromIndex(static_cast<int>(n % BookingService::TOTAL_SEATS))};
+    }
+};
+
+// 1 booking per 10 operations, the rest read seat maps of random shows.
+constexpr int READS_PER_BOOKING = 9;
+
+Task<void> asyncClient(AsyncBookingService& async, Fixture& fx, int ops, unsigned seed) {
+    std::mt19937 rng(seed);
+    for (int i = 0; i < ops; ++i) {
+        if (i % (READS_PER_BOOKING + 1) == 0) {
+            auto [show, seat] = fx.claimSeat();
+            std::vector<std::string> seats{std::move(seat)};
+            (void)co_await async.bookSeatsAsync(show, std::move(seats));
+        } else {
+            (void)co_await async.getAvailableSeatsAsync(fx.shows[rng() % fx.shows.size()]);
+        }
+    }
+}
+
+double seconds(std::chrono::steady_clock::time_point since) {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - since).count();
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int clients = argc > 1 ? std::atoi(argv[1]) : 256;
+    const int loops = argc > 2 ? std::atoi(argv[2]) : 2;
+    const int ops = argc > 3 ? std::atoi(argv[3]) : 2000;
+    const long long totalOps = static_cast<long long>(clients) * ops;
+    const long long bookings = totalOps / (READS_PER_BOOKING + 1) + clients;
+
+    {
+        Fixture fx(bookings);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        for (int c = 0; c < clients; ++c)
+            pool.emplace_back([&, c] {
+                std::mt19937 rng(static_cast<unsigned>(c));
+                for (int i = 0; i < ops; ++i) {
+                    if (i % (READS_PER_BOOKING + 1) == 0) {
+                        auto [show, seat] = fx.claimSeat();
+                        (void)fx.svc.bookSeats(show, {seat});
+                    } else {
+                        (void)fx.svc.getAvailableSeats(fx.shows[rng() % fx.shows.size()]);
+                    }
+                }
+            });
+        for (auto& th : pool) th.join();
+        const double s = seconds(start);
+        std::cout << "blocking: " << clients << " threads        "
+                  << static_cast<long long>(static_cast<double>(totalOps) / s) << " ops/s\n";
+    }
+
+    {
+        Fixture fx(bookings);
+        AsyncBookingService async(fx.svc);
+        auto start = std::chrono::steady_clock::now();
+        std::vector<std::thread> pool;
+        for (int l = 0; l < loops; ++l)
+            pool.emplace_back([&, l] {
+                EventLoop loop;
+                for (int c = l; c < clients; c += loops)
+                    loop.spawn(asyncClient(async, fx, ops, static_cast<unsigned>(c)));
+                loop.run();
+            });
+        for (auto& th : pool) th.join();
+        const double s = seconds(start);
+        std::cout << "async:    " << loops << " loops x " << (clients + loops - 1) / loops << " coroutines "
+                  << static_cast<long long>(static_cast<double>(totalOps) / s) << " ops/s\n";
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+// Group seating on a multi-row auditorium: replays one seeded sequence of party arrivals (mostly
+// couples, few singles to fill gaps, some groups of 10-30 that need several rows) and
+// cancellations through GroupAllocator::place and through naive first-fit, and compares how full
+// the house ends up, how many orphan seats are stranded and how many parties are turned away.
+// Also reports the time per allocation call. Pass a larger `requests` to oversell the house.
+// Usage: bench_group_alloc [rows=40] [seats_per_row=50] [requests=1.1*seats/avg_party] [seed=1]
+#include "GroupAllocator.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int CANCEL_PERCENT = 10;
+
+constexpr int PARTY_SIZES[] = {1, 2, 3, 4, 5, 6, 7, 8, 10, 12, 15, 20, 25, 30};
+constexpr double PARTY_WEIGHTS[] = {3, 45, 12, 16, 5, 5, 2, 2, 3, 2, 2, 2, 1, 1};
+
+struct Event {
+    int partySize;   // 0 for a cancellation
+    int cancels;     // Index of the arrival cancelled
+};
+
+struct Result {
+    int placed{0};
+    int rejected{0};
+    long long rejectedSeats{0};
+    int freeSeats{0};
+    int orphans{0};
+    long long calls{0};
+    double nanos{0};
+    double worstNanos{0};
+};
+
+std::vector<Event> makeEvents(int count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::discrete_distribution<int> party(std::begin(PARTY_WEIGHTS), std::end(PARTY_WEIGHTS));
+    std::uniform_int_distribution<int> percent(0, 99);
+    std::vector<Event> events;
+    int arrivals = 0;
+    while (static_cast<int>(events.size()) < count) {
+        if (arrivals > 0 && percent(rng) < CANCEL_PERCENT) {
+            events.push_back({0, std::uniform_int_distribution<int>(0, arrivals - 1)(rng)});
+        } else {
+            events.push_back({PARTY_SIZES[party(rng)], 0});
+            ++arrivals;
+        }
+    }
+    return events;
+}
+
+template <typename Allocate>
+Result replay(int rows, int seatsPerRow, const std::vector<Event>& events, Allocate allocate) {
+    SeatMap map(rows, seatsPerRow);
+    std::vector<std::optional<GroupPlacement>> arrivals;
+    Result r;
+    for (const Event& e : events) {
+        if (e.partySize == 0) {
+            auto& booked = arrivals[static_cast<std::size_t>(e.cancels)];
+            if (booked) {
+                for (const auto& b : booked->blocks) map.release(b.row, b.mask());
+                booked.reset();
+            }
+            continue;
+        }
+        const auto start = Clock::now();
+        auto placement = allocate(map, e.partySize);
+        const double ns = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+        r.nanos += ns;
+        r.worstNanos = std::max(r.worstNanos, ns);
+        ++r.calls;
+        if (placement && GroupAllocator::apply(map, *placement)) {
+            ++r.placed;
+        } else {
+            placement.reset();
+            ++r.rejected;
+            r.rejectedSeats += e.partySize;
+        }
+        arrivals.push_back(std::move(placement));
+    }
+    r.freeSeats = map.freeSeats();
+    r.orphans = map.orphanSeats();
+    return r;
+}
+
+void print(const char* name, const Result& r, int seats) {
+    std::printf("%s\t%.1f\t%d\t%d\t%lld\t%.2f\t%.2f\n", name, 100.0 * (seats - r.freeSeats) / seats, r.orphans,
+                r.rejected, r.rejectedSeats, r.nanos / 1000.0 / static_cast<double>(r.calls), r.worstNanos / 1000.0);
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int rows = argc > 1 ? std::atoi(argv[1]) : 40;
+    const int seatsPerRow = argc > 2 ? std::atoi(argv[2]) : 50;
+    if (rows <= 0 || seatsPerRow <= 0 || seatsPerRow > SeatMap::MAX_SEATS_PER_ROW) {
+        std::fprintf(stderr, "rows must be positive and seats_per_row in 1..%d\n", SeatMap::MAX_SEATS_PER_ROW);
+        return 1;
+    }
+    const int seats = rows * seatsPerRow;
+    double weight = 0, mean = 0;
+    for (std::size_t i = 0; i < std::size(PARTY_SIZES); ++i) {
+        weight += PARTY_WEIGHTS[i];
+        mean += PARTY_WEIGHTS[i] * PARTY_SIZES[i];
+    }
+    int requests = argc > 3 ? std::atoi(argv[3]) : 0;
+    if (requests <= 0) requests = static_cast<int>(1.1 * seats / (mean / weight));   // Demand just past capacity
+    const unsigned seed = argc > 4 ? static_cast<unsigned>(std::atoi(argv[4])) : 1;
+
+    const auto events = makeEvents(requests, seed);
+    std::printf("%d rows x %d seats, %d events (%d%% cancellations)\n", rows, seatsPerRow, requests, CANCEL_PERCENT);
+    std::printf("allocator\toccupancy%%\torphans\trejected\trejected_seats\tus/call\tworst_us\n");
+    print("first-fit", replay(rows, seatsPerRow, events, GroupAllocator::firstFit), seats);
+    print("place", replay(rows, seatsPerRow, events, GroupAllocator::place), seats);
+    return 0;
+}
@@ -0,0 +1,65 @@
+// Catalog loading: importCatalog() vs parsing the same CSV with getline and calling
+// addMovie/addTheater/createShow per row.
+// Usage: bench_import [rows=2000000] [movies=5000] [theaters=2000]
+#include "BookingService.hpp"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+
+using namespace booking;
+
+int main(int argc, char** argv) {
+    const long long rows = argc > 1 ? std::atoll(argv[1]) : 2000000;
+    const int movies = argc > 2 ? std::atoi(argv[2]) : 5000;
+    const int theaters = argc > 3 ? std::atoi(argv[3]) : 2000;
+    const std::string path = "/tmp/bench_import_catalog.csv";
+
+    {
+        std::ofstream out(path, std::ios::binary);
+        std::mt19937_64 rng(42);
+        out << "movie,theater\n";
+        for (long long i = 0; i < rows; ++i)
+            out << "Movie " << rng() % static_cast<unsigned>(movies) << ",Theater "
+                << rng() % static_cast<unsigned>(theaters) << '\n';
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    BookingService bulk;
+    auto stats = bulk.importCatalog(path, true);
+    const double bulkSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!stats) return 1;
+
+    std::cerr.setstate(std::ios::failbit);   // silence per-call duplicate messages
+    start = std::chrono::steady_clock::now();
+    BookingService sequential;
+    {
+        std::ifstream in(path);
+        std::string line;
+        std::getline(in, line);               // header
+        std::unordered_map<std::string, int> movieIds, theaterIds;
+        while (std::getline(in, line)) {
+            const auto comma = line.find(',');
+            const std::string movie = line.substr(0, comma), theater = line.substr(comma + 1);
+            auto m = movieIds.find(movie);
+            if (m == movieIds.end()) m = movieIds.emplace(movie, sequential.addMovie(movie)).first;
+            auto t = theaterIds.find(theater);
+            if (t == theaterIds.end()) t = theaterIds.emplace(theater, sequential.addTheater(theater)).first;
+            (void)sequential.createShow(m->second, t->second);
+        }
+    }
+    const double seqSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cerr.clear();
+    std::remove(path.c_str());
+
+    std::cout << "rows " << stats->rows << " | movies " << stats->moviesCreated << " | theaters "
+              << stats->theatersCreated << " | shows " << stats->showsCreated << " | duplicates "
+              << stats->duplicateShows << "\n"
+              << "importCatalog   " << bulkSecs << " s  (" << static_cast<double>(rows) / bulkSecs / 1e6 << " M rows/s)\n"
+              << "per-row calls   " << seqSecs << " s  (" << static_cast<double>(rows) / seqSecs / 1e6 << " M rows/s)\n";
+    return 0;
+}
@@ -0,0 +1,101 @@
+// Contention between single-show bookSeats and multi-show bookAcrossShows. Single-show clients
+// book fresh seats show after show (like bench_sharded), so they all crowd the same few shows;
+// package clients keep booking 2-3 leg deals over exactly those shows. Prints single-show
+// throughput and latency percentiles with and without the package clients running: if ordered
+// locking starved single bookings, their tail latency and throughput would collapse.
+// Usage: bench_multi_show [single_threads=4] [package_threads=2] [bookings_per_thread=200000]
+#include "BookingService.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+struct Result {
+    double singleOpsPerSec{};
+    double p50Us{}, p99Us{}, maxUs{};
+    long long packageAttempts{};
+    long long packagesBooked{};
+};
+
+Result run(int singleThreads, int packageThreads, long long perThread) {
+    const long long total = perThread * singleThreads;
+    const long long showCount = total / BookingService::TOTAL_SEATS + 8;
+    BookingService svc;
+    std::vector<long long> shows;
+    const int m = svc.addMovie("Feature");
+    for (long long i = 0; i < showCount; ++i)
+        shows.push_back(svc.createShow(m, svc.addTheater("Screen " + std::to_string(i))));
+
+    std::atomic<long long> next{0};
+    std::atomic<int> singlesRunning{singleThreads};
+    std::atomic<long long> packageAttempts{0}, packagesBooked{0};
+    std::vector<std::vector<double>> latencies(static_cast<std::size_t>(singleThreads));
+
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < singleThreads; ++t)
+        pool.emplace_back([&, t] {
+            auto& lat = latencies[static_cast<std::size_t>(t)];
+            lat.reserve(static_cast<std::size_t>(perThread));
+            for (long long i = 0; i < perThread; ++i) {
+                const long long n = next.fetch_add(1, std::memory_order_relaxed);
+                const auto t0 = std::chrono::steady_clock::now();
+                (void)svc.bookSeats(shows[static_cast<std::size_t>(n / BookingService::TOTAL_SEATS)],
+                                    {BookingService::seatLabelFromIndex(static_cast<int>(n % BookingService::TOTAL_SEATS))});
+                lat.push_back(std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - t0).count());
+            }
+            --singlesRunning;
+        });
+    for (int t = 0; t < packageThreads; ++t)
+        pool.emplace_back([&, t] {
+            std::mt19937 rng(static_cast<unsigned>(t) + 1);
+            std::vector<BookingService::ShowSeats> legs;
+            while (singlesRunning.load(std::memory_order_relaxed) > 0) {
+                // Legs on the shows single clients are filling right now, in random order.
+                const auto base = static_cast<std::size_t>(next.load(std::memory_order_relaxed) / BookingService::TOTAL_SEATS);
+                const std::size_t count = 2 + rng() % 2;
+                legs.clear();
+                for (std::size_t j = 0; j < count && base + j < shows.size(); ++j)
+                    legs.push_back({shows[base + j], {BookingService::seatLabelFromIndex(static_cast<int>(rng() % BookingService::TOTAL_SEATS))}});
+                std::shuffle(legs.begin(), legs.end(), rng);
+                ++packageAttempts;
+                if (!svc.bookAcrossShows(legs).empty()) ++packagesBooked;
+            }
+        });
+    for (auto& th : pool) th.join();
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<double> all;
+    for (auto& lat : latencies) all.insert(all.end(), lat.begin(), lat.end());
+    std::sort(all.begin(), all.end());
+    auto pct = [&](double p) { return all[static_cast<std::size_t>(p * static_cast<double>(all.size() - 1))]; };
+    return {static_cast<double>(total) / secs, pct(0.50), pct(0.99), all.back(),
+            packageAttempts.load(), packagesBooked.load()};
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int singleThreads = argc > 1 ? std::max(1, std::atoi(argv[1])) : 4;
+    const int packageThreads = argc > 2 ? std::max(0, std::atoi(argv[2])) : 2;
+    const long long perThread = argc > 3 ? std::max(1LL, std::atoll(argv[3])) : 200000;
+
+    // Seat conflicts are the expected outcome of the contention here; keep them off the console.
+    std::cerr.setstate(std::ios::failbit);
+
+    std::cout << "package_threads  single_ops/s  p50_us  p99_us  max_us  packages_booked/attempted\n";
+    for (int packages : {0, packageThreads}) {
+        const Result r = run(singleThreads, packages, perThread);
+        std::cout << packages << "\t\t " << static_cast<long long>(r.singleOpsPerSec)
+                  << "\t" << r.p50Us << "\t" << r.p99Us << "\t" << r.maxUs
+                  << "\t" << r.packagesBooked << "/" << r.packageAttempts << "\n";
+        if (packageThreads == 0) break;
+    }
+    return 0;
+}
@@ -0,0 +1,158 @@
+// Open-loop load generator: issues getAvailableSeats/bookSeats at a fixed arrival rate, for ten
+// increasing offered loads, and prints latency percentiles at each so the saturation knee shows
+// up as the step where the tail leaves the service time behind. Requests are due at evenly spaced
+// intended start times and latency is measured from those, so a stalled request also charges the
+// requests queued behind it (no coordinated omission). Show popularity is Zipf (s = 1.0); a
+// booking asks for 1-8 adjacent seats, mostly pairs.
+// Usage: bench_open_loop [max_rate=200000] [step_ms=1000] [threads=hardware_concurrency]
+#include "BookingService.hpp"
+#include "LatencyHistogram.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+constexpr int READ_PERCENT = 80;
+
+// Seats per booking request: party sizes, weighted towards couples.
+constexpr int PARTY_SIZES[] = {1, 2, 3, 4, 5, 6, 7, 8};
+constexpr double PARTY_WEIGHTS[] = {15, 45, 15, 15, 4, 3, 2, 1};
+
+struct Step {
+    LatencyHistogram latency;   // From intended start
+    LatencyHistogram service;   // From actual start
+    long long booked{0};
+    long long bookAttempts{0};
+    long long dropped{0};
+    double seconds{0};          // First intended start to last completion
+};
+
+std::vector<long long> makeShows(BookingService& svc, long long count) {
+    const int side = static_cast<int>(std::sqrt(static_cast<double>(count))) + 1;
+    std::vector<int> movies, theaters;
+    for (int i = 0; i < side; ++i) {
+        movies.push_back(svc.addMovie("Movie " + std::to_string(i)));
+        theaters.push_back(svc.addTheater("Theater " + std::to_string(i)));
+    }
+    std::vector<long long> shows;
+    for (int m : movies)
+        for (int t : theaters)
+            if (static_cast<long long>(shows.size()) < count) shows.push_back(svc.createShow(m, t));
+    return shows;
+}
+
+void waitUntil(Clock::time_point when) {
+    for (auto now = Clock::now(); now < when; now = Clock::now()) {
+        if (when - now > std::chrono::microseconds(100)) std::this_thread::sleep_for(when - now - std::chrono::microseconds(50));
+        else std::this_thread::yield();
+    }
+}
+
+// Runs one offered load on a fresh service. Requests not started by the end of a grace period as
+// long as the step itself are dropped (and counted) rather than queued forever.
+Step runStep(double rate, std::chrono::milliseconds duration, int threads, const std::vector<double>& zipfCdf) {
+    BookingService svc;
+    const auto shows = makeShows(svc, static_cast<long long>(zipfCdf.size()));
+    const auto total = static_cast<long long>(rate * std::chrono::duration<double>(duration).count());
+    const auto interval = std::chrono::duration<double, std::nano>(1e9 / rate);
+
+    std::atomic<long long> next{0};
+    std::vector<Step> perThread(static_cast<std::size_t>(threads));
+    const auto t0 = Clock::now() + std::chrono::milliseconds(10);
+    const auto giveUp = t0 + 2 * duration;
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back([&, t] {
+            Step& out = perThread[static_cast<std::size_t>(t)];
+            std::mt19937_64 rng(1000 + static_cast<std::uint64_t>(t));
+            std::uniform_real_distribution<double> pick(0, zipfCdf.back());
+            std::discrete_distribution<int> party(std::begin(PARTY_WEIGHTS), std::end(PARTY_WEIGHTS));
+            std::vector<std::string> labels;
+            for (long long i; (i = next.fetch_add(1, std::memory_order_relaxed)) < total;) {
+                const auto intended = t0 + std::chrono::duration_cast<Clock::duration>(interval * static_cast<double>(i));
+                const long long show = shows[static_cast<std::size_t>(
+                    std::lower_bound(zipfCdf.begin(), zipfCdf.end(), pick(rng)) - zipfCdf.begin())];
+                const bool read = static_cast<int>(rng() % 100) < READ_PERCENT;
+                labels.clear();
+                if (!read) {
+                    const int seats = PARTY_SIZES[party(rng)];
+                    const int first = static_cast<int>(rng() % static_cast<std::uint64_t>(BookingService::TOTAL_SEATS - seats + 1));
+                    for (int s = first; s < first + seats; ++s) labels.push_back(BookingService::seatLabelFromIndex(s));
+                }
+
+                waitUntil(intended);
+                const auto start = Clock::now();
+                if (start > giveUp) {
+                    ++out.dropped;
+                    continue;
+                }
+                if (read) {
+                    (void)svc.getAvailableSeats(show);
+                } else {
+                    ++out.bookAttempts;
+                    out.booked += svc.bookSeats(show, labels);
+                }
+                const auto end = Clock::now();
+                out.latency.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - intended).count()));
+                out.service.record(static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()));
+                out.seconds = std::chrono::duration<double>(end - t0).count();
+            }
+        });
+    for (auto& th : pool) th.join();
+
+    Step merged;
+    for (const Step& s : perThread) {
+        merged.latency.merge(s.latency);
+        merged.service.merge(s.service);
+        merged.booked += s.booked;
+        merged.bookAttempts += s.bookAttempts;
+        merged.dropped += s.dropped;
+        merged.seconds = std::max(merged.seconds, s.seconds);
+    }
+    return merged;
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const double maxRate = argc > 1 ? std::max(10, std::atoi(argv[1])) : 200000;
+    const auto stepDuration = std::chrono::milliseconds(argc > 2 ? std::max(10, std::atoi(argv[2])) : 1000);
+    const int threads = argc > 3 ? std::max(1, std::atoi(argv[3])) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const long long showCount = 100000;
+    const double skew = 1.0;
+
+    std::vector<double> cdf(static_cast<std::size_t>(showCount));
+    double total = 0;
+    for (long long i = 0; i < showCount; ++i) cdf[static_cast<std::size_t>(i)] = (total += 1.0 / std::pow(i + 1.0, skew));
+
+    std::cerr.setstate(std::ios::failbit);   // Sold-out and taken-seat failures are expected
+    std::cout << "threads=" << threads << " shows=" << showCount << " zipf_s=" << skew << " reads=" << READ_PERCENT
+              << "% step=" << stepDuration.count() << "ms (latency in us, from intended start)\n";
+    std::cout << "offered/s\tachieved/s\tp50\tp90\tp99\tp99.9\tmax\tservice_p99\tbooked%\tdropped\n";
+    for (int step = 1; step <= 10; ++step) {
+        const double rate = maxRate * step / 10;
+        const Step s = runStep(rate, stepDuration, threads, cdf);
+        const auto us = [](std::uint64_t ns) { return static_cast<double>(ns) / 1000.0; };
+        std::printf("%.0f\t%.0f\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%.1f\t%lld\n", rate,
+                    static_cast<double>(s.latency.count()) / std::max(s.seconds, std::chrono::duration<double>(stepDuration).count()),
+                    us(s.latency.valueAtPercentile(50)), us(s.latency.valueAtPercentile(90)),
+                    us(s.latency.valueAtPercentile(99)), us(s.latency.valueAtPercentile(99.9)), us(s.latency.max()),
+                    us(s.service.valueAtPercentile(99)),
+                    s.bookAttempts ? 100.0 * static_cast<double>(s.booked) / static_cast<double>(s.bookAttempts) : 0.0,
+                    s.dropped);
+        std::fflush(stdout);
+    }
+    return 0;
+}
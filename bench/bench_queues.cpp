@@ -0,0 +1,125 @@
+// Queue throughput: mutex + std::deque vs SpscQueue vs MpscQueue, single-item and batched,
+// with spinning and blocking wait strategies. One consumer drains everything the producers send.
+// Usage: bench_queues [producers=2] [items_per_producer=2000000] [batch=32]
+#include "MpscQueue.hpp"
+#include "SpscQueue.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+constexpr std::size_t CAPACITY = 4096;
+
+// Baseline: what a pipeline would use without a concurrent queue.
+class MutexQueue {
+public:
+    void push(long long v) {
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            notFull_.wait(lock, [&] { return items_.size() < CAPACITY; });
+            items_.push_back(v);
+        }
+        notEmpty_.notify_one();
+    }
+    long long pop() {
+        long long v;
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            notEmpty_.wait(lock, [&] { return !items_.empty(); });
+            v = items_.front();
+            items_.pop_front();
+        }
+        notFull_.notify_one();
+        return v;
+    }
+
+private:
+    std::mutex mtx_;
+    std::condition_variable notEmpty_, notFull_;
+    std::deque<long long> items_;
+};
+
+template <typename Produce, typename Consume>
+void report(const std::string& name, int producers, long long perProducer, Produce&& produce, Consume&& consume) {
+    const long long total = perProducer * producers;
+    const auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) threads.emplace_back(produce);
+    const long long sum = consume(total);
+    for (auto& t : threads) t.join();
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const long long expected = producers * (perProducer * (perProducer - 1) / 2);
+    std::cout << name << "\t" << static_cast<long long>(static_cast<double>(total) / secs / 1e3) << " K items/s"
+              << (sum == expected ? "" : "  [CHECKSUM MISMATCH]") << "\n";
+}
+
+template <typename Queue>
+void singleItems(const std::string& name, Queue& q, int producers, long long perProducer) {
+    report(name, producers, perProducer,
+           [&] { for (long long i = 0; i < perProducer; ++i) q.push(i); },
+           [&](long long total) {
+               long long sum = 0;
+               for (long long n = 0; n < total; ++n) sum += q.pop();
+               return sum;
+           });
+}
+
+template <typename Queue>
+void batched(const std::string& name, Queue& q, int producers, long long perProducer, std::size_t batch) {
+    report(name, producers, perProducer,
+           [&] {
+               std::vector<long long> buf(batch);
+               for (long long i = 0; i < perProducer;) {
+                   const std::size_t n = std::min<std::size_t>(batch, static_cast<std::size_t>(perProducer - i));
+                   for (std::size_t k = 0; k < n; ++k) buf[k] = i + static_cast<long long>(k);
+                   std::size_t sent = 0;
+                   while (sent < n) {
+                       const std::size_t pushed = q.tryPushBatch(buf.begin() + static_cast<std::ptrdiff_t>(sent), n - sent);
+                       if (pushed == 0) std::this_thread::yield();
+                       sent += pushed;
+                   }
+                   i += static_cast<long long>(n);
+               }
+           },
+           [&](long long total) {
+               std::vector<long long> buf(batch);
+               long long sum = 0;
+               for (long long n = 0; n < total;) {
+                   const std::size_t got = q.tryPopBatch(buf.begin(), batch);
+                   if (got == 0) { std::this_thread::yield(); continue; }
+                   for (std::size_t k = 0; k < got; ++k) sum += buf[k];
+                   n += static_cast<long long>(got);
+               }
+               return sum;
+           });
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int producers = argc > 1 ? std::max(1, std::atoi(argv[1])) : 2;
+    const long long perProducer = argc > 2 ? std::atoll(argv[2]) : 2000000;
+    const std::size_t batch = argc > 3 ? static_cast<std::size_t>(std::max(1, std::atoi(argv[3]))) : 32;
+
+    std::cout << "1 producer -> 1 consumer\n";
+    { MutexQueue q;                                   singleItems("  mutex+deque     ", q, 1, perProducer); }
+    { SpscQueue<long long> q(CAPACITY);               singleItems("  spsc yielding   ", q, 1, perProducer); }
+    { SpscQueue<long long, BlockingWait> q(CAPACITY); singleItems("  spsc blocking   ", q, 1, perProducer); }
+    { SpscQueue<long long> q(CAPACITY);               batched    ("  spsc batch      ", q, 1, perProducer, batch); }
+
+    std::cout << producers << " producers -> 1 consumer\n";
+    { MutexQueue q;                                   singleItems("  mutex+deque     ", q, producers, perProducer); }
+    { MpscQueue<long long> q(CAPACITY);               singleItems("  mpsc yielding   ", q, producers, perProducer); }
+    { MpscQueue<long long, BlockingWait> q(CAPACITY); singleItems("  mpsc blocking   ", q, producers, perProducer); }
+    { MpscQueue<long long> q(CAPACITY);               batched    ("  mpsc batch      ", q, producers, perProducer, batch); }
+    return 0;
+}
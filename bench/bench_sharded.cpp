@@ -0,0 +1,95 @@
+// bookSeats throughput: shared-state BookingService vs shard-per-core ShardedBookingService,
+// for an increasing number of client threads. Every booking takes a fresh seat, and consecutive
+// seats belong to the same show, so concurrent clients contend on the same hot shows.
+// Usage: bench_sharded [max_threads=hardware_concurrency] [bookings_per_thread=100000]
+#include "ShardedBookingService.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+template <typename CreateShow>
+std::vector<long long> makeShows(long long count, CreateShow&& create,
+                                 const std::function<int(const std::string&)>& addMovie,
+                                 const std::function<int(const std::string&)>& addTheater) {
+    const int side = static_cast<int>(std::sqrt(static_cast<double>(count))) + 1;
+    std::vector<int> movies, theaters;
+    for (int i = 0; i < side; ++i) {
+        movies.push_back(addMovie("Movie " + std::to_string(i)));
+        theaters.push_back(addTheater("Theater " + std::to_string(i)));
+    }
+    std::vector<long long> shows;
+    for (int m : movies)
+        for (int t : theaters)
+            if (static_cast<long long>(shows.size()) < count) shows.push_back(create(m, t));
+    return shows;
+}
+
+template <typename Body>
+double timeThreads(int threads, Body&& body) {
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t) pool.emplace_back(body, t);
+    for (auto& th : pool) th.join();
+    return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+} // namespace
+
+int main(int argc, char** argv) {
+    const int maxThreads = argc > 1 ? std::atoi(argv[1]) : static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+    const long long perThread = argc > 2 ? std::atoll(argv[2]) : 100000;
+
+    std::cout << "threads  shared_ops/s  sharded_ops/s\n";
+    for (int threads = 1; threads <= maxThreads; threads *= 2) {
+        const long long total = perThread * threads;
+        const long long showCount = total / BookingService::TOTAL_SEATS + 1;
+
+        double shared = 0;
+        {
+            BookingService svc;
+            auto shows = makeShows(showCount, [&](int m, int t) { return svc.createShow(m, t); },
+                                   [&](const std::string& s) { return svc.addMovie(s); },
+                                   [&](const std::string& s) { return svc.addTheater(s); });
+            std::atomic<long long> next{0};
+            const double secs = timeThreads(threads, [&](int) {
+                for (long long i = 0; i < perThread; ++i) {
+                    const long long n = next.fetch_add(1, std::memory_order_relaxed);
+                    (void)svc.bookSeats(shows[static_cast<std::size_t>(n / BookingService::TOTAL_SEATS)],
+                                        {BookingService::seatLabelFromIndex(static_cast<int>(n % BookingService::TOTAL_SEATS))});
+                }
+            });
+            shared = static_cast<double>(total) / secs;
+        }
+
+        double sharded = 0;
+        {
+            ShardedBookingService svc(static_cast<std::size_t>(threads), static_cast<std::size_t>(threads) + 1);
+            auto setup = svc.connect();
+            auto shows = makeShows(showCount, [&](int m, int t) { return setup.createShow(m, t); },
+                                   [&](const std::string& s) { return svc.addMovie(s); },
+                                   [&](const std::string& s) { return svc.addTheater(s); });
+            std::atomic<long long> next{0};
+            const double secs = timeThreads(threads, [&](int) {
+                auto client = svc.connect();
+                for (long long i = 0; i < perThread; ++i) {
+                    const long long n = next.fetch_add(1, std::memory_order_relaxed);
+                    (void)client.bookSeats(shows[static_cast<std::size_t>(n / BookingService::TOTAL_SEATS)],
+                                           {BookingService::seatLabelFromIndex(static_cast<int>(n % BookingService::TOTAL_SEATS))});
+                }
+            });
+            sharded = static_cast<double>(total) / secs;
+        }
+
+        std::cout << threads << "\t " << static_cast<long long>(shared)
+                  << "\t       " << static_cast<long long>(sharded) << "\n";
+    }
+    return 0;
+}
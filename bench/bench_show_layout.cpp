@@ -0,0 +1,84 @@
+// Memory and allocation count per show: the original layout (make_shared<Show> with a
+// std::vector<bool> seat map) vs the pooled, cache-line-aligned Show with an inline bitmap.
+// Heap usage is measured with malloc_usable_size, so malloc headers and rounding are included.
+// Usage: bench_show_layout [shows=100000]
+#include "BookingService.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <malloc.h>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+std::size_t g_allocations = 0;
+std::size_t g_bytes = 0;
+bool g_counting = false;
+
+// Show as it was before pooling: two heap blocks (shared_ptr control block + object, seat vector).
+struct LegacyShow {
+    int movieId{};
+    int theaterId{};
+    BookingService::SeatAggregate* movieStats{};
+    BookingService::SeatAggregate* theaterStats{};
+    std::vector<bool> seats;
+    mutable std::mutex mtx;
+    int availableCount{BookingService::TOTAL_SEATS};
+};
+} // namespace
+
+void* operator new(std::size_t size) {
+    void* p = std::malloc(size ? size : 1);
+    if (!p) throw std::bad_alloc();
+    if (g_counting) {
+        ++g_allocations;
+        g_bytes += malloc_usable_size(p) + sizeof(std::size_t);   // + glibc chunk header
+    }
+    return p;
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+int main(int argc, char** argv) {
+    const long long shows = argc > 1 ? std::atoll(argv[1]) : 100000;
+
+    std::vector<std::shared_ptr<LegacyShow>> legacy;
+    legacy.reserve(static_cast<std::size_t>(shows));
+    g_allocations = g_bytes = 0;
+    g_counting = true;
+    auto start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < shows; ++i) {
+        auto s = std::make_shared<LegacyShow>();
+        s->seats.assign(BookingService::TOTAL_SEATS, false);
+        legacy.push_back(std::move(s));
+    }
+    const double legacySecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    g_counting = false;
+    const double legacyBytes = static_cast<double>(g_bytes) / static_cast<double>(shows);
+    const double legacyAllocs = static_cast<double>(g_allocations) / static_cast<double>(shows);
+
+    ObjectPool<BookingService::Show> pool;
+    std::vector<BookingService::Show*> pooled;
+    pooled.reserve(static_cast<std::size_t>(shows));
+    g_allocations = 0;
+    g_counting = true;
+    start = std::chrono::steady_clock::now();
+    for (long long i = 0; i < shows; ++i) pooled.push_back(pool.create());
+    const double pooledSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    g_counting = false;
+    const double pooledBytes = static_cast<double>(pool.bytesReserved()) / static_cast<double>(shows);
+    const double pooledAllocs = static_cast<double>(g_allocations) / static_cast<double>(shows);
+    for (auto* s : pooled) pool.destroy(s);
+
+    std::cout << "layout        bytes/show  allocs/show  ns/create\n"
+              << "shared_ptr    " << legacyBytes << "\t    " << legacyAllocs << "\t " << legacySecs * 1e9 / static_cast<double>(shows) << "\n"
+              << "pooled        " << pooledBytes << "\t    " << pooledAllocs << "\t " << pooledSecs * 1e9 / static_cast<double>(shows) << "\n"
+              << "saved per show: " << legacyBytes - pooledBytes << " bytes, "
+              << legacyAllocs - pooledAllocs << " allocations; sizeof(Show) = "
+              << sizeof(BookingService::Show) << " (" << sizeof(BookingService::Show) / 64 << " cache lines)\n";
+    return 0;
+}
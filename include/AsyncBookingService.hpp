@@ -0,0 +1,85 @@
+#pragma once
+
+#include "BookingService.hpp"
+#include "EventLoop.hpp"
+
+#include <atomic>
+#include <coroutine>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace booking {
+// ----------------- Async Mutex -----------------
+// Coroutine mutex: a contended lock() suspends the coroutine and links it into
+// an intrusive waiter list instead of blocking the thread. unlock() hands the
+// lock directly to the oldest waiter and posts it to the EventLoop it was
+// suspended on. The state word is NOT_LOCKED, 0 (locked, no new waiters) or
+// the head of a LIFO stack of newly arrived waiters.
+class AsyncMutex {
+public:
+    class LockAwaiter {
+    public:
+        LockAwaiter(AsyncMutex& m, EventLoop& loop) noexcept : mutex_(m), loop_(loop) {}
+        bool await_ready() noexcept { return mutex_.tryLock(); }
+        bool await_suspend(std::coroutine_handle<> h) noexcept;
+        void await_resume() noexcept {}
+
+    private:
+        friend class AsyncMutex;
+        AsyncMutex& mutex_;
+        EventLoop& loop_;
+        std::coroutine_handle<> handle_;
+        LockAwaiter* next_{nullptr};
+    };
+
+    AsyncMutex() = default;
+    AsyncMutex(const AsyncMutex&) = delete;
+    AsyncMutex& operator=(const AsyncMutex&) = delete;
+
+    [[nodiscard]] LockAwaiter lock(EventLoop& loop) noexcept { return {*this, loop}; }
+    [[nodiscard]] bool tryLock() noexcept;
+    void unlock();
+
+private:
+    static constexpr std::uintptr_t NOT_LOCKED = 1;
+    std::atomic<std::uintptr_t> state_{NOT_LOCKED};
+    LockAwaiter* waiters_{nullptr};   // FIFO of waiters, only touched by the lock holder
+};
+
+// ----------------- Async Booking Service -----------------
+// co_await-able facade over BookingService. Requests for the same show are
+// serialized by a per-show AsyncMutex, so a burst of coroutines on a hot show
+// queues in user space and reaches Show::mtx uncontended. A show's mutex exists
+// only while requests hold or await it, and only for listed shows; requests for
+// unknown shows go straight to the service. Must be awaited from a coroutine
+// running on an EventLoop (EventLoop::current()).
+class AsyncBookingService {
+public:
+    explicit AsyncBookingService(BookingService& service) : service_(service) {}
+
+    [[nodiscard]] Task<bool> bookSeatsAsync(long long showId, std::vector<std::string> seatLabels);
+    [[nodiscard]] Task<std::vector<std::string>> getAvailableSeatsAsync(long long showId);
+
+    [[nodiscard]] BookingService& service() noexcept { return service_; }
+    [[nodiscard]] std::size_t activeShowLocks();                     // Shows with requests holding or awaiting their mutex
+
+private:
+    struct ShowLock {
+        AsyncMutex mutex;
+        std::atomic<std::size_t> users{0};                            // Requests holding or awaiting mutex; dropped at 0
+    };
+    class ShowLockRef;
+
+    ShowLock* acquireShowLock(long long showId);                      // nullptr for an unknown show
+    void releaseShowLock(long long showId);
+
+    BookingService& service_;
+    std::shared_mutex mtx_;                                           // Protects showLocks_; users may change under a shared lock
+    std::unordered_map<long long, std::unique_ptr<ShowLock>> showLocks_;
+};
+
+} // namespace booking
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <array>
+#include <bit>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
@@ -11,6 +14,16 @@
 #include <cstdint>
 #include <utility>
 #include <functional>
+#include <optional>
+#include <span>
+#include "EpochManager.hpp"
+#include "HotShowTracker.hpp"
+#include "MutationLog.hpp"
+#include "ObjectPool.hpp"
+#include "SegmentedTable.hpp"
+#include "ShardedCounter.hpp"
+#include "StringPool.hpp"
+#include "TicketStore.hpp"
 
 namespace booking {
 // ----------------- Booking Service -----------------
@@ -20,27 +33,84 @@ public:
     static constexpr char SEAT_ROW = 'A';
     static constexpr int  TOTAL_SEATS = 20;
 
+    // Seat categories. Every seat belongs to exactly one; the split is part of the fixed layout,
+    // the price of each category is set per service (setCategoryPrice).
+    enum class SeatCategory : std::uint8_t { Standard, Premium, Recliner };
+    static constexpr int CATEGORY_COUNT = 3;
+    static constexpr std::array<std::uint32_t, CATEGORY_COUNT> CATEGORY_SEATS{
+        0x00000FFFu,    // Standard: A1-A12
+        0x0001F000u,    // Premium:  A13-A17
+        0x000E0000u,    // Recliner: A18-A20
+    };
+    static constexpr std::array<long long, CATEGORY_COUNT> DEFAULT_PRICE_CENTS{1200, 1800, 2600};
+
     // Represents a movie
     struct Movie {
         int id{};
-        std::string title;
+        std::string_view title;     // interned in strings_
     };
 
     // Represents a theater
     struct Theater {
         int id{};
-        std::string name;
+        std::string_view name;      // interned in strings_
+    };
+
+    // Running seat totals for one movie or one theater, maintained on every create/book
+    struct SeatAggregate {
+        ShardedCounter available;
+        ShardedCounter sold;
+    };
+
+    // Snapshot returned by getMovieAvailability() / getTheaterAvailability()
+    struct SeatTotals {
+        long long availableSeats{};
+        long long soldSeats{};
     };
 
     // Represents a show of a movie in a theater
-    struct Show {
-        int movieId{};
+    // Seat state is published under a seqlock: bookers hold `mtx` and bump `seq` to odd before
+    // and even after changing the seat words, readers copy the words optimistically and retry
+    // if `seq` moved. Readers therefore never take `mtx` and never delay a booker.
+    //
+    // Shows are allocated from showPool_ with the seat bitmap inline. The state written by every
+    // booking starts on its own cache line and the fields fixed at creation follow on the next,
+    // so bookings of one show never invalidate lines of its neighbours or of its own read-only
+    // fields.
+    static constexpr int SEAT_WORDS = (TOTAL_SEATS + 31) / 32;
+    struct alignas(64) Show {
+        mutable std::mutex mtx;          // per-show booking lock (writers only)
+        std::atomic<std::uint32_t> seq{0};                           // seqlock sequence, odd = write in progress
+        std::array<std::atomic<std::uint32_t>, SEAT_WORDS> seats{};  // bit i of word i/32 set = seat i booked
+        std::atomic<int> availableCount{TOTAL_SEATS};                // cached available seats
+        std::array<std::atomic<std::uint8_t>, CATEGORY_COUNT> categoryAvailable{
+            {{categorySize(0)}, {categorySize(1)}, {categorySize(2)}}}; // cached available seats per category
+        bool removed{false};             // set by removeShow under mtx; later bookings fail
+
+        alignas(64) int movieId{};
         int theaterId{};
-        std::vector<bool> seats;   // true = booked, false = available
-        mutable std::mutex mtx;    // per-show seat lock
-        int availableCount{TOTAL_SEATS}; // cached available seats
+        SeatAggregate* movieStats{};     // owned by movieStats_, lives as long as the service
+        SeatAggregate* theaterStats{};   // owned by theaterStats_
+    };
+
+    // Consistent copy of a show's seat state taken by readSeats()
+    struct SeatSnapshot {
+        std::array<std::uint32_t, SEAT_WORDS> booked{};
+        int availableCount{};
+        [[nodiscard]] bool isBooked(int idx) const noexcept { return (booked[idx / 32] >> (idx % 32)) & 1u; }
     };
 
+    using Ticket = TicketStore::Ticket;
+    using HotShow = HotShowTracker::HotShow;
+    using LogRecord = MutationLog::Record;
+    static constexpr long long ANONYMOUS_CUSTOMER = TicketStore::ANONYMOUS_CUSTOMER;
+    static_assert(TOTAL_SEATS <= 32, "Ticket seat masks hold at most 32 seats");
+    static_assert(CATEGORY_COUNT == 3, "Show::categoryAvailable initializes three categories");
+    static_assert((CATEGORY_SEATS[0] | CATEGORY_SEATS[1] | CATEGORY_SEATS[2]) == (std::uint32_t{1} << TOTAL_SEATS) - 1 &&
+                  (CATEGORY_SEATS[0] & CATEGORY_SEATS[1]) == 0 && (CATEGORY_SEATS[0] & CATEGORY_SEATS[2]) == 0 &&
+                  (CATEGORY_SEATS[1] & CATEGORY_SEATS[2]) == 0,
+                  "Seat categories must partition the seats");
+
     // For getAllShows()
     struct ShowInfo {
         long long id;
@@ -49,18 +119,107 @@ public:
         int availableSeats;
     };
 
+    // For getAllShowViews(): no string copies, views point into the intern pool
+    struct ShowView {
+        long long id;
+        int movieId;
+        int theaterId;
+        std::string_view movieTitle;
+        std::string_view theaterName;
+        int availableSeats;
+    };
+
+    // Optional predicate for scanShows(); zero fields match anything
+    struct ShowFilter {
+        int movieId{0};
+        int theaterId{0};
+        int minAvailable{0};
+    };
+
+    // One page of scanShows(). Pass nextCursor back to continue; done == true at the end.
+    struct ShowPage {
+        std::vector<ShowView> shows;
+        long long nextCursor{0};
+        bool done{false};
+    };
+
+    // Result of importCatalog(). Every non-blank row is counted in exactly one of
+    // showsCreated, duplicateShows (show already existed or repeated in the file), malformedRows
+    // or rejectedCapacity.
+    struct ImportStats {
+        std::size_t rows{0};             // Non-blank data rows read
+        std::size_t moviesCreated{0};
+        std::size_t theatersCreated{0};
+        std::size_t showsCreated{0};
+        std::size_t duplicateShows{0};
+        std::size_t malformedRows{0};
+        std::size_t rejectedCapacity{0}; // Well-formed rows skipped because the show table is full
+    };
+
+    // One leg of bookAcrossShows(): the seats wanted in one show
+    struct ShowSeats {
+        long long showId;
+        std::vector<std::string> seatLabels;
+    };
+
+    static constexpr std::size_t SCAN_BUDGET = 1024;   // Max show IDs probed per scanShows() page
+    static constexpr long long MAX_SHOW_ID_GAP = 1LL << 24; // createShow(..., showId) may run this far above the highest ID
+    static constexpr std::uint32_t HOT_SHOW_SAMPLING = 16; // topShows() counts ~1 in 16 requests
+
     BookingService() = default;
+    ~BookingService();
+    BookingService(const BookingService&) = delete;
+    BookingService& operator=(const BookingService&) = delete;
 
     [[nodiscard]] int addMovie(const std::string& title);                                       // Add movie and returns movie ID
+    [[nodiscard]] int addMovie(const std::string& title, int movieId);                          // Same under a caller-chosen ID (0 = next free)
     [[nodiscard]] int addTheater(const std::string& name);                                      // Add theater and returns theater ID
+    [[nodiscard]] int addTheater(const std::string& name, int theaterId);                       // Same under a caller-chosen ID (0 = next free)
     [[nodiscard]] long long createShow(int movieId, int theaterId);                             // Create show and returns show ID
+    [[nodiscard]] long long createShow(int movieId, int theaterId, long long showId);           // Same under a caller-chosen ID (0 = next free)
+    bool removeShow(long long showId);                                                          // Unlists the show; memory is reclaimed by epoch
+    [[nodiscard]] std::optional<ImportStats> importCatalog(const std::string& path);           // Bulk-loads a CSV/JSONL schedule; nullopt if unreadable
+    [[nodiscard]] std::optional<ImportStats> importCatalog(const std::string& path, bool csvHeader); // Same, skipping a CSV header line if csvHeader
+    bool exportCatalog(const std::string& path) const;                                          // Writes a columnar snapshot for ReadOnlyBookingView
 
     [[nodiscard]] std::vector<std::string> getAvailableSeats(long long showId) const;           // Returns list of available seat labels for the show
+    [[nodiscard]] int getAvailableSeatCount(long long showId) const;                            // Seats left in the show, without listing them
+    [[nodiscard]] bool hasShow(long long showId) const noexcept;                                // Whether the show is currently listed
     [[nodiscard]] bool bookSeats(long long showId, const std::vector<std::string>& seatLabels); // Books the given seats for the show
+    [[nodiscard]] long long bookTicket(long long showId, const std::vector<std::string>& seatLabels,
+                                       long long customerId);                           // Books seats and returns ticket ID or -1
+    [[nodiscard]] std::vector<long long> bookAcrossShows(std::span<const ShowSeats> legs,
+                                                         long long customerId = ANONYMOUS_CUSTOMER); // All legs or none; ticket ID per leg, empty on failure (also for no legs)
+
+    // Seat categories and prices. Availability per category is cached next to the seat bitmap,
+    // so these never scan the seats.
+    [[nodiscard]] int getAvailability(long long showId, SeatCategory category) const;          // Free seats of one category; throws on unknown show
+    [[nodiscard]] long long bookCheapestSeats(long long showId, int count,
+                                              long long customerId = ANONYMOUS_CUSTOMER);       // Books the `count` cheapest free seats; ticket ID or -1
+    void setCategoryPrice(SeatCategory category, long long priceCents) noexcept;
+    [[nodiscard]] long long getCategoryPrice(SeatCategory category) const noexcept;
+    [[nodiscard]] long long quoteSeats(const std::vector<std::string>& seatLabels) const;     // Total price in cents, or -1 if a label is invalid/repeated
+    static SeatCategory seatCategory(int idx) noexcept;                                         // Category of a 0-based seat index
+
+    // Seat holds: the prepare step of a booking decided elsewhere (see ShardServer's two-phase
+    // commit). Held seats are taken for every other booker and reader and count as sold in the
+    // aggregates, but no ticket exists until the hold is confirmed. Holds never expire.
+    [[nodiscard]] long long holdSeats(long long showId, const std::vector<std::string>& seatLabels); // Hold ID or -1
+    [[nodiscard]] long long confirmHold(long long holdId, long long customerId);                // Books the held seats; ticket ID or -1
+    bool releaseHold(long long holdId);                                                         // Frees the held seats; false if unknown
+
+    [[nodiscard]] std::optional<Ticket> getTicket(long long ticketId) const;            // Returns booking record by ticket ID
+    [[nodiscard]] std::vector<Ticket> getTicketsForCustomer(long long customerId) const; // Returns customer's bookings, newest first
 
     bool listMovies() const;                                                        // Lists all active movies, i.e., with at least one show
     void listTheatersForMovie(int movieId) const;                                   // Lists theaters showing the given movie
 
+    [[nodiscard]] SeatTotals getMovieAvailability(int movieId) const;              // Seats left/sold for a movie across all theaters
+    [[nodiscard]] SeatTotals getTheaterAvailability(int theaterId) const;          // Seats left/sold across a theater's shows
+
+    [[nodiscard]] std::vector<HotShow> topShows(std::size_t k,
+                                                std::chrono::steady_clock::duration window) const; // Most requested shows in the window
+
     [[nodiscard]] std::string getMovieTitle(int movieId) const;                     // Returns movie title or "Unknown Movie"
     [[nodiscard]] std::string getTheaterName(int theaterId) const;                  // Returns theater name or "Unknown Theater"
 
@@ -71,11 +230,75 @@ public:
     [[nodiscard]] std::vector<std::pair<int, std::string>> getAllMovies() const;   // Returns vector of (movieId, movieTitle)
     [[nodiscard]] std::vector<std::pair<int, std::string>> getAllTheaters() const; // Returns vector of (theaterId, theaterName)
 
+    // Allocation-free listing variants. Views stay valid as long as the service lives (the intern
+    // pool never frees); catalogEpoch() changes whenever a listing result may be stale.
+    [[nodiscard]] std::vector<ShowView> getAllShowViews() const;                                // Returns IDs + interned names per show
+    [[nodiscard]] std::vector<std::pair<int, std::string_view>> getAllMovieViews() const;       // Returns (movieId, interned title)
+    [[nodiscard]] std::vector<std::pair<int, std::string_view>> getAllTheaterViews() const;     // Returns (theaterId, interned name)
+    [[nodiscard]] std::uint64_t catalogEpoch() const noexcept;                                  // Bumped on every catalog change
+
+    [[nodiscard]] ShowPage scanShows(long long cursor, std::size_t limit) const;                // Paginated show listing, start with cursor 0
+    [[nodiscard]] ShowPage scanShows(long long cursor, std::size_t limit,
+                                     const ShowFilter& filter) const;                           // Same, keeping only shows matching filter
+
+    // Replication: every successful mutation appends a record to `log` (see MutationLog). Attach
+    // before the service is shared between threads; nullptr detaches.
+    void setMutationLog(MutationLog* log) noexcept;
+    bool skipTicketIds(long long lastTicketId);                            // Later tickets get higher IDs; a re-synced replica continues the primary's numbering
+
 private:
-    // Composite key hasher for (movieId, theaterId)
+    // Catalog inserts shared by the single-item API and importCatalog(). Caller holds mtx_
+    // exclusively and has already rejected duplicates; insertShowLocked leaves the showLookup_
+    // entry to the caller, which usually has it from its duplicate check.
+    int insertMovieLocked(std::string_view title, std::string lowerTitle, int id = 0);     // id 0 = next free ID
+    int insertTheaterLocked(std::string_view name, std::string lowerName, int id = 0);
+    long long insertShowLocked(int movieId, int theaterId, long long id = 0);   // id 0 = next free ID
+
+    MutationLog::Writer logWriter() const;                                 // Empty Writer when no log is attached
+
+    // Runs `step` (which numbers something, e.g. appends tickets) and reserves `count` LSNs in
+    // the same critical section of the log; without a log just runs `step`.
+    template <typename Step>
+    MutationLog::Writer logReserve(std::size_t count, Step&& step) const {
+        if (!log_) {
+            (void)step();
+            return {};
+        }
+        return log_->reserve(count, std::forward<Step>(step));
+    }
+
+    static SeatSnapshot readSeats(const Show& show) noexcept;              // Seqlock read, never blocks
+    static void commitSeats(Show& show, std::uint32_t seatMask) noexcept;  // Seqlock write, caller holds show.mtx
+
+    // Booking steps shared by bookTicket() and bookAcrossShows()
+    static std::optional<std::uint32_t> seatMaskFromLabels(const std::vector<std::string>& seatLabels); // nullopt if a label is invalid/repeated
+    static bool seatsFreeLocked(const Show& show, std::uint32_t seatMask);  // Caller holds show.mtx
+    static void applyBookingLocked(Show& show, std::uint32_t seatMask) noexcept; // Commit + aggregates, caller holds show.mtx
+    long long issueTicketLocked(long long showId, Show& show, std::uint32_t seatMask,
+                                long long customerId);                      // Ticket + commit + log; caller holds show.mtx, seats are free
+    static constexpr std::uint8_t categorySize(int category) noexcept {
+        return static_cast<std::uint8_t>(std::popcount(CATEGORY_SEATS[static_cast<std::size_t>(category)]));
+    }
+    static void releaseSeats(Show& show, std::uint32_t seatMask) noexcept; // Seqlock write undoing commitSeats, caller holds show.mtx
+
+    // Seats held by holdSeats() until confirmHold()/releaseHold()
+    struct Hold {
+        long long showId;
+        std::uint32_t seatMask;
+    };
+    std::optional<Hold> takeHold(long long holdId);                        // Removes and returns the hold
+
+    // Composite key hasher for (movieId, theaterId). Both IDs are small dense integers and
+    // std::hash<int> is the identity, so the pair is packed into 64 bits and mixed (splitmix64
+    // finalizer); a plain xor/shift would map millions of pairs onto a few thousand buckets.
     struct PairHash {
         size_t operator()(const std::pair<int, int>& p) const noexcept {
-            return std::hash<int>()(p.first) ^ (std::hash<int>()(p.second) << 1);
+            auto x = (static_cast<std::uint64_t>(static_cast<std::uint32_t>(p.first)) << 32) |
+                     static_cast<std::uint32_t>(p.second);
+            x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+            x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+            x ^= x >> 31;
+            return static_cast<size_t>(x);
         }
     };
 
@@ -83,7 +306,10 @@ private:
 
     std::unordered_map<int, Movie> movies_;                      // movieId to Movie struct hash map
     std::unordered_map<int, Theater> theaters_;                  // theaterId to Theater struct hash map
-    std::unordered_map<long long, std::shared_ptr<Show>> shows_; // showId to Show ptr hash map
+    ObjectPool<Show> showPool_;                                  // Backing storage of every Show, outlives epochs_
+    using ShowTable = SegmentedTable<Show>;
+    ShowTable shows_;                                            // showId to Show, lock-free lookup; owned, removed shows are retired to epochs_
+    std::size_t liveShows_{0};                                   // Shows currently in shows_
 
     // 🔹 Optimization maps
     std::unordered_map<std::string, int> movieNameToId_;    // Secondary hash map for Movie duplicate check based on lowercase title.
@@ -91,6 +317,22 @@ private:
     std::unordered_map<std::pair<int, int>, long long, PairHash> showLookup_; // Composite key (movieId, theaterId) lookup for shows. Use Custom hasher.
     std::unordered_set<int> activeMovies_;                  // Maintain hash map for active movies, i.e., set of movie IDs with at least one active show.
     std::unordered_map<int, std::unordered_set<int>> movieToTheaters_; //   Map from movieId to set of theaterIds showing that movie.
+    std::unordered_map<int, std::unique_ptr<SeatAggregate>> movieStats_;   // movieId to seat totals across its shows
+    std::unordered_map<int, std::unique_ptr<SeatAggregate>> theaterStats_; // theaterId to seat totals across its shows
+
+    StringPool strings_;                                    // Interned movie titles and theater names
+    TicketStore tickets_;                                   // Append-only booking records
+    mutable HotShowTracker hotShows_{HOT_SHOW_SAMPLING};    // Request counts fed by bookTicket/getAvailableSeats
+    std::atomic<std::uint64_t> catalogEpoch_{0};            // Incremented by addMovie/addTheater/createShow/removeShow
+    mutable EpochManager epochs_;                           // Defers freeing removed shows past in-flight readers
+    MutationLog* log_{nullptr};                             // Replication log of the primary, not owned
+
+    std::array<std::atomic<long long>, CATEGORY_COUNT> categoryPrices_{
+        {{DEFAULT_PRICE_CENTS[0]}, {DEFAULT_PRICE_CENTS[1]}, {DEFAULT_PRICE_CENTS[2]}}}; // Price in cents per SeatCategory
+
+    std::mutex holdsMtx_;                                   // Protects holds_ and holdCounter_; taken inside show.mtx
+    std::unordered_map<long long, Hold> holds_;             // holdId to held seats
+    long long holdCounter_{0};                              // For generating unique hold IDs
 
     std::atomic<int> movieCounter_{0};              // For generating unique movie IDs
     std::atomic<int> theaterCounter_{0};            // For generating unique theater IDs
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace booking {
+// ----------------- Catalog File Format -----------------
+// On-disk layout written by BookingService::exportCatalog() and mapped by ReadOnlyBookingView.
+//
+// The file is a fixed header followed by one section per column. Every section starts on an
+// 8-byte boundary and holds a plain array in host byte order, so a reader that maps the file can
+// use the columns in place:
+//
+//   MOVIE_IDS       int32[movieCount]              sorted ascending
+//   MOVIE_NAMES     uint64[movieCount + 1]         [i, i + 1) = title i in STRINGS
+//   THEATER_IDS     int32[theaterCount]            sorted ascending
+//   THEATER_NAMES   uint64[theaterCount + 1]
+//   SHOW_IDS        int64[showCount]               sorted ascending
+//   SHOW_MOVIE      uint32[showCount]              row in the MOVIE_* columns
+//   SHOW_THEATER    uint32[showCount]              row in the THEATER_* columns
+//   SHOW_AVAILABLE  int32[showCount]
+//   SHOW_SEATS      uint32[showCount * seatWords]  bit i of word i/32 set = seat i booked
+//   STRINGS         char[stringBytes]              titles then names, not NUL-terminated
+namespace catalog_file {
+
+inline constexpr char MAGIC[8] = {'B', 'K', 'C', 'A', 'T', 'L', 'G', '\0'};
+inline constexpr std::uint32_t VERSION = 1;
+inline constexpr std::uint32_t BYTE_ORDER_MARK = 0x01020304;   // Read back byte-swapped on a foreign-endian host
+inline constexpr std::size_t ALIGNMENT = 8;
+
+enum Section : std::uint32_t {
+    MOVIE_IDS,
+    MOVIE_NAMES,
+    THEATER_IDS,
+    THEATER_NAMES,
+    SHOW_IDS,
+    SHOW_MOVIE,
+    SHOW_THEATER,
+    SHOW_AVAILABLE,
+    SHOW_SEATS,
+    STRINGS,
+    SECTION_COUNT
+};
+
+struct SectionRef {
+    std::uint64_t offset{};          // From the start of the file, multiple of ALIGNMENT
+    std::uint64_t bytes{};
+};
+
+struct Header {
+    char magic[8]{};
+    std::uint32_t version{};
+    std::uint32_t byteOrder{};
+    std::uint32_t totalSeats{};      // BookingService::TOTAL_SEATS of the exporter
+    std::uint32_t seatWords{};       // 32-bit words per show in SHOW_SEATS
+    std::uint64_t catalogEpoch{};    // Exporter's catalogEpoch() when the snapshot was taken
+    std::uint64_t movieCount{};
+    std::uint64_t theaterCount{};
+    std::uint64_t showCount{};
+    std::uint64_t stringBytes{};
+    SectionRef sections[SECTION_COUNT]{};
+};
+
+static_assert(sizeof(Header) % ALIGNMENT == 0, "Sections must start aligned after the header");
+
+} // namespace catalog_file
+} // namespace booking
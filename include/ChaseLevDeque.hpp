@@ -0,0 +1,112 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <vector>
+
+namespace booking {
+// ----------------- Chase-Lev Deque -----------------
+// Lock-free work-stealing deque (Chase & Lev 2005, memory orders after Le et
+// al. 2013). The owning thread pushes and pops at the bottom; any thread may
+// steal from the top. T must be trivially copyable (typically a pointer).
+// The ring doubles when full; retired rings are kept until destruction so a
+// concurrent thief never reads freed memory.
+template <typename T>
+class ChaseLevDeque {
+public:
+    explicit ChaseLevDeque(std::int64_t capacity = 256)
+        : array_(new Ring(roundUp(capacity))) {
+        retired_.emplace_back(array_.load(std::memory_order_relaxed));
+    }
+    ChaseLevDeque(const ChaseLevDeque&) = delete;
+    ChaseLevDeque& operator=(const ChaseLevDeque&) = delete;
+
+    // Owner only.
+    void push(T item) {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed);
+        const std::int64_t t = top_.load(std::memory_order_acquire);
+        Ring* a = array_.load(std::memory_order_relaxed);
+        if (b - t > a->capacity - 1) a = grow(a, t, b);
+        a->put(b, item);
+        std::atomic_thread_fence(std::memory_order_release);
+        bottom_.store(b + 1, std::memory_order_relaxed);
+    }
+
+    // Owner only. Takes the most recently pushed item.
+    std::optional<T> pop() {
+        const std::int64_t b = bottom_.load(std::memory_order_relaxed) - 1;
+        Ring* a = array_.load(std::memory_order_relaxed);
+        bottom_.store(b, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        std::int64_t t = top_.load(std::memory_order_relaxed);
+
+        if (t > b) {                                  // empty
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+        T item = a->get(b);
+        if (t == b) {                                 // last item: race thieves for it
+            const bool won = top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                                          std::memory_order_relaxed);
+            bottom_.store(b + 1, std::memory_order_relaxed);
+            if (!won) return std::nullopt;
+        }
+        return item;
+    }
+
+    // Any thread. Takes the oldest item; may fail spuriously under contention.
+    std::optional<T> steal() {
+        std::int64_t t = top_.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        const std::int64_t b = bottom_.load(std::memory_order_acquire);
+        if (t >= b) return std::nullopt;
+
+        Ring* a = array_.load(std::memory_order_acquire);
+        T item = a->get(t);
+        if (!top_.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                          std::memory_order_relaxed))
+            return std::nullopt;
+        return item;
+    }
+
+    [[nodiscard]] bool empty() const noexcept {
+        return bottom_.load(std::memory_order_relaxed) <= top_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Ring {
+        explicit Ring(std::int64_t cap)
+            : capacity(cap), mask(cap - 1), slots(new std::atomic<T>[static_cast<std::size_t>(cap)]) {}
+        // Release/acquire on the slot itself (free on x86) also publishes whatever the item points
+        // to in a way race detectors understand; they do not model the standalone fences.
+        T get(std::int64_t i) const noexcept { return slots[static_cast<std::size_t>(i & mask)].load(std::memory_order_acquire); }
+        void put(std::int64_t i, T v) noexcept { slots[static_cast<std::size_t>(i & mask)].store(v, std::memory_order_release); }
+
+        std::int64_t capacity;
+        std::int64_t mask;
+        std::unique_ptr<std::atomic<T>[]> slots;
+    };
+
+    static std::int64_t roundUp(std::int64_t n) {
+        std::int64_t c = 2;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    Ring* grow(Ring* old, std::int64_t t, std::int64_t b) {
+        auto* bigger = new Ring(old->capacity * 2);
+        for (std::int64_t i = t; i < b; ++i) bigger->put(i, old->get(i));
+        retired_.emplace_back(bigger);
+        array_.store(bigger, std::memory_order_release);
+        return bigger;
+    }
+
+    alignas(64) std::atomic<std::int64_t> top_{0};
+    alignas(64) std::atomic<std::int64_t> bottom_{0};
+    alignas(64) std::atomic<Ring*> array_;
+    std::vector<std::unique_ptr<Ring>> retired_;     // Owner only: every ring ever allocated
+};
+
+} // namespace booking
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace booking {
+// ----------------- Consistent Hash Ring -----------------
+// Maps 64-bit keys to node IDs. Each node is placed at VIRTUAL_NODES pseudo-random points on a
+// 64-bit ring and a key belongs to the first point at or after its own hash (wrapping around).
+// Adding a node therefore only takes over the arcs just before its points: about 1/(N+1) of the
+// keys move, all of them to the new node. Removing a node hands its arcs to the following points.
+//
+// Not synchronized; lookups are a binary search over N * VIRTUAL_NODES points.
+class ConsistentHashRing {
+public:
+    static constexpr std::size_t VIRTUAL_NODES = 128;   // Points per node; more = evener split
+
+    void addNode(std::uint32_t node) {
+        for (std::uint64_t v = 0; v < VIRTUAL_NODES; ++v)
+            points_.push_back({mix((std::uint64_t{node} << 32 | v) ^ POINT_SEED), node});
+        std::sort(points_.begin(), points_.end());
+        ++nodes_;
+    }
+
+    void removeNode(std::uint32_t node) {
+        const auto before = points_.size();
+        points_.erase(std::remove_if(points_.begin(), points_.end(),
+                                     [node](const Point& p) { return p.second == node; }),
+                      points_.end());
+        if (points_.size() != before) --nodes_;
+    }
+
+    // Owner of `key`; the ring must not be empty.
+    [[nodiscard]] std::uint32_t owner(std::uint64_t key) const noexcept {
+        const std::uint64_t h = mix(key);
+        auto it = std::lower_bound(points_.begin(), points_.end(), Point{h, 0});
+        return (it == points_.end() ? points_.front() : *it).second;
+    }
+
+    [[nodiscard]] std::size_t nodeCount() const noexcept { return nodes_; }
+    [[nodiscard]] bool empty() const noexcept { return points_.empty(); }
+
+    // splitmix64 finalizer: sequential keys (show IDs) land uniformly on the ring
+    static std::uint64_t mix(std::uint64_t x) noexcept {
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+private:
+    // Seeds point positions so they are unrelated to the hashes of small keys: without it node
+    // 0's points would be mix(0..127), exactly where show IDs 0..127 land.
+    static constexpr std::uint64_t POINT_SEED = 0x9e3779b97f4a7c15ULL;
+
+    using Point = std::pair<std::uint64_t, std::uint32_t>;   // (position, node)
+    std::vector<Point> points_;                              // Sorted by position
+    std::size_t nodes_{0};
+};
+
+} // namespace booking
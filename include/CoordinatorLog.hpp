@@ -0,0 +1,92 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace booking {
+// ----------------- Coordinator Log -----------------
+// Durable log of the two-phase commit coordinator behind ShardRouter::bookAcrossShows().
+//
+// A transaction is logged as BEGIN (its participants and their seats, forced to disk before any
+// participant is asked to prepare), then COMMIT (forced before any participant is told to
+// commit) or ABORT, then END once every participant has acknowledged the outcome. A transaction
+// without END is in doubt after a crash: one with COMMIT must still be committed everywhere,
+// any other is aborted (presumed abort: ABORT itself is never forced).
+//
+// Records are framed as [u32 length][payload][u32 checksum]. A torn last record from a crash
+// mid-append fails its length or checksum and is dropped by open(), which also rewrites the file
+// to hold only unfinished transactions. An append that fails while running (e.g. ENOSPC) is cut
+// off again with ftruncate, so no later record ever follows a torn one; if even that fails, the
+// log refuses further appends. The file is also rewritten whenever it has grown to COMPACT_BYTES
+// and twice its size after the last rewrite, so a long-running coordinator's log stays bounded.
+// Thread-safe; appends are serialized.
+class CoordinatorLog {
+public:
+    static constexpr std::uint64_t COMPACT_BYTES = std::uint64_t{1} << 16;   // Smallest file size that is compacted
+
+    enum class Decision : std::uint8_t { Undecided, Commit, Abort };
+
+    // Seats one participant is asked to hold for a transaction
+    struct Leg {
+        long long showId{};
+        std::uint32_t seatMask{};        // bit i = seat index i
+    };
+
+    // A shard taking part in a transaction, identified by its socket path so that recovery can
+    // reach it without the router that started the transaction
+    struct Participant {
+        std::string path;
+        std::vector<Leg> legs;
+    };
+
+    struct Transaction {
+        std::uint64_t id{};
+        long long customerId{};
+        std::vector<Participant> participants;
+        Decision decision{Decision::Undecided};
+    };
+
+    [[nodiscard]] static std::unique_ptr<CoordinatorLog> open(const std::string& path);   // nullptr if unusable
+
+    ~CoordinatorLog();
+    CoordinatorLog(const CoordinatorLog&) = delete;
+    CoordinatorLog& operator=(const CoordinatorLog&) = delete;
+
+    [[nodiscard]] std::optional<std::uint64_t> begin(long long customerId,
+                                                     std::vector<Participant> participants);  // Forced; returns the transaction ID
+    bool decide(std::uint64_t txId, Decision decision);    // Commit is forced; false if not durable
+    bool end(std::uint64_t txId);                           // Forgets the transaction
+
+    [[nodiscard]] std::vector<Transaction> unfinished() const;   // Begun but not ended, in ID order
+    [[nodiscard]] std::optional<std::uint64_t> endedBelow();     // Syncs; every ID below the result has a durable END
+
+private:
+    enum RecordType : std::uint8_t { BEGIN = 1, DECIDE, END, WATERMARK };
+
+    CoordinatorLog(std::string path, int fd) : path_(std::move(path)), fd_(fd) {}
+
+    bool append(const std::string& payload, bool force);   // Caller holds mtx_; all or nothing
+    bool replay(std::string_view bytes);                   // Rebuilds open_ from a file's contents
+    bool compact();                                        // Rewrites the file with open_ only
+    void compactIfGrown();                                 // Caller holds mtx_
+    static std::string encodeBegin(const Transaction& tx);
+
+    std::string path_;
+    int fd_{-1};                                          // O_APPEND descriptor
+    mutable std::mutex mtx_;                              // Protects everything below
+    std::uint64_t size_{0};                               // End of the last complete record
+    std::uint64_t compactAt_{COMPACT_BYTES};              // Size at which the file is rewritten next
+    bool broken_{false};                                  // A failed append could not be cut off
+    std::map<std::uint64_t, Transaction> open_;           // Begun and not ended
+    std::uint64_t lastTxId_{0};                           // Highest ID ever handed out
+};
+
+} // namespace booking
@@ -0,0 +1,114 @@
+#pragma once
+
+#include "LatencyHistogram.hpp"
+#include "WorkStealingPool.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <vector>
+
+namespace booking {
+// ----------------- Deadline Scheduler -----------------
+// Admission layer in front of a WorkStealingPool for requests that are worthless after a
+// deadline. At most limit() requests are in the pool at once; the rest wait here, earliest
+// deadline first. A request is shed (its onShed runs instead of its job) when it reaches the
+// head of the queue too late to finish by its deadline at the recent service time, or when it
+// arrives to a full queue. Work is thus spent only on requests whose client is still waiting.
+//
+// The limit adapts to the pool (AIMD): every completion that waited less than targetQueueTime
+// and met its deadline raises it by 1/limit, any other lowers it by `backoff` (at most once per
+// targetQueueTime). Once the pool falls behind, requests queue here, in deadline order and
+// visible to shedding, instead of in the pool.
+//
+// Exactly one of job/onShed runs for every submit(): onShed inline in submit() or later on
+// whichever thread dispatches. Both must be quick and must not call back into the scheduler.
+// The pool must outlive the scheduler; the destructor sheds what is still queued and waits for
+// what is running.
+class DeadlineScheduler {
+public:
+    using Clock = std::chrono::steady_clock;
+    using Job = std::function<void()>;
+
+    struct Options {
+        std::size_t initialLimit{16};
+        std::size_t minLimit{1};
+        std::size_t maxLimit{1024};
+        std::size_t maxQueued{4096};                               // Beyond this, arrivals are shed
+        Clock::duration targetQueueTime{std::chrono::milliseconds(5)};
+        double backoff{0.9};                                       // Multiplicative decrease
+    };
+
+    enum class ShedReason { Deadline, QueueFull };
+
+    struct Metrics {
+        std::uint64_t submitted{0};
+        std::uint64_t completed{0};
+        std::uint64_t shedDeadline{0};     // Could not finish in time when dispatched
+        std::uint64_t shedQueueFull{0};    // Arrived to a full queue
+        std::uint64_t lateCompletions{0};  // Ran but finished after the deadline
+        std::size_t limit{0};
+        std::size_t inFlight{0};
+        std::size_t queued{0};
+        LatencyHistogram queueTime;        // ns from submit() to start, completed requests
+        LatencyHistogram serviceTime;      // ns from start to end
+    };
+
+    explicit DeadlineScheduler(WorkStealingPool& pool, const Options& options);
+    explicit DeadlineScheduler(WorkStealingPool& pool) : DeadlineScheduler(pool, Options{}) {}
+    ~DeadlineScheduler();
+    DeadlineScheduler(const DeadlineScheduler&) = delete;
+    DeadlineScheduler& operator=(const DeadlineScheduler&) = delete;
+
+    // Runs `job` on the pool if it can still finish by `deadline`, else calls onShed(reason).
+    // Returns false if the request was shed inside this call.
+    bool submit(Clock::time_point deadline, Job job, std::function<void(ShedReason)> onShed,
+                std::size_t affinity = WorkStealingPool::NO_AFFINITY);
+
+    [[nodiscard]] Metrics metrics() const;                 // Snapshot
+    [[nodiscard]] std::size_t limit() const;
+
+private:
+    struct Request {
+        Clock::time_point deadline;
+        Clock::time_point submitted;
+        std::uint64_t sequence;                             // FIFO among equal deadlines
+        Job job;
+        std::function<void(ShedReason)> onShed;
+        std::size_t affinity;
+    };
+    struct LaterDeadline {
+        bool operator()(const Request& a, const Request& b) const noexcept {
+            return a.deadline != b.deadline ? a.deadline > b.deadline : a.sequence > b.sequence;
+        }
+    };
+    struct Shed {
+        std::function<void(ShedReason)> onShed;
+        ShedReason reason;
+        std::uint64_t sequence;
+    };
+
+    void dispatchLocked(std::vector<Shed>& shed);           // Starts queued requests up to the limit
+    static void runShed(std::vector<Shed>& shed);           // Outside mtx_
+    void run(Request request, Clock::time_point started);
+    void adaptLocked(bool congested, Clock::time_point now);
+
+    WorkStealingPool& pool_;
+    const Options options_;
+
+    mutable std::mutex mtx_;                                // Protects everything below
+    std::priority_queue<Request, std::vector<Request>, LaterDeadline> queue_;
+    double limit_;
+    std::size_t inFlight_{0};
+    std::uint64_t sequence_{0};
+    Clock::time_point lastDecrease_{};
+    double serviceEstimate_{0};                             // EWMA of service time, ns
+    Metrics metrics_;
+    std::condition_variable drained_;                       // inFlight_ reached 0
+};
+
+} // namespace booking
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace booking {
+// ----------------- Epoch Manager -----------------
+// Epoch-based reclamation (Fraser 2004). A thread pins the manager for the
+// duration of a read-side critical section; objects unlinked from shared
+// structures are retired instead of deleted, and freed once every thread that
+// could still hold a pointer to them has unpinned.
+//
+// The global epoch advances only when every pinned thread has observed the
+// current one; an object retired in epoch e is freed once the epoch reaches
+// e + 2. Pinning costs one store, one fence and one store to a cache line owned
+// by the calling thread, so hot read paths share no reference counts.
+class EpochManager {
+    struct Participant;
+
+public:
+    // RAII read-side critical section. Guards nest; only the outermost one publishes.
+    class Guard {
+    public:
+        Guard(Guard&& other) noexcept : participant_(std::exchange(other.participant_, nullptr)) {}
+        Guard& operator=(Guard&&) = delete;
+        Guard(const Guard&) = delete;
+        Guard& operator=(const Guard&) = delete;
+        ~Guard();
+
+    private:
+        friend class EpochManager;
+        explicit Guard(Participant* participant) noexcept : participant_(participant) {}
+        Participant* participant_;
+    };
+
+    EpochManager();
+    ~EpochManager();                       // Frees everything still retired
+    EpochManager(const EpochManager&) = delete;
+    EpochManager& operator=(const EpochManager&) = delete;
+
+    [[nodiscard]] Guard pin();
+    void retire(void* object, void (*deleter)(void* context, void* object), void* context);
+    template <typename T>
+    void retire(T* object) {
+        retire(object, [](void*, void* p) { delete static_cast<T*>(p); }, nullptr);
+    }
+    std::size_t reclaim();                 // Tries to advance the epoch; returns the number of objects freed
+    [[nodiscard]] std::size_t pending() const;
+    [[nodiscard]] std::uint64_t epoch() const noexcept { return global_.load(std::memory_order_relaxed); }
+
+private:
+    struct alignas(64) Participant {
+        std::atomic<std::uint64_t> epoch{0};   // Epoch observed when pinned, 0 = not pinned
+        std::atomic<bool> claimed{false};
+        int depth{0};                          // Guard nesting, touched only by the claiming thread
+        Participant* next{nullptr};
+    };
+
+    struct Retired {
+        void* object;
+        void (*deleter)(void* context, void* object);
+        void* context;                         // e.g. the pool the object came from
+        std::uint64_t epoch;
+    };
+
+    struct ThreadState;
+    static ThreadState& localState();
+    Participant* claimParticipant();
+    bool tryAdvance();
+    std::size_t freeExpired();             // Caller holds retiredMtx_
+
+    const std::uint64_t id_;                           // Distinguishes managers in thread-local state
+    alignas(64) std::atomic<std::uint64_t> global_{1};
+    std::atomic<Participant*> participants_{nullptr};  // Lock-free list, nodes live until destruction
+    mutable std::mutex retiredMtx_;
+    std::vector<Retired> retired_;
+};
+
+} // namespace booking
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <condition_variable>
+#include <coroutine>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <optional>
+#include <utility>
+
+namespace booking {
+// ----------------- Task -----------------
+// Lazily started coroutine returning T. Awaiting a Task starts it and resumes
+// the awaiter (symmetric transfer) when it finishes; exceptions propagate to
+// the awaiter. A Task is move-only and owns its coroutine frame.
+template <typename T>
+class Task;
+
+namespace detail {
+struct TaskPromiseBase {
+    std::coroutine_handle<> continuation;
+    std::exception_ptr error;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+
+    struct FinalAwaiter {
+        bool await_ready() noexcept { return false; }
+        template <typename P>
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<P> h) noexcept {
+            auto next = h.promise().continuation;
+            return next ? next : std::noop_coroutine();
+        }
+        void await_resume() noexcept {}
+    };
+    FinalAwaiter final_suspend() noexcept { return {}; }
+    void unhandled_exception() noexcept { error = std::current_exception(); }
+};
+
+template <typename T>
+struct TaskPromise : TaskPromiseBase {
+    std::optional<T> value;
+    Task<T> get_return_object() noexcept;
+    template <typename U>
+    void return_value(U&& v) { value.emplace(std::forward<U>(v)); }
+    T take() {
+        if (error) std::rethrow_exception(error);
+        return std::move(*value);
+    }
+};
+
+template <>
+struct TaskPromise<void> : TaskPromiseBase {
+    Task<void> get_return_object() noexcept;
+    void return_void() noexcept {}
+    void take() {
+        if (error) std::rethrow_exception(error);
+    }
+};
+} // namespace detail
+
+template <typename T = void>
+class Task {
+public:
+    using promise_type = detail::TaskPromise<T>;
+
+    explicit Task(std::coroutine_handle<promise_type> h) noexcept : handle_(h) {}
+    Task(Task&& other) noexcept : handle_(std::exchange(other.handle_, {})) {}
+    Task& operator=(Task&& other) noexcept {
+        if (this != &other) {
+            if (handle_) handle_.destroy();
+            handle_ = std::exchange(other.handle_, {});
+        }
+        return *this;
+    }
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+    ~Task() { if (handle_) handle_.destroy(); }
+
+    auto operator co_await() && noexcept {
+        struct Awaiter {
+            std::coroutine_handle<promise_type> h;
+            bool await_ready() noexcept { return !h || h.done(); }
+            std::coroutine_handle<> await_suspend(std::coroutine_handle<> awaiting) noexcept {
+                h.promise().continuation = awaiting;
+                return h;
+            }
+            T await_resume() { return h.promise().take(); }
+        };
+        return Awaiter{handle_};
+    }
+
+private:
+    std::coroutine_handle<promise_type> handle_;
+};
+
+namespace detail {
+template <typename T>
+Task<T> TaskPromise<T>::get_return_object() noexcept {
+    return Task<T>{std::coroutine_handle<TaskPromise<T>>::from_promise(*this)};
+}
+inline Task<void> TaskPromise<void>::get_return_object() noexcept {
+    return Task<void>{std::coroutine_handle<TaskPromise<void>>::from_promise(*this)};
+}
+} // namespace detail
+
+// ----------------- Event Loop -----------------
+// Single-threaded scheduler. run() resumes ready coroutines on the calling
+// thread until every spawned task has finished. post() is thread-safe, so a
+// coroutine on another loop (e.g. one releasing an AsyncMutex) can hand a
+// waiter back to the loop it belongs to; the waiter never blocks a thread.
+class EventLoop {
+public:
+    EventLoop() = default;
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator=(const EventLoop&) = delete;
+
+    void post(std::coroutine_handle<> h);          // Thread-safe: queue h to resume on this loop
+    void spawn(Task<void> task);                   // Start a detached task on this loop
+    std::size_t run();                             // Run until all spawned tasks finished; returns resumptions
+
+    template <typename T>
+    T runUntilComplete(Task<T> task);              // Spawn task, run, and return its result
+
+    static EventLoop* current() noexcept;          // Loop running on this thread, or nullptr
+
+    // co_await loop.yield() requeues the current coroutine behind other ready work.
+    auto yield() noexcept {
+        struct Awaiter {
+            EventLoop& loop;
+            bool await_ready() noexcept { return false; }
+            void await_suspend(std::coroutine_handle<> h) { loop.post(h); }
+            void await_resume() noexcept {}
+        };
+        return Awaiter{*this};
+    }
+
+private:
+    struct Detached;
+    static Detached launch(EventLoop& loop, Task<void> task);
+
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::deque<std::coroutine_handle<>> ready_;
+    std::size_t outstanding_{0};                   // Spawned tasks not yet finished
+};
+
+template <typename T>
+T EventLoop::runUntilComplete(Task<T> task) {
+    std::optional<T> result;
+    std::exception_ptr error;
+    spawn([](Task<T> t, std::optional<T>& out, std::exception_ptr& err) -> Task<void> {
+        try {
+            out.emplace(co_await std::move(t));
+        } catch (...) {
+            err = std::current_exception();
+        }
+    }(std::move(task), result, error));
+    run();
+    if (error) std::rethrow_exception(error);
+    return std::move(*result);
+}
+
+template <>
+inline void EventLoop::runUntilComplete<void>(Task<void> task) {
+    std::exception_ptr error;
+    spawn([](Task<void> t, std::exception_ptr& err) -> Task<void> {
+        try {
+            co_await std::move(t);
+        } catch (...) {
+            err = std::current_exception();
+        }
+    }(std::move(task), error));
+    run();
+    if (error) std::rethrow_exception(error);
+}
+
+} // namespace booking
@@ -0,0 +1,107 @@
+#pragma once
+
+#include "BookingService.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace booking {
+// ----------------- Flash Sale Gate -----------------
+// Admission control in front of bookSeats() for shows flagged as high-demand. A client first
+// join()s the show's virtual queue and receives a position token; positions are admitted in
+// order by a token bucket (admitPerSecond, up to `burst` at once), so the show only ever sees
+// bookings at the rate it was configured to absorb, however many clients arrive. An admitted
+// token may book until it lapses admitWindow after its admission; it is spent by the first
+// successful booking. Clients poll() their token for progress in between.
+//
+// The queue is bounded: join() fails with QueueFull once `capacity` tokens are waiting. A show
+// with no seats left is refused with SoldOut at join(), poll() and bookSeats() without queueing.
+// Shows that were never flagged pass straight through to the service.
+//
+// Admission is computed lazily on every call from the elapsed time, so the gate runs no thread.
+// Every call takes `now` so that tests can drive the clock.
+class FlashSaleGate {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    struct Config {
+        std::size_t capacity{10000};               // Max tokens waiting for admission
+        double admitPerSecond{50};                 // Steady admission rate
+        std::size_t burst{10};                     // Max tokens admitted at once after a lull
+        Clock::duration admitWindow{std::chrono::seconds(30)}; // Time an admitted token stays valid
+    };
+
+    enum class Status {
+        Waiting,      // Queued; `ahead` positions are admitted before this one
+        Admitted,     // May book now
+        SoldOut,      // No seats left; not queued
+        QueueFull,    // Too many waiting; not queued
+        Expired,      // Admitted but unused for admitWindow, or already spent
+        Invalid,      // Not a token issued by this gate for a flagged show
+    };
+
+    // Position token handed out by join(). `tag` ties it to the queue that issued it.
+    struct Token {
+        long long showId{};
+        std::uint64_t position{};
+        std::uint64_t tag{};
+    };
+
+    struct Admission {
+        Status status{Status::Invalid};
+        Token token;                       // Meaningful for Waiting/Admitted
+        std::uint64_t ahead{0};            // Waiting: positions still to be admitted first
+        Clock::duration estimatedWait{};   // Waiting: (ahead + 1) / admitPerSecond, at most
+    };
+
+    explicit FlashSaleGate(BookingService& service) : service_(service) {}
+    FlashSaleGate(const FlashSaleGate&) = delete;
+    FlashSaleGate& operator=(const FlashSaleGate&) = delete;
+
+    bool enableQueue(long long showId, const Config& config, Clock::time_point now = Clock::now()); // Flags a show; false if unknown or already flagged
+    bool disableQueue(long long showId);                                                          // Unflags; outstanding tokens become Invalid
+    [[nodiscard]] bool isQueued(long long showId) const;
+
+    [[nodiscard]] Admission join(long long showId, Clock::time_point now = Clock::now());         // Takes a position in the show's queue
+    [[nodiscard]] Admission poll(const Token& token, Clock::time_point now = Clock::now());       // Current state of a token
+    [[nodiscard]] bool bookSeats(const Token& token, const std::vector<std::string>& seatLabels,
+                                 Clock::time_point now = Clock::now());                           // Books with an admitted token
+    [[nodiscard]] bool bookSeats(long long showId, const std::vector<std::string>& seatLabels);  // Unflagged shows only
+
+private:
+    struct Queue {
+        Queue(const Config& config, std::uint64_t salt, Clock::time_point now)
+            : config(config), salt(salt), refilled(now), tokens(static_cast<double>(config.burst)) {}
+
+        std::mutex mtx;                     // Protects everything below
+        Config config;
+        std::uint64_t salt;                 // Mixed into token tags
+        std::uint64_t issued{0};            // Positions handed out: [0, issued)
+        std::uint64_t admitted{0};          // Positions admitted: [0, admitted)
+        std::uint64_t lapsed{0};            // Positions whose admission lapsed: [0, lapsed)
+        Clock::time_point refilled;         // Last token-bucket update
+        double tokens;                      // Admissions available now, <= burst
+        std::deque<std::pair<std::uint64_t, Clock::time_point>> batches; // (admitted after, when), oldest first
+        std::deque<bool> spent;             // For positions [lapsed, admitted): booked or booking
+    };
+
+    std::shared_ptr<Queue> findQueue(long long showId) const;
+    static void advanceLocked(Queue& q, Clock::time_point now);                      // Refill, admit, lapse; caller holds q.mtx
+    static std::uint64_t tagFor(const Queue& q, long long showId, std::uint64_t position) noexcept;
+    static Admission stateLocked(const Queue& q, const Token& token);              // Caller holds q.mtx, has advanced q
+    bool soldOut(long long showId) const;
+
+    BookingService& service_;
+    mutable std::shared_mutex mtx_;                                     // Protects queues_
+    std::unordered_map<long long, std::shared_ptr<Queue>> queues_;     // Flagged shows
+};
+
+} // namespace booking
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace booking {
+// ----------------- Seat Map -----------------
+// Booked-seat bitmap of a multi-row auditorium: one 64-bit word per row, bit s = seat s (from
+// the left) booked. Row r and r + 1 are adjacent.
+class SeatMap {
+public:
+    static constexpr int MAX_SEATS_PER_ROW = 64;
+
+    SeatMap(int rows, int seatsPerRow);
+
+    [[nodiscard]] int rows() const noexcept { return static_cast<int>(booked_.size()); }
+    [[nodiscard]] int seatsPerRow() const noexcept { return seatsPerRow_; }
+    [[nodiscard]] std::uint64_t freeMask(int row) const noexcept { return rowMask_ & ~booked_[static_cast<std::size_t>(row)]; }
+    [[nodiscard]] bool isFree(int row, int seat) const noexcept { return (freeMask(row) >> seat) & 1u; }
+
+    bool book(int row, std::uint64_t seats);       // false (nothing booked) if any seat is taken or outside the row
+    void release(int row, std::uint64_t seats) noexcept;
+
+    [[nodiscard]] int freeSeats() const noexcept;
+    [[nodiscard]] int orphanSeats() const noexcept;   // Free seats with no free neighbour in their row
+
+private:
+    int seatsPerRow_;
+    std::uint64_t rowMask_;                           // Bits of the seats that exist in every row
+    std::vector<std::uint64_t> booked_;
+};
+
+// ----------------- Group Allocator -----------------
+// Seats a party together: each row used gets one contiguous block and the rows are adjacent.
+// place() uses the fewest rows that can hold the party and, among all placements in that many
+// rows, picks the one leaving the fewest orphan seats (a free seat between two taken seats or
+// a taken seat and the aisle, which no later party of two or more can use), then the one whose
+// blocks line up best under each other, then the frontmost.
+//
+// Within a window of rows the party is split as evenly as the free runs allow, and each block
+// is tried flush against either end of every free run that can hold it, and centred under the
+// first block. Runs are found with bit scans over the row words, so a 2,000-seat map is
+// searched in microseconds.
+//
+// firstFit() is the naive baseline: the same row count and even split, but each block goes at
+// the left end of the first run that fits, in the first window that fits.
+struct GroupPlacement {
+    struct Block {
+        int row;
+        int firstSeat;
+        int count;
+        [[nodiscard]] std::uint64_t mask() const noexcept {
+            return (count == 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << count) - 1) << firstSeat;
+        }
+    };
+    std::vector<Block> blocks;   // One per row, front row first
+    int orphans{0};              // Orphan seats this placement creates
+};
+
+class GroupAllocator {
+public:
+    [[nodiscard]] static std::optional<GroupPlacement> place(const SeatMap& map, int partySize);
+    [[nodiscard]] static std::optional<GroupPlacement> firstFit(const SeatMap& map, int partySize);
+    static bool apply(SeatMap& map, const GroupPlacement& placement);   // Books every block, or none
+};
+
+} // namespace booking
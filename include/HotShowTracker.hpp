@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace booking {
+// ----------------- Hot Show Tracker -----------------
+// Streaming heavy-hitter detection over show IDs.
+//
+// record() only bumps a per-thread table of (show ID, count); when that table
+// holds BUFFER_SIZE distinct shows or MAX_BUFFERED requests, or the time bucket
+// it was filled in has ended, it is folded into that bucket's summary under a
+// mutex. A burst on a hot show therefore costs one thread-local increment per
+// call and a single shared update per flush. flush() folds every thread's
+// table, so topShows() after flush() sees all requests recorded so far.
+//
+// Each bucket is a count-min sketch gating a Space-Saving style summary of
+// CAPACITY counters: every event updates the sketch, and a show only takes a
+// counter once its sketch estimate exceeds the smallest tracked count. Cold
+// shows therefore cost a few sketch increments instead of an eviction.
+// BUCKETS buckets of BUCKET_WIDTH form a ring, so memory is fixed regardless
+// of the number of shows. Reported counts never under-estimate, and
+// `count - error` is a lower bound on the true count.
+//
+// With sampleEvery > 1 each thread forwards only one request in sampleEvery
+// on average (random gaps) with weight sampleEvery, so a skipped call costs a
+// counter decrement. Counts then become unbiased estimates and the bounds
+// above hold for the sampled stream only.
+class HotShowTracker {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    static constexpr std::size_t CAPACITY     = 256;   // Tracked counters per bucket
+    static constexpr std::size_t BUCKETS      = 60;    // Ring length
+    static constexpr std::size_t BUFFER_SIZE  = 64;    // Distinct shows per thread-local flush
+    static constexpr std::size_t MAX_BUFFERED = 1024;  // Requests per thread-local flush
+    static constexpr std::size_t SKETCH_DEPTH = 4;     // Count-min rows
+    static constexpr std::size_t SKETCH_WIDTH = 2048;  // Count-min columns (power of two)
+    static constexpr std::chrono::seconds BUCKET_WIDTH{1};
+
+    struct HotShow {
+        long long showId{};
+        std::uint64_t count{};   // Estimated requests in the window (upper bound)
+        std::uint64_t error{};   // Maximum over-estimation of count
+    };
+
+    explicit HotShowTracker(std::uint32_t sampleEvery = 1);
+    ~HotShowTracker();
+    HotShowTracker(const HotShowTracker&) = delete;
+    HotShowTracker& operator=(const HotShowTracker&) = delete;
+
+    void record(long long showId);                                             // Hot path: a few ns amortized; may throw bad_alloc
+    void flush();                                                              // Fold every thread's buffer now
+    [[nodiscard]] std::vector<HotShow> topShows(std::size_t k, Clock::duration window) const; // Up to k hottest shows, hottest first
+
+private:
+    // One time bucket: sketch + min-heap of tracked counters + open-addressing index into the heap
+    struct Summary {
+        struct Entry {
+            HotShow show;
+            std::uint32_t slot;                  // Position of this entry in `index`
+        };
+        static constexpr std::size_t INDEX_SIZE = CAPACITY * 2;
+        static constexpr std::int32_t EMPTY = -1;
+
+        std::int64_t bucket{-1};                 // Absolute bucket number held in this slot
+        std::vector<std::uint32_t> sketch;       // SKETCH_DEPTH x SKETCH_WIDTH
+        std::vector<Entry> heap;                 // At most CAPACITY, smallest count first
+        std::vector<std::int32_t> index;         // Heap position or EMPTY, linear probing
+
+        void reset(std::int64_t b);
+        void add(long long showId, std::uint32_t weight);
+        [[nodiscard]] std::uint64_t floor() const noexcept;   // Smallest tracked count when full, else 0
+
+    private:
+        std::uint64_t sketchAdd(long long showId, std::uint32_t weight) noexcept;   // Returns the new estimate
+        std::uint32_t probe(long long showId) const noexcept;
+        void unindex(std::uint32_t slot) noexcept;
+        void place(std::size_t pos, const Entry& e) noexcept;
+        void siftDown(std::size_t pos) noexcept;
+        void siftUp(std::size_t pos) noexcept;
+    };
+
+    struct ThreadBuffer;
+    friend struct ThreadBuffer;
+
+    static std::int64_t bucketOf(Clock::time_point t) noexcept;
+    void fold(const ThreadBuffer& buf);
+    ThreadBuffer& localBuffer();
+
+    const std::uint64_t id_;                   // Distinguishes trackers in thread-local buffers
+    const std::uint32_t sampleEvery_;          // 1 = count every request
+    mutable std::mutex mtx_;                   // Protects ring_
+    std::array<Summary, BUCKETS> ring_;
+};
+
+} // namespace booking
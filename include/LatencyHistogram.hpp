@@ -0,0 +1,103 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace booking {
+// ----------------- Latency Histogram -----------------
+// Fixed-size log-linear histogram in the style of HdrHistogram. Values (nanoseconds, say) are
+// bucketed by power of two and each power of two is split into SUB_BUCKETS / 2 linear steps, so
+// every recorded value is kept to within 1/128 of its true size over the whole range
+// [0, 2^MAX_BITS) in 4096 buckets (32 KB), and recording is a bit scan plus an increment.
+// Larger values are clamped to the top bucket.
+//
+// recordCorrected() compensates for coordinated omission in closed-loop measurement: when one
+// response took `value` and the caller would have issued a request every `expectedInterval`,
+// the requests that would have been waiting meanwhile are recorded too (value - interval,
+// value - 2 * interval, ...). Open-loop callers that measure from the intended start time
+// already include that waiting and should use record().
+//
+// Not synchronized: keep one per thread and merge().
+class LatencyHistogram {
+public:
+    static constexpr int SUB_BUCKET_BITS = 8;
+    static constexpr std::uint64_t SUB_BUCKETS = std::uint64_t{1} << SUB_BUCKET_BITS;   // Values below are exact
+    static constexpr int MAX_BITS = 38;                                                 // ~275 s in ns
+    static constexpr std::size_t BUCKETS = SUB_BUCKETS + (MAX_BITS - SUB_BUCKET_BITS) * SUB_BUCKETS / 2;
+
+    void record(std::uint64_t value, std::uint64_t count = 1) noexcept {
+        counts_[indexOf(value)] += count;
+        total_ += count;
+        max_ = std::max(max_, value);
+        min_ = std::min(min_, value);
+        sum_ += static_cast<double>(value) * static_cast<double>(count);
+    }
+
+    void recordCorrected(std::uint64_t value, std::uint64_t expectedInterval) noexcept {
+        record(value);
+        if (expectedInterval == 0) return;
+        for (std::uint64_t missed = value; missed > expectedInterval;) {
+            missed -= expectedInterval;
+            record(missed);
+        }
+    }
+
+    void merge(const LatencyHistogram& other) noexcept {
+        for (std::size_t i = 0; i < BUCKETS; ++i) counts_[i] += other.counts_[i];
+        total_ += other.total_;
+        max_ = std::max(max_, other.max_);
+        min_ = std::min(min_, other.min_);
+        sum_ += other.sum_;
+    }
+
+    void reset() noexcept { *this = LatencyHistogram(); }
+
+    // Smallest bucket value v such that at least `percentile`% of the samples are <= v (within
+    // the bucket resolution); percentile 100 returns the exact maximum.
+    [[nodiscard]] std::uint64_t valueAtPercentile(double percentile) const noexcept {
+        if (total_ == 0) return 0;
+        if (percentile >= 100.0) return max_;
+        const auto rank = std::max<std::uint64_t>(1, static_cast<std::uint64_t>(percentile / 100.0 * static_cast<double>(total_) + 0.5));
+        std::uint64_t seen = 0;
+        for (std::size_t i = 0; i < BUCKETS; ++i) {
+            seen += counts_[i];
+            if (seen >= rank) return std::min(highestInBucket(i), max_);
+        }
+        return max_;
+    }
+
+    [[nodiscard]] std::uint64_t count() const noexcept { return total_; }
+    [[nodiscard]] std::uint64_t max() const noexcept { return max_; }
+    [[nodiscard]] std::uint64_t min() const noexcept { return total_ ? min_ : 0; }
+    [[nodiscard]] double mean() const noexcept { return total_ ? sum_ / static_cast<double>(total_) : 0.0; }
+
+private:
+    // Values below SUB_BUCKETS map 1:1. A larger value with `shift` = bit length - SUB_BUCKET_BITS
+    // keeps its top SUB_BUCKET_BITS bits (value >> shift, in [SUB_BUCKETS / 2, SUB_BUCKETS)); each
+    // shift adds SUB_BUCKETS / 2 buckets.
+    static std::size_t indexOf(std::uint64_t value) noexcept {
+        value = std::min(value, (std::uint64_t{1} << MAX_BITS) - 1);
+        if (value < SUB_BUCKETS) return static_cast<std::size_t>(value);
+        const int shift = std::bit_width(value) - SUB_BUCKET_BITS;          // >= 1
+        return static_cast<std::size_t>(shift) * SUB_BUCKETS / 2 + SUB_BUCKETS / 2 +
+               static_cast<std::size_t>(value >> shift) - SUB_BUCKETS / 2;
+    }
+
+    static std::uint64_t highestInBucket(std::size_t index) noexcept {
+        if (index < SUB_BUCKETS) return index;
+        const std::size_t shift = (index - SUB_BUCKETS / 2) / (SUB_BUCKETS / 2);
+        const std::uint64_t sub = (index - SUB_BUCKETS / 2) % (SUB_BUCKETS / 2) + SUB_BUCKETS / 2;
+        return ((sub + 1) << shift) - 1;
+    }
+
+    std::array<std::uint64_t, BUCKETS> counts_{};
+    std::uint64_t total_{0};
+    std::uint64_t max_{0};
+    std::uint64_t min_{UINT64_MAX};
+    double sum_{0};
+};
+
+} // namespace booking
@@ -0,0 +1,114 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+namespace booking {
+// ----------------- Local Socket -----------------
+// Move-only owner of a Unix domain stream socket with blocking, length-prefixed framing
+// (uint32 byte count in host order, then the payload). Both ends run on the same machine, so
+// host byte order is the wire byte order.
+//
+// Failures are reported by return value: factories return an invalid socket (with a message on
+// std::cerr for setup errors), I/O calls return false once the peer is gone or the socket was
+// shut down. A socket may be read by one thread and written by another; shutdown() may be called
+// from any thread to wake both.
+class LocalSocket {
+public:
+    static constexpr std::uint32_t MAX_FRAME_BYTES = 16u << 20;   // Larger frames are treated as a protocol error
+
+    LocalSocket() = default;
+    explicit LocalSocket(int fd) noexcept : fd_(fd) {}
+    ~LocalSocket() { close(); }
+    LocalSocket(LocalSocket&& other) noexcept;
+    LocalSocket& operator=(LocalSocket&& other) noexcept;
+    LocalSocket(const LocalSocket&) = delete;
+    LocalSocket& operator=(const LocalSocket&) = delete;
+
+    [[nodiscard]] static LocalSocket listen(const std::string& path, int backlog = 16);   // Replaces a stale socket file at path
+    [[nodiscard]] static LocalSocket connect(const std::string& path);                    // Invalid if nobody listens at path
+    [[nodiscard]] LocalSocket accept() const;                                             // Blocks; invalid after shutdown()
+
+    [[nodiscard]] bool valid() const noexcept { return fd_ >= 0; }
+    [[nodiscard]] int fd() const noexcept { return fd_; }
+
+    bool sendAll(const void* data, std::size_t bytes) const;     // Writes everything or fails
+    bool recvAll(void* data, std::size_t bytes) const;           // Reads exactly `bytes` or fails
+    bool sendFrame(std::string_view payload) const;
+    bool recvFrame(std::string& payload) const;                  // Replaces payload with the next frame
+    [[nodiscard]] bool readable(std::chrono::milliseconds timeout) const;   // Data (or EOF) pending within timeout
+
+    void shutdown() const noexcept;                              // Wakes blocked accept/recv/send on this socket
+    void close() noexcept;
+
+private:
+    int fd_{-1};
+};
+
+// ----------------- Frame Encoding -----------------
+// Builds a frame payload from fixed-size scalars (host order) and length-prefixed strings.
+class FrameWriter {
+public:
+    template <typename T>
+    FrameWriter& put(T value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        char raw[sizeof(T)];
+        std::memcpy(raw, &value, sizeof(T));
+        bytes_.append(raw, sizeof(T));
+        return *this;
+    }
+    FrameWriter& putString(std::string_view s) {
+        put(static_cast<std::uint32_t>(s.size()));
+        bytes_.append(s.data(), s.size());
+        return *this;
+    }
+    [[nodiscard]] const std::string& bytes() const noexcept { return bytes_; }
+    [[nodiscard]] std::string take() noexcept { return std::move(bytes_); }
+
+private:
+    std::string bytes_;
+};
+
+// Reads a payload written by FrameWriter. Reading past the end sets failed() and yields zeros.
+class FrameReader {
+public:
+    explicit FrameReader(std::string_view bytes) noexcept : bytes_(bytes) {}
+
+    template <typename T>
+    T get() noexcept {
+        static_assert(std::is_trivially_copyable_v<T>);
+        T value{};
+        if (bytes_.size() - pos_ < sizeof(T)) {
+            failed_ = true;
+            return value;
+        }
+        std::memcpy(&value, bytes_.data() + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+    std::string_view getString() noexcept {
+        const auto n = get<std::uint32_t>();
+        if (failed_ || bytes_.size() - pos_ < n) {
+            failed_ = true;
+            return {};
+        }
+        std::string_view s = bytes_.substr(pos_, n);
+        pos_ += n;
+        return s;
+    }
+    [[nodiscard]] bool failed() const noexcept { return failed_; }
+    [[nodiscard]] bool done() const noexcept { return pos_ == bytes_.size(); }   // Everything consumed
+
+private:
+    std::string_view bytes_;
+    std::size_t pos_{0};
+    bool failed_{false};
+};
+
+} // namespace booking
@@ -0,0 +1,178 @@
+#pragma once
+
+#include "WaitStrategy.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace booking {
+// ----------------- MPSC Queue -----------------
+// Bounded multi-producer / single-consumer ring buffer (Vyukov's sequenced ring,
+// specialised for one consumer). Every slot carries a sequence number: a slot at
+// position p is free for a producer when seq == p and holds a value for the
+// consumer when seq == p + 1. Producers claim positions with one CAS on tail_;
+// the consumer never performs an atomic RMW.
+//
+// tryPushBatch claims a run of n positions with a single CAS, so a batch costs
+// one contended operation instead of n. The consumer publishes head_ once per
+// pop/batch, which lets producers size a batch without probing slots.
+template <typename T, typename Wait = YieldingWait>
+class MpscQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "T must be nothrow movable");
+
+public:
+    explicit MpscQueue(std::size_t capacity)
+        : capacity_(roundUp(capacity)), mask_(capacity_ - 1),
+          slots_(static_cast<Slot*>(::operator new(sizeof(Slot) * capacity_, std::align_val_t{alignof(Slot)}))) {
+        for (std::size_t i = 0; i < capacity_; ++i)
+            new (&slots_[i].seq) std::atomic<std::size_t>(i);
+    }
+
+    ~MpscQueue() {
+        while (tryPop()) {}
+        ::operator delete(slots_, std::align_val_t{alignof(Slot)});
+    }
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread. Returns false when full.
+    template <typename U>
+    bool tryPush(U&& value) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        for (;;) {
+            Slot& slot = slots_[pos & mask_];
+            const std::size_t seq = slot.seq.load(std::memory_order_acquire);
+            const auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    new (slot.bytes) T(std::forward<U>(value));
+                    slot.seq.store(pos + 1, std::memory_order_release);
+                    notEmpty_.notify();
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;                              // Slot still holds the value from the previous lap
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // Any thread. Moves up to `count` items starting at `first` into consecutive positions;
+    // returns how many were taken. Items of one batch stay contiguous in consumer order.
+    template <typename InputIt>
+    std::size_t tryPushBatch(InputIt first, std::size_t count) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        std::size_t n = 0;
+        for (;;) {
+            // The consumer frees positions in order and stores head_ after their sequence
+            // numbers, so every position below head_ + capacity_ is free once claimed.
+            const std::size_t head = head_.load(std::memory_order_acquire);
+            const std::size_t used = pos - head;
+            if (used >= capacity_) {
+                // head_ may be stale by the time we read tail_; re-read before reporting full.
+                const std::size_t again = tail_.load(std::memory_order_relaxed);
+                if (again == pos) return 0;
+                pos = again;
+                continue;
+            }
+            n = std::min(count, capacity_ - used);
+            if (n == 0) return 0;
+            if (tail_.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) break;
+        }
+        for (std::size_t i = 0; i < n; ++i, ++first) {
+            Slot& slot = slots_[(pos + i) & mask_];
+            new (slot.bytes) T(std::move(*first));
+            slot.seq.store(pos + i + 1, std::memory_order_release);
+        }
+        notEmpty_.notify();
+        return n;
+    }
+
+    // Any thread. Waits while the ring is full.
+    template <typename U>
+    void push(U&& value) {
+        while (!tryPush(std::forward<U>(value)))   // value is only consumed on success
+            notFull_.wait([this] { return !full(); });
+    }
+
+    // Consumer only. Returns std::nullopt when empty (or when the next producer has
+    // claimed its position but not finished writing it).
+    std::optional<T> tryPop() {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        Slot& slot = slots_[head & mask_];
+        if (slot.seq.load(std::memory_order_acquire) != head + 1) return std::nullopt;
+        T* value = slot.value();
+        std::optional<T> out(std::move(*value));
+        value->~T();
+        slot.seq.store(head + capacity_, std::memory_order_release);
+        head_.store(head + 1, std::memory_order_release);
+        notFull_.notify();
+        return out;
+    }
+
+    // Consumer only. Moves up to `max` ready items to `out`; returns how many were written.
+    template <typename OutputIt>
+    std::size_t tryPopBatch(OutputIt out, std::size_t max) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        std::size_t n = 0;
+        for (; n < max; ++n, ++out) {
+            Slot& slot = slots_[(head + n) & mask_];
+            if (slot.seq.load(std::memory_order_acquire) != head + n + 1) break;
+            T* value = slot.value();
+            *out = std::move(*value);
+            value->~T();
+            slot.seq.store(head + n + capacity_, std::memory_order_release);
+        }
+        if (n == 0) return 0;
+        head_.store(head + n, std::memory_order_release);
+        notFull_.notify();
+        return n;
+    }
+
+    // Consumer only. Waits while the ring is empty.
+    T pop() {
+        for (;;) {
+            if (auto value = tryPop()) return std::move(*value);
+            notEmpty_.wait([this] { return !empty(); });
+        }
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    // Consumer view: true when the next position has no published value.
+    [[nodiscard]] bool empty() const noexcept {
+        const std::size_t head = head_.load(std::memory_order_acquire);
+        return slots_[head & mask_].seq.load(std::memory_order_acquire) != head + 1;
+    }
+    [[nodiscard]] bool full() const noexcept {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire) >= capacity_;
+    }
+
+private:
+    struct Slot {
+        std::atomic<std::size_t> seq;
+        alignas(T) unsigned char bytes[sizeof(T)];
+        T* value() noexcept { return std::launder(reinterpret_cast<T*>(bytes)); }
+    };
+
+    static std::size_t roundUp(std::size_t n) {
+        std::size_t c = 2;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    Slot* const slots_;
+
+    alignas(64) std::atomic<std::size_t> head_{0};   // Consumer position
+    alignas(64) std::atomic<std::size_t> tail_{0};   // Next position to claim (producers)
+    [[no_unique_address]] Wait notEmpty_{};          // Consumer waits here
+    [[no_unique_address]] Wait notFull_{};           // Producers wait here
+};
+
+} // namespace booking
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace booking {
+// ----------------- Mutation Log -----------------
+// In-memory log of the catalog and booking mutations of one BookingService, in the order a
+// follower must replay them to reach the same state with the same IDs.
+//
+// Each record gets a log sequence number (LSN: 1, 2, 3, ...) and is stored already encoded, so
+// shipping it is a copy. A writer reserves its LSN while it still holds whatever orders the
+// mutation (the show lock of a booking, the catalog lock of a new show), before the mutation is
+// visible; the record itself is encoded and stored afterwards, outside the log's lock. A mutation
+// that depends on another (a booking on a new show, a ticket ID after a lower one) therefore
+// always gets a higher LSN, while the lock is held only to hand out numbers. Readers see records
+// up to lastLsn(), the end of the gap-free prefix.
+//
+// The log keeps at most about `retainRecords` records; the replication primary trims further, up
+// to what every connected follower has acknowledged. Trimmed records are folded into a base state
+// (catalog, live shows with their booked seats, last ticket ID) whose size follows the catalog,
+// not the booking history, and snapshot() turns it into records a follower that asks for a
+// trimmed LSN can re-sync from.
+class MutationLog {
+public:
+    static constexpr std::size_t DEFAULT_RETAINED_RECORDS = std::size_t{1} << 18;
+    static constexpr std::size_t TRIM_BATCH = 1024;   // Records trimmed at least per trim
+
+    struct Record {
+        // Noop fills an LSN reserved by a Writer that was destroyed unused (an exception). ShowSeats
+        // and Snapshot only appear in snapshots.
+        enum class Type : std::uint8_t { AddMovie = 1, AddTheater, CreateShow, RemoveShow, Book, Noop, ShowSeats, Snapshot };
+
+        Type type{Type::AddMovie};
+        std::uint64_t lsn{};             // Assigned by Writer::append; a snapshot's records carry its LSN
+        std::int64_t timestampNs{};      // Primary's system_clock at append
+        long long id{};                  // Movie, theater or show ID
+        int movieId{};                   // CreateShow
+        int theaterId{};                 // CreateShow
+        long long ticketId{};            // Book; Snapshot: last ticket ID issued
+        long long customerId{};          // Book
+        std::uint32_t seatMask{};        // Book, ShowSeats: bit i = seat index i
+        std::string text{};              // AddMovie title / AddTheater name
+    };
+
+    // LSNs reserved by one writer; an empty Writer (no log attached) ignores appends. LSNs still
+    // unused when the Writer is destroyed are filled with Noop records so readers never stall.
+    class Writer {
+    public:
+        Writer() = default;
+        ~Writer();
+        Writer(Writer&& other) noexcept
+            : log_(std::exchange(other.log_, nullptr)), next_(std::exchange(other.next_, 0)),
+              end_(std::exchange(other.end_, 0)) {}
+        Writer& operator=(Writer&&) = delete;
+
+        void reserve(std::size_t count = 1);     // Takes the next `count` LSNs now, giving up any still unused
+        std::uint64_t append(Record record);     // Fills the oldest reserved LSN (reserving one if none is left) and returns it; 0 for an empty Writer
+
+    private:
+        friend class MutationLog;
+        explicit Writer(MutationLog& log) : log_(&log) {}
+        void fillUnused();
+
+        MutationLog* log_{nullptr};
+        std::uint64_t next_{0};                  // Next reserved LSN to fill
+        std::uint64_t end_{0};                   // One past the last reserved LSN
+    };
+
+    // State of the log up to `lsn`, as records that rebuild it: AddMovie, AddTheater, CreateShow
+    // and ShowSeats per live show, then a Snapshot record with the last ticket ID.
+    struct Snapshot {
+        std::uint64_t lsn{0};
+        std::vector<std::string> records;        // Encoded
+    };
+
+    explicit MutationLog(std::size_t retainRecords = DEFAULT_RETAINED_RECORDS) : retain_(retainRecords) {}
+    MutationLog(const MutationLog&) = delete;
+    MutationLog& operator=(const MutationLog&) = delete;
+
+    [[nodiscard]] Writer writer() { return Writer(*this); }
+
+    // Runs `step` under the log's lock and, if it returns true, reserves `count` LSNs in the same
+    // critical section: whatever `step` numbers (ticket IDs) is numbered in LSN order too.
+    template <typename Step>
+    [[nodiscard]] Writer reserve(std::size_t count, Step&& step) {
+        Writer writer(*this);
+        std::lock_guard lock(mtx_);
+        if (step()) reserveLocked(writer, count);
+        return writer;
+    }
+
+    [[nodiscard]] std::uint64_t lastLsn() const noexcept { return lastLsn_.load(std::memory_order_acquire); }
+    [[nodiscard]] std::uint64_t firstLsn() const;           // Oldest LSN still held; lastLsn() + 1 when empty
+    [[nodiscard]] std::size_t size() const;                 // Records held, including reserved ones
+
+    // Appends encoded records with LSN >= fromLsn to `out` (at most maxRecords), waiting up to
+    // `timeout` for the first one. Returns the number appended, or nullopt if fromLsn was
+    // trimmed (re-sync from snapshot()).
+    std::optional<std::size_t> readFrom(std::uint64_t fromLsn, std::vector<std::string>& out, std::size_t maxRecords,
+                                        std::chrono::milliseconds timeout) const;
+
+    void trim(std::uint64_t throughLsn);                    // Drops records up to throughLsn (at most lastLsn()) into the base state
+    [[nodiscard]] Snapshot snapshot() const;                // Base state: everything before firstLsn()
+
+    static std::string encode(const Record& record);
+    [[nodiscard]] static std::optional<Record> decode(std::string_view bytes);   // nullopt if malformed
+
+private:
+    struct BaseShow {
+        int movieId;
+        int theaterId;
+        std::uint32_t seatMask;
+    };
+
+    void reserveLocked(Writer& writer, std::size_t count);
+    void fill(std::uint64_t lsn, std::string bytes);
+    bool trimTo(std::uint64_t throughLsn, bool wait);       // false if another trim was running and wait == false
+
+    const std::size_t retain_;
+
+    mutable std::mutex mtx_;                     // Protects the LSN counters and records_
+    mutable std::condition_variable appended_;   // Signalled when lastLsn_ advances
+    std::deque<std::string> records_;            // records_[lsn - firstLsn_], encoded; empty = reserved, not yet filled
+    std::uint64_t firstLsn_{1};
+    std::uint64_t nextLsn_{1};                   // Next LSN to reserve
+    std::atomic<std::uint64_t> lastLsn_{0};      // Every LSN up to this one is filled
+
+    mutable std::mutex baseMtx_;                 // Protects the base state; held across a whole trim. Taken before mtx_
+    std::vector<std::pair<int, std::string>> baseMovies_;
+    std::vector<std::pair<int, std::string>> baseTheaters_;
+    std::map<long long, BaseShow> baseShows_;    // Live shows as of firstLsn_ - 1
+    long long baseLastTicket_{0};
+};
+
+} // namespace booking
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+namespace booking {
+// ----------------- Object Pool -----------------
+// Slab allocator for one object type. Objects are carved from slabs of
+// SLAB_OBJECTS, each slab aligned to alignof(T), so an over-aligned T (e.g.
+// alignas(64)) never straddles a cache line shared with a neighbour and no
+// per-object malloc header or rounding is paid. Freed objects go on an
+// intrusive free list and are reused before a new slab is allocated; slabs are
+// returned to the system only when the pool is destroyed.
+template <typename T, std::size_t SLAB_OBJECTS = 256>
+class ObjectPool {
+    static_assert(sizeof(T) >= sizeof(void*), "free list link is stored in the object's storage");
+
+public:
+    ObjectPool() = default;
+    ~ObjectPool() {
+        for (void* slab : slabs_) ::operator delete(slab, std::align_val_t{alignof(T)});
+    }
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    template <typename... Args>
+    [[nodiscard]] T* create(Args&&... args) {
+        void* storage;
+        {
+            std::lock_guard<std::mutex> guard(mtx_);
+            storage = take();
+            ++live_;
+        }
+        try {
+            return new (storage) T(std::forward<Args>(args)...);
+        } catch (...) {
+            std::lock_guard<std::mutex> guard(mtx_);
+            give(storage);
+            --live_;
+            throw;
+        }
+    }
+
+    void destroy(T* object) noexcept {
+        if (!object) return;
+        object->~T();
+        std::lock_guard<std::mutex> guard(mtx_);
+        give(object);
+        --live_;
+    }
+
+    [[nodiscard]] std::size_t live() const {
+        std::lock_guard<std::mutex> guard(mtx_);
+        return live_;
+    }
+    [[nodiscard]] std::size_t bytesReserved() const {
+        std::lock_guard<std::mutex> guard(mtx_);
+        return slabs_.size() * SLAB_OBJECTS * sizeof(T);
+    }
+    static constexpr std::size_t bytesPerObject() noexcept { return sizeof(T); }
+
+private:
+    struct FreeNode {
+        FreeNode* next;
+    };
+
+    // Caller holds mtx_.
+    void* take() {
+        if (free_) {
+            FreeNode* node = free_;
+            free_ = node->next;
+            return node;
+        }
+        if (slabs_.empty() || carved_ == SLAB_OBJECTS) {
+            slabs_.push_back(::operator new(sizeof(T) * SLAB_OBJECTS, std::align_val_t{alignof(T)}));
+            carved_ = 0;
+        }
+        return static_cast<unsigned char*>(slabs_.back()) + sizeof(T) * carved_++;
+    }
+
+    void give(void* storage) noexcept {
+        free_ = new (storage) FreeNode{free_};
+    }
+
+    mutable std::mutex mtx_;
+    std::vector<void*> slabs_;
+    std::size_t carved_{0};          // Objects handed out from the newest slab
+    FreeNode* free_{nullptr};
+    std::size_t live_{0};
+};
+
+} // namespace booking
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+#include "BookingService.hpp"
+#include "CatalogFile.hpp"
+
+namespace booking {
+// ----------------- Read-Only Booking View -----------------
+// Query-only view of a catalog file written by BookingService::exportCatalog().
+//
+// open() maps the file read-only and checks the header and section bounds; nothing is parsed or
+// copied. Every query then reads the columns in place: show lookup is a binary search over the
+// sorted SHOW_IDS column and names are views into the mapping. The view is a frozen snapshot:
+// it never observes later bookings, and it stays valid even if the file is replaced meanwhile
+// (exportCatalog() renames a new file over the old one, the mapping keeps the old inode).
+//
+// Safe to query from any number of threads; move-only.
+class ReadOnlyBookingView {
+public:
+    using ShowInfo = BookingService::ShowInfo;
+    using ShowView = BookingService::ShowView;
+
+    [[nodiscard]] static std::optional<ReadOnlyBookingView> open(const std::string& path); // nullopt if unreadable or not a catalog file
+
+    ~ReadOnlyBookingView();
+    ReadOnlyBookingView(ReadOnlyBookingView&& other) noexcept;
+    ReadOnlyBookingView& operator=(ReadOnlyBookingView&& other) noexcept;
+    ReadOnlyBookingView(const ReadOnlyBookingView&) = delete;
+    ReadOnlyBookingView& operator=(const ReadOnlyBookingView&) = delete;
+
+    [[nodiscard]] std::size_t movieCount() const noexcept { return header_->movieCount; }
+    [[nodiscard]] std::size_t theaterCount() const noexcept { return header_->theaterCount; }
+    [[nodiscard]] std::size_t showCount() const noexcept { return header_->showCount; }
+    [[nodiscard]] std::uint64_t catalogEpoch() const noexcept { return header_->catalogEpoch; }  // Exporter's epoch at snapshot time
+
+    [[nodiscard]] std::vector<std::string> getAvailableSeats(long long showId) const;   // Same labels as BookingService; throws on unknown ID
+    [[nodiscard]] int getAvailableSeatCount(long long showId) const;                    // Cached count; throws on unknown ID
+
+    [[nodiscard]] std::vector<ShowInfo> getAllShows() const;                            // Shows in ID order, names copied
+    [[nodiscard]] std::vector<ShowView> getAllShowViews() const;                        // Same, names are views into the mapping
+    [[nodiscard]] std::vector<std::pair<int, std::string_view>> getAllMovieViews() const;   // (movieId, title) in ID order
+    [[nodiscard]] std::vector<std::pair<int, std::string_view>> getAllTheaterViews() const; // (theaterId, name) in ID order
+
+    [[nodiscard]] std::string_view getMovieTitle(int movieId) const;                    // Title or "Unknown Movie"
+    [[nodiscard]] std::string_view getTheaterName(int theaterId) const;                 // Name or "Unknown Theater"
+
+private:
+    ReadOnlyBookingView(const void* base, std::size_t size) noexcept;
+
+    template <typename T>
+    const T* column(catalog_file::Section section) const noexcept {
+        return reinterpret_cast<const T*>(base_ + header_->sections[section].offset);
+    }
+    [[nodiscard]] std::size_t findShow(long long showId) const;          // Row of showId; throws std::invalid_argument
+    [[nodiscard]] std::string_view name(catalog_file::Section offsets, std::size_t row) const noexcept;
+    [[nodiscard]] ShowView showViewAt(std::size_t row) const noexcept;
+
+    const char* base_{nullptr};                        // Start of the read-only mapping
+    std::size_t size_{0};                              // Mapped bytes
+    const catalog_file::Header* header_{nullptr};      // At base_
+};
+
+} // namespace booking
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "BookingService.hpp"
+#include "LocalSocket.hpp"
+#include "MutationLog.hpp"
+
+namespace booking {
+// ----------------- Log-Shipping Replication -----------------
+// Primary/follower replication between processes on one machine.
+//
+// The primary's BookingService appends every mutation to a MutationLog (setMutationLog); a
+// ReplicationPrimary listens on a Unix socket and streams that log to each connected follower,
+// starting at the LSN the follower asks for. A ReplicationFollower applies the records, in LSN
+// order, to its own BookingService through the public API, so the follower ends up with the same
+// IDs and seat maps and can serve getAvailableSeats and listings. Ticket timestamps are the
+// follower's own.
+//
+// The log is trimmed up to what every connected follower has acknowledged (and to its own
+// retention bound). A follower that asks for a trimmed LSN, e.g. a new one or one that was
+// disconnected for long, gets a SNAPSHOT instead: the log's base state, which it applies as a
+// diff (missing catalog entries and shows, extra booked seats, removed shows) before streaming
+// resumes after it. Bookings covered by a snapshot show up on the follower as seats, not as the
+// primary's tickets: their IDs are skipped, and any seats the follower had to add are held by
+// anonymous tickets of its own.
+//
+// Both sides report lag. The primary sends a heartbeat carrying its last LSN whenever it has
+// nothing to ship for HEARTBEAT_INTERVAL; the follower acknowledges what it has applied. The
+// follower's staleness is the time since it last knew it had applied everything the primary had
+// announced, measured on its own clock, so it is an upper bound on how old its reads can be.
+//
+// Wire messages are LocalSocket frames. Log records are shipped as MutationLog encodes them
+// (first byte = record type); control messages use the MessageType bytes below.
+namespace replication {
+enum MessageType : std::uint8_t {
+    HELLO = 0x40,        // follower -> primary: u64 first LSN wanted
+    HEARTBEAT = 0x41,    // primary -> follower: u64 primary's last LSN
+    ACK = 0x42,          // follower -> primary: u64 last LSN applied
+    SNAPSHOT = 0x43      // primary -> follower: u64 snapshot LSN, followed by its records up to the Snapshot record
+};
+inline constexpr auto HEARTBEAT_INTERVAL = std::chrono::milliseconds(50);
+inline constexpr std::size_t BATCH_RECORDS = 256;     // Records shipped per log read
+} // namespace replication
+
+class ReplicationPrimary {
+public:
+    struct FollowerStatus {
+        std::uint64_t followerId{};
+        bool connected{};
+        std::uint64_t ackedLsn{};                             // Last LSN the follower reported applied
+        std::uint64_t lagRecords{};                           // Primary's last LSN - ackedLsn
+        std::chrono::steady_clock::duration sinceAck{};       // Age of the last acknowledgement
+    };
+
+    ReplicationPrimary(MutationLog& log, std::string socketPath);
+    ~ReplicationPrimary();                                    // stop()
+    ReplicationPrimary(const ReplicationPrimary&) = delete;
+    ReplicationPrimary& operator=(const ReplicationPrimary&) = delete;
+
+    bool start();                                             // Listens and accepts followers; false if the socket cannot be bound
+    void stop();                                              // Disconnects followers, joins threads, removes the socket file
+
+    [[nodiscard]] std::vector<FollowerStatus> followers() const;   // One entry per follower ever connected
+    [[nodiscard]] std::uint64_t lastLsn() const noexcept { return log_.lastLsn(); }
+
+private:
+    struct Follower {
+        std::uint64_t id{};
+        LocalSocket socket;
+        std::atomic<bool> connected{true};
+        std::atomic<std::uint64_t> ackedLsn{0};
+        std::atomic<std::int64_t> ackedAtNs{0};          // steady_clock
+        std::thread thread;
+    };
+
+    void acceptLoop();
+    void serve(Follower& follower);
+    void trimAcknowledged();                                  // Trims the log up to the lowest ACK of the connected followers
+
+    MutationLog& log_;
+    std::string path_;
+    LocalSocket listener_;
+    std::thread acceptThread_;
+    std::atomic<bool> stopping_{false};
+    mutable std::mutex mtx_;                                  // Protects followers_
+    std::vector<std::unique_ptr<Follower>> followers_;
+};
+
+class ReplicationFollower {
+public:
+    struct Status {
+        bool connected{};
+        bool diverged{};                                      // A record could not be applied; replication stopped
+        std::uint64_t appliedLsn{};
+        std::uint64_t primaryLsn{};                           // Highest LSN the primary has announced
+        std::uint64_t lagRecords{};                           // primaryLsn - appliedLsn
+        std::uint64_t snapshotsApplied{};                     // Re-syncs after falling behind the primary's trimmed log
+        std::chrono::steady_clock::duration staleness{};      // Time since last known fully caught up
+    };
+
+    ReplicationFollower(BookingService& replica, std::string socketPath);
+    ~ReplicationFollower();                                   // stop()
+    ReplicationFollower(const ReplicationFollower&) = delete;
+    ReplicationFollower& operator=(const ReplicationFollower&) = delete;
+
+    // Connects (retrying until connectTimeout) and starts applying; reconnects and resumes from the
+    // next LSN if the primary goes away. False if the first connection cannot be made.
+    bool start(std::chrono::milliseconds connectTimeout = std::chrono::seconds(5));
+    void stop();
+
+    [[nodiscard]] Status status() const;
+    [[nodiscard]] bool withinStaleness(std::chrono::steady_clock::duration bound) const;      // Safe to serve reads with this bound
+    bool waitForLsn(std::uint64_t lsn, std::chrono::milliseconds timeout) const;             // Read-your-writes for a primary LSN
+
+private:
+    bool connect(std::chrono::milliseconds timeout);
+    void applyLoop();
+    bool apply(const BookingService::LogRecord& record);
+    bool applySnapshot(const std::vector<BookingService::LogRecord>& records);   // Last record is the Snapshot record
+    void caughtUp();                                          // appliedLsn_ reached primaryLsn_
+    void notifyProgress();                                    // Wakes waitForLsn()
+
+    BookingService& replica_;
+    std::string path_;
+    mutable std::mutex socketMtx_;                            // Guards replacing socket_ against stop()'s shutdown
+    LocalSocket socket_;                                      // Read/written by the apply thread only
+    std::thread thread_;
+    std::atomic<bool> stopping_{false};
+    std::atomic<bool> connected_{false};
+    std::atomic<bool> diverged_{false};
+    std::atomic<std::uint64_t> appliedLsn_{0};
+    std::atomic<std::uint64_t> primaryLsn_{0};
+    std::atomic<std::uint64_t> snapshotsApplied_{0};
+    std::atomic<std::int64_t> caughtUpAtNs_{0};               // steady_clock; 0 = never
+    mutable std::mutex waitMtx_;
+    mutable std::condition_variable progressed_;               // Signalled after each applied batch
+};
+
+} // namespace booking
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+
+namespace booking {
+// ----------------- Schedule Points -----------------
+// Hooks for deterministic concurrency tests. The booking paths call schedulePoint() wherever a
+// different interleaving could change what other threads observe: between finding a show and
+// locking it, inside seqlock write sections, between the loads of a seqlock read. Normally no
+// hook is installed and a call costs one relaxed load. A test scheduler installs a hook that
+// parks the calling thread and picks the next one to run, so that one seed replays exactly one
+// interleaving.
+//
+// Threads park only at schedule points, so a lock held across one must be taken with
+// lockCooperatively(): a thread finding it held then yields at a schedule point instead of
+// blocking, and the scheduler can run the holder.
+using ScheduleHook = void (*)() noexcept;
+inline std::atomic<ScheduleHook> scheduleHook{nullptr};
+
+inline void schedulePoint() noexcept {
+    if (ScheduleHook hook = scheduleHook.load(std::memory_order_relaxed)) hook();
+}
+
+// Locks `m`; under a scheduler, waits by yielding at schedule points rather than blocking.
+template <typename Mutex>
+std::unique_lock<Mutex> lockCooperatively(Mutex& m) {
+    std::unique_lock<Mutex> lock(m, std::try_to_lock);
+    if (lock.owns_lock()) return lock;
+    if (!scheduleHook.load(std::memory_order_relaxed)) {
+        lock.lock();
+        return lock;
+    }
+    do schedulePoint(); while (!lock.try_lock());
+    return lock;
+}
+
+} // namespace booking
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <limits>
+#include <utility>
+
+namespace booking {
+// ----------------- Segmented Table -----------------
+// Lock-free map from dense integer IDs (1, 2, 3, ...) to T*. IDs live in lazily
+// allocated chunks of CHUNK_SIZE atomic slots, found through a directory of
+// LEVELS pages where page k holds 2^k chunk pointers (chunk c is on page
+// bit_width(c + 1) - 1). A lookup is three acquire loads (page, chunk, slot),
+// and the table grows one chunk, and now and then one page, at a time without
+// ever rehashing or moving existing slots. Every positive long long is a valid
+// ID; only the pages and chunks actually used are allocated, so the directory
+// costs about 8 bytes per CHUNK_SIZE IDs up to the largest ID published. Callers
+// that take IDs from outside keep them near their dense counter: one stray huge
+// ID allocates a directory page proportional to it.
+//
+// Writers publish with a release store; the table never owns or frees T. Chunks
+// and pages live until the table is destroyed.
+template <typename T>
+class SegmentedTable {
+public:
+    static constexpr std::size_t CHUNK_BITS = 10;                           // 1024 slots (8 KB) per chunk
+    static constexpr std::size_t CHUNK_SIZE = std::size_t{1} << CHUNK_BITS;
+    static constexpr std::size_t LEVELS     = 64 - CHUNK_BITS;              // Directory pages: enough for any positive ID
+    static constexpr long long MAX_ID       = std::numeric_limits<long long>::max();
+
+    SegmentedTable() = default;
+    ~SegmentedTable() {
+        for (std::size_t level = 0; level < LEVELS; ++level) {
+            std::atomic<Chunk*>* page = pages_[level].load(std::memory_order_relaxed);
+            if (!page) continue;
+            for (std::size_t c = 0; c < (std::size_t{1} << level); ++c)
+                delete page[c].load(std::memory_order_relaxed);
+            delete[] page;
+        }
+    }
+    SegmentedTable(const SegmentedTable&) = delete;
+    SegmentedTable& operator=(const SegmentedTable&) = delete;
+
+    [[nodiscard]] static bool inRange(long long id) noexcept { return id >= 1; }
+
+    // nullptr when `id` was never published, has been cleared, or is out of range.
+    [[nodiscard]] T* find(long long id) const noexcept {
+        if (!inRange(id)) return nullptr;
+        const std::size_t index = static_cast<std::size_t>(id) - 1;
+        const Chunk* chunk = findChunk(index);
+        return chunk ? chunk->slots[index & (CHUNK_SIZE - 1)].load(std::memory_order_acquire) : nullptr;
+    }
+
+    // Allocates the chunk of `id` (which must be inRange), so that a later publish(id) cannot throw.
+    // Throws std::bad_alloc like publish; the table is unchanged apart from the allocation.
+    void reserve(long long id) { chunkFor(static_cast<std::size_t>(id) - 1); }
+
+    // Publishes `value` under `id` (which must be inRange); allocates its chunk on first use.
+    void publish(long long id, T* value) {
+        const std::size_t index = static_cast<std::size_t>(id) - 1;
+        chunkFor(index).slots[index & (CHUNK_SIZE - 1)].store(value, std::memory_order_release);
+    }
+
+    // Unpublishes `id` and returns the previous value (nullptr if none).
+    T* clear(long long id) noexcept {
+        if (!inRange(id)) return nullptr;
+        const std::size_t index = static_cast<std::size_t>(id) - 1;
+        Chunk* chunk = findChunk(index);
+        return chunk ? chunk->slots[index & (CHUNK_SIZE - 1)].exchange(nullptr, std::memory_order_acq_rel) : nullptr;
+    }
+
+    // Calls f(id, value) for every published ID in ascending order. Only allocated pages and chunks
+    // are visited, so a sparse table costs O(pages + chunks * CHUNK_SIZE), not O(largest ID).
+    template <typename F>
+    void forEach(F&& f) const {
+        for (std::size_t level = 0; level < LEVELS; ++level) {
+            const std::atomic<Chunk*>* page = pages_[level].load(std::memory_order_acquire);
+            if (!page) continue;
+            for (std::size_t c = 0; c < (std::size_t{1} << level); ++c) {
+                const Chunk* chunk = page[c].load(std::memory_order_acquire);
+                if (!chunk) continue;
+                const std::size_t first = ((std::size_t{1} << level) - 1 + c) << CHUNK_BITS;
+                for (std::size_t i = 0; i < CHUNK_SIZE; ++i)
+                    if (T* value = chunk->slots[i].load(std::memory_order_acquire))
+                        f(static_cast<long long>(first + i + 1), value);
+            }
+        }
+    }
+
+private:
+    struct Chunk {
+        std::atomic<T*> slots[CHUNK_SIZE]{};
+    };
+
+    // Page and position on it of the chunk holding slot `index`.
+    static std::pair<std::size_t, std::size_t> locate(std::size_t index) noexcept {
+        const std::size_t n = (index >> CHUNK_BITS) + 1;
+        const auto level = static_cast<std::size_t>(std::bit_width(n)) - 1;
+        return {level, n - (std::size_t{1} << level)};
+    }
+
+    Chunk* findChunk(std::size_t index) const noexcept {
+        const auto [level, offset] = locate(index);
+        const std::atomic<Chunk*>* page = pages_[level].load(std::memory_order_acquire);
+        return page ? page[offset].load(std::memory_order_acquire) : nullptr;
+    }
+
+    // Racing allocators publish pages and chunks with a CAS; the loser frees its copy and uses
+    // the winner's.
+    Chunk& chunkFor(std::size_t index) {
+        const auto [level, offset] = locate(index);
+        std::atomic<Chunk*>* page = pages_[level].load(std::memory_order_acquire);
+        if (!page) {
+            auto* fresh = new std::atomic<Chunk*>[std::size_t{1} << level]{};
+            if (pages_[level].compare_exchange_strong(page, fresh, std::memory_order_acq_rel)) page = fresh;
+            else delete[] fresh;
+        }
+        auto& entry = page[offset];
+        Chunk* chunk = entry.load(std::memory_order_acquire);
+        if (chunk) return *chunk;
+        auto* fresh = new Chunk();
+        if (entry.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel)) return *fresh;
+        delete fresh;
+        return *chunk;
+    }
+
+    std::atomic<std::atomic<Chunk*>*> pages_[LEVELS]{};   // Chunk directory, page k holds 2^k chunks
+};
+
+} // namespace booking
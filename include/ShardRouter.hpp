@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "BookingService.hpp"
+#include "ConsistentHashRing.hpp"
+#include "CoordinatorLog.hpp"
+#include "LocalSocket.hpp"
+
+namespace booking {
+// ----------------- Shard Router -----------------
+// Front end of a multi-process deployment. Shows are partitioned across ShardServer processes by
+// consistent hashing of the show ID; each shard holds the seat state of its shows only. The
+// movie/theater catalog is small and read-mostly: the router owns it (assigning IDs and
+// rejecting duplicates, like BookingService) and sends every entry to every shard under its
+// ID, so show records on any shard refer to the same IDs even if a shard missed an earlier add.
+//
+// Point requests (createShow, bookSeats, getAvailableSeats) go to the owning shard; listings are
+// scattered to every shard and the partial results merged in show ID order. addShard() moves
+// only the shows the new shard takes over on the ring (about 1/(N+1) of them) and blocks other
+// requests while it copies them. Bookings through the router do not return ticket records.
+//
+// bookAcrossShows() books legs on several shards atomically with two-phase commit: the router
+// is the coordinator (decisions in a CoordinatorLog, see openTransactionLog()) and each shard a
+// participant holding seats between PREPARE and COMMIT/ABORT. A transaction whose participants
+// could not all be told the outcome stays in doubt; resolveInDoubt() finishes it later, also
+// after a router restart. Run it before addShard(), which would copy held seats as booked. Every
+// FORGET_INTERVAL ended transactions, the shards are told to forget the outcomes of all ended ones.
+//
+// Thread-safe. Requests to one shard are serialized on its connection; different shards are
+// reached in parallel.
+class ShardRouter {
+public:
+    using ShowInfo = BookingService::ShowInfo;
+    using ShowSeats = BookingService::ShowSeats;
+
+    static constexpr std::uint64_t FORGET_INTERVAL = 64;   // Ended transactions between FORGET broadcasts
+
+    ShardRouter() = default;
+    ShardRouter(const ShardRouter&) = delete;
+    ShardRouter& operator=(const ShardRouter&) = delete;
+
+    // Connects to a shard, replays the catalog to it and migrates the shows it now owns. Returns
+    // the number of shows moved, or std::nullopt (nothing changed) if the shard is unusable.
+    std::optional<std::size_t> addShard(const std::string& socketPath);
+
+    [[nodiscard]] int addMovie(const std::string& title);                 // Movie ID or -1 (duplicate / shard failure)
+    [[nodiscard]] int addTheater(const std::string& name);                // Theater ID or -1
+    [[nodiscard]] long long createShow(int movieId, int theaterId);       // Show ID or -1
+
+    [[nodiscard]] bool bookSeats(long long showId, const std::vector<std::string>& seatLabels);
+    [[nodiscard]] std::vector<std::string> getAvailableSeats(long long showId) const;   // Throws std::invalid_argument on unknown ID
+
+    // Sends bookSeats/getAvailableSeats with this deadline budget (0 = the shard's default). A
+    // request the shard sheds fails: bookSeats returns false, getAvailableSeats throws
+    // std::runtime_error.
+    void setRequestDeadline(std::chrono::microseconds budget) noexcept;
+
+    bool openTransactionLog(const std::string& path);     // Opens the coordinator log and resolves what it left in doubt
+    [[nodiscard]] std::vector<long long> bookAcrossShows(std::span<const ShowSeats> legs,
+                                                         long long customerId = BookingService::ANONYMOUS_CUSTOMER); // Two-phase commit; ticket ID per leg, empty if aborted or no legs
+    std::size_t resolveInDoubt();                          // Retries unfinished transactions; returns how many remain
+
+    [[nodiscard]] std::vector<ShowInfo> getAllShows() const;                         // Scatter-gather, show ID order
+    [[nodiscard]] std::vector<std::pair<int, std::string>> getAllMovies() const;
+    [[nodiscard]] std::vector<std::pair<int, std::string>> getAllTheaters() const;
+
+    [[nodiscard]] std::size_t shardCount() const;
+    [[nodiscard]] std::size_t shardOf(long long showId) const;            // Index in addShard() order; needs a shard
+
+private:
+    struct Shard {
+        std::string path;
+        std::mutex mtx;                  // One request in flight per connection
+        LocalSocket socket;
+    };
+
+    // One row of a shard's LIST response
+    struct ShardShow {
+        long long id;
+        int movieId;
+        int theaterId;
+        std::uint32_t booked;
+    };
+
+    std::optional<std::string> call(Shard& shard, const std::string& request) const;   // Round trip; nullopt if the shard is gone
+    std::optional<long long> callForId(Shard& shard, const std::string& request) const; // Round trip returning the leading i64
+    std::optional<std::vector<ShardShow>> listShard(Shard& shard) const;
+    std::string withDeadline(std::string request) const;                 // Wraps a point request in DEADLINE if a budget is set
+    static std::optional<std::vector<ShardShow>> parseList(std::string_view response);
+    Shard& ownerOf(long long showId) const;
+    std::optional<std::string> callPath(const std::string& path, const std::string& request) const;   // Caller holds topologyMtx_
+    bool finish(const CoordinatorLog::Transaction& tx, std::vector<long long>* tickets);               // Sends the outcome; true once all acknowledged
+    void forgetEnded();                                                  // Caller holds topologyMtx_; FORGETs ended transactions now and then
+
+    std::atomic<std::uint32_t> deadlineMicros_{0};   // setRequestDeadline(); 0 = none
+
+    mutable std::shared_mutex topologyMtx_;      // Shared by requests, exclusive while a shard is added
+    std::vector<std::unique_ptr<Shard>> shards_;
+    ConsistentHashRing ring_;                    // Node i = shards_[i]
+
+    mutable std::shared_mutex catalogMtx_;       // Protects the catalog below
+    std::vector<std::string> movies_;            // movies_[id - 1] = title
+    std::vector<std::string> theaters_;          // theaters_[id - 1] = name
+    std::unordered_map<std::string, int> movieNameToId_;     // Lowercase title -> ID
+    std::unordered_map<std::string, int> theaterNameToId_;   // Lowercase name -> ID
+    std::unordered_set<int> pendingMovies_;      // Not on every shard yet: resent by the next add of the title
+    std::unordered_set<int> pendingTheaters_;    // Same for theaters
+    std::unordered_set<long long> showKeys_;     // (movieId << 32 | theaterId) with a show
+    long long showCounter_{0};
+
+    std::unique_ptr<CoordinatorLog> txLog_;      // Set by openTransactionLog() under topologyMtx_
+    std::mutex txMtx_;                           // Protects the three below
+    std::unordered_set<std::uint64_t> activeTx_; // In flight in bookAcrossShows(); resolveInDoubt() skips them
+    std::uint64_t endedSinceForget_{0};          // Transactions ended since the last FORGET broadcast
+    std::uint64_t forgottenBelow_{0};            // Watermark of the last FORGET broadcast
+};
+
+} // namespace booking
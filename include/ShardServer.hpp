@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+#include "BookingService.hpp"
+#include "DeadlineScheduler.hpp"
+#include "LocalSocket.hpp"
+#include "WorkStealingPool.hpp"
+
+namespace booking {
+// ----------------- Shard Server -----------------
+// Serves one BookingService to a ShardRouter over a Unix socket: one backend process of a
+// multi-process deployment. Requests and responses are LocalSocket frames built with
+// FrameWriter; every request is answered with exactly one response, in order, per connection.
+//
+// The server is also a two-phase commit participant: PREPARE takes seat holds for a
+// transaction, COMMIT confirms them into tickets and ABORT releases them. All three are
+// idempotent and remember each transaction's outcome, so a recovering coordinator may repeat
+// them and a PREPARE that arrives after its ABORT is refused. FORGET tells the participant that
+// every transaction below a watermark has ended at the coordinator: their outcomes are dropped
+// and a late PREPARE below the watermark is refused, so outcomes are not kept forever.
+// Participant state is in memory: a shard process that dies loses its holds along with its seats.
+//
+// With enableDeadlines(), BOOK and SEATS requests run on a worker pool behind a
+// DeadlineScheduler instead of on the connection thread. Each gets a deadline: the budget of
+// its DEADLINE envelope, or the server default, counted from when the request was read. One
+// that cannot finish in time is answered SHED without running; STATS reports shed counts and
+// queue times.
+namespace shard_protocol {
+enum Op : std::uint8_t {
+    ADD_MOVIE = 1,    // i32 id, string title             -> i64 id or -1 (id again if resent)
+    ADD_THEATER,      // i32 id, string name              -> i64 id or -1 (id again if resent)
+    ADOPT_SHOW,       // i64 id, i64 router's last show ID, i32 movie, i32 theater, u32 booked mask -> i64 id or -1
+    REMOVE_SHOW,      // i64 id                           -> i64 1 or 0
+    BOOK,             // i64 id, u32 seat mask            -> i64 ticket or -1
+    SEATS,            // i64 id                           -> i64 1, u32 booked mask; or i64 -1
+    LIST,             // (none)                           -> i64 n, n x (i64 id, i32 movie, i32 theater, u32 booked mask)
+
+    // Two-phase commit participant (coordinator: ShardRouter::bookAcrossShows)
+    PREPARE,          // u64 tx, i64 customer, u32 n, n x (i64 show, u32 seat mask) -> i64 1 (holds taken) or 0
+    COMMIT,           // u64 tx                           -> i64 n, n x i64 ticket in PREPARE order; or i64 -1 if unknown or not confirmable yet
+    ABORT,            // u64 tx                           -> i64 1; or 0 if the transaction had committed
+    FORGET,           // u64 watermark                    -> i64 1; outcomes below the watermark are dropped
+
+    // Deadlines and load shedding (see ShardServer::enableDeadlines)
+    DEADLINE,         // u32 budget in us, then a BOOK or SEATS request -> its response, or i64 SHED
+    STATS             // (none) -> u64 submitted, completed, shed at deadline, shed queue full, late,
+                      //           u32 limit, u32 queued, u64 queue-time p50, p99, p99.9, max in ns;
+                      //           or i64 -1 without deadlines
+};
+
+constexpr std::int64_t SHED = -2;   // Response of a request dropped because its deadline could not be met
+} // namespace shard_protocol
+
+class ShardServer {
+public:
+    ShardServer(BookingService& service, std::string socketPath);
+    ~ShardServer();                                  // stop()
+    ShardServer(const ShardServer&) = delete;
+    ShardServer& operator=(const ShardServer&) = delete;
+
+    // Runs BOOK/SEATS on `workers` threads with deadlines (default: `budget` from arrival). Call
+    // before start().
+    void enableDeadlines(std::chrono::microseconds budget, std::size_t workers = std::thread::hardware_concurrency(),
+                         const DeadlineScheduler::Options& options = {});
+    [[nodiscard]] std::optional<DeadlineScheduler::Metrics> schedulerMetrics() const;   // nullopt without deadlines
+
+    bool start();                                    // Listens; false if the socket cannot be bound
+    void stop();                                     // Closes connections, joins threads, removes the socket file
+
+    // Process entry point: serves `socketPath` until SIGINT/SIGTERM, with deadlines if `budget` is
+    // non-zero. Returns the exit code.
+    static int runUntilSignal(const std::string& socketPath, std::chrono::microseconds budget = {});
+
+    static std::uint32_t seatMask(const BookingService& service, long long showId);   // Booked seats; throws on unknown ID
+
+private:
+    void acceptLoop();
+    void serve(LocalSocket& connection);
+    std::string handle(const std::string& request);
+    std::string schedule(std::string request, std::chrono::microseconds budget, DeadlineScheduler::Clock::time_point arrival);
+    std::string stats() const;
+
+    BookingService& service_;
+    std::string path_;
+    LocalSocket listener_;
+    std::thread acceptThread_;
+    std::atomic<bool> stopping_{false};
+    std::mutex mtx_;                                            // Protects connections_
+    std::vector<std::pair<std::unique_ptr<LocalSocket>, std::thread>> connections_;
+
+    std::unique_ptr<WorkStealingPool> pool_;                    // Set by enableDeadlines(); outlives scheduler_
+    std::unique_ptr<DeadlineScheduler> scheduler_;
+    std::chrono::microseconds defaultBudget_{0};
+
+    std::string prepareTx(FrameReader& in);
+    std::string commitTx(std::uint64_t txId);
+    std::string abortTx(std::uint64_t txId);
+    std::string forgetTx(std::uint64_t watermark);
+
+    // Transaction prepared here and not yet decided
+    struct PreparedTx {
+        long long customerId;
+        std::vector<long long> holdIds;                         // One per leg, in PREPARE order
+        std::vector<long long> tickets;                         // Holds confirmed so far, by a COMMIT that failed midway
+    };
+    std::mutex txMtx_;                                          // Protects the three below; serializes PREPARE/COMMIT/ABORT/FORGET
+    std::unordered_map<std::uint64_t, PreparedTx> prepared_;
+    std::unordered_map<std::uint64_t, std::optional<std::vector<long long>>> finished_;   // Tickets if committed, nullopt if aborted
+    std::uint64_t forgottenBelow_{0};                           // Highest FORGET watermark: lower IDs ended at the coordinator
+};
+
+// ----------------- Local Shard Launcher -----------------
+// Starts shard processes on this machine for tests and local clusters: each launch() forks a
+// child that runs ShardServer::runUntilSignal on <directory>/shard-<n>.sock. Call launch() before
+// the parent starts threads of its own. stopAll() (or the destructor) terminates and reaps them.
+class LocalShardLauncher {
+public:
+    explicit LocalShardLauncher(std::string directory);
+    ~LocalShardLauncher();
+    LocalShardLauncher(const LocalShardLauncher&) = delete;
+    LocalShardLauncher& operator=(const LocalShardLauncher&) = delete;
+
+    std::optional<std::string> launch();             // Socket path once the shard accepts connections
+    void stopAll();
+    [[nodiscard]] const std::vector<std::string>& socketPaths() const noexcept { return paths_; }
+
+private:
+    std::string directory_;
+    std::vector<pid_t> pids_;
+    std::vector<std::string> paths_;
+};
+
+} // namespace booking
@@ -0,0 +1,140 @@
+#pragma once
+
+#include "BookingService.hpp"
+#include "SpscQueue.hpp"
+#include "StringPool.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace booking {
+// ----------------- Sharded Booking Service -----------------
+// Shard-per-core execution mode. Every show is owned by exactly one shard
+// thread (showId % shardCount()); only that thread ever touches the show's
+// seat map, so seat state needs no locks or atomics. Callers talk to shards
+// through a Client, which owns one SPSC request queue per shard; results come
+// back through a completion record on the caller's stack. Listings scatter a
+// request to every shard and gather the partial results.
+//
+// The movie/theater catalog is shared and read-mostly (shared_mutex), as in
+// BookingService. Bookings in this mode do not create ticket records.
+class ShardedBookingService {
+public:
+    static constexpr std::size_t QUEUE_CAPACITY = 1024;   // Requests in flight per client and shard
+    using ShowView = BookingService::ShowView;
+
+    class Client;
+
+    explicit ShardedBookingService(std::size_t shards = std::thread::hardware_concurrency(),
+                                   std::size_t maxClients = 64);
+    ~ShardedBookingService();                              // Stops and joins shard threads
+    ShardedBookingService(const ShardedBookingService&) = delete;
+    ShardedBookingService& operator=(const ShardedBookingService&) = delete;
+
+    [[nodiscard]] int addMovie(const std::string& title);       // Returns movie ID or -1 on duplicate
+    [[nodiscard]] int addTheater(const std::string& name);      // Returns theater ID or -1 on duplicate
+    [[nodiscard]] Client connect();                             // One client per caller thread; throws when maxClients are connected
+
+    [[nodiscard]] std::size_t shardCount() const noexcept { return shards_.size(); }
+    [[nodiscard]] std::size_t shardOf(long long showId) const noexcept {
+        return static_cast<std::size_t>(showId) % shards_.size();
+    }
+
+private:
+    struct Completion;
+
+    struct Request {
+        enum class Op : std::uint8_t { Create, Book, Query, List };
+        Op op{Op::Query};
+        long long showId{};
+        int movieId{};
+        int theaterId{};
+        std::uint32_t seatMask{};
+        Completion* done{};
+    };
+
+    struct ShardShow {
+        int movieId;
+        int theaterId;
+        std::uint32_t booked;        // bit i set = seat index i booked
+        int availableCount;
+    };
+
+    struct ShowSummary {
+        long long id;
+        int movieId;
+        int theaterId;
+        int availableSeats;
+    };
+
+    struct alignas(64) Shard {
+        std::thread thread;
+        std::unordered_map<long long, ShardShow> shows;   // Owned by `thread` only
+    };
+
+    // Per-client queues, one per shard. Allocated once and reused by later clients.
+    struct ClientSlot {
+        std::vector<std::unique_ptr<SpscQueue<Request>>> queues;
+        std::atomic<bool> inUse{false};
+    };
+
+    void shardLoop(std::size_t index);
+    void handle(Shard& shard, Request& req);
+    void releaseClient(std::size_t slot) noexcept;
+
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<std::unique_ptr<ClientSlot>> clients_;     // Fixed size: maxClients
+    std::atomic<std::size_t> clientHighWater_{0};          // Shards poll slots [0, high water)
+    std::atomic<bool> stopping_{false};
+
+    // Catalog
+    mutable std::shared_mutex catalogMtx_;
+    StringPool strings_;
+    std::unordered_map<int, std::string_view> movies_;
+    std::unordered_map<int, std::string_view> theaters_;
+    std::unordered_map<std::string, int> movieNameToId_;
+    std::unordered_map<std::string, int> theaterNameToId_;
+    std::unordered_set<long long> showKeys_;               // (movieId << 32 | theaterId) of created shows
+    int movieCounter_{0};
+    int theaterCounter_{0};
+    std::atomic<long long> showCounter_{0};
+
+public:
+    // Handle for one caller thread. Calls are synchronous: the request is pushed to the owning
+    // shard's queue and the client spins (then yields) until the shard completes it.
+    class Client {
+    public:
+        Client(Client&& other) noexcept
+            : service_(std::exchange(other.service_, nullptr)), slot_(other.slot_) {}
+        Client& operator=(Client&&) = delete;
+        Client(const Client&) = delete;
+        Client& operator=(const Client&) = delete;
+        ~Client();
+
+        [[nodiscard]] long long createShow(int movieId, int theaterId);                          // Show ID or -1
+        [[nodiscard]] bool bookSeats(long long showId, const std::vector<std::string>& seatLabels);
+        [[nodiscard]] std::vector<std::string> getAvailableSeats(long long showId);              // Throws std::invalid_argument for unknown show
+        [[nodiscard]] std::vector<ShowView> getAllShows();                                       // Scatter-gather across shards, by show ID
+
+    private:
+        friend class ShardedBookingService;
+        Client(ShardedBookingService* service, std::size_t slot) noexcept : service_(service), slot_(slot) {}
+        void send(std::size_t shard, const Request& req);
+        static void await(const Completion& done) noexcept;
+
+        ShardedBookingService* service_;
+        std::size_t slot_;
+    };
+};
+
+} // namespace booking
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+namespace booking {
+// ----------------- Sharded Counter -----------------
+// Write-optimized counter: each thread adds to one of SHARDS cache-line padded
+// cells, so concurrent writers rarely share a line. Reads sum every cell and
+// are O(SHARDS) = O(1). A read concurrent with writers sees some prefix of the
+// updates, never a torn value.
+class ShardedCounter {
+public:
+    static constexpr std::size_t SHARDS = 16;
+
+    void add(long long delta) noexcept {
+        cells_[threadSlot()].value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] long long load() const noexcept {
+        long long sum = 0;
+        for (const auto& c : cells_) sum += c.value.load(std::memory_order_relaxed);
+        return sum;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<long long> value{0};
+    };
+
+    // Threads are assigned cells round-robin on first use.
+    static std::size_t threadSlot() noexcept {
+        static std::atomic<std::size_t> nextSlot{0};
+        thread_local const std::size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % SHARDS;
+        return slot;
+    }
+
+    std::array<Cell, SHARDS> cells_{};
+};
+
+} // namespace booking
@@ -0,0 +1,150 @@
+#pragma once
+
+#include "WaitStrategy.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace booking {
+// ----------------- SPSC Queue -----------------
+// Bounded single-producer / single-consumer ring buffer. Head and tail live on
+// separate cache lines, and each side caches the other's index so the shared
+// line is only read when the cached value says the ring looks full/empty.
+//
+// try* calls never block. push/pop wait through `Wait` (see WaitStrategy.hpp)
+// while the ring is full/empty. Batch calls move up to n items with a single
+// index publication, which amortizes the cross-core traffic per item.
+template <typename T, typename Wait = YieldingWait>
+class SpscQueue {
+    static_assert(std::is_nothrow_move_constructible_v<T>, "T must be nothrow movable");
+
+public:
+    explicit SpscQueue(std::size_t capacity)
+        : capacity_(roundUp(capacity)), mask_(capacity_ - 1),
+          slots_(static_cast<Slot*>(::operator new(sizeof(Slot) * capacity_, std::align_val_t{alignof(Slot)}))) {}
+
+    ~SpscQueue() {
+        while (tryPop()) {}
+        ::operator delete(slots_, std::align_val_t{alignof(Slot)});
+    }
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only. Returns false when full.
+    template <typename U>
+    bool tryPush(U&& value) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail - cachedHead_ == capacity_) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail - cachedHead_ == capacity_) return false;
+        }
+        new (&slots_[tail & mask_]) T(std::forward<U>(value));
+        tail_.store(tail + 1, std::memory_order_release);
+        notEmpty_.notify();
+        return true;
+    }
+
+    // Producer only. Moves up to `count` items starting at `first`; returns how many were taken.
+    template <typename InputIt>
+    std::size_t tryPushBatch(InputIt first, std::size_t count) {
+        const std::size_t tail = tail_.load(std::memory_order_relaxed);
+        if (capacity_ - (tail - cachedHead_) < count)
+            cachedHead_ = head_.load(std::memory_order_acquire);
+        const std::size_t n = std::min(count, capacity_ - (tail - cachedHead_));
+        if (n == 0) return 0;
+        for (std::size_t i = 0; i < n; ++i, ++first)
+            new (&slots_[(tail + i) & mask_]) T(std::move(*first));
+        tail_.store(tail + n, std::memory_order_release);
+        notEmpty_.notify();
+        return n;
+    }
+
+    // Producer only. Waits while the ring is full.
+    template <typename U>
+    void push(U&& value) {
+        while (!tryPush(std::forward<U>(value)))   // value is only consumed on success
+            notFull_.wait([this] { return !full(); });
+    }
+
+    // Consumer only. Returns std::nullopt when empty.
+    std::optional<T> tryPop() {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (head == cachedTail_) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head == cachedTail_) return std::nullopt;
+        }
+        T* slot = at(head);
+        std::optional<T> out(std::move(*slot));
+        slot->~T();
+        head_.store(head + 1, std::memory_order_release);
+        notFull_.notify();
+        return out;
+    }
+
+    // Consumer only. Moves up to `max` items to `out`; returns how many were written.
+    template <typename OutputIt>
+    std::size_t tryPopBatch(OutputIt out, std::size_t max) {
+        const std::size_t head = head_.load(std::memory_order_relaxed);
+        if (cachedTail_ - head < max)
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+        const std::size_t n = std::min(max, cachedTail_ - head);
+        if (n == 0) return 0;
+        for (std::size_t i = 0; i < n; ++i, ++out) {
+            T* slot = at(head + i);
+            *out = std::move(*slot);
+            slot->~T();
+        }
+        head_.store(head + n, std::memory_order_release);
+        notFull_.notify();
+        return n;
+    }
+
+    // Consumer only. Waits while the ring is empty.
+    T pop() {
+        for (;;) {
+            if (auto value = tryPop()) return std::move(*value);
+            notEmpty_.wait([this] { return !empty(); });
+        }
+    }
+
+    [[nodiscard]] std::size_t capacity() const noexcept { return capacity_; }
+    [[nodiscard]] bool empty() const noexcept {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+    [[nodiscard]] bool full() const noexcept {
+        return tail_.load(std::memory_order_acquire) - head_.load(std::memory_order_acquire) == capacity_;
+    }
+
+private:
+    struct Slot {
+        alignas(T) unsigned char bytes[sizeof(T)];
+    };
+
+    static std::size_t roundUp(std::size_t n) {
+        std::size_t c = 2;
+        while (c < n) c <<= 1;
+        return c;
+    }
+
+    T* at(std::size_t index) noexcept {
+        return std::launder(reinterpret_cast<T*>(&slots_[index & mask_]));
+    }
+
+    const std::size_t capacity_;
+    const std::size_t mask_;
+    Slot* const slots_;
+
+    alignas(64) std::atomic<std::size_t> head_{0};   // Consumer position
+    std::size_t cachedTail_{0};                      // Consumer's last view of tail_
+    alignas(64) std::atomic<std::size_t> tail_{0};   // Producer position
+    std::size_t cachedHead_{0};                      // Producer's last view of head_
+    [[no_unique_address]] Wait notEmpty_{};               // Consumer waits here
+    [[no_unique_address]] Wait notFull_{};                // Producer waits here
+};
+
+} // namespace booking
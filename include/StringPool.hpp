@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+namespace booking {
+// ----------------- String Pool -----------------
+// Append-only interning pool. Each distinct string is copied once into a
+// block arena and handed out as a std::string_view. Blocks are never moved or
+// freed before the pool itself, so every returned view stays valid for the
+// lifetime of the pool. Not synchronized: callers serialize intern().
+class StringPool {
+public:
+    explicit StringPool(std::size_t blockSize = 64 * 1024);
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    std::string_view intern(std::string_view s);                 // Returns the pooled copy of s
+    [[nodiscard]] std::size_t size() const noexcept;             // Number of distinct strings
+    [[nodiscard]] std::size_t bytesUsed() const noexcept;        // Bytes of string data stored
+
+private:
+    char* allocate(std::size_t n);
+
+    std::size_t blockSize_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* current_{nullptr};                      // Block currently being filled
+    std::size_t blockUsed_{0};                    // Bytes used in current_
+    std::size_t bytesUsed_{0};
+    std::unordered_set<std::string_view> index_;  // Views into the blocks
+};
+
+} // namespace booking
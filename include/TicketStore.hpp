@@ -0,0 +1,86 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace booking {
+// ----------------- Ticket Store -----------------
+// Append-only store of booking records.
+//
+// Records live in fixed-size chunks (an arena) that are allocated once per
+// CHUNK_SIZE records, so inserting a record never touches the heap. Ticket IDs
+// are dense (1, 2, 3, ...) and map straight to (chunk, offset), which makes ID
+// lookup two loads. Every customer's records form a singly linked list threaded
+// through the records themselves; a striped open-addressing index keeps only
+// the head of each list.
+class TicketStore {
+public:
+    static constexpr std::size_t CHUNK_BITS = 16;                          // 64K records (2 MB) per chunk
+    static constexpr std::size_t CHUNK_SIZE = std::size_t{1} << CHUNK_BITS;
+    static constexpr std::size_t MAX_CHUNKS = std::size_t{1} << 16;        // Capacity: 2^32 records
+    static constexpr std::size_t CAPACITY   = CHUNK_SIZE * MAX_CHUNKS;
+    static constexpr long long   ANONYMOUS_CUSTOMER = 0;                   // Not indexed by customer
+
+    // Copy of a stored record returned to callers
+    struct Ticket {
+        long long ticketId{};
+        long long showId{};
+        long long customerId{};
+        std::int64_t timestampNs{};   // system_clock, nanoseconds since epoch
+        std::uint32_t seatMask{};     // bit i set = seat index i booked by this ticket
+    };
+
+    TicketStore();
+    ~TicketStore();
+    TicketStore(const TicketStore&) = delete;
+    TicketStore& operator=(const TicketStore&) = delete;
+
+    [[nodiscard]] long long append(long long showId, long long customerId, std::uint32_t seatMask); // Returns ticket ID, or -1 when full
+    [[nodiscard]] long long reserve(std::size_t count);                                  // First of `count` consecutive ticket IDs, or -1 (none taken) when they do not fit
+    void write(long long ticketId, long long showId, long long customerId, std::uint32_t seatMask); // Publishes a reserved ticket ID
+    bool skipTo(long long lastTicketId);                                                 // Next append returns at least lastTicketId + 1; false past CAPACITY
+    [[nodiscard]] std::optional<Ticket> find(long long ticketId) const;                 // O(1) lookup by ticket ID
+    [[nodiscard]] std::vector<Ticket> findByCustomer(long long customerId) const;        // Newest first, O(k) for k tickets
+    [[nodiscard]] std::size_t size() const noexcept;                                     // Number of published records
+
+private:
+    // 32 bytes: two records per cache line
+    struct Record {
+        long long showId;
+        long long customerId;
+        std::atomic<std::int64_t> timestampNs; // 0 until the record is published
+        std::uint32_t seatMask;
+        std::uint32_t prevForCustomer;         // Index + 1 of the customer's previous record, 0 = none
+    };
+    static_assert(sizeof(Record) == 32, "Record should stay at half a cache line");
+
+    // Open-addressing customerId -> newest record (index + 1), linear probing
+    struct alignas(64) CustomerStripe {
+        struct Slot {
+            long long customerId;
+            std::uint32_t head;                // 0 = empty slot
+        };
+        mutable std::mutex mtx;
+        std::vector<Slot> slots;
+        std::size_t used{0};
+    };
+    static constexpr std::size_t CUSTOMER_STRIPES = 64;
+
+    Record* chunkFor(std::size_t index);                        // Allocates the chunk on first use
+    const Record* recordAt(std::size_t index) const noexcept;   // nullptr when not published
+    static std::size_t mix(long long key) noexcept;
+    static std::uint32_t* headSlot(CustomerStripe& stripe, long long customerId);
+
+    std::unique_ptr<std::atomic<Record*>[]> chunks_;           // Chunk directory
+    std::atomic<std::size_t> next_{0};                          // Next free record index
+    std::atomic<std::size_t> published_{0};                     // Records fully written
+    std::array<CustomerStripe, CUSTOMER_STRIPES> customers_;
+};
+
+} // namespace booking
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+#include <immintrin.h>
+#endif
+
+namespace booking {
+// ----------------- Wait Strategies -----------------
+// How a bounded queue waits when it is full (producers) or empty (consumer).
+// Every strategy has the same interface:
+//
+//   wait(ready)  returns once ready() is true; may return spuriously early
+//   notify()     called after every state change that could make ready() true
+//
+// BusySpinWait burns a core for the lowest handoff latency, YieldingWait spins
+// briefly and then gives its timeslice away, and BlockingWait parks the thread on
+// a condition variable. BlockingWait's notify() is one fence and one load while
+// nobody is parked, so the fast path of a non-blocking queue stays lock-free.
+
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__)
+    _mm_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+struct BusySpinWait {
+    template <typename Ready>
+    void wait(Ready&& ready) const {
+        while (!ready()) cpuRelax();
+    }
+    void notify() const noexcept {}
+};
+
+struct YieldingWait {
+    static constexpr int SPINS = 128;   // pause-loops before yielding
+
+    template <typename Ready>
+    void wait(Ready&& ready) const {
+        for (int i = 0; !ready(); ++i) {
+            if (i < SPINS) cpuRelax();
+            else std::this_thread::yield();
+        }
+    }
+    void notify() const noexcept {}
+};
+
+class BlockingWait {
+public:
+    static constexpr int SPINS = 64;    // pause-loops before parking
+
+    template <typename Ready>
+    void wait(Ready&& ready) {
+        for (int i = 0; i < SPINS; ++i) {
+            if (ready()) return;
+            cpuRelax();
+        }
+        // Dekker handshake with notify(): the waiter announces itself (seq_cst RMW) and
+        // re-checks; the notifier publishes its state change, fences, then reads waiters_.
+        // At least one side sees the other, so no wakeup is lost.
+        waiters_.fetch_add(1, std::memory_order_seq_cst);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        {
+            std::unique_lock<std::mutex> lock(mtx_);
+            cv_.wait(lock, [&] { return ready(); });
+        }
+        waiters_.fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) == 0) return;
+        std::lock_guard<std::mutex> lock(mtx_);
+        cv_.notify_all();
+    }
+
+private:
+    alignas(64) std::atomic<int> waiters_{0};
+    std::mutex mtx_;
+    std::condition_variable cv_;
+};
+
+} // namespace booking
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "ChaseLevDeque.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace booking {
+// ----------------- Work-Stealing Pool -----------------
+// Fixed set of worker threads, each owning a Chase-Lev deque. Tasks submitted
+// from a worker go to its own deque (LIFO, cache-warm); tasks submitted from
+// outside, or with an affinity hint naming another worker, go to that worker's
+// inbox. Idle workers steal from the top of other deques and park on a
+// condition variable once there is nothing left to steal.
+//
+// Affinity hints (e.g. a show ID) keep work for one show on one worker, so the
+// show's lock and seat map stay in that core's cache; stealing still balances
+// load when a worker falls behind.
+class WorkStealingPool {
+public:
+    using Job = std::function<void()>;
+    static constexpr std::size_t NO_AFFINITY = static_cast<std::size_t>(-1);
+
+    explicit WorkStealingPool(std::size_t workers = std::thread::hardware_concurrency());
+    ~WorkStealingPool();                                        // Runs remaining tasks, then joins
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    void submit(Job job, std::size_t affinity = NO_AFFINITY);   // affinity % size() picks the worker
+    void waitIdle();                                            // Blocks until every submitted task finished
+
+    [[nodiscard]] std::size_t size() const noexcept { return workers_.size(); }
+    [[nodiscard]] std::uint64_t stolenCount() const noexcept { return stolen_.load(std::memory_order_relaxed); }
+    [[nodiscard]] static std::size_t currentWorker() noexcept;  // Index of the calling worker, or NO_AFFINITY
+
+private:
+    struct Task {
+        Job fn;
+    };
+
+    struct alignas(64) Worker {
+        ChaseLevDeque<Task*> deque;
+        std::mutex inboxMtx;
+        std::vector<Task*> inbox;                               // Submissions from other threads
+        std::atomic<bool> hasInbox{false};
+        std::thread thread;
+    };
+
+    void workerLoop(std::size_t index);
+    Task* findTask(std::size_t index);
+    void execute(Task* task);
+    void wakeOne();
+
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<std::size_t> pending_{0};                       // Submitted but not finished
+    std::atomic<std::size_t> queued_{0};                        // Submitted but not started
+    std::atomic<std::uint64_t> stolen_{0};
+    std::atomic<bool> stopping_{false};
+    std::atomic<std::size_t> nextExternal_{0};                  // Round-robin for un-hinted external submits
+
+    std::mutex parkMtx_;
+    std::condition_variable parkCv_;                            // Idle workers
+    std::atomic<std::size_t> sleepers_{0};
+    std::condition_variable idleCv_;                            // waitIdle()
+};
+
+} // namespace booking
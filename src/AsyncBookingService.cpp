@@ -0,0 +1,169 @@
+#include "AsyncBookingService.hpp"
+#include <mutex>
+#include <stdexcept>
+
+namespace booking {
+
+// ----------------- Async Mutex -----------------
+bool AsyncMutex::tryLock() noexcept {
+    std::uintptr_t expected = NOT_LOCKED;
+    return state_.compare_exchange_strong(expected, 0, std::memory_order_acquire,
+                                          std::memory_order_relaxed);
+}
+
+/**
+ * The function `await_suspend` either grabs the lock (if it was released meanwhile) and continues
+ * without suspending, or pushes this awaiter onto the lock's waiter stack and suspends.
+ *
+ * Time complexity: O(1) per CAS attempt.
+ * Space complexity: O(1) — the awaiter lives in the coroutine frame.
+ */
+bool AsyncMutex::LockAwaiter::await_suspend(std::coroutine_handle<> h) noexcept {
+    handle_ = h;
+    std::uintptr_t old = mutex_.state_.load(std::memory_order_acquire);
+    for (;;) {
+        if (old == NOT_LOCKED) {
+            if (mutex_.state_.compare_exchange_weak(old, 0, std::memory_order_acquire,
+                                                    std::memory_order_relaxed))
+                return false;   // acquired, resume immediately
+        } else {
+            next_ = reinterpret_cast<LockAwaiter*>(old);
+            if (mutex_.state_.compare_exchange_weak(old, reinterpret_cast<std::uintptr_t>(this),
+                                                    std::memory_order_release,
+                                                    std::memory_order_acquire))
+                return true;
+        }
+    }
+}
+
+/**
+ * The function `unlock` releases the lock or, if coroutines are waiting, transfers ownership to
+ * the oldest one and posts it to its EventLoop. The releasing thread does the hand-off; nobody
+ * sleeps in the kernel waiting for the lock.
+ *
+ * Time complexity: O(1) amortized (newly arrived waiters are reversed once into FIFO order).
+ * Space complexity: O(1)
+ */
+void AsyncMutex::unlock() {
+    LockAwaiter* head = waiters_;
+    if (!head) {
+        std::uintptr_t old = 0;
+        if (state_.compare_exchange_strong(old, NOT_LOCKED, std::memory_order_release,
+                                           std::memory_order_relaxed))
+            return;
+
+        // New waiters arrived: take the whole stack and reverse it into FIFO order.
+        old = state_.exchange(0, std::memory_order_acquire);
+        auto* w = reinterpret_cast<LockAwaiter*>(old);
+        while (w) {
+            LockAwaiter* next = w->next_;
+            w->next_ = head;
+            head = w;
+            w = next;
+        }
+    }
+    waiters_ = head->next_;
+    head->loop_.post(head->handle_);
+}
+
+// ----------------- Async Booking Service -----------------
+// Registers the caller as a user of the show's mutex, creating it for a listed show. Users are
+// counted under at least a shared lock, so an entry seen with no users under the exclusive lock
+// has nobody holding, awaiting or about to await it.
+AsyncBookingService::ShowLock* AsyncBookingService::acquireShowLock(long long showId) {
+    {
+        std::shared_lock shrLock(mtx_);
+        auto it = showLocks_.find(showId);
+        if (it != showLocks_.end()) {
+            it->second->users.fetch_add(1, std::memory_order_relaxed);
+            return it->second.get();
+        }
+    }
+    if (!service_.hasShow(showId)) return nullptr;
+    std::unique_lock unqLock(mtx_);
+    auto& slot = showLocks_[showId];
+    if (!slot) slot = std::make_unique<ShowLock>();
+    slot->users.fetch_add(1, std::memory_order_relaxed);
+    return slot.get();
+}
+
+// Drops the caller's use; the last user erases the entry, so idle and removed shows cost nothing.
+void AsyncBookingService::releaseShowLock(long long showId) {
+    {
+        std::shared_lock shrLock(mtx_);
+        if (showLocks_.at(showId)->users.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+    }
+    std::unique_lock unqLock(mtx_);
+    auto it = showLocks_.find(showId);   // another request may have taken it again, or erased it
+    if (it != showLocks_.end() && it->second->users.load(std::memory_order_relaxed) == 0) showLocks_.erase(it);
+}
+
+std::size_t AsyncBookingService::activeShowLocks() {
+    std::shared_lock shrLock(mtx_);
+    return showLocks_.size();
+}
+
+// Holds one use of a show's mutex entry for the lifetime of a request.
+class AsyncBookingService::ShowLockRef {
+public:
+    ShowLockRef(AsyncBookingService& owner, long long showId) noexcept : owner_(owner), showId_(showId) {}
+    ~ShowLockRef() { owner_.releaseShowLock(showId_); }
+    ShowLockRef(const ShowLockRef&) = delete;
+    ShowLockRef& operator=(const ShowLockRef&) = delete;
+
+private:
+    AsyncBookingService& owner_;
+    long long showId_;
+};
+
+namespace {
+EventLoop& currentLoop() {
+    EventLoop* loop = EventLoop::current();
+    if (!loop) throw std::logic_error("Async booking call outside of an EventLoop");
+    return *loop;
+}
+
+// Releases an AsyncMutex when the coroutine leaves the critical section (also on exception).
+struct AsyncLockGuard {
+    AsyncMutex& m;
+    ~AsyncLockGuard() { m.unlock(); }
+};
+} // namespace
+
+/**
+ * The function `bookSeatsAsync` books seats like BookingService::bookSeats, but a caller that finds
+ * the show busy is suspended and queued on the show's AsyncMutex instead of blocking its thread.
+ *
+ * @return Task yielding true if all seats were booked, false otherwise.
+ *
+ * Time complexity: O(k) for k requested seats, plus queueing time.
+ * Space complexity: O(1) plus the coroutine frame.
+ */
+Task<bool> AsyncBookingService::bookSeatsAsync(long long showId, std::vector<std::string> seatLabels) {
+    ShowLock* entry = acquireShowLock(showId);
+    if (!entry) co_return service_.bookSeats(showId, seatLabels);   // unknown show: the service reports it
+    ShowLockRef ref(*this, showId);
+    co_await entry->mutex.lock(currentLoop());
+    AsyncLockGuard guard{entry->mutex};
+    co_return service_.bookSeats(showId, seatLabels);
+}
+
+/**
+ * The function `getAvailableSeatsAsync` returns the available seat labels of a show, queuing on the
+ * show's AsyncMutex while a booking for the same show is in progress.
+ *
+ * @return Task yielding the available seat labels; throws std::invalid_argument for an invalid show.
+ *
+ * Time complexity: O(TOTAL_SEATS)
+ * Space complexity: O(TOTAL_SEATS)
+ */
+Task<std::vector<std::string>> AsyncBookingService::getAvailableSeatsAsync(long long showId) {
+    ShowLock* entry = acquireShowLock(showId);
+    if (!entry) co_return service_.getAvailableSeats(showId);       // unknown show: throws
+    ShowLockRef ref(*this, showId);
+    co_await entry->mutex.lock(currentLoop());
+    AsyncLockGuard guard{entry->mutex};
+    co_return service_.getAvailableSeats(showId);
+}
+
+} // namespace booking
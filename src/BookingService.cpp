@@ -1,8 +1,11 @@
 #include "BookingService.hpp"
+#include "SchedulePoint.hpp"
+#include "WaitStrategy.hpp"
 #include <algorithm>
 #include <iostream>
 #include <sstream>
 #include <stdexcept>
+#include <bit>
 #include <bitset>
 #include <cctype>
 
@@ -76,6 +79,11 @@ std::string BookingService::seatLabelFromIndex(int idx) {
     return os.str();
 }
 
+// Live shows are owned by shows_; removed ones are owned by epochs_ until it returns them to showPool_.
+BookingService::~BookingService() {
+    shows_.forEach([this](long long, Show* show) { showPool_.destroy(show); });
+}
+
 // ----------------- Movie / Theater Creation -----------------
 /**
  * The `addMovie` function adds a new movie to a booking service while performing a duplicate
@@ -93,21 +101,49 @@ std::string BookingService::seatLabelFromIndex(int idx) {
  * Hash lookup + insert
  */
 int BookingService::addMovie(const std::string& title) {
+    return addMovie(title, 0);
+}
+
+/**
+ * The function `addMovie` with a `movieId` adds the movie under that ID instead of the next free
+ * one, for a shard router that assigns catalog IDs itself. Adding the same title under the same ID
+ * again returns the ID, so a router can resend a request that did not reach every shard. Later
+ * automatic IDs continue above the highest ID used. 0 = next free ID.
+ *
+ * @return movieId, or -1 if the title exists under another ID or the ID is taken.
+ *
+ * Time complexity: O(1) average.
+ * Space complexity: O(1) per movie.
+ */
+int BookingService::addMovie(const std::string& title, int movieId) {
     const std::string lowerTitle = toLower(title);
 
     // Fast O(1) duplicate check
     std::shared_lock slk(mtx_);
-    if (movieNameToId_.count(lowerTitle)) {
-        std::cerr << "Movie \"" << title << "\" already exists (ID: "
-                  << movieNameToId_.at(lowerTitle) << ")\n";
+    if (auto it = movieNameToId_.find(lowerTitle); it != movieNameToId_.end()) {
+        if (movieId != 0 && it->second == movieId) return movieId;   // resent
+        std::cerr << "Movie \"" << title << "\" already exists (ID: " << it->second << ")\n";
         return -1;
     }
     slk.unlock();
 
-    const int id = ++movieCounter_;
     std::unique_lock unqLock(mtx_);
-    movies_.try_emplace(id, Movie{id, title});
-    movieNameToId_[lowerTitle] = id;
+    if (movieId < 0 || movies_.count(movieId)) {
+        std::cerr << "Movie ID unavailable: " << movieId << '\n';
+        return -1;
+    }
+    const int id = insertMovieLocked(title, lowerTitle, movieId);
+    logWriter().append({.type = LogRecord::Type::AddMovie, .id = id, .text = title});
+    catalogEpoch_.fetch_add(1, std::memory_order_release);
+    return id;
+}
+
+int BookingService::insertMovieLocked(std::string_view title, std::string lowerTitle, int id) {
+    if (id == 0) id = ++movieCounter_;
+    else if (id > movieCounter_.load(std::memory_order_relaxed)) movieCounter_.store(id, std::memory_order_relaxed);
+    movies_.try_emplace(id, Movie{id, strings_.intern(title)});
+    movieNameToId_.emplace(std::move(lowerTitle), id);
+    movieStats_.emplace(id, std::make_unique<SeatAggregate>());
     return id;
 }
 
@@ -127,20 +163,46 @@ int BookingService::addMovie(const std::string& title) {
  * Hash lookup + insert
  */
 int BookingService::addTheater(const std::string& name) {
+    return addTheater(name, 0);
+}
+
+/**
+ * The function `addTheater` with a `theaterId` adds the theater under that ID, like the explicit
+ * addMovie: resending the same name under the same ID returns the ID. 0 = next free ID.
+ *
+ * @return theaterId, or -1 if the name exists under another ID or the ID is taken.
+ *
+ * Time complexity: O(1) average.
+ * Space complexity: O(1) per theater.
+ */
+int BookingService::addTheater(const std::string& name, int theaterId) {
     const std::string lowerName = toLower(name);
 
     std::shared_lock slk(mtx_);
-    if (theaterNameToId_.count(lowerName)) {
-        std::cerr << "Theater \"" << name << "\" already exists (ID: "
-                  << theaterNameToId_.at(lowerName) << ")\n";
+    if (auto it = theaterNameToId_.find(lowerName); it != theaterNameToId_.end()) {
+        if (theaterId != 0 && it->second == theaterId) return theaterId;   // resent
+        std::cerr << "Theater \"" << name << "\" already exists (ID: " << it->second << ")\n";
         return -1;
     }
     slk.unlock();
 
-    const int id = ++theaterCounter_;
     std::unique_lock unqLock(mtx_);
-    theaters_.try_emplace(id, Theater{id, name});
-    theaterNameToId_[lowerName] = id;
+    if (theaterId < 0 || theaters_.count(theaterId)) {
+        std::cerr << "Theater ID unavailable: " << theaterId << '\n';
+        return -1;
+    }
+    const int id = insertTheaterLocked(name, lowerName, theaterId);
+    logWriter().append({.type = LogRecord::Type::AddTheater, .id = id, .text = name});
+    catalogEpoch_.fetch_add(1, std::memory_order_release);
+    return id;
+}
+
+int BookingService::insertTheaterLocked(std::string_view name, std::string lowerName, int id) {
+    if (id == 0) id = ++theaterCounter_;
+    else if (id > theaterCounter_.load(std::memory_order_relaxed)) theaterCounter_.store(id, std::memory_order_relaxed);
+    theaters_.try_emplace(id, Theater{id, strings_.intern(name)});
+    theaterNameToId_.emplace(std::move(lowerName), id);
+    theaterStats_.emplace(id, std::make_unique<SeatAggregate>());
     return id;
 }
 
@@ -166,6 +228,23 @@ int BookingService::addTheater(const std::string& name) {
  * Composite key lookup
  */
 long long BookingService::createShow(int movieId, int theaterId) {
+    return createShow(movieId, theaterId, 0);
+}
+
+/**
+ * The function `createShow` with a `showId` creates the show under that ID instead of the next
+ * free one, for deployments where IDs are assigned outside this service (a shard router, a
+ * replication follower). Later automatic IDs continue above the highest ID used. 0 = next free ID.
+ * The ID may be at most MAX_SHOW_ID_GAP above the highest ID used so far, so a stray huge ID
+ * cannot make the show table allocate a directory page proportional to it.
+ *
+ * @return showId, or -1 if the movie/theater is unknown, the pair already has a show, or the ID
+ * is out of range, too far above the highest ID, or taken.
+ *
+ * Time complexity: O(1) average.
+ * Space complexity: O(1) per show.
+ */
+long long BookingService::createShow(int movieId, int theaterId, long long showId) {
     std::unique_lock unqLock(mtx_);
 
     if (!movies_.count(movieId)) {
@@ -184,24 +263,104 @@ long long BookingService::createShow(int movieId, int theaterId) {
         return -1;
     }
 
-    long long id = ++showCounter_;
-    auto show = std::make_shared<Show>();
+    if (showId == 0 && showCounter_.load(std::memory_order_relaxed) == ShowTable::MAX_ID) {
+        std::cerr << "Show table is full\n";
+        return -1;
+    }
+    if (showId != 0 && (!ShowTable::inRange(showId) || shows_.find(showId))) {
+        std::cerr << "Show ID unavailable: " << showId << '\n';
+        return -1;
+    }
+    if (showId - showCounter_.load(std::memory_order_relaxed) > MAX_SHOW_ID_GAP) {
+        std::cerr << "Show ID too far above the highest ID " << showCounter_.load(std::memory_order_relaxed)
+                  << ": " << showId << '\n';
+        return -1;
+    }
+
+    auto logged = logWriter();
+    logged.reserve();                 // before publishing: bookings of the new show log after it
+    const long long id = insertShowLocked(movieId, theaterId, showId);
+    logged.append({.type = LogRecord::Type::CreateShow, .id = id, .movieId = movieId, .theaterId = theaterId});
+    showLookup_.emplace(key, id);
+    catalogEpoch_.fetch_add(1, std::memory_order_release);
+    return id;
+}
+
+long long BookingService::insertShowLocked(int movieId, int theaterId, long long id) {
+    const long long last = showCounter_.load(std::memory_order_relaxed);
+    if (id == 0) id = last + 1;
+    shows_.reserve(id);                                       // may throw: nothing below has changed yet
+    if (id > last)
+        showCounter_.store(id, std::memory_order_release);   // writers hold mtx_ exclusively
+    Show* show = showPool_.create();
     show->movieId = movieId;
     show->theaterId = theaterId;
-    show->seats.assign(TOTAL_SEATS, false);
-    show->availableCount = TOTAL_SEATS;
+    show->movieStats = movieStats_.at(movieId).get();
+    show->theaterStats = theaterStats_.at(theaterId).get();
+    show->movieStats->available.add(TOTAL_SEATS);
+    show->theaterStats->available.add(TOTAL_SEATS);
 
-    shows_.emplace(id, show);
-    showLookup_[key] = id;
+    shows_.publish(id, show);
+    ++liveShows_;
     activeMovies_.insert(movieId);
     movieToTheaters_[movieId].insert(theaterId);
     return id;
 }
 
+/**
+ * The function `removeShow` unlists a show: it disappears from lookups and listings, its seats leave
+ * the movie/theater totals, and bookings that race with the removal fail. Tickets already issued
+ * for the show are kept.
+ *
+ * @param showId Unique identifier of the show to remove.
+ *
+ * @return `true` if the show existed and was removed, `false` otherwise.
+ *
+ * The Show object is not freed here: it is retired to the epoch manager and deleted only after
+ * every thread that may have looked it up has left its read-side section, so the lookup paths
+ * work with raw pointers and no reference counting.
+ * Time complexity: O(1) average.
+ * Space complexity: O(1)
+ */
+bool BookingService::removeShow(long long showId) {
+    std::unique_lock unqLock(mtx_);
+    Show* show = shows_.clear(showId);
+    if (!show) return false;
+    --liveShows_;
+
+    showLookup_.erase({show->movieId, show->theaterId});
+    auto theatersIt = movieToTheaters_.find(show->movieId);
+    theatersIt->second.erase(show->theaterId);
+    if (theatersIt->second.empty()) {
+        movieToTheaters_.erase(theatersIt);
+        activeMovies_.erase(show->movieId);
+    }
+
+    {
+        // Bookers that already hold the pointer either committed (counted below) or will see `removed`.
+        std::lock_guard<std::mutex> guard(show->mtx);
+        show->removed = true;
+        const int available = show->availableCount.load(std::memory_order_relaxed);
+        show->movieStats->available.add(-available);
+        show->movieStats->sold.add(available - TOTAL_SEATS);
+        show->theaterStats->available.add(-available);
+        show->theaterStats->sold.add(available - TOTAL_SEATS);
+        logWriter().append({.type = LogRecord::Type::RemoveShow, .id = showId});
+    }
+    catalogEpoch_.fetch_add(1, std::memory_order_release);
+    unqLock.unlock();
+
+    epochs_.retire(show, [](void* pool, void* object) {
+        static_cast<ObjectPool<Show>*>(pool)->destroy(static_cast<Show*>(object));
+    }, &showPool_);
+    return true;
+}
+
 // ----------------- Seat Availability -----------------
 /**
  * The function `getAvailableSeats` retrieves the available seats for a given show ID in a booking
- * service, ensuring thread safety with mutex locks.
+ * service without taking any lock: the show is found in the segmented table and its seats are read
+ * through the show's seqlock.
  *
  * @param showId The `showId` parameter is a unique identifier for a particular show in the booking
  * service. It is used to look up the show details and retrieve information about the available seats
@@ -216,28 +375,122 @@ long long BookingService::createShow(int movieId, int theaterId) {
  * Uses cached count.
  */
 std::vector<std::string> BookingService::getAvailableSeats(long long showId) const {
-    std::shared_lock shrLock(mtx_);
-    auto it = shows_.find(showId);
-    if (it == shows_.end()) throw std::invalid_argument("Invalid show ID");
-    std::shared_ptr<Show> show = it->second;
-    shrLock.unlock();
+    auto epochGuard = epochs_.pin();          // keeps `show` alive even if it is removed meanwhile
+    const Show* show = shows_.find(showId);
+    if (!show) throw std::invalid_argument("Invalid show ID");
+    hotShows_.record(showId);
 
-    std::lock_guard<std::mutex> guard(show->mtx);
+    const SeatSnapshot snap = readSeats(*show);
     std::vector<std::string> available;
-    available.reserve(show->availableCount);
+    available.reserve(snap.availableCount);
     for (int i = 0; i < TOTAL_SEATS; ++i)
-        if (!show->seats[i])
+        if (!snap.isBooked(i))
             available.emplace_back(seatLabelFromIndex(i));
     return available;
 }
 
+/**
+ * The function `getAvailableSeatCount` returns how many seats of a show are still free, from the
+ * count cached next to the seat bitmap. It takes no lock and, unlike getAvailableSeats(), is not
+ * counted as a request for hot-show tracking, so admission checks can call it freely.
+ *
+ * @throws std::invalid_argument if the show does not exist.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+int BookingService::getAvailableSeatCount(long long showId) const {
+    auto epochGuard = epochs_.pin();
+    const Show* show = shows_.find(showId);
+    if (!show) throw std::invalid_argument("Invalid show ID");
+    return show->availableCount.load(std::memory_order_acquire);
+}
+
+/**
+ * The function `hasShow` reports whether `showId` is a listed show, without locking or throwing.
+ * A concurrent removeShow() may unlist it right after.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+bool BookingService::hasShow(long long showId) const noexcept {
+    return shows_.find(showId) != nullptr;
+}
+
+/**
+ * The function `readSeats` takes a consistent snapshot of a show's seat words and available count
+ * without locking. It copies the state between two reads of `show.seq` and retries if a booker
+ * was writing (odd sequence) or committed in between (sequence changed).
+ *
+ * Time complexity: O(SEAT_WORDS) per attempt; retries only while a booking commits.
+ * Space complexity: O(1)
+ */
+BookingService::SeatSnapshot BookingService::readSeats(const Show& show) noexcept {
+    SeatSnapshot snap;
+    for (;;) {
+        const std::uint32_t before = show.seq.load(std::memory_order_acquire);
+        if (before & 1u) {
+            cpuRelax();
+            schedulePoint();
+            continue;
+        }
+        for (int w = 0; w < SEAT_WORDS; ++w)
+            snap.booked[w] = show.seats[w].load(std::memory_order_relaxed);
+        schedulePoint();
+        snap.availableCount = show.availableCount.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (show.seq.load(std::memory_order_relaxed) == before) return snap;
+    }
+}
+
+/**
+ * The function `commitSeats` marks the seats in `seatMask` as booked inside a seqlock write
+ * section. The caller holds `show.mtx`, so there is exactly one writer per show.
+ *
+ * Time complexity: O(SEAT_WORDS)
+ * Space complexity: O(1)
+ */
+void BookingService::commitSeats(Show& show, std::uint32_t seatMask) noexcept {
+    const std::uint32_t seq = show.seq.load(std::memory_order_relaxed);
+    show.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);   // odd sequence is visible before any seat word
+
+    show.seats[0].store(show.seats[0].load(std::memory_order_relaxed) | seatMask, std::memory_order_relaxed);
+    schedulePoint();
+    show.availableCount.store(show.availableCount.load(std::memory_order_relaxed) - std::popcount(seatMask),
+                              std::memory_order_relaxed);
+    for (int c = 0; c < CATEGORY_COUNT; ++c)
+        if (const int n = std::popcount(seatMask & CATEGORY_SEATS[c]))
+            show.categoryAvailable[c].store(static_cast<std::uint8_t>(show.categoryAvailable[c].load(std::memory_order_relaxed) - n),
+                                            std::memory_order_relaxed);
+
+    show.seq.store(seq + 2, std::memory_order_release);
+}
+
+// Clears the seats in `seatMask` inside a seqlock write section; the inverse of commitSeats.
+void BookingService::releaseSeats(Show& show, std::uint32_t seatMask) noexcept {
+    const std::uint32_t seq = show.seq.load(std::memory_order_relaxed);
+    show.seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    show.seats[0].store(show.seats[0].load(std::memory_order_relaxed) & ~seatMask, std::memory_order_relaxed);
+    show.availableCount.store(show.availableCount.load(std::memory_order_relaxed) + std::popcount(seatMask),
+                              std::memory_order_relaxed);
+    for (int c = 0; c < CATEGORY_COUNT; ++c)
+        if (const int n = std::popcount(seatMask & CATEGORY_SEATS[c]))
+            show.categoryAvailable[c].store(static_cast<std::uint8_t>(show.categoryAvailable[c].load(std::memory_order_relaxed) + n),
+                                            std::memory_order_relaxed);
+
+    show.seq.store(seq + 2, std::memory_order_release);
+}
+
 // ----------------- Booking -----------------
 /**
  * The function `bookSeats` in the BookingService class books seats for a show based on seat labels,
- * checking for validity and availability.
+ * checking for validity and availability. The booking is recorded as an anonymous ticket.
  *
  * @param showId The `showId` parameter in the `bookSeats` function represents the unique identifier of
- * the show for which seats are being booked. It is used to find the specific show in the `shows_` map
+ * the show for which seats are being booked. It is used to find the specific show in the `shows_` table
  * where the seats will be booked.
  * @param seatLabels The `seatLabels` parameter is a vector of strings that contains the labels of the
  * seats that need to be booked for a particular show. Each string in the vector represents the label
@@ -248,48 +501,403 @@ std::vector<std::string> BookingService::getAvailableSeats(long long showId) con
  * showId. If any error occurs during the booking process (such as invalid seat labels, duplicate
  * seats, or already booked seats), the function will return `false`.
  *
+ * Time complexity: O(k) where k = reqested seats being booked(small).
+ * Space complexity: O(1)
+ */
+bool BookingService::bookSeats(long long showId, const std::vector<std::string>& seatLabels) {
+    return bookTicket(showId, seatLabels, ANONYMOUS_CUSTOMER) > 0;
+}
+
+/**
+ * The function `bookTicket` books seats for a show and stores a booking record (ticket) for
+ * the given customer.
+ *
+ * @param showId Unique identifier of the show.
+ * @param seatLabels Labels of the seats to book, e.g. {"A1", "A2"}.
+ * @param customerId Customer placing the booking; ANONYMOUS_CUSTOMER is not indexed by customer.
+ *
+ * @return The ticket ID of the new booking record, or -1 if the show does not exist, any seat
+ * label is invalid or duplicated, or any seat is already booked. Nothing is booked on failure.
+ *
+ * The record is appended while the show lock is held, so a ticket exists exactly for every
+ * committed booking. Seats are committed through the show's seqlock, so concurrent readers
+ * never wait on the show lock.
  * Each operation (lookup, set) is O(1).
  * Time complexity: O(k) where k = reqested seats being booked(small).
  * Space complexity: O(TOTAL_SEATS) = O(1) fixed array and bitset.
  */
-bool BookingService::bookSeats(long long showId, const std::vector<std::string>& seatLabels) {
-    std::shared_lock shrLock(mtx_);
-    auto it = shows_.find(showId);
-    if (it == shows_.end()) return false;
+long long BookingService::bookTicket(long long showId, const std::vector<std::string>& seatLabels,
+                                     long long customerId) {
+    auto epochGuard = epochs_.pin();          // keeps `show` alive even if it is removed meanwhile
+    Show* show = shows_.find(showId);
+    if (!show) return -1;
+    hotShows_.record(showId);
+
+    const auto seatMask = seatMaskFromLabels(seatLabels);
+    if (!seatMask) return -1;
+
+    schedulePoint();
+    auto guard = lockCooperatively(show->mtx);
+    if (show->removed || !seatsFreeLocked(*show, *seatMask)) return -1;
+
+    return issueTicketLocked(showId, *show, *seatMask, customerId);
+}
+
+// Appends the ticket, commits the seats and logs the booking. Caller holds show.mtx and has
+// checked that the seats are free. Returns the ticket ID, or -1 if the ticket store is full.
+long long BookingService::issueTicketLocked(long long showId, Show& show, std::uint32_t seatMask, long long customerId) {
+    schedulePoint();
+    long long ticketId = -1;
+    // The ticket ID and the LSN are taken together, so ticket IDs reach the log in order.
+    auto logged = logReserve(1, [&] { return (ticketId = tickets_.append(showId, customerId, seatMask)) >= 0; });
+    if (ticketId < 0) {
+        std::cerr << "Ticket store is full\n";
+        return -1;
+    }
+
+    applyBookingLocked(show, seatMask);
+    logged.append({.type = LogRecord::Type::Book, .id = showId, .ticketId = ticketId,
+                   .customerId = customerId, .seatMask = seatMask});
+    return ticketId;
+}
+
+/**
+ * The function `bookAcrossShows` books seats in several shows as one unit: either every leg is
+ * booked or none is (a double feature, or a group split across two screens).
+ *
+ * All labels are validated before any lock is taken. The shows are then locked in ascending
+ * show ID order, so two multi-show bookings over overlapping shows can never wait on each other
+ * in a cycle, and a single-show booking only ever waits for bookings that hold its show. Only
+ * once every leg is known to be free are the tickets appended and the seats committed.
+ *
+ * @param legs Show IDs and the seats wanted in each; at least one, and a show may appear only once.
+ * @param customerId Customer placing the booking; ANONYMOUS_CUSTOMER is not indexed by customer.
+ *
+ * @return One ticket ID per leg, in the order of `legs`, or an empty vector on failure: `legs` is
+ * empty, any show does not exist, any label is invalid or duplicated, a show is listed twice, or
+ * any seat is taken. An empty result therefore always means nothing was booked because of an error.
+ *
+ * Time complexity: O(L log L + K), L = legs, K = requested seats in total.
+ * Space complexity: O(L)
+ */
+std::vector<long long> BookingService::bookAcrossShows(std::span<const ShowSeats> legs, long long customerId) {
+    struct Leg {
+        long long showId;
+        Show* show;
+        std::uint32_t seatMask;
+        std::size_t position;            // Index in `legs`, for the result order
+    };
+
+    if (legs.empty()) {
+        std::cerr << "No shows to book\n";
+        return {};
+    }
+    auto epochGuard = epochs_.pin();
+    std::vector<Leg> ordered;
+    ordered.reserve(legs.size());
+    for (std::size_t i = 0; i < legs.size(); ++i) {
+        Show* show = shows_.find(legs[i].showId);
+        if (!show) return {};
+        hotShows_.record(legs[i].showId);
+        const auto seatMask = seatMaskFromLabels(legs[i].seatLabels);
+        if (!seatMask) return {};
+        ordered.push_back({legs[i].showId, show, *seatMask, i});
+    }
+    std::sort(ordered.begin(), ordered.end(), [](const Leg& a, const Leg& b) { return a.showId < b.showId; });
+    for (std::size_t i = 1; i < ordered.size(); ++i) {
+        if (ordered[i].showId == ordered[i - 1].showId) {
+            std::cerr << "Duplicate show: " << ordered[i].showId << '\n';
+            return {};
+        }
+    }
 
-    std::shared_ptr<Show> show = it->second;
-    shrLock.unlock();
+    std::vector<std::unique_lock<std::mutex>> locks;
+    locks.reserve(ordered.size());
+    for (const Leg& leg : ordered) {
+        schedulePoint();
+        locks.push_back(lockCooperatively(leg.show->mtx));
+        if (leg.show->removed || !seatsFreeLocked(*leg.show, leg.seatMask)) return {};
+    }
+
+    // Every ticket ID is reserved at once, so a full store fails the booking before anything
+    // is written and the ticket IDs stay gap-free for followers.
+    long long firstTicket = -1;
+    auto logged = logReserve(ordered.size(), [&] { return (firstTicket = tickets_.reserve(ordered.size())) >= 0; });
+    if (firstTicket < 0) {
+        std::cerr << "Ticket store is full\n";
+        return {};
+    }
+    std::vector<long long> ticketIds(legs.size());
+    for (std::size_t i = 0; i < ordered.size(); ++i) {
+        const Leg& leg = ordered[i];
+        ticketIds[leg.position] = firstTicket + static_cast<long long>(i);
+        tickets_.write(ticketIds[leg.position], leg.showId, customerId, leg.seatMask);
+    }
+    for (const Leg& leg : ordered) {
+        applyBookingLocked(*leg.show, leg.seatMask);
+        logged.append({.type = LogRecord::Type::Book, .id = leg.showId, .ticketId = ticketIds[leg.position],
+                       .customerId = customerId, .seatMask = leg.seatMask});
+    }
+    return ticketIds;
+}
 
-    std::lock_guard<std::mutex> guard(show->mtx);
+// ----------------- Seat Holds -----------------
+/**
+ * The function `holdSeats` takes seats of a show without booking them: they become unavailable
+ * exactly as if booked, but no ticket is written until `confirmHold`, and `releaseHold` gives
+ * them back. This is the prepare step of a booking whose outcome is decided elsewhere.
+ *
+ * @return The hold ID, or -1 if the show does not exist, any label is invalid or duplicated, or
+ * any seat is already booked or held.
+ *
+ * Time complexity: O(k), k = labels.
+ * Space complexity: O(1)
+ */
+long long BookingService::holdSeats(long long showId, const std::vector<std::string>& seatLabels) {
+    auto epochGuard = epochs_.pin();
+    Show* show = shows_.find(showId);
+    if (!show) return -1;
+    const auto seatMask = seatMaskFromLabels(seatLabels);
+    if (!seatMask) return -1;
 
-    std::bitset<TOTAL_SEATS> seen;
-    int tmpIndices[TOTAL_SEATS];
-    int n = 0;
+    auto guard = lockCooperatively(show->mtx);
+    if (show->removed || !seatsFreeLocked(*show, *seatMask)) return -1;
+    applyBookingLocked(*show, *seatMask);
+    std::lock_guard<std::mutex> holdsGuard(holdsMtx_);
+    holds_.emplace(++holdCounter_, Hold{showId, *seatMask});
+    return holdCounter_;
+}
 
+/**
+ * The function `confirmHold` turns a hold into a booking: it writes the ticket (and the
+ * replication record) for the held seats. If the ticket store is full the hold is kept, so the
+ * caller can retry or release it; otherwise it is consumed either way.
+ *
+ * @return The ticket ID, or -1 if the hold is unknown, its show was removed meanwhile, or the
+ * ticket store is full.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+long long BookingService::confirmHold(long long holdId, long long customerId) {
+    const auto hold = takeHold(holdId);
+    if (!hold) return -1;
+    auto epochGuard = epochs_.pin();
+    Show* show = shows_.find(hold->showId);
+    if (!show) return -1;
+
+    auto guard = lockCooperatively(show->mtx);
+    if (show->removed) return -1;
+    long long ticketId = -1;
+    auto logged = logReserve(1, [&] { return (ticketId = tickets_.append(hold->showId, customerId, hold->seatMask)) >= 0; });
+    if (ticketId < 0) {
+        std::cerr << "Ticket store is full\n";
+        std::lock_guard<std::mutex> holdsGuard(holdsMtx_);
+        holds_.emplace(holdId, *hold);        // the seats stay held, not sold without a ticket
+        return -1;
+    }
+    logged.append({.type = LogRecord::Type::Book, .id = hold->showId, .ticketId = ticketId,
+                   .customerId = customerId, .seatMask = hold->seatMask});
+    return ticketId;
+}
+
+/**
+ * The function `releaseHold` gives held seats back to the show.
+ *
+ * @return false if the hold is unknown (already confirmed or released).
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+bool BookingService::releaseHold(long long holdId) {
+    const auto hold = takeHold(holdId);
+    if (!hold) return false;
+    auto epochGuard = epochs_.pin();
+    Show* show = shows_.find(hold->showId);
+    if (!show) return true;                   // removed: its seats are gone anyway
+
+    auto guard = lockCooperatively(show->mtx);
+    if (show->removed) return true;
+    const int n = std::popcount(hold->seatMask);
+    releaseSeats(*show, hold->seatMask);
+    show->movieStats->available.add(n);
+    show->movieStats->sold.add(-n);
+    show->theaterStats->available.add(n);
+    show->theaterStats->sold.add(-n);
+    return true;
+}
+
+std::optional<BookingService::Hold> BookingService::takeHold(long long holdId) {
+    std::lock_guard<std::mutex> guard(holdsMtx_);
+    auto it = holds_.find(holdId);
+    if (it == holds_.end()) return std::nullopt;
+    const Hold hold = it->second;
+    holds_.erase(it);
+    return hold;
+}
+
+/**
+ * The function `seatMaskFromLabels` converts seat labels to a seat bitmap, reporting the first
+ * invalid or repeated label on std::cerr.
+ *
+ * @return The bitmap (bit i = seat index i), or std::nullopt if any label is invalid or repeated.
+ *
+ * Time complexity: O(k), k = labels.
+ * Space complexity: O(1)
+ */
+std::optional<std::uint32_t> BookingService::seatMaskFromLabels(const std::vector<std::string>& seatLabels) {
+    std::uint32_t seatMask = 0;
     for (const auto& lbl : seatLabels) {
-        int idx = seatIndexFromLabel(lbl);
+        const int idx = seatIndexFromLabel(lbl);
         if (idx < 0) {
             std::cerr << "Invalid seat: " << lbl << '\n';
-            return false;
+            return std::nullopt;
         }
-        if (seen[idx]) {
+        if (seatMask & (std::uint32_t{1} << idx)) {
             std::cerr << "Duplicate seat: " << lbl << '\n';
-            return false;
-        }
-        seen[idx] = true;
-
-        if (show->seats[idx]) {
-            std::cerr << "Seat already booked: " << lbl << '\n';
-            return false;
+            return std::nullopt;
         }
-        tmpIndices[n++] = idx;
+        seatMask |= std::uint32_t{1} << idx;
     }
+    return seatMask;
+}
+
+// Caller holds show.mtx, so the seat words cannot change underneath.
+bool BookingService::seatsFreeLocked(const Show& show, std::uint32_t seatMask) {
+    const std::uint32_t taken = show.seats[0].load(std::memory_order_relaxed) & seatMask;
+    if (taken == 0) return true;
+    std::cerr << "Seat already booked: " << seatLabelFromIndex(std::countr_zero(taken)) << '\n';
+    return false;
+}
+
+// Commits the seats and moves them from available to sold in the movie/theater aggregates.
+void BookingService::applyBookingLocked(Show& show, std::uint32_t seatMask) noexcept {
+    const int n = std::popcount(seatMask);
+    commitSeats(show, seatMask);
+    show.movieStats->available.add(-n);
+    show.movieStats->sold.add(n);
+    show.theaterStats->available.add(-n);
+    show.theaterStats->sold.add(n);
+}
+
+/**
+ * The function `getTicket` returns the booking record for a ticket ID.
+ *
+ * @return The ticket, or std::nullopt if no booking has that ID.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+std::optional<BookingService::Ticket> BookingService::getTicket(long long ticketId) const {
+    return tickets_.find(ticketId);
+}
+
+/**
+ * The function `getTicketsForCustomer` returns every booking record of a customer, newest first.
+ *
+ * Time complexity: O(k) (k = tickets of this customer).
+ * Space complexity: O(k) for result vector.
+ */
+std::vector<BookingService::Ticket> BookingService::getTicketsForCustomer(long long customerId) const {
+    return tickets_.findByCustomer(customerId);
+}
+
+// ----------------- Seat Categories -----------------
+BookingService::SeatCategory BookingService::seatCategory(int idx) noexcept {
+    for (int c = 0; c < CATEGORY_COUNT; ++c)
+        if (CATEGORY_SEATS[c] & (std::uint32_t{1} << idx)) return static_cast<SeatCategory>(c);
+    return SeatCategory::Standard;
+}
+
+void BookingService::setCategoryPrice(SeatCategory category, long long priceCents) noexcept {
+    categoryPrices_[static_cast<std::size_t>(category)].store(priceCents, std::memory_order_relaxed);
+}
+
+long long BookingService::getCategoryPrice(SeatCategory category) const noexcept {
+    return categoryPrices_[static_cast<std::size_t>(category)].load(std::memory_order_relaxed);
+}
+
+/**
+ * The function `getAvailability` returns how many seats of one category are still free in a
+ * show, from the per-category count that every booking updates with the seat bitmap.
+ *
+ * @throws std::invalid_argument if the show does not exist.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+int BookingService::getAvailability(long long showId, SeatCategory category) const {
+    auto epochGuard = epochs_.pin();
+    const Show* show = shows_.find(showId);
+    if (!show) throw std::invalid_argument("Invalid show ID");
+    return show->categoryAvailable[static_cast<std::size_t>(category)].load(std::memory_order_acquire);
+}
+
+/**
+ * The function `quoteSeats` prices a set of seats: the number of seats of each category (a
+ * popcount of the seat mask and the category mask) times the category price.
+ *
+ * @return The total in cents, or -1 if a label is invalid or repeated.
+ *
+ * Time complexity: O(K) for K labels.
+ * Space complexity: O(1)
+ */
+long long BookingService::quoteSeats(const std::vector<std::string>& seatLabels) const {
+    const auto seatMask = seatMaskFromLabels(seatLabels);
+    if (!seatMask) return -1;
+    long long total = 0;
+    for (int c = 0; c < CATEGORY_COUNT; ++c)
+        total += std::popcount(*seatMask & CATEGORY_SEATS[c]) * categoryPrices_[c].load(std::memory_order_relaxed);
+    return total;
+}
 
-    for (int i = 0; i < n; ++i) {
-        show->seats[tmpIndices[i]] = true;
-        show->availableCount--; // update cached available count
+/**
+ * The function `bookCheapestSeats` books `count` seats, taking the free seats of the cheapest
+ * category first (lowest seat numbers first within a category) and moving on to dearer ones
+ * only as needed. Free seats per category are the free-seat mask ANDed with the category mask,
+ * so choosing the seats costs a few bit operations per seat and never scans the layout.
+ *
+ * @return The ticket ID, or -1 if the show does not exist, count is out of range, or fewer
+ * than `count` seats are free.
+ *
+ * Time complexity: O(count + CATEGORY_COUNT log CATEGORY_COUNT)
+ * Space complexity: O(1)
+ */
+long long BookingService::bookCheapestSeats(long long showId, int count, long long customerId) {
+    if (count <= 0 || count > TOTAL_SEATS) return -1;
+    auto epochGuard = epochs_.pin();
+    Show* show = shows_.find(showId);
+    if (!show) return -1;
+    hotShows_.record(showId);
+
+    std::array<int, CATEGORY_COUNT> byPrice{};
+    for (int c = 0; c < CATEGORY_COUNT; ++c) byPrice[c] = c;
+    std::stable_sort(byPrice.begin(), byPrice.end(), [&](int a, int b) {
+        return categoryPrices_[a].load(std::memory_order_relaxed) < categoryPrices_[b].load(std::memory_order_relaxed);
+    });
+
+    schedulePoint();
+    auto guard = lockCooperatively(show->mtx);
+    if (show->removed || show->availableCount.load(std::memory_order_relaxed) < count) return -1;
+
+    const std::uint32_t allSeats = (TOTAL_SEATS == 32) ? ~std::uint32_t{0} : (std::uint32_t{1} << TOTAL_SEATS) - 1;
+    const std::uint32_t free = allSeats & ~show->seats[0].load(std::memory_order_relaxed);
+    std::uint32_t seatMask = 0;
+    int needed = count;
+    for (int c : byPrice) {
+        std::uint32_t candidates = free & CATEGORY_SEATS[c];
+        if (std::popcount(candidates) <= needed) {
+            seatMask |= candidates;
+            needed -= std::popcount(candidates);
+            continue;
+        }
+        for (; needed > 0; --needed) {
+            seatMask |= candidates & (~candidates + 1);   // lowest free seat
+            candidates &= candidates - 1;
+        }
+        break;
     }
-    return true;
+    return issueTicketLocked(showId, *show, seatMask, customerId);
 }
 
 // ----------------- Listing -----------------
@@ -342,12 +950,66 @@ void BookingService::listTheatersForMovie(int movieId) const {
         return;
     }
 
-    std::cout << "Theaters showing \"" << getMovieTitle(movieId) << "\":\n";
+    std::cout << "Theaters showing \"" << movies_.at(movieId).title << "\":\n";
     for (int tid : it->second) {                // O(K)
-        std::cout << "  [" << tid << "] " << getTheaterName(tid) << "\n";
+        std::cout << "  [" << tid << "] " << theaters_.at(tid).name << "\n";
     }
 }
 
+// ----------------- Aggregates -----------------
+/**
+ * The function `getMovieAvailability` returns how many seats are left and sold for a movie across
+ * every theater showing it. Totals are maintained incrementally by `createShow` and `bookTicket`,
+ * so no show is visited.
+ *
+ * @param movieId Unique identifier of the movie.
+ *
+ * @return The movie's SeatTotals. Throws std::invalid_argument for an unknown movie ID.
+ *
+ * Time complexity: O(1) — hash lookup + ShardedCounter::SHARDS loads.
+ * Space complexity: O(1)
+ */
+BookingService::SeatTotals BookingService::getMovieAvailability(int movieId) const {
+    std::shared_lock shrLock(mtx_);
+    auto it = movieStats_.find(movieId);
+    if (it == movieStats_.end()) throw std::invalid_argument("Invalid movie ID");
+    return {it->second->available.load(), it->second->sold.load()};
+}
+
+/**
+ * The function `getTheaterAvailability` returns how many seats are left and sold across all shows
+ * of a theater.
+ *
+ * @param theaterId Unique identifier of the theater.
+ *
+ * @return The theater's SeatTotals. Throws std::invalid_argument for an unknown theater ID.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+BookingService::SeatTotals BookingService::getTheaterAvailability(int theaterId) const {
+    std::shared_lock shrLock(mtx_);
+    auto it = theaterStats_.find(theaterId);
+    if (it == theaterStats_.end()) throw std::invalid_argument("Invalid theater ID");
+    return {it->second->available.load(), it->second->sold.load()};
+}
+
+/**
+ * The function `topShows` returns the `k` most requested shows (bookings + seat-map reads) over the
+ * last `window`, hottest first. Requests are sampled (HOT_SHOW_SAMPLING), so counts are
+ * estimates; see HotShowTracker.
+ * Every thread's buffered requests are folded in first, each into the bucket it was recorded in.
+ *
+ * Time complexity: O(W * HotShowTracker::CAPACITY + T * HotShowTracker::BUFFER_SIZE) for W
+ * one-second buckets and T recording threads.
+ * Space complexity: O(W * HotShowTracker::CAPACITY)
+ */
+std::vector<BookingService::HotShow> BookingService::topShows(std::size_t k,
+                                                              std::chrono::steady_clock::duration window) const {
+    hotShows_.flush();
+    return hotShows_.topShows(k, window);
+}
+
 // ----------------- Utility -----------------
 /**
  * The function `getMovieTitle` returns the title of a movie based on its ID, or "Unknown Movie" if the
@@ -367,7 +1029,7 @@ void BookingService::listTheatersForMovie(int movieId) const {
 std::string BookingService::getMovieTitle(int movieId) const {
     std::shared_lock shrLock(mtx_);
     auto it = movies_.find(movieId);
-    return (it != movies_.end()) ? it->second.title : "Unknown Movie";
+    return (it != movies_.end()) ? std::string(it->second.title) : std::string("Unknown Movie");
 }
 
 /**
@@ -389,7 +1051,7 @@ std::string BookingService::getMovieTitle(int movieId) const {
 std::string BookingService::getTheaterName(int theaterId) const {
     std::shared_lock shrLock(mtx_);
     auto it = theaters_.find(theaterId);
-    return (it != theaters_.end()) ? it->second.name : "Unknown Theater";
+    return (it != theaters_.end()) ? std::string(it->second.name) : std::string("Unknown Theater");
 }
 
 /**
@@ -406,17 +1068,17 @@ std::string BookingService::getTheaterName(int theaterId) const {
 std::vector<BookingService::ShowInfo> BookingService::getAllShows() const {
     std::shared_lock shrLock(mtx_);
     std::vector<ShowInfo> info;
-    info.reserve(shows_.size());
+    info.reserve(liveShows_);
 
-    for (const auto& [sid, showPtr] : shows_) {
-        if (!showPtr) continue;
+    shows_.forEach([&](long long sid, const Show* showPtr) {
+        schedulePoint();
         info.push_back({
             sid,
-            getMovieTitle(showPtr->movieId),
-            getTheaterName(showPtr->theaterId),
-            showPtr->availableCount
+            std::string(movies_.at(showPtr->movieId).title),
+            std::string(theaters_.at(showPtr->theaterId).name),
+            showPtr->availableCount.load(std::memory_order_relaxed)
         });
-    }
+    });
     return info;
 }
 
@@ -436,7 +1098,7 @@ std::vector<std::pair<int, std::string>> BookingService::getAllMovies() const {
     std::shared_lock shrLock(mtx_);
     std::vector<std::pair<int, std::string>> result;
     for (const auto& [id, movie] : movies_)
-        result.emplace_back(id, movie.title);
+        result.emplace_back(id, std::string(movie.title));
     return result;
 }
 
@@ -455,9 +1117,171 @@ std::vector<std::pair<int, std::string>> BookingService::getAllMovies() const {
 std::vector<std::pair<int, std::string>> BookingService::getAllTheaters() const {
     std::shared_lock shrLock(mtx_);
     std::vector<std::pair<int, std::string>> result;
+    for (const auto& [id, theater] : theaters_)
+        result.emplace_back(id, std::string(theater.name));
+    return result;
+}
+
+/**
+ * The function `getAllShowViews` lists every show like `getAllShows`, but returns IDs and views of
+ * the interned movie title and theater name instead of copying both strings per show.
+ *
+ * @return A vector of `ShowView`; the only allocation is the vector itself.
+ *
+ * Time complexity: O(S) (S = number of shows).
+ * Space complexity: O(S) for result vector, zero string allocations.
+ */
+std::vector<BookingService::ShowView> BookingService::getAllShowViews() const {
+    std::shared_lock shrLock(mtx_);
+    std::vector<ShowView> views;
+    views.reserve(liveShows_);
+
+    shows_.forEach([&](long long sid, const Show* showPtr) {
+        views.push_back({
+            sid,
+            showPtr->movieId,
+            showPtr->theaterId,
+            movies_.at(showPtr->movieId).title,
+            theaters_.at(showPtr->theaterId).name,
+            showPtr->availableCount.load(std::memory_order_relaxed)
+        });
+    });
+    return views;
+}
+
+/**
+ * The function `getAllMovieViews` returns (movieId, title) pairs with the title as a view into
+ * the intern pool.
+ *
+ * Time complexity: O(M)
+ * Space complexity: O(M) for result vector, zero string allocations.
+ */
+std::vector<std::pair<int, std::string_view>> BookingService::getAllMovieViews() const {
+    std::shared_lock shrLock(mtx_);
+    std::vector<std::pair<int, std::string_view>> result;
+    result.reserve(movies_.size());
+    for (const auto& [id, movie] : movies_)
+        result.emplace_back(id, movie.title);
+    return result;
+}
+
+/**
+ * The function `getAllTheaterViews` returns (theaterId, name) pairs with the name as a view into
+ * the intern pool.
+ *
+ * Time complexity: O(T)
+ * Space complexity: O(T) for result vector, zero string allocations.
+ */
+std::vector<std::pair<int, std::string_view>> BookingService::getAllTheaterViews() const {
+    std::shared_lock shrLock(mtx_);
+    std::vector<std::pair<int, std::string_view>> result;
+    result.reserve(theaters_.size());
     for (const auto& [id, theater] : theaters_)
         result.emplace_back(id, theater.name);
     return result;
 }
 
-} // namespace booking
\ No newline at end of file
+/**
+ * The function `scanShows` returns one page of shows in ascending show-ID order, starting after
+ * `cursor`. It holds the catalog lock only while building this page, so writers are blocked for
+ * at most one page instead of the whole catalog.
+ *
+ * Generated show IDs are handed out in increasing order, so the cursor (last ID returned) is
+ * stable under concurrent inserts: a show is never returned twice, and shows created during the
+ * scan are returned if their ID lies beyond the cursor. A show created under an explicit ID (a
+ * replicated or adopted show) may land at or below the cursor; a scan already past that ID does
+ * not return it.
+ *
+ * @param cursor 0 for the first page, otherwise `nextCursor` of the previous page.
+ * @param limit Maximum number of shows in the page; larger values are clamped to SCAN_BUDGET.
+ * @param filter Optional movie / theater / minimum-availability predicate.
+ *
+ * @return The page. At most SCAN_BUDGET IDs are probed per call, whatever `limit` is, so a
+ * selective filter may return fewer than `limit` shows with `done == false`; keep calling until
+ * `done`.
+ *
+ * Time complexity: O(SCAN_BUDGET) average per page.
+ * Space complexity: O(min(limit, SCAN_BUDGET)) — bounded by the page size.
+ */
+BookingService::ShowPage BookingService::scanShows(long long cursor, std::size_t limit) const {
+    return scanShows(cursor, limit, ShowFilter{});
+}
+
+BookingService::ShowPage BookingService::scanShows(long long cursor, std::size_t limit,
+                                                   const ShowFilter& filter) const {
+    ShowPage page;
+    page.nextCursor = cursor < 0 ? 0 : cursor;
+    if (limit == 0) return page;
+    limit = std::min(limit, SCAN_BUDGET);                 // the probe budget bounds the lock hold
+    page.shows.reserve(limit);
+
+    std::shared_lock shrLock(mtx_);
+    const long long last = showCounter_.load(std::memory_order_acquire);
+    std::size_t probed = 0;
+
+    long long id = page.nextCursor + 1;
+    for (; id <= last && page.shows.size() < limit && probed < SCAN_BUDGET; ++id, ++probed) {
+        const Show* found = shows_.find(id);
+        if (!found) continue;
+        const Show& show = *found;
+        if (filter.movieId && show.movieId != filter.movieId) continue;
+        if (filter.theaterId && show.theaterId != filter.theaterId) continue;
+        const int available = show.availableCount.load(std::memory_order_relaxed);
+        if (available < filter.minAvailable) continue;
+        page.shows.push_back({
+            id,
+            show.movieId,
+            show.theaterId,
+            movies_.at(show.movieId).title,
+            theaters_.at(show.theaterId).name,
+            available
+        });
+    }
+    page.nextCursor = id - 1;
+    page.done = id > last;
+    return page;
+}
+
+/**
+ * The function `catalogEpoch` returns a counter bumped by every catalog mutation. Callers caching
+ * a view listing can compare epochs to decide whether to list again.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+std::uint64_t BookingService::catalogEpoch() const noexcept {
+    return catalogEpoch_.load(std::memory_order_acquire);
+}
+
+// ----------------- Replication -----------------
+/**
+ * The function `setMutationLog` attaches the log that records every later mutation for followers.
+ * Lock order for writers is mtx_ -> show.mtx -> log. Each mutation reserves its LSN while its
+ * own locks are held, so LSN order is a valid replay order; the log's lock covers only the
+ * reservation, and the record is encoded and stored after it is released.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+void BookingService::setMutationLog(MutationLog* log) noexcept {
+    log_ = log;
+}
+
+/**
+ * The function `skipTicketIds` makes the next ticket ID at least `lastTicketId` + 1. A follower
+ * re-synced from a snapshot calls it so that later replicated bookings keep the primary's IDs.
+ *
+ * @return false if `lastTicketId` is beyond the ticket store's capacity.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+bool BookingService::skipTicketIds(long long lastTicketId) {
+    return tickets_.skipTo(lastTicketId);
+}
+
+MutationLog::Writer BookingService::logWriter() const {
+    return log_ ? log_->writer() : MutationLog::Writer{};
+}
+
+} // namespace booking
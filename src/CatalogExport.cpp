@@ -0,0 +1,139 @@
+#include "BookingService.hpp"
+#include "CatalogFile.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace booking {
+
+// ----------------- Catalog Export -----------------
+namespace {
+
+// Appends `count` elements at `data` as one section, pads it to ALIGNMENT and records where it landed.
+template <typename T>
+void writeSection(std::ofstream& out, catalog_file::Header& header, catalog_file::Section section,
+                  const T* data, std::size_t count, std::uint64_t& offset) {
+    static constexpr char PADDING[catalog_file::ALIGNMENT] = {};
+    const std::uint64_t bytes = count * sizeof(T);
+    header.sections[section] = {offset, bytes};
+    if (bytes) out.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+    const std::uint64_t pad = (catalog_file::ALIGNMENT - bytes % catalog_file::ALIGNMENT) % catalog_file::ALIGNMENT;
+    out.write(PADDING, static_cast<std::streamsize>(pad));
+    offset += bytes + pad;
+}
+
+} // namespace
+
+/**
+ * The function `exportCatalog` writes a snapshot of the catalog (movies, theaters, shows and their
+ * seat bitmaps) to `path` in the columnar format of CatalogFile.hpp, for ReadOnlyBookingView to map.
+ *
+ * The columns are gathered under a shared lock, so the catalog is consistent as of one
+ * catalogEpoch(); each show's seats come from one seqlock read, so bookings committing meanwhile
+ * are either fully in or fully out of that show's row. The file is written next to `path` and
+ * renamed over it, so a reader never maps a half-written file.
+ *
+ * @param path Destination file, replaced if it exists.
+ *
+ * @return true on success; false (with a message on std::cerr) if the file cannot be written.
+ *
+ * Time complexity: O(M log M + T log T + S) for M movies, T theaters, S shows.
+ * Space complexity: O(M + T + S) for the columns; strings are copied straight from the intern pool.
+ */
+bool BookingService::exportCatalog(const std::string& path) const {
+    std::vector<std::int32_t> movieIds, theaterIds, showAvailable;
+    std::vector<std::uint64_t> movieNames{0}, theaterNames;
+    std::vector<std::int64_t> showIds;
+    std::vector<std::uint32_t> showMovie, showTheater, showSeats;
+    std::vector<std::string_view> strings;          // Views into strings_, valid for the service's lifetime
+    catalog_file::Header header;
+    {
+        std::shared_lock shrLock(mtx_);
+        header.catalogEpoch = catalogEpoch_.load(std::memory_order_acquire);
+
+        for (const auto& [id, movie] : movies_) movieIds.push_back(id);
+        for (const auto& [id, theater] : theaters_) theaterIds.push_back(id);
+        std::sort(movieIds.begin(), movieIds.end());
+        std::sort(theaterIds.begin(), theaterIds.end());
+
+        // IDs are dense, so ID -> column row is a plain vector
+        std::vector<std::uint32_t> movieRow(movieCounter_.load(std::memory_order_relaxed) + 1);
+        std::vector<std::uint32_t> theaterRow(theaterCounter_.load(std::memory_order_relaxed) + 1);
+        std::uint64_t stringBytes = 0;
+        for (std::size_t i = 0; i < movieIds.size(); ++i) {
+            movieRow[movieIds[i]] = static_cast<std::uint32_t>(i);
+            strings.push_back(movies_.at(movieIds[i]).title);
+            movieNames.push_back(stringBytes += strings.back().size());
+        }
+        theaterNames.push_back(stringBytes);            // Names follow the titles in STRINGS
+        for (std::size_t i = 0; i < theaterIds.size(); ++i) {
+            theaterRow[theaterIds[i]] = static_cast<std::uint32_t>(i);
+            strings.push_back(theaters_.at(theaterIds[i]).name);
+            theaterNames.push_back(stringBytes += strings.back().size());
+        }
+        header.stringBytes = stringBytes;
+
+        showIds.reserve(liveShows_);
+        showMovie.reserve(liveShows_);
+        showTheater.reserve(liveShows_);
+        showAvailable.reserve(liveShows_);
+        showSeats.reserve(liveShows_ * SEAT_WORDS);
+        shows_.forEach([&](long long sid, const Show* show) {
+            const SeatSnapshot snap = readSeats(*show);
+            showIds.push_back(sid);
+            showMovie.push_back(movieRow[show->movieId]);
+            showTheater.push_back(theaterRow[show->theaterId]);
+            showAvailable.push_back(snap.availableCount);
+            showSeats.insert(showSeats.end(), snap.booked.begin(), snap.booked.end());
+        });
+    }
+
+    std::memcpy(header.magic, catalog_file::MAGIC, sizeof header.magic);
+    header.version = catalog_file::VERSION;
+    header.byteOrder = catalog_file::BYTE_ORDER_MARK;
+    header.totalSeats = TOTAL_SEATS;
+    header.seatWords = SEAT_WORDS;
+    header.movieCount = movieIds.size();
+    header.theaterCount = theaterIds.size();
+    header.showCount = showIds.size();
+
+    const std::string tmpPath = path + ".tmp";
+    std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!out) {
+        std::cerr << "Cannot write catalog file: " << tmpPath << '\n';
+        return false;
+    }
+    out.write(reinterpret_cast<const char*>(&header), sizeof header);   // Rewritten below with the offsets
+    std::uint64_t offset = sizeof header;
+    using namespace catalog_file;
+    writeSection(out, header, MOVIE_IDS, movieIds.data(), movieIds.size(), offset);
+    writeSection(out, header, MOVIE_NAMES, movieNames.data(), movieNames.size(), offset);
+    writeSection(out, header, THEATER_IDS, theaterIds.data(), theaterIds.size(), offset);
+    writeSection(out, header, THEATER_NAMES, theaterNames.data(), theaterNames.size(), offset);
+    writeSection(out, header, SHOW_IDS, showIds.data(), showIds.size(), offset);
+    writeSection(out, header, SHOW_MOVIE, showMovie.data(), showMovie.size(), offset);
+    writeSection(out, header, SHOW_THEATER, showTheater.data(), showTheater.size(), offset);
+    writeSection(out, header, SHOW_AVAILABLE, showAvailable.data(), showAvailable.size(), offset);
+    writeSection(out, header, SHOW_SEATS, showSeats.data(), showSeats.size(), offset);
+    header.sections[STRINGS] = {offset, header.stringBytes};
+    for (std::string_view s : strings) out.write(s.data(), static_cast<std::streamsize>(s.size()));
+
+    out.seekp(0);
+    out.write(reinterpret_cast<const char*>(&header), sizeof header);
+    out.close();
+    if (!out) {
+        std::cerr << "Failed writing catalog file: " << tmpPath << '\n';
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+        std::cerr << "Cannot replace catalog file: " << path << '\n';
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+} // namespace booking
@@ -0,0 +1,549 @@
+#include "BookingService.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <deque>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <thread>
+
+namespace booking {
+
+// ----------------- Catalog Import -----------------
+// importCatalog() runs in three phases:
+//   1. parse   (parallel over newline-aligned chunks): rows become views into the file buffer
+//              plus a lowercased copy of it, with the dedup hashes precomputed and each row filed
+//              under the partitions its movie and theater keys hash to;
+//   2. dedup   (parallel over hash partitions): each thread owns the keys whose hash falls in its
+//              partition, visits only the rows filed under it, and marks, per row, the first row
+//              carrying the same movie / theater / show;
+//   3. publish (one exclusive section): rows are walked in file order and only first occurrences
+//              touch the service maps, so IDs are assigned exactly as sequential adds would.
+namespace {
+
+constexpr std::size_t MIN_CHUNK_BYTES = 64 * 1024;
+
+struct ParsedRow {
+    std::string_view movie;          // As written (unescaped), used for the interned title
+    std::string_view theater;
+    std::string_view movieKey;       // Lowercased, used for dedup like addMovie/addTheater
+    std::string_view theaterKey;
+    std::size_t movieHash{};
+    std::size_t theaterHash{};
+    bool malformed{false};
+};
+
+struct ParseChunk {
+    std::size_t begin{};
+    std::size_t end{};
+    std::vector<ParsedRow> rows;
+    std::deque<std::string> arena;   // Unescaped fields and their lowercase copies (stable addresses)
+    // Per dedup partition: indexes into rows whose movie / theater / show key hashes to it
+    std::vector<std::vector<std::uint32_t>> movieRows, theaterRows, showRows;
+};
+
+// Key with its hash computed once during parsing.
+struct HashedKey {
+    std::string_view text;
+    std::size_t hash;
+    bool operator==(const HashedKey& o) const noexcept { return text == o.text; }
+};
+struct HashedKeyHash {
+    std::size_t operator()(const HashedKey& k) const noexcept { return k.hash; }
+};
+
+// Open-addressing set of 64-bit keys (linear probing, doubles at half load). Show keys are pairs
+// of canonical row indexes, so no strings are hashed or compared to deduplicate shows.
+class FlatKeySet {
+public:
+    static constexpr std::uint64_t EMPTY = ~std::uint64_t{0};   // Never a key: row indexes are < 2^32 - 1
+
+    bool insert(std::uint64_t key) {
+        if ((used_ + 1) * 2 > slots_.size()) grow();
+        const std::size_t mask = slots_.size() - 1;
+        for (std::size_t i = mix(key) & mask;; i = (i + 1) & mask) {
+            if (slots_[i] == key) return false;
+            if (slots_[i] == EMPTY) {
+                slots_[i] = key;
+                ++used_;
+                return true;
+            }
+        }
+    }
+    [[nodiscard]] std::size_t size() const noexcept { return used_; }
+
+    static std::uint64_t mix(std::uint64_t x) noexcept {
+        x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+        x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+        return x ^ (x >> 31);
+    }
+
+private:
+    void grow() {
+        std::vector<std::uint64_t> old = std::move(slots_);
+        slots_.assign(old.empty() ? 1024 : old.size() * 2, EMPTY);
+        used_ = 0;
+        for (std::uint64_t key : old)
+            if (key != EMPTY) insert(key);
+    }
+
+    std::vector<std::uint64_t> slots_;
+    std::size_t used_{0};
+};
+
+// Runs fn(i) for i in [0, n) on up to hardware_concurrency threads.
+template <typename Fn>
+void parallelFor(std::size_t n, Fn&& fn) {
+    const std::size_t threads = std::min<std::size_t>(n, std::max(1u, std::thread::hardware_concurrency()));
+    if (threads <= 1) {
+        for (std::size_t i = 0; i < n; ++i) fn(i);
+        return;
+    }
+    std::atomic<std::size_t> next{0};
+    std::vector<std::thread> pool;
+    pool.reserve(threads);
+    for (std::size_t t = 0; t < threads; ++t)
+        pool.emplace_back([&] {
+            for (std::size_t i; (i = next.fetch_add(1, std::memory_order_relaxed)) < n;) fn(i);
+        });
+    for (auto& th : pool) th.join();
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+// One parsed field: `text` points into the buffer unless the field had escapes, in which case
+// the unescaped text is in `owned`.
+struct Field {
+    std::string_view text;
+    std::string owned;
+    bool escaped{false};
+};
+
+// CSV field at `pos` (RFC 4180 quoting, "" inside quotes). Advances `pos` past the delimiter.
+bool nextCsvField(std::string_view line, std::size_t& pos, Field& out) {
+    while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t')) ++pos;
+    if (pos < line.size() && line[pos] == '"') {
+        const std::size_t start = ++pos;
+        out.escaped = false;
+        for (;; ++pos) {
+            if (pos >= line.size()) return false;                    // unterminated quote
+            const char c = line[pos];
+            if (c == '"') {
+                if (pos + 1 >= line.size() || line[pos + 1] != '"') break;
+                if (!out.escaped) {                                  // first "": switch to the owned copy
+                    out.owned.assign(line.substr(start, pos - start));
+                    out.escaped = true;
+                }
+                out.owned += '"';
+                ++pos;
+            } else if (out.escaped) {
+                out.owned += c;
+            }
+        }
+        out.text = out.escaped ? std::string_view(out.owned) : line.substr(start, pos - start);
+        ++pos;
+        while (pos < line.size() && (line[pos] == ' ' || line[pos] == '\t' || line[pos] == '\r')) ++pos;
+        if (pos < line.size() && line[pos] != ',') return false;
+        ++pos;
+        return true;
+    }
+    const std::size_t comma = line.find(',', pos);
+    const std::size_t end = comma == std::string_view::npos ? line.size() : comma;
+    out.text = trim(line.substr(pos, end - pos));
+    out.escaped = false;
+    pos = end + 1;
+    return true;
+}
+
+void appendUtf8(std::string& out, std::uint32_t cp) {
+    if (cp < 0x80) {
+        out += static_cast<char>(cp);
+    } else if (cp < 0x800) {
+        out += static_cast<char>(0xC0 | (cp >> 6));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else if (cp < 0x10000) {
+        out += static_cast<char>(0xE0 | (cp >> 12));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    } else {
+        out += static_cast<char>(0xF0 | (cp >> 18));
+        out += static_cast<char>(0x80 | ((cp >> 12) & 0x3F));
+        out += static_cast<char>(0x80 | ((cp >> 6) & 0x3F));
+        out += static_cast<char>(0x80 | (cp & 0x3F));
+    }
+}
+
+bool parseHex4(std::string_view s, std::size_t pos, std::uint32_t& value) {
+    if (pos + 4 > s.size()) return false;
+    value = 0;
+    for (std::size_t i = pos; i < pos + 4; ++i) {
+        const char c = s[i];
+        value <<= 4;
+        if (c >= '0' && c <= '9') value |= static_cast<std::uint32_t>(c - '0');
+        else if (c >= 'a' && c <= 'f') value |= static_cast<std::uint32_t>(c - 'a' + 10);
+        else if (c >= 'A' && c <= 'F') value |= static_cast<std::uint32_t>(c - 'A' + 10);
+        else return false;
+    }
+    return true;
+}
+
+// JSON string starting at the opening quote `s[pos]`. Advances `pos` past the closing quote.
+bool parseJsonString(std::string_view s, std::size_t& pos, Field& out) {
+    const std::size_t start = ++pos;
+    out.escaped = false;
+    for (; pos < s.size(); ++pos) {
+        const char c = s[pos];
+        if (c == '"') {
+            if (!out.escaped) out.text = s.substr(start, pos - start);
+            else out.text = out.owned;
+            ++pos;
+            return true;
+        }
+        if (c != '\\') {
+            if (out.escaped) out.owned += c;
+            continue;
+        }
+        if (!out.escaped) {
+            out.owned.assign(s.substr(start, pos - start));
+            out.escaped = true;
+        }
+        if (++pos >= s.size()) return false;
+        switch (s[pos]) {
+        case '"':  out.owned += '"';  break;
+        case '\\': out.owned += '\\'; break;
+        case '/':  out.owned += '/';  break;
+        case 'b':  out.owned += '\b'; break;
+        case 'f':  out.owned += '\f'; break;
+        case 'n':  out.owned += '\n'; break;
+        case 'r':  out.owned += '\r'; break;
+        case 't':  out.owned += '\t'; break;
+        case 'u': {
+            std::uint32_t cp;
+            if (!parseHex4(s, pos + 1, cp)) return false;
+            pos += 4;
+            if (cp >= 0xD800 && cp < 0xDC00) {                       // surrogate pair
+                std::uint32_t low;
+                if (pos + 2 >= s.size() || s[pos + 1] != '\\' || s[pos + 2] != 'u' ||
+                    !parseHex4(s, pos + 3, low) || low < 0xDC00 || low >= 0xE000)
+                    return false;
+                cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                pos += 6;
+            }
+            appendUtf8(out.owned, cp);
+            break;
+        }
+        default:
+            return false;
+        }
+    }
+    return false;
+}
+
+void skipWs(std::string_view s, std::size_t& pos) {
+    while (pos < s.size() && (s[pos] == ' ' || s[pos] == '\t' || s[pos] == '\r')) ++pos;
+}
+
+// Flat JSON object per line: {"movie": "...", "theater": "...", ...}. Other keys may hold strings,
+// numbers, booleans or null and are ignored.
+bool parseJsonLine(std::string_view line, Field& movie, Field& theater) {
+    std::size_t pos = 0;
+    skipWs(line, pos);
+    if (pos >= line.size() || line[pos++] != '{') return false;
+    bool haveMovie = false, haveTheater = false;
+    Field key, other;
+    for (;;) {
+        skipWs(line, pos);
+        if (pos < line.size() && line[pos] == '}' && !haveMovie && !haveTheater) break;   // {}
+        if (pos >= line.size() || line[pos] != '"' || !parseJsonString(line, pos, key)) return false;
+        skipWs(line, pos);
+        if (pos >= line.size() || line[pos++] != ':') return false;
+        skipWs(line, pos);
+        if (pos >= line.size()) return false;
+
+        if (line[pos] == '"') {
+            Field* target = key.text == "movie" ? &movie : key.text == "theater" ? &theater : &other;
+            if (!parseJsonString(line, pos, *target)) return false;
+            haveMovie |= target == &movie;
+            haveTheater |= target == &theater;
+        } else {
+            const std::size_t end = line.find_first_of(",}", pos);
+            if (end == std::string_view::npos) return false;
+            const std::string_view scalar = trim(line.substr(pos, end - pos));
+            if (scalar.empty() || scalar.front() == '{' || scalar.front() == '[') return false;
+            pos = end;
+        }
+        skipWs(line, pos);
+        if (pos < line.size() && line[pos] == ',') { ++pos; continue; }
+        if (pos < line.size() && line[pos] == '}') break;
+        return false;
+    }
+    return haveMovie && haveTheater;
+}
+
+// Lowercases `text` the same way addMovie/addTheater do (std::tolower per byte).
+void lowerInto(std::string_view text, char* out) {
+    for (std::size_t i = 0; i < text.size(); ++i)
+        out[i] = static_cast<char>(std::tolower(static_cast<unsigned char>(text[i])));
+}
+
+std::string_view stash(ParseChunk& chunk, const Field& field) {
+    if (!field.escaped) return field.text;
+    return chunk.arena.emplace_back(field.owned);
+}
+
+std::string_view lowerKey(ParseChunk& chunk, std::string_view text, const std::string& buffer,
+                          const std::string& lowered) {
+    if (text.data() >= buffer.data() && text.data() < buffer.data() + buffer.size())
+        return {lowered.data() + (text.data() - buffer.data()), text.size()};
+    std::string& key = chunk.arena.emplace_back(text.size(), '\0');
+    lowerInto(text, key.data());
+    return key;
+}
+
+// Parses the lines of `chunk` and files each well-formed row under its movie and theater partitions.
+void parseChunk(ParseChunk& chunk, bool json, std::size_t partitions, const std::string& buffer, std::string& lowered) {
+    lowerInto(std::string_view(buffer).substr(chunk.begin, chunk.end - chunk.begin), lowered.data() + chunk.begin);
+    chunk.movieRows.resize(partitions);
+    chunk.theaterRows.resize(partitions);
+
+    const std::hash<std::string_view> hasher;
+    Field movie, theater;
+    std::size_t lineStart = chunk.begin;
+    while (lineStart < chunk.end) {
+        std::size_t lineEnd = buffer.find('\n', lineStart);
+        if (lineEnd == std::string::npos || lineEnd > chunk.end) lineEnd = chunk.end;
+        const std::string_view line = trim(std::string_view(buffer).substr(lineStart, lineEnd - lineStart));
+        lineStart = lineEnd + 1;
+        if (line.empty()) continue;
+
+        ParsedRow row;
+        bool ok;
+        if (json) {
+            ok = parseJsonLine(line, movie, theater);
+        } else {
+            std::size_t pos = 0;
+            ok = nextCsvField(line, pos, movie) && pos <= line.size() && nextCsvField(line, pos, theater);
+        }
+        if (ok) {
+            row.movie = stash(chunk, movie);
+            row.theater = stash(chunk, theater);
+            ok = !trim(row.movie).empty() && !trim(row.theater).empty();
+        }
+        if (!ok) {
+            row.malformed = true;
+            chunk.rows.push_back(row);
+            continue;
+        }
+        row.movieKey = lowerKey(chunk, row.movie, buffer, lowered);
+        row.theaterKey = lowerKey(chunk, row.theater, buffer, lowered);
+        row.movieHash = hasher(row.movieKey);
+        row.theaterHash = hasher(row.theaterKey);
+        const auto index = static_cast<std::uint32_t>(chunk.rows.size());
+        chunk.movieRows[row.movieHash % partitions].push_back(index);
+        chunk.theaterRows[row.theaterHash % partitions].push_back(index);
+        chunk.rows.push_back(row);
+    }
+}
+
+bool looksLikeJsonLines(const std::string& path, const std::string& buffer) {
+    const auto dot = path.rfind('.');
+    if (dot != std::string::npos) {
+        std::string ext = path.substr(dot);
+        std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return std::tolower(c); });
+        if (ext == ".jsonl" || ext == ".ndjson" || ext == ".json") return true;
+        if (ext == ".csv") return false;
+    }
+    const auto first = buffer.find_first_not_of(" \t\r\n");
+    return first != std::string::npos && buffer[first] == '{';
+}
+
+} // namespace
+
+/**
+ * The function `importCatalog` bulk-loads a show schedule: one row per show naming its movie and
+ * theater. Movies and theaters are created on first mention and deduplicated case-insensitively
+ * against the file and the existing catalog, exactly like addMovie/addTheater/createShow.
+ *
+ * Accepted formats (chosen by extension, else by the first character):
+ *  - CSV:   `movie,theater[,ignored...]`, RFC 4180 quoting;
+ *  - JSONL: one flat object per line with string fields "movie" and "theater".
+ *
+ * @param path File to read.
+ * @param csvHeader true if the first non-blank line of a CSV file is a header, not a show; it is
+ * then skipped without being counted. Ignored for JSONL. The one-argument overload reads every
+ * line as data.
+ *
+ * @return Import counters, or std::nullopt if the file cannot be read. Malformed rows are skipped
+ * and counted; everything else is published.
+ *
+ * Parsing and deduplication run in parallel without touching the service; mtx_ is taken
+ * exclusively once, for the publish walk, and catalogEpoch() is bumped once.
+ * Time complexity: O(N / P) parse + O(N / P + C) per dedup partition + O(N) publish for N rows,
+ * P threads, C parse chunks.
+ * Space complexity: O(file size + N).
+ */
+std::optional<BookingService::ImportStats> BookingService::importCatalog(const std::string& path) {
+    return importCatalog(path, false);
+}
+
+std::optional<BookingService::ImportStats> BookingService::importCatalog(const std::string& path, bool csvHeader) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        std::cerr << "Cannot open catalog file: " << path << '\n';
+        return std::nullopt;
+    }
+    std::string buffer((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    std::string lowered(buffer.size(), '\0');
+    const bool json = looksLikeJsonLines(path, buffer);
+
+    // ---- Phase 1: parse newline-aligned chunks in parallel
+    const std::size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    const std::size_t target = std::max(MIN_CHUNK_BYTES, buffer.size() / (threads * 4) + 1);
+    std::size_t dataBegin = 0;
+    while (csvHeader && !json && dataBegin < buffer.size()) {  // skip the first non-blank line
+        const std::size_t lineEnd = std::min(buffer.find('\n', dataBegin), buffer.size());
+        const bool blank = trim(std::string_view(buffer).substr(dataBegin, lineEnd - dataBegin)).empty();
+        dataBegin = lineEnd + 1;
+        if (!blank) break;
+    }
+    std::vector<ParseChunk> chunks;
+    for (std::size_t begin = dataBegin; begin < buffer.size();) {
+        std::size_t end = std::min(buffer.size(), begin + target);
+        if (end < buffer.size()) {
+            end = buffer.find('\n', end);
+            end = end == std::string::npos ? buffer.size() : end + 1;
+        }
+        ParseChunk& chunk = chunks.emplace_back();
+        chunk.begin = begin;
+        chunk.end = end;
+        begin = end;
+    }
+    const std::size_t partitions = threads;
+    parallelFor(chunks.size(), [&](std::size_t c) { parseChunk(chunks[c], json, partitions, buffer, lowered); });
+
+    std::vector<std::size_t> base(chunks.size() + 1, 0);
+    for (std::size_t c = 0; c < chunks.size(); ++c) base[c + 1] = base[c] + chunks[c].rows.size();
+    const std::size_t total = base.back();
+    if (total >= std::numeric_limits<std::uint32_t>::max()) {
+        std::cerr << "Catalog file has too many rows: " << total << '\n';
+        return std::nullopt;
+    }
+
+    // ---- Phase 2: parallel hash build, one partition of the key space per task, each visiting only
+    // the rows filed under it. canon*[g] = index of the first row with the same movie / theater key.
+    // A show is then the pair (canonMovie, canonTheater); firstShow[g] = row g is the first row with
+    // its pair. Chunks are visited in file order, so "first" is the first in the file.
+    std::vector<std::uint32_t> canonMovie(total), canonTheater(total);
+    std::vector<std::uint8_t> firstShow(total, 0);
+    std::vector<std::size_t> uniqueShowsPerPartition(partitions, 0);
+
+    parallelFor(partitions, [&](std::size_t p) {
+        std::unordered_map<HashedKey, std::uint32_t, HashedKeyHash> movies, theaters;
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            const auto first = static_cast<std::uint32_t>(base[c]);
+            for (std::uint32_t i : chunks[c].movieRows[p]) {
+                const ParsedRow& row = chunks[c].rows[i];
+                canonMovie[first + i] = movies.try_emplace({row.movieKey, row.movieHash}, first + i).first->second;
+            }
+            for (std::uint32_t i : chunks[c].theaterRows[p]) {
+                const ParsedRow& row = chunks[c].rows[i];
+                canonTheater[first + i] = theaters.try_emplace({row.theaterKey, row.theaterHash}, first + i).first->second;
+            }
+        }
+    });
+    // Show keys exist only now that both canonical rows are known, so they are filed per chunk here
+    const auto showKey = [&](std::uint32_t g) { return std::uint64_t{canonMovie[g]} << 32 | canonTheater[g]; };
+    parallelFor(chunks.size(), [&](std::size_t c) {
+        ParseChunk& chunk = chunks[c];
+        chunk.showRows.resize(partitions);
+        for (std::uint32_t i = 0; i < chunk.rows.size(); ++i)
+            if (!chunk.rows[i].malformed)
+                chunk.showRows[FlatKeySet::mix(showKey(static_cast<std::uint32_t>(base[c]) + i)) % partitions].push_back(i);
+    });
+    parallelFor(partitions, [&](std::size_t p) {
+        FlatKeySet shows;
+        for (std::size_t c = 0; c < chunks.size(); ++c) {
+            const auto first = static_cast<std::uint32_t>(base[c]);
+            for (std::uint32_t i : chunks[c].showRows[p]) firstShow[first + i] = shows.insert(showKey(first + i));
+        }
+        uniqueShowsPerPartition[p] = shows.size();
+    });
+
+    // ---- Phase 3: publish under one exclusive section, in file order
+    ImportStats stats;
+    std::size_t uniqueShows = 0;
+    for (std::size_t n : uniqueShowsPerPartition) uniqueShows += n;
+    std::vector<int> movieIdOf(total, 0), theaterIdOf(total, 0);   // filled at canonical rows
+
+    std::unique_lock unqLock(mtx_);
+    auto logged = logWriter();
+    showLookup_.reserve(showLookup_.size() + uniqueShows);
+    std::uint32_t g = 0;
+    for (const ParseChunk& chunk : chunks) {
+        for (const ParsedRow& row : chunk.rows) {
+            const std::uint32_t index = g++;
+            ++stats.rows;
+            if (row.malformed) {
+                ++stats.malformedRows;
+                continue;
+            }
+            if (canonMovie[index] == index) {
+                std::string key(row.movieKey);
+                auto it = movieNameToId_.find(key);
+                if (it != movieNameToId_.end()) {
+                    movieIdOf[index] = it->second;
+                } else {
+                    movieIdOf[index] = insertMovieLocked(row.movie, std::move(key));
+                    logged.append({.type = LogRecord::Type::AddMovie, .id = movieIdOf[index], .text = std::string(row.movie)});
+                    ++stats.moviesCreated;
+                }
+            }
+            if (canonTheater[index] == index) {
+                std::string key(row.theaterKey);
+                auto it = theaterNameToId_.find(key);
+                if (it != theaterNameToId_.end()) {
+                    theaterIdOf[index] = it->second;
+                } else {
+                    theaterIdOf[index] = insertTheaterLocked(row.theater, std::move(key));
+                    logged.append({.type = LogRecord::Type::AddTheater, .id = theaterIdOf[index], .text = std::string(row.theater)});
+                    ++stats.theatersCreated;
+                }
+            }
+            if (!firstShow[index]) {
+                ++stats.duplicateShows;
+                continue;
+            }
+            const int movieId = movieIdOf[canonMovie[index]];
+            const int theaterId = theaterIdOf[canonTheater[index]];
+            if (showCounter_.load(std::memory_order_relaxed) == ShowTable::MAX_ID) {
+                ++stats.rejectedCapacity;               // no room left: reported, not silently dropped
+                continue;
+            }
+            auto [slot, fresh] = showLookup_.try_emplace({movieId, theaterId}, 0);
+            if (!fresh) {
+                ++stats.duplicateShows;
+                continue;
+            }
+            logged.reserve();                           // before publishing: bookings of the show log after it
+            slot->second = insertShowLocked(movieId, theaterId);
+            logged.append({.type = LogRecord::Type::CreateShow, .id = slot->second, .movieId = movieId, .theaterId = theaterId});
+            ++stats.showsCreated;
+        }
+    }
+    catalogEpoch_.fetch_add(1, std::memory_order_release);
+    unqLock.unlock();
+
+    if (stats.malformedRows)
+        std::cerr << "Catalog import skipped " << stats.malformedRows << " malformed row(s) in " << path << '\n';
+    if (stats.rejectedCapacity)
+        std::cerr << "Catalog import skipped " << stats.rejectedCapacity << " show(s) in " << path << ": show table is full\n";
+    return stats;
+}
+
+} // namespace booking
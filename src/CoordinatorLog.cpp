@@ -0,0 +1,289 @@
+#include "CoordinatorLog.hpp"
+#include "LocalSocket.hpp"
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fcntl.h>
+#include <iostream>
+#include <unistd.h>
+
+namespace booking {
+
+namespace {
+
+// FNV-1a over the payload; catches torn and zero-filled tails, not tampering.
+std::uint32_t checksum(std::string_view bytes) noexcept {
+    std::uint32_t h = 2166136261u;
+    for (unsigned char c : bytes) {
+        h ^= c;
+        h *= 16777619u;
+    }
+    return h;
+}
+
+bool writeAll(int fd, std::string_view bytes) {
+    while (!bytes.empty()) {
+        const ssize_t n = ::write(fd, bytes.data(), bytes.size());
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        bytes.remove_prefix(static_cast<std::size_t>(n));
+    }
+    return true;
+}
+
+std::string frame(const std::string& payload) {
+    return FrameWriter().put(static_cast<std::uint32_t>(payload.size())).take() + payload +
+           FrameWriter().put(checksum(payload)).take();
+}
+
+std::optional<std::string> readFile(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return errno == ENOENT ? std::optional<std::string>(std::string()) : std::nullopt;
+    std::string bytes;
+    char buf[1 << 16];
+    ssize_t n;
+    while ((n = ::read(fd, buf, sizeof buf)) != 0) {
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0) {
+            ::close(fd);
+            return std::nullopt;
+        }
+        bytes.append(buf, static_cast<std::size_t>(n));
+    }
+    ::close(fd);
+    return bytes;
+}
+
+} // namespace
+
+/**
+ * The function `open` reads an existing coordinator log (or starts an empty one), rebuilds the
+ * set of unfinished transactions and rewrites the file so that it holds only those, plus the
+ * highest transaction ID handed out so far (IDs are never reused across restarts).
+ *
+ * @return The log, or nullptr (with a message on std::cerr) if the file cannot be read or written.
+ *
+ * Time complexity: O(file size)
+ * Space complexity: O(unfinished transactions)
+ */
+std::unique_ptr<CoordinatorLog> CoordinatorLog::open(const std::string& path) {
+    const auto bytes = readFile(path);
+    if (!bytes) {
+        std::cerr << "Cannot read coordinator log: " << path << '\n';
+        return nullptr;
+    }
+    std::unique_ptr<CoordinatorLog> log(new CoordinatorLog(path, -1));
+    if (!log->replay(*bytes)) std::cerr << "Coordinator log " << path << " has a torn tail; ignoring it\n";
+    if (!log->compact()) {
+        std::cerr << "Cannot write coordinator log: " << path << '\n';
+        return nullptr;
+    }
+    return log;
+}
+
+CoordinatorLog::~CoordinatorLog() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+// Applies complete records in order; stops (returning false) at the first torn or corrupt one.
+bool CoordinatorLog::replay(std::string_view bytes) {
+    while (!bytes.empty()) {
+        FrameReader header(bytes);
+        const auto length = header.get<std::uint32_t>();
+        if (header.failed() || bytes.size() < sizeof(std::uint32_t) * 2 + length) return false;
+        const std::string_view payload = bytes.substr(sizeof(std::uint32_t), length);
+        FrameReader trailer(bytes.substr(sizeof(std::uint32_t) + length));
+        if (trailer.get<std::uint32_t>() != checksum(payload)) return false;
+        bytes.remove_prefix(sizeof(std::uint32_t) * 2 + length);
+
+        FrameReader in(payload);
+        const auto type = in.get<std::uint8_t>();
+        const auto txId = in.get<std::uint64_t>();
+        if (in.failed()) return false;
+        lastTxId_ = std::max(lastTxId_, txId);
+        switch (type) {
+        case BEGIN: {
+            Transaction tx;
+            tx.id = txId;
+            tx.customerId = in.get<std::int64_t>();
+            const auto participants = in.get<std::uint32_t>();
+            for (std::uint32_t p = 0; p < participants && !in.failed(); ++p) {
+                Participant participant;
+                participant.path = std::string(in.getString());
+                const auto legs = in.get<std::uint32_t>();
+                for (std::uint32_t l = 0; l < legs && !in.failed(); ++l) {
+                    Leg leg;
+                    leg.showId = in.get<std::int64_t>();
+                    leg.seatMask = in.get<std::uint32_t>();
+                    participant.legs.push_back(leg);
+                }
+                tx.participants.push_back(std::move(participant));
+            }
+            if (in.failed()) return false;
+            open_[txId] = std::move(tx);
+            break;
+        }
+        case DECIDE: {
+            const auto decision = static_cast<Decision>(in.get<std::uint8_t>());
+            if (auto it = open_.find(txId); it != open_.end() && !in.failed()) it->second.decision = decision;
+            break;
+        }
+        case END:
+            open_.erase(txId);
+            break;
+        case WATERMARK:
+            break;
+        default:
+            return false;
+        }
+    }
+    return true;
+}
+
+std::string CoordinatorLog::encodeBegin(const Transaction& tx) {
+    FrameWriter out;
+    out.put<std::uint8_t>(BEGIN).put(tx.id).put<std::int64_t>(tx.customerId)
+       .put(static_cast<std::uint32_t>(tx.participants.size()));
+    for (const Participant& participant : tx.participants) {
+        out.putString(participant.path).put(static_cast<std::uint32_t>(participant.legs.size()));
+        for (const Leg& leg : participant.legs) out.put<std::int64_t>(leg.showId).put(leg.seatMask);
+    }
+    return out.take();
+}
+
+// Writes the surviving state to path.tmp, syncs it and renames it over the log.
+bool CoordinatorLog::compact() {
+    std::string bytes = frame(FrameWriter().put<std::uint8_t>(WATERMARK).put(lastTxId_).take());
+    for (const auto& [id, tx] : open_) {
+        bytes += frame(encodeBegin(tx));
+        if (tx.decision != Decision::Undecided)
+            bytes += frame(FrameWriter().put<std::uint8_t>(DECIDE).put(id).put(tx.decision).take());
+    }
+
+    const std::string tmpPath = path_ + ".tmp";
+    const int tmp = ::open(tmpPath.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    if (tmp < 0) return false;
+    const bool written = writeAll(tmp, bytes) && ::fsync(tmp) == 0;
+    ::close(tmp);
+    if (!written || std::rename(tmpPath.c_str(), path_.c_str()) != 0) {
+        std::remove(tmpPath.c_str());
+        return false;
+    }
+    if (fd_ >= 0) ::close(fd_);
+    fd_ = ::open(path_.c_str(), O_WRONLY | O_APPEND | O_CLOEXEC);
+    size_ = bytes.size();
+    compactAt_ = std::max(COMPACT_BYTES, 2 * size_);
+    broken_ = fd_ < 0;
+    return fd_ >= 0;
+}
+
+/**
+ * The function `append` adds one record, synced if `force`. If the write or the sync fails, the
+ * file is truncated back to the end of the previous record: a torn record left in the middle would
+ * make open() drop every record after it, a committed decision among them.
+ *
+ * @return false if the record was not (durably, with `force`) written; the file is then as before.
+ *
+ * Time complexity: O(record)
+ * Space complexity: O(record)
+ */
+bool CoordinatorLog::append(const std::string& payload, bool force) {
+    if (broken_) return false;
+    const std::string bytes = frame(payload);
+    if (!writeAll(fd_, bytes) || (force && ::fdatasync(fd_) != 0)) {
+        if (::ftruncate(fd_, static_cast<off_t>(size_)) != 0) {
+            std::cerr << "Cannot cut a failed record off coordinator log " << path_ << "; refusing further records\n";
+            broken_ = true;
+        }
+        return false;
+    }
+    size_ += bytes.size();
+    return true;
+}
+
+// Rewrites the file once it has doubled since the last rewrite. Called after open_ reflects the
+// last record, so the rewrite keeps it; a failed rewrite leaves the current file in use.
+void CoordinatorLog::compactIfGrown() {
+    if (size_ >= compactAt_ && !compact()) std::cerr << "Cannot compact coordinator log: " << path_ << '\n';
+}
+
+/**
+ * The function `begin` assigns a transaction ID and durably records the participants and the
+ * seats each will hold, before any of them is asked to prepare.
+ *
+ * @return The transaction ID, or std::nullopt if the record could not be made durable.
+ *
+ * Time complexity: O(legs) + one fdatasync.
+ * Space complexity: O(legs)
+ */
+std::optional<std::uint64_t> CoordinatorLog::begin(long long customerId, std::vector<Participant> participants) {
+    std::lock_guard lock(mtx_);
+    Transaction tx{++lastTxId_, customerId, std::move(participants), Decision::Undecided};
+    if (!append(encodeBegin(tx), true)) {
+        std::cerr << "Cannot write coordinator log: " << path_ << '\n';
+        return std::nullopt;
+    }
+    const std::uint64_t id = tx.id;
+    open_.emplace(id, std::move(tx));
+    compactIfGrown();
+    return id;
+}
+
+/**
+ * The function `decide` records the outcome of a transaction. A commit decision is synced before
+ * returning: only then may participants be told to commit. An abort is not synced; if it is lost,
+ * recovery presumes abort anyway.
+ *
+ * @return false if the decision could not be written (a commit must then be treated as aborted).
+ */
+bool CoordinatorLog::decide(std::uint64_t txId, Decision decision) {
+    std::lock_guard lock(mtx_);
+    auto it = open_.find(txId);
+    if (it == open_.end()) return false;
+    if (!append(FrameWriter().put<std::uint8_t>(DECIDE).put(txId).put(decision).take(), decision == Decision::Commit)) {
+        std::cerr << "Cannot write coordinator log: " << path_ << '\n';
+        return false;
+    }
+    it->second.decision = decision;
+    compactIfGrown();
+    return true;
+}
+
+// Marks a transaction finished on every participant. Not synced: a lost END only means
+// recovery repeats an outcome the participants already applied.
+bool CoordinatorLog::end(std::uint64_t txId) {
+    std::lock_guard lock(mtx_);
+    if (open_.erase(txId) == 0) return false;
+    const bool written = append(FrameWriter().put<std::uint8_t>(END).put(txId).take(), false);
+    compactIfGrown();
+    return written;
+}
+
+/**
+ * The function `endedBelow` returns a watermark such that every transaction with a lower ID has
+ * ended, after syncing the log so that those END records survive a crash. Participants may then
+ * forget the outcomes of those transactions: recovery will never ask for them again.
+ *
+ * @return The lowest unfinished ID (the next ID if none is open), or std::nullopt if the log
+ * cannot be synced.
+ *
+ * Time complexity: O(1) + one fdatasync.
+ */
+std::optional<std::uint64_t> CoordinatorLog::endedBelow() {
+    std::lock_guard lock(mtx_);
+    if (broken_ || ::fdatasync(fd_) != 0) {
+        std::cerr << "Cannot sync coordinator log: " << path_ << '\n';
+        return std::nullopt;
+    }
+    return open_.empty() ? lastTxId_ + 1 : open_.begin()->first;
+}
+
+std::vector<CoordinatorLog::Transaction> CoordinatorLog::unfinished() const {
+    std::lock_guard lock(mtx_);
+    std::vector<Transaction> out;
+    out.reserve(open_.size());
+    for (const auto& [id, tx] : open_) out.push_back(tx);
+    return out;
+}
+
+} // namespace booking
@@ -0,0 +1,150 @@
+#include "DeadlineScheduler.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace booking {
+
+namespace {
+constexpr double SERVICE_EWMA_WEIGHT = 0.1;   // Weight of the newest sample in serviceEstimate_
+
+std::uint64_t nanos(DeadlineScheduler::Clock::duration d) {
+    return static_cast<std::uint64_t>(std::max<std::int64_t>(0, std::chrono::duration_cast<std::chrono::nanoseconds>(d).count()));
+}
+
+} // namespace
+
+// Runs onShed callbacks collected under mtx_, after releasing it.
+void DeadlineScheduler::runShed(std::vector<Shed>& shed) {
+    for (auto& s : shed)
+        if (s.onShed) s.onShed(s.reason);
+    shed.clear();
+}
+
+DeadlineScheduler::DeadlineScheduler(WorkStealingPool& pool, const Options& options)
+    : pool_(pool), options_(options),
+      limit_(static_cast<double>(std::clamp(options.initialLimit, std::max<std::size_t>(1, options.minLimit), options.maxLimit))) {}
+
+DeadlineScheduler::~DeadlineScheduler() {
+    std::vector<Shed> shed;
+    std::unique_lock lock(mtx_);
+    while (!queue_.empty()) {
+        auto& top = const_cast<Request&>(queue_.top());
+        shed.push_back({std::move(top.onShed), ShedReason::Deadline, top.sequence});
+        ++metrics_.shedDeadline;
+        queue_.pop();
+    }
+    drained_.wait(lock, [&] { return inFlight_ == 0; });
+    lock.unlock();
+    runShed(shed);
+}
+
+/**
+ * The function `submit` queues a request by deadline and starts as many queued requests as the
+ * concurrency limit allows. A request arriving to a full queue is shed at once.
+ *
+ * @return false if the request was shed before this call returned.
+ *
+ * Time complexity: O(log Q) for Q queued requests, plus O(log Q) per request started or shed.
+ * Space complexity: O(1) per queued request.
+ */
+bool DeadlineScheduler::submit(Clock::time_point deadline, Job job, std::function<void(ShedReason)> onShed,
+                               std::size_t affinity) {
+    std::vector<Shed> shed;
+    bool accepted = true;
+    {
+        std::lock_guard lock(mtx_);
+        ++metrics_.submitted;
+        if (queue_.size() >= options_.maxQueued) {
+            ++metrics_.shedQueueFull;
+            shed.push_back({std::move(onShed), ShedReason::QueueFull, 0});
+            accepted = false;
+        } else {
+            const std::uint64_t sequence = sequence_++;
+            queue_.push(Request{deadline, Clock::now(), sequence, std::move(job), std::move(onShed), affinity});
+            dispatchLocked(shed);
+            accepted = std::none_of(shed.begin(), shed.end(), [&](const Shed& s) { return s.sequence == sequence; });
+        }
+    }
+    runShed(shed);
+    return accepted;
+}
+
+/**
+ * The function `dispatchLocked` hands queued requests to the pool, earliest deadline first, while
+ * fewer than limit() are in flight. A request that would finish after its deadline at the
+ * current service-time estimate is shed instead, which frees its place for the next one.
+ *
+ * Time complexity: O(log Q) per request started or shed.
+ * Space complexity: O(1)
+ */
+void DeadlineScheduler::dispatchLocked(std::vector<Shed>& shed) {
+    const auto now = Clock::now();
+    const auto expected = std::chrono::nanoseconds(static_cast<std::int64_t>(serviceEstimate_));
+    while (!queue_.empty()) {
+        const bool hopeless = now + expected > queue_.top().deadline;
+        if (!hopeless && inFlight_ >= static_cast<std::size_t>(limit_)) break;
+        // The top has the earliest deadline: hopeless requests surface there and are shed even
+        // while the limit is reached, so their clients hear back without waiting for a slot.
+        Request request = std::move(const_cast<Request&>(queue_.top()));
+        queue_.pop();
+        if (hopeless) {
+            ++metrics_.shedDeadline;
+            shed.push_back({std::move(request.onShed), ShedReason::Deadline, request.sequence});
+            continue;
+        }
+        ++inFlight_;
+        const std::size_t affinity = request.affinity;
+        pool_.submit([this, r = std::move(request)]() mutable { run(std::move(r), Clock::now()); }, affinity);
+    }
+}
+
+void DeadlineScheduler::run(Request request, Clock::time_point started) {
+    request.job();
+    const auto finished = Clock::now();
+
+    std::vector<Shed> shed;
+    {
+        std::lock_guard lock(mtx_);
+        const auto waited = started - request.submitted;
+        const bool late = finished > request.deadline;
+        metrics_.queueTime.record(nanos(waited));
+        metrics_.serviceTime.record(nanos(finished - started));
+        ++metrics_.completed;
+        if (late) ++metrics_.lateCompletions;
+        const double sample = static_cast<double>(nanos(finished - started));
+        serviceEstimate_ = serviceEstimate_ == 0 ? sample : serviceEstimate_ + SERVICE_EWMA_WEIGHT * (sample - serviceEstimate_);
+        adaptLocked(late || waited > options_.targetQueueTime, finished);
+        --inFlight_;
+        dispatchLocked(shed);
+        if (inFlight_ == 0) drained_.notify_all();
+    }
+    runShed(shed);
+}
+
+// AIMD step after one completion.
+void DeadlineScheduler::adaptLocked(bool congested, Clock::time_point now) {
+    const auto lo = static_cast<double>(std::max<std::size_t>(1, options_.minLimit));
+    const auto hi = static_cast<double>(options_.maxLimit);
+    if (!congested) {
+        limit_ = std::min(hi, limit_ + 1.0 / limit_);
+    } else if (now - lastDecrease_ >= options_.targetQueueTime) {
+        limit_ = std::max(lo, limit_ * options_.backoff);
+        lastDecrease_ = now;
+    }
+}
+
+DeadlineScheduler::Metrics DeadlineScheduler::metrics() const {
+    std::lock_guard lock(mtx_);
+    Metrics out = metrics_;
+    out.limit = static_cast<std::size_t>(limit_);
+    out.inFlight = inFlight_;
+    out.queued = queue_.size();
+    return out;
+}
+
+std::size_t DeadlineScheduler::limit() const {
+    std::lock_guard lock(mtx_);
+    return static_cast<std::size_t>(limit_);
+}
+
+} // namespace booking
@@ -0,0 +1,184 @@
+#include "EpochManager.hpp"
+#include <algorithm>
+#include <unordered_map>
+
+namespace booking {
+
+namespace {
+// Live managers by ID. Thread-local state may outlive the manager it was registered with,
+// so releasing a participant at thread exit goes through this registry.
+std::mutex& registryMutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::unordered_map<std::uint64_t, EpochManager*>& registry() {
+    static std::unordered_map<std::uint64_t, EpochManager*> r;
+    return r;
+}
+
+std::atomic<std::uint64_t> g_nextManagerId{1};
+
+constexpr std::size_t RECLAIM_THRESHOLD = 64;   // retire() tries to reclaim at this many pending objects
+} // namespace
+
+// Participants the calling thread holds, one per manager it has pinned. Usually a single entry.
+struct EpochManager::ThreadState {
+    struct Entry {
+        std::uint64_t owner;
+        Participant* participant;
+    };
+    std::vector<Entry> entries;
+
+    ~ThreadState() {
+        std::lock_guard<std::mutex> guard(registryMutex());
+        for (const auto& e : entries)
+            if (registry().count(e.owner))
+                e.participant->claimed.store(false, std::memory_order_release);
+    }
+};
+
+EpochManager::EpochManager() : id_(g_nextManagerId.fetch_add(1, std::memory_order_relaxed)) {
+    std::lock_guard<std::mutex> guard(registryMutex());
+    registry().emplace(id_, this);
+}
+
+EpochManager::~EpochManager() {
+    {
+        std::lock_guard<std::mutex> guard(registryMutex());
+        registry().erase(id_);
+    }
+    for (const auto& r : retired_) r.deleter(r.context, r.object);
+    for (Participant* p = participants_.load(std::memory_order_relaxed); p;) {
+        Participant* next = p->next;
+        delete p;
+        p = next;
+    }
+}
+
+EpochManager::ThreadState& EpochManager::localState() {
+    thread_local ThreadState state;
+    return state;
+}
+
+/**
+ * The function `claimParticipant` reuses a released participant record or links a new one.
+ *
+ * Time complexity: O(P) for P records ever created (bounded by the peak thread count).
+ * Space complexity: O(1) amortized.
+ */
+EpochManager::Participant* EpochManager::claimParticipant() {
+    for (Participant* p = participants_.load(std::memory_order_acquire); p; p = p->next) {
+        bool expected = false;
+        if (!p->claimed.load(std::memory_order_relaxed) &&
+            p->claimed.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+            return p;
+    }
+    auto* fresh = new Participant;
+    fresh->claimed.store(true, std::memory_order_relaxed);
+    fresh->next = participants_.load(std::memory_order_relaxed);
+    while (!participants_.compare_exchange_weak(fresh->next, fresh, std::memory_order_release,
+                                                std::memory_order_relaxed)) {}
+    return fresh;
+}
+
+/**
+ * The function `pin` enters a read-side critical section: until the guard is destroyed, no object
+ * retired after this call is freed.
+ *
+ * Time complexity: O(1) on the fast path (thread already registered with this manager).
+ * Space complexity: O(1)
+ */
+EpochManager::Guard EpochManager::pin() {
+    ThreadState& state = localState();
+    ThreadState::Entry* entry = nullptr;
+    for (auto& e : state.entries)
+        if (e.owner == id_) { entry = &e; break; }
+
+    if (!entry) {
+        // Slow path, once per (thread, manager): drop entries of destroyed managers first.
+        {
+            std::lock_guard<std::mutex> guard(registryMutex());
+            state.entries.erase(std::remove_if(state.entries.begin(), state.entries.end(),
+                                               [](const ThreadState::Entry& e) { return !registry().count(e.owner); }),
+                                state.entries.end());
+        }
+        state.entries.push_back({id_, claimParticipant()});
+        entry = &state.entries.back();
+    }
+
+    Participant* participant = entry->participant;
+    if (participant->depth++ == 0) {
+        participant->epoch.store(global_.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_seq_cst);   // publish before reading shared pointers
+    }
+    return Guard(participant);
+}
+
+EpochManager::Guard::~Guard() {
+    if (participant_ && --participant_->depth == 0)
+        participant_->epoch.store(0, std::memory_order_release);
+}
+
+/**
+ * The function `retire` schedules `deleter(context, object)` for when no pinned thread can reference
+ * `object` any more. The caller must already have unlinked the object from every shared structure.
+ *
+ * Time complexity: O(1) amortized; O(P + R) when the pending list crosses RECLAIM_THRESHOLD.
+ * Space complexity: O(1) per retired object.
+ */
+void EpochManager::retire(void* object, void (*deleter)(void* context, void* object), void* context) {
+    std::lock_guard<std::mutex> guard(retiredMtx_);
+    retired_.push_back({object, deleter, context, global_.load(std::memory_order_acquire)});
+    if (retired_.size() >= RECLAIM_THRESHOLD) {
+        tryAdvance();
+        freeExpired();
+    }
+}
+
+/**
+ * The function `tryAdvance` moves the global epoch forward if every pinned participant has
+ * observed the current epoch.
+ *
+ * Time complexity: O(P)
+ * Space complexity: O(1)
+ */
+bool EpochManager::tryAdvance() {
+    std::uint64_t current = global_.load(std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    for (Participant* p = participants_.load(std::memory_order_acquire); p; p = p->next) {
+        const std::uint64_t e = p->epoch.load(std::memory_order_acquire);
+        if (e != 0 && e != current) return false;
+    }
+    return global_.compare_exchange_strong(current, current + 1, std::memory_order_acq_rel);
+}
+
+std::size_t EpochManager::freeExpired() {
+    const std::uint64_t now = global_.load(std::memory_order_acquire);
+    auto split = std::partition(retired_.begin(), retired_.end(),
+                                [now](const Retired& r) { return r.epoch + 2 > now; });
+    const auto freed = static_cast<std::size_t>(retired_.end() - split);
+    for (auto it = split; it != retired_.end(); ++it) it->deleter(it->context, it->object);
+    retired_.erase(split, retired_.end());
+    return freed;
+}
+
+/**
+ * The function `reclaim` advances the epoch as far as pinned threads allow (at most twice) and
+ * frees every retired object that is no longer reachable.
+ *
+ * Time complexity: O(P + R) for P participants and R retired objects.
+ * Space complexity: O(1)
+ */
+std::size_t EpochManager::reclaim() {
+    std::lock_guard<std::mutex> guard(retiredMtx_);
+    if (tryAdvance()) tryAdvance();
+    return freeExpired();
+}
+
+std::size_t EpochManager::pending() const {
+    std::lock_guard<std::mutex> guard(retiredMtx_);
+    return retired_.size();
+}
+
+} // namespace booking
@@ -0,0 +1,101 @@
+#include "EventLoop.hpp"
+#include <iostream>
+
+namespace booking {
+
+namespace {
+thread_local EventLoop* t_currentLoop = nullptr;
+}
+
+// Fire-and-forget coroutine wrapping a spawned task; its frame frees itself when done.
+struct EventLoop::Detached {
+    struct promise_type {
+        Detached get_return_object() noexcept {
+            return {std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_never final_suspend() noexcept { return {}; }
+        void return_void() noexcept {}
+        void unhandled_exception() noexcept {
+            std::cerr << "Unhandled exception in spawned task\n";
+        }
+    };
+    std::coroutine_handle<promise_type> handle;
+};
+
+EventLoop::Detached EventLoop::launch(EventLoop& loop, Task<void> task) {
+    try {
+        co_await std::move(task);
+    } catch (const std::exception& e) {
+        std::cerr << "Spawned task failed: " << e.what() << '\n';
+    } catch (...) {
+        std::cerr << "Spawned task failed with an unknown error\n";
+    }
+    std::lock_guard<std::mutex> guard(loop.mtx_);
+    --loop.outstanding_;
+    loop.cv_.notify_all();
+}
+
+EventLoop* EventLoop::current() noexcept {
+    return t_currentLoop;
+}
+
+/**
+ * The function `post` queues a suspended coroutine to be resumed by this loop's thread.
+ * Safe to call from any thread.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+void EventLoop::post(std::coroutine_handle<> h) {
+    // Notify under the lock: once unlocked, the loop may finish run() and be destroyed.
+    std::lock_guard<std::mutex> guard(mtx_);
+    ready_.push_back(h);
+    cv_.notify_one();
+}
+
+/**
+ * The function `spawn` starts `task` on this loop without waiting for it. The task begins
+ * running on the next iteration of run().
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1) plus the coroutine frame.
+ */
+void EventLoop::spawn(Task<void> task) {
+    Detached d = launch(*this, std::move(task));
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        ++outstanding_;
+    }
+    post(d.handle);
+}
+
+/**
+ * The function `run` resumes ready coroutines on the calling thread until every spawned task has
+ * completed. When nothing is ready but tasks are still suspended (waiting for another loop to post
+ * them back), the thread sleeps on a condition variable; individual waiters never own a thread.
+ *
+ * @return Number of coroutine resumptions performed.
+ *
+ * Time complexity: O(R) for R resumptions.
+ * Space complexity: O(Q) for the ready queue.
+ */
+std::size_t EventLoop::run() {
+    EventLoop* previous = std::exchange(t_currentLoop, this);
+    std::size_t resumed = 0;
+    std::unique_lock<std::mutex> lk(mtx_);
+    for (;;) {
+        cv_.wait(lk, [this] { return !ready_.empty() || outstanding_ == 0; });
+        if (ready_.empty()) break;   // outstanding_ == 0
+        auto h = ready_.front();
+        ready_.pop_front();
+        lk.unlock();
+        h.resume();
+        ++resumed;
+        lk.lock();
+    }
+    t_currentLoop = previous;
+    return resumed;
+}
+
+} // namespace booking
@@ -0,0 +1,216 @@
+#include "FlashSaleGate.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+namespace booking {
+
+/**
+ * The function `enableQueue` flags a show as high-demand: from now on bookings for it go through
+ * its virtual queue. The token bucket starts full, so the first `burst` arrivals are admitted
+ * at once.
+ *
+ * @return false (with a message on std::cerr) if the show does not exist, is already flagged or
+ * the config admits nothing.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1) per flagged show, plus O(admitPerSecond * admitWindow) while selling.
+ */
+bool FlashSaleGate::enableQueue(long long showId, const Config& config, Clock::time_point now) {
+    if (config.capacity == 0 || config.burst == 0 || !(config.admitPerSecond > 0)) {
+        std::cerr << "Invalid queue config for show " << showId << '\n';
+        return false;
+    }
+    try {
+        (void)service_.getAvailableSeatCount(showId);
+    } catch (const std::invalid_argument&) {
+        std::cerr << "Invalid show ID: " << showId << '\n';
+        return false;
+    }
+    std::random_device rd;
+    const std::uint64_t salt = (std::uint64_t{rd()} << 32) ^ rd();
+
+    std::unique_lock lock(mtx_);
+    if (!queues_.try_emplace(showId, std::make_shared<Queue>(config, salt, now)).second) {
+        std::cerr << "Show " << showId << " is already queued\n";
+        return false;
+    }
+    return true;
+}
+
+bool FlashSaleGate::disableQueue(long long showId) {
+    std::unique_lock lock(mtx_);
+    return queues_.erase(showId) != 0;
+}
+
+bool FlashSaleGate::isQueued(long long showId) const {
+    return findQueue(showId) != nullptr;
+}
+
+std::shared_ptr<FlashSaleGate::Queue> FlashSaleGate::findQueue(long long showId) const {
+    std::shared_lock lock(mtx_);
+    auto it = queues_.find(showId);
+    return it == queues_.end() ? nullptr : it->second;
+}
+
+// Removed shows have nothing left to sell either.
+bool FlashSaleGate::soldOut(long long showId) const {
+    try {
+        return service_.getAvailableSeatCount(showId) == 0;
+    } catch (const std::invalid_argument&) {
+        return true;
+    }
+}
+
+std::uint64_t FlashSaleGate::tagFor(const Queue& q, long long showId, std::uint64_t position) noexcept {
+    std::uint64_t x = q.salt ^ (static_cast<std::uint64_t>(showId) * 0x9e3779b97f4a7c15ULL) ^ position;
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return x;
+}
+
+/**
+ * The function `advanceLocked` brings a queue up to `now`: refills the token bucket for the time
+ * elapsed, admits as many waiting positions as it holds tokens, and lapses the batches admitted
+ * more than admitWindow ago. Each admission that admits anything appends one batch, so the
+ * bookkeeping is bounded by the admissions made within one window.
+ *
+ * Time complexity: O(1) amortized.
+ * Space complexity: O(1) amortized.
+ */
+void FlashSaleGate::advanceLocked(Queue& q, Clock::time_point now) {
+    // Positions waiting since the last call would have been admitted as tokens arrived, so only
+    // what is left over after admitting them is capped at `burst`.
+    if (now > q.refilled) {
+        q.tokens += std::chrono::duration<double>(now - q.refilled).count() * q.config.admitPerSecond;
+        q.refilled = now;
+    }
+    const auto admit = std::min<std::uint64_t>(q.issued - q.admitted, static_cast<std::uint64_t>(std::floor(q.tokens + 1e-9)));   // absorb rounding of elapsed * rate
+    q.tokens = std::min(static_cast<double>(q.config.burst), q.tokens - static_cast<double>(admit));
+    if (admit > 0) {
+        q.admitted += admit;
+        q.batches.emplace_back(q.admitted, now);
+        q.spent.resize(q.admitted - q.lapsed, false);
+    }
+    while (!q.batches.empty() && now - q.batches.front().second >= q.config.admitWindow) {
+        const std::uint64_t end = q.batches.front().first;
+        q.spent.erase(q.spent.begin(), q.spent.begin() + static_cast<std::ptrdiff_t>(end - q.lapsed));
+        q.lapsed = end;
+        q.batches.pop_front();
+    }
+}
+
+FlashSaleGate::Admission FlashSaleGate::stateLocked(const Queue& q, const Token& token) {
+    Admission out;
+    if (token.position >= q.issued || token.tag != tagFor(q, token.showId, token.position)) return out;
+    out.token = token;
+    if (token.position < q.lapsed) {
+        out.status = Status::Expired;
+    } else if (token.position < q.admitted) {
+        out.status = q.spent[token.position - q.lapsed] ? Status::Expired : Status::Admitted;
+    } else {
+        out.status = Status::Waiting;
+        out.ahead = token.position - q.admitted;
+        out.estimatedWait = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(out.ahead + 1) / q.config.admitPerSecond));
+    }
+    return out;
+}
+
+/**
+ * The function `join` hands out the next position in a flagged show's queue. A sold-out show and
+ * a full queue are refused at once, without taking a position.
+ *
+ * @return Waiting with the number of positions ahead, or Admitted if the bucket had a token
+ * spare; SoldOut, QueueFull, or Invalid for a show that is not flagged.
+ *
+ * Time complexity: O(1) amortized.
+ * Space complexity: O(1)
+ */
+FlashSaleGate::Admission FlashSaleGate::join(long long showId, Clock::time_point now) {
+    auto q = findQueue(showId);
+    if (!q) {
+        std::cerr << "Show " << showId << " has no queue\n";
+        return {};
+    }
+    if (soldOut(showId)) return Admission{.status = Status::SoldOut, .token = {}};
+
+    std::lock_guard lock(q->mtx);
+    advanceLocked(*q, now);
+    if (q->issued - q->admitted >= q->config.capacity) return Admission{.status = Status::QueueFull, .token = {}};
+    const Token token{showId, q->issued, tagFor(*q, showId, q->issued)};
+    ++q->issued;
+    advanceLocked(*q, now);
+    return stateLocked(*q, token);
+}
+
+/**
+ * The function `poll` reports where a token stands. Once the show sells out every token that
+ * has not been spent reads SoldOut, so waiting clients can give up.
+ *
+ * Time complexity: O(1) amortized.
+ * Space complexity: O(1)
+ */
+FlashSaleGate::Admission FlashSaleGate::poll(const Token& token, Clock::time_point now) {
+    auto q = findQueue(token.showId);
+    if (!q) return {};
+    const bool gone = soldOut(token.showId);
+
+    std::lock_guard lock(q->mtx);
+    advanceLocked(*q, now);
+    Admission state = stateLocked(*q, token);
+    if (gone && (state.status == Status::Waiting || state.status == Status::Admitted)) return {Status::SoldOut, token};
+    return state;
+}
+
+/**
+ * The function `bookSeats` books seats with an admitted token. The token is spent by a successful
+ * booking; after a failed one (a seat was taken meanwhile) it stays admitted for another try
+ * until it lapses. Concurrent calls with the same token cannot both book.
+ *
+ * @return true if the seats were booked; false (with a message on std::cerr) if the token is not
+ * admitted or the show is sold out, or as BookingService::bookSeats().
+ *
+ * Time complexity: O(1) amortized plus the booking.
+ * Space complexity: O(1)
+ */
+bool FlashSaleGate::bookSeats(const Token& token, const std::vector<std::string>& seatLabels, Clock::time_point now) {
+    auto q = findQueue(token.showId);
+    if (!q) {
+        std::cerr << "Show " << token.showId << " has no queue\n";
+        return false;
+    }
+    if (soldOut(token.showId)) {
+        std::cerr << "Show " << token.showId << " is sold out\n";
+        return false;
+    }
+    {
+        std::lock_guard lock(q->mtx);
+        advanceLocked(*q, now);
+        if (stateLocked(*q, token).status != Status::Admitted) {
+            std::cerr << "Token " << token.position << " for show " << token.showId << " is not admitted\n";
+            return false;
+        }
+        q->spent[token.position - q->lapsed] = true;
+    }
+
+    const bool booked = service_.bookSeats(token.showId, seatLabels);
+    if (!booked) {
+        std::lock_guard lock(q->mtx);
+        if (token.position >= q->lapsed && token.position < q->admitted) q->spent[token.position - q->lapsed] = false;
+    }
+    return booked;
+}
+
+bool FlashSaleGate::bookSeats(long long showId, const std::vector<std::string>& seatLabels) {
+    if (isQueued(showId)) {
+        std::cerr << "Show " << showId << " is queued; join its queue first\n";
+        return false;
+    }
+    return service_.bookSeats(showId, seatLabels);
+}
+
+} // namespace booking
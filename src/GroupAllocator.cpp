@@ -0,0 +1,222 @@
+#include "GroupAllocator.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstdlib>
+#include <numeric>
+#include <stdexcept>
+
+namespace booking {
+
+namespace {
+
+constexpr long long ORPHAN_COST = 1'000'000;   // One orphan outweighs any alignment difference
+
+struct Run {
+    int first;
+    int length;
+};
+
+std::uint64_t lowBits(int n) noexcept {
+    return n >= 64 ? ~std::uint64_t{0} : (std::uint64_t{1} << n) - 1;
+}
+
+// Maximal runs of free seats in one row, left to right.
+std::vector<Run> freeRuns(std::uint64_t free) {
+    std::vector<Run> runs;
+    while (free) {
+        const int first = std::countr_zero(free);
+        const int length = std::countr_one(free >> first);
+        runs.push_back({first, length});
+        free &= ~(lowBits(length) << first);
+    }
+    return runs;
+}
+
+int orphansAround(const Run& run, int firstSeat, int count) noexcept {
+    const int left = firstSeat - run.first;
+    const int right = run.first + run.length - (firstSeat + count);
+    return (left == 1) + (right == 1);
+}
+
+// Splits `partySize` over rows whose longest runs are `caps` as evenly as the caps allow: every
+// row gets min(cap, t) for the smallest t that seats everyone, and the surplus is taken back
+// from the rows at t. Empty if the rows cannot hold the party.
+std::vector<int> evenSplit(const std::vector<int>& caps, int partySize) {
+    int total = 0;
+    for (int cap : caps) {
+        if (cap == 0) return {};
+        total += cap;
+    }
+    if (total < partySize) return {};
+    int level = 1;
+    for (;; ++level) {
+        int seated = 0;
+        for (int cap : caps) seated += std::min(cap, level);
+        if (seated >= partySize) {
+            total = seated;
+            break;
+        }
+    }
+    std::vector<int> split;
+    for (int cap : caps) split.push_back(std::min(cap, level));
+    for (std::size_t i = split.size(); i-- > 0 && total > partySize;)
+        if (split[i] == level) {
+            --split[i];
+            --total;
+        }
+    return split;
+}
+
+} // namespace
+
+// ----------------- Seat Map -----------------
+SeatMap::SeatMap(int rows, int seatsPerRow)
+    : seatsPerRow_(seatsPerRow), rowMask_(lowBits(seatsPerRow)) {
+    if (rows <= 0 || seatsPerRow <= 0 || seatsPerRow > MAX_SEATS_PER_ROW) throw std::invalid_argument("Invalid seat map size");
+    booked_.assign(static_cast<std::size_t>(rows), 0);
+}
+
+bool SeatMap::book(int row, std::uint64_t seats) {
+    if (row < 0 || row >= rows() || (seats & ~freeMask(row))) return false;
+    booked_[static_cast<std::size_t>(row)] |= seats;
+    return true;
+}
+
+void SeatMap::release(int row, std::uint64_t seats) noexcept {
+    if (row >= 0 && row < rows()) booked_[static_cast<std::size_t>(row)] &= ~seats;
+}
+
+int SeatMap::freeSeats() const noexcept {
+    int n = 0;
+    for (int r = 0; r < rows(); ++r) n += std::popcount(freeMask(r));
+    return n;
+}
+
+int SeatMap::orphanSeats() const noexcept {
+    int n = 0;
+    for (int r = 0; r < rows(); ++r) {
+        const std::uint64_t free = freeMask(r);
+        n += std::popcount(free & ~(free << 1) & ~(free >> 1));
+    }
+    return n;
+}
+
+// ----------------- Group Allocator -----------------
+/**
+ * The function `place` finds where to seat a party of `partySize`: in the fewest adjacent rows
+ * that can hold it, at the candidate leaving the fewest orphan seats, then best aligned (each
+ * block centred under the first, the first centred in its row), then frontmost.
+ *
+ * @return The placement, or std::nullopt if no window of at most partySize rows can hold it.
+ *
+ * Time complexity: O(R * W) bit scans to list the runs, then O(R * k * W) per row count k tried,
+ * R rows, W free runs per row.
+ * Space complexity: O(R * W)
+ */
+std::optional<GroupPlacement> GroupAllocator::place(const SeatMap& map, int partySize) {
+    if (partySize <= 0) return std::nullopt;
+    std::vector<std::vector<Run>> runs(static_cast<std::size_t>(map.rows()));
+    std::vector<int> longest(runs.size(), 0);
+    for (int r = 0; r < map.rows(); ++r) {
+        runs[r] = freeRuns(map.freeMask(r));
+        for (const Run& run : runs[r]) longest[r] = std::max(longest[r], run.length);
+    }
+    if (std::accumulate(longest.begin(), longest.end(), 0) < partySize) return std::nullopt;
+
+    const int centre2 = map.seatsPerRow();   // Row centre in half seats
+    const int minRows = (partySize + map.seatsPerRow() - 1) / map.seatsPerRow();
+    for (int k = minRows; k <= std::min(partySize, map.rows()); ++k) {
+        std::optional<GroupPlacement> best;
+        long long bestCost = 0;
+        for (int start = 0; start + k <= map.rows(); ++start) {
+            const auto split = evenSplit({longest.begin() + start, longest.begin() + start + k}, partySize);
+            if (split.empty()) continue;
+
+            GroupPlacement placement;
+            long long cost = 0;
+            int reference2 = centre2;
+            for (int i = 0; i < k; ++i) {
+                const int row = start + i;
+                const int count = split[static_cast<std::size_t>(i)];
+                long long rowBest = -1;
+                GroupPlacement::Block block{};
+                int blockOrphans = 0;
+                for (const Run& run : runs[row]) {
+                    if (run.length < count) continue;
+                    const int last = run.first + run.length - count;
+                    const int centred = std::clamp((reference2 - count) / 2, run.first, last);
+                    for (int seat : {run.first, last, centred, std::clamp(centred - 1, run.first, last),
+                                     std::clamp(centred + 1, run.first, last)}) {
+                        const int orphans = orphansAround(run, seat, count);
+                        const long long c = orphans * ORPHAN_COST + std::abs(2 * seat + count - reference2);
+                        if (rowBest < 0 || c < rowBest) {
+                            rowBest = c;
+                            block = {row, seat, count};
+                            blockOrphans = orphans;
+                        }
+                    }
+                }
+                cost += rowBest;
+                placement.orphans += blockOrphans;
+                placement.blocks.push_back(block);
+                if (i == 0) reference2 = 2 * block.firstSeat + block.count;
+            }
+            if (!best || cost < bestCost) {
+                best = std::move(placement);
+                bestCost = cost;
+            }
+        }
+        if (best) return best;
+    }
+    return std::nullopt;
+}
+
+/**
+ * The function `firstFit` is the naive allocator the benchmark compares against: the first
+ * window (front to back) of the fewest rows that holds the party, each block at the left end of
+ * the first free run long enough.
+ *
+ * Time complexity: O(R * k * W) per row count k tried.
+ * Space complexity: O(R * W)
+ */
+std::optional<GroupPlacement> GroupAllocator::firstFit(const SeatMap& map, int partySize) {
+    if (partySize <= 0) return std::nullopt;
+    std::vector<std::vector<Run>> runs(static_cast<std::size_t>(map.rows()));
+    std::vector<int> longest(runs.size(), 0);
+    for (int r = 0; r < map.rows(); ++r) {
+        runs[r] = freeRuns(map.freeMask(r));
+        for (const Run& run : runs[r]) longest[r] = std::max(longest[r], run.length);
+    }
+    if (std::accumulate(longest.begin(), longest.end(), 0) < partySize) return std::nullopt;
+
+    const int minRows = (partySize + map.seatsPerRow() - 1) / map.seatsPerRow();
+    for (int k = minRows; k <= std::min(partySize, map.rows()); ++k) {
+        for (int start = 0; start + k <= map.rows(); ++start) {
+            const auto split = evenSplit({longest.begin() + start, longest.begin() + start + k}, partySize);
+            if (split.empty()) continue;
+            GroupPlacement placement;
+            for (int i = 0; i < k; ++i) {
+                const int count = split[static_cast<std::size_t>(i)];
+                const auto& row = runs[start + i];
+                const auto run = std::find_if(row.begin(), row.end(), [&](const Run& r) { return r.length >= count; });
+                placement.orphans += orphansAround(*run, run->first, count);
+                placement.blocks.push_back({start + i, run->first, count});
+            }
+            return placement;
+        }
+    }
+    return std::nullopt;
+}
+
+bool GroupAllocator::apply(SeatMap& map, const GroupPlacement& placement) {
+    for (std::size_t i = 0; i < placement.blocks.size(); ++i) {
+        const auto& block = placement.blocks[i];
+        if (!map.book(block.row, block.mask())) {
+            for (std::size_t j = 0; j < i; ++j) map.release(placement.blocks[j].row, placement.blocks[j].mask());
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace booking
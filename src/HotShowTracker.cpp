@@ -0,0 +1,378 @@
+#include "HotShowTracker.hpp"
+#include <algorithm>
+#include <ctime>
+#include <new>
+#include <unordered_map>
+
+namespace booking {
+
+namespace {
+// Live trackers by ID. Thread-local buffers may outlive the tracker they were filled for,
+// so flushing goes through this registry and silently drops events of destroyed trackers.
+std::mutex& registryMutex() {
+    static std::mutex m;
+    return m;
+}
+
+std::unordered_map<std::uint64_t, HotShowTracker*>& registry() {
+    static std::unordered_map<std::uint64_t, HotShowTracker*> r;
+    return r;
+}
+
+std::atomic<std::uint64_t> g_nextTrackerId{1};
+
+// steady_clock::now() at coarse resolution (a few ms), a fraction of the cost on the record
+// path. On Linux steady_clock is CLOCK_MONOTONIC, which the coarse clock shares its epoch with.
+HotShowTracker::Clock::time_point coarseNow() noexcept {
+#ifdef CLOCK_MONOTONIC_COARSE
+    timespec ts{};
+    if (clock_gettime(CLOCK_MONOTONIC_COARSE, &ts) == 0)
+        return HotShowTracker::Clock::time_point(std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec));
+#endif
+    return HotShowTracker::Clock::now();
+}
+} // namespace
+
+// Per-thread pre-aggregation: open-addressing (show ID, count) table at most half full, holding
+// events of a single time bucket.
+struct HotShowTracker::ThreadBuffer {
+    static constexpr std::size_t SLOTS = BUFFER_SIZE * 2;
+    struct Slot {
+        long long showId;
+        std::uint32_t count;     // 0 = empty
+    };
+
+    std::uint32_t skip{1};       // Calls until the next sampled one; owning thread only
+    std::uint32_t rng{0x9E3779B9u};
+    std::mutex mtx;              // Protects the rest: flush() may fold this buffer from another thread
+    std::uint64_t owner{0};
+    std::int64_t bucket{0};      // Time bucket of the buffered events
+    std::size_t distinct{0};
+    std::size_t events{0};
+    Slot slots[SLOTS]{};
+    ThreadBuffer* prev{nullptr};  // Links of the list of all threads' buffers, under listMutex
+    ThreadBuffer* next{nullptr};
+
+    // Every thread's buffer, so flush() can fold the ones other threads filled. Lock order:
+    // listMutex -> mtx -> registryMutex -> HotShowTracker::mtx_.
+    static std::mutex listMutex;
+    static ThreadBuffer* head;
+
+    ThreadBuffer() {
+        std::lock_guard<std::mutex> guard(listMutex);
+        next = head;
+        if (next) next->prev = this;
+        head = this;
+    }
+
+    ~ThreadBuffer() {
+        {
+            std::lock_guard<std::mutex> guard(mtx);
+            try {
+                flushLocked();
+            } catch (const std::bad_alloc&) {
+                // Thread exit: the events are dropped rather than terminating
+            }
+        }
+        std::lock_guard<std::mutex> guard(listMutex);
+        (prev ? prev->next : head) = next;
+        if (next) next->prev = prev;
+    }
+
+    void flushLocked() {
+        if (events == 0) return;
+        {
+            std::lock_guard<std::mutex> guard(registryMutex());
+            auto it = registry().find(owner);
+            if (it != registry().end())
+                it->second->fold(*this);
+        }
+        for (auto& s : slots) s.count = 0;
+        distinct = events = 0;
+    }
+};
+
+std::mutex HotShowTracker::ThreadBuffer::listMutex;
+HotShowTracker::ThreadBuffer* HotShowTracker::ThreadBuffer::head = nullptr;
+
+HotShowTracker::HotShowTracker(std::uint32_t sampleEvery)
+    : id_(g_nextTrackerId.fetch_add(1, std::memory_order_relaxed)),
+      sampleEvery_(sampleEvery ? sampleEvery : 1) {
+    std::lock_guard<std::mutex> guard(registryMutex());
+    registry().emplace(id_, this);
+}
+
+HotShowTracker::~HotShowTracker() {
+    std::lock_guard<std::mutex> guard(registryMutex());
+    registry().erase(id_);
+}
+
+std::int64_t HotShowTracker::bucketOf(Clock::time_point t) noexcept {
+    return static_cast<std::int64_t>(t.time_since_epoch() / BUCKET_WIDTH);
+}
+
+HotShowTracker::ThreadBuffer& HotShowTracker::localBuffer() {
+    thread_local ThreadBuffer buffer;
+    return buffer;
+}
+
+/**
+ * The function `record` counts one request for `showId` in the calling thread's table; the
+ * shared summary is touched once per BUFFER_SIZE distinct shows or MAX_BUFFERED requests, and
+ * when a new time bucket starts. When sampling, unsampled calls return after a single decrement.
+ * Only sampled calls read the clock and take the (uncontended) buffer lock.
+ *
+ * Throws std::bad_alloc if the summary of a new bucket cannot be allocated.
+ *
+ * Time complexity: O(1) amortized.
+ * Space complexity: O(1)
+ */
+void HotShowTracker::record(long long showId) {
+    ThreadBuffer& buf = localBuffer();
+    if (buf.owner != id_) {
+        std::lock_guard<std::mutex> guard(buf.mtx);
+        buf.flushLocked();      // events of the previously used tracker
+        buf.owner = id_;
+        buf.skip = 1;
+    }
+    if (--buf.skip) return;
+
+    std::uint32_t weight = 1;
+    if (sampleEvery_ > 1) {
+        // xorshift32 gap uniform in [1, 2 * sampleEvery - 1]: mean sampleEvery, no aliasing with
+        // periodic request patterns.
+        buf.rng ^= buf.rng << 13; buf.rng ^= buf.rng >> 17; buf.rng ^= buf.rng << 5;
+        buf.skip = 1 + buf.rng % (2 * sampleEvery_ - 1);
+        weight = sampleEvery_;
+    } else {
+        buf.skip = 1;
+    }
+
+    const std::int64_t bucket = bucketOf(coarseNow());
+    std::lock_guard<std::mutex> guard(buf.mtx);
+    if (bucket != buf.bucket) {
+        buf.flushLocked();      // the buffered events belong to the bucket that just ended
+        buf.bucket = bucket;
+    }
+    auto i = static_cast<std::size_t>(static_cast<std::uint64_t>(showId) * 0x9E3779B97F4A7C15ULL >> 57);
+    while (buf.slots[i].count && buf.slots[i].showId != showId)
+        i = (i + 1) & (ThreadBuffer::SLOTS - 1);
+    if (!buf.slots[i].count) {
+        buf.slots[i].showId = showId;
+        ++buf.distinct;
+    }
+    buf.slots[i].count += weight;
+    if (++buf.events == MAX_BUFFERED || buf.distinct == BUFFER_SIZE) buf.flushLocked();
+}
+
+/**
+ * The function `flush` folds the pending events every thread has buffered for this tracker into
+ * the shared summary.
+ *
+ * Time complexity: O(T * BUFFER_SIZE) for T threads that have recorded events.
+ * Space complexity: O(1)
+ */
+void HotShowTracker::flush() {
+    std::lock_guard<std::mutex> list(ThreadBuffer::listMutex);
+    for (ThreadBuffer* buf = ThreadBuffer::head; buf; buf = buf->next) {
+        std::lock_guard<std::mutex> guard(buf->mtx);
+        if (buf->owner == id_) buf->flushLocked();
+    }
+}
+
+// ----------------- Per-bucket summary -----------------
+namespace {
+inline std::uint64_t mixId(long long id) noexcept {
+    auto x = static_cast<std::uint64_t>(id);
+    x ^= x >> 33; x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33; x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+} // namespace
+
+void HotShowTracker::Summary::reset(std::int64_t b) {
+    bucket = b;
+    sketch.assign(SKETCH_DEPTH * SKETCH_WIDTH, 0);
+    heap.clear();
+    heap.reserve(CAPACITY);
+    index.assign(INDEX_SIZE, EMPTY);
+}
+
+std::uint64_t HotShowTracker::Summary::floor() const noexcept {
+    return heap.size() == CAPACITY ? heap.front().show.count : 0;
+}
+
+// Conservative update: raises each of the show's cells only up to (old estimate + weight), which
+// keeps estimates upper bounds while cutting collision noise. Returns the new estimate.
+std::uint64_t HotShowTracker::Summary::sketchAdd(long long showId, std::uint32_t weight) noexcept {
+    const std::uint64_t h = mixId(showId);
+    std::uint32_t* cells[SKETCH_DEPTH];
+    std::uint32_t est = UINT32_MAX;
+    for (std::size_t row = 0; row < SKETCH_DEPTH; ++row) {
+        cells[row] = &sketch[row * SKETCH_WIDTH + ((h >> (row * 16)) & (SKETCH_WIDTH - 1))];
+        if (*cells[row] < est) est = *cells[row];
+    }
+    est = (est > UINT32_MAX - weight) ? UINT32_MAX : est + weight;
+    for (auto* cell : cells)
+        if (*cell < est) *cell = est;
+    return est;
+}
+
+// Returns the index slot holding showId, or the empty slot where it would go.
+std::uint32_t HotShowTracker::Summary::probe(long long showId) const noexcept {
+    auto i = static_cast<std::uint32_t>((mixId(showId) >> 48) % INDEX_SIZE);
+    while (index[i] != EMPTY && heap[static_cast<std::size_t>(index[i])].show.showId != showId)
+        i = (i + 1) % INDEX_SIZE;
+    return i;
+}
+
+// Backward-shift deletion keeps linear-probing chains intact without tombstones.
+void HotShowTracker::Summary::unindex(std::uint32_t hole) noexcept {
+    index[hole] = EMPTY;
+    for (std::uint32_t j = (hole + 1) % INDEX_SIZE; index[j] != EMPTY; j = (j + 1) % INDEX_SIZE) {
+        const long long id = heap[static_cast<std::size_t>(index[j])].show.showId;
+        const auto home = static_cast<std::uint32_t>((mixId(id) >> 48) % INDEX_SIZE);
+        // Entry j may only move into the hole if its home is not cyclically in (hole, j].
+        const bool stays = (hole <= j) ? (hole < home && home <= j) : (hole < home || home <= j);
+        if (stays) continue;
+        index[hole] = index[j];
+        heap[static_cast<std::size_t>(index[hole])].slot = hole;
+        index[j] = EMPTY;
+        hole = j;
+    }
+}
+
+void HotShowTracker::Summary::place(std::size_t pos, const Entry& e) noexcept {
+    heap[pos] = e;
+    index[e.slot] = static_cast<std::int32_t>(pos);
+}
+
+void HotShowTracker::Summary::siftDown(std::size_t pos) noexcept {
+    const Entry e = heap[pos];
+    for (;;) {
+        std::size_t child = 2 * pos + 1;
+        if (child >= heap.size()) break;
+        if (child + 1 < heap.size() && heap[child + 1].show.count < heap[child].show.count) ++child;
+        if (heap[child].show.count >= e.show.count) break;
+        place(pos, heap[child]);
+        pos = child;
+    }
+    place(pos, e);
+}
+
+void HotShowTracker::Summary::siftUp(std::size_t pos) noexcept {
+    const Entry e = heap[pos];
+    while (pos > 0) {
+        const std::size_t parent = (pos - 1) / 2;
+        if (heap[parent].show.count <= e.show.count) break;
+        place(pos, heap[parent]);
+        pos = parent;
+    }
+    place(pos, e);
+}
+
+/**
+ * The function `add` counts `weight` requests for `showId`.
+ *
+ * A tracked show's counter grows exactly. An untracked show only updates the sketch, unless its
+ * sketch estimate beats the smallest tracked count: it then takes a free counter or replaces the
+ * heap root. A newly tracked show starts at its sketch estimate (never below the true count) with
+ * error = estimate - weight, since only these requests are known to be exact.
+ *
+ * Time complexity: O(SKETCH_DEPTH) for cold shows, O(log CAPACITY) when the heap changes.
+ * Space complexity: O(1)
+ */
+void HotShowTracker::Summary::add(long long showId, std::uint32_t weight) {
+    const std::uint64_t est = sketchAdd(showId, weight);
+    std::uint32_t slot = probe(showId);
+    if (index[slot] != EMPTY) {
+        const auto pos = static_cast<std::size_t>(index[slot]);
+        heap[pos].show.count += weight;
+        siftDown(pos);
+        return;
+    }
+    if (heap.size() < CAPACITY) {
+        heap.push_back({HotShow{showId, est, est - weight}, slot});
+        index[slot] = static_cast<std::int32_t>(heap.size() - 1);
+        siftUp(heap.size() - 1);
+        return;
+    }
+    if (est <= heap.front().show.count) return;   // still colder than every tracked show
+
+    unindex(heap.front().slot);
+    slot = probe(showId);
+    place(0, {HotShow{showId, est, est - weight}, slot});
+    siftDown(0);
+}
+
+/**
+ * The function `fold` adds a thread's pre-aggregated counts to the summary of the bucket they
+ * were recorded in. Events of a bucket that has already left the ring are dropped.
+ *
+ * Time complexity: O(d * SKETCH_DEPTH) typical, O(d log CAPACITY) worst case, d = distinct shows.
+ * Space complexity: O(SKETCH_DEPTH * SKETCH_WIDTH + CAPACITY) per bucket.
+ */
+void HotShowTracker::fold(const ThreadBuffer& buf) {
+    std::lock_guard<std::mutex> guard(mtx_);
+    Summary& sum = ring_[static_cast<std::size_t>(buf.bucket) % BUCKETS];
+    if (sum.bucket > buf.bucket) return;             // slot already reused for a newer bucket
+    if (sum.bucket != buf.bucket) sum.reset(buf.bucket);   // slot held an expired bucket
+    for (const auto& slot : buf.slots)
+        if (slot.count) sum.add(slot.showId, slot.count);
+}
+
+/**
+ * The function `topShows` returns up to `k` shows with the highest request counts over the
+ * last `window` (rounded up to whole buckets, at most BUCKETS * BUCKET_WIDTH).
+ *
+ * A show missing from a full bucket may still have up to that bucket's smallest count there;
+ * that amount is added to both its count and its error, keeping count an upper bound and
+ * `count - error` a lower bound.
+ *
+ * Time complexity: O(W * CAPACITY) for W buckets in the window.
+ * Space complexity: O(W * CAPACITY) while merging.
+ */
+std::vector<HotShowTracker::HotShow> HotShowTracker::topShows(std::size_t k, Clock::duration window) const {
+    const std::int64_t now = bucketOf(Clock::now());
+    auto span = static_cast<std::int64_t>((window + BUCKET_WIDTH - Clock::duration{1}) / BUCKET_WIDTH);
+    span = std::clamp<std::int64_t>(span, 1, static_cast<std::int64_t>(BUCKETS));
+
+    struct Acc {
+        std::uint64_t count{0};
+        std::uint64_t error{0};
+        std::uint64_t floors{0};   // floors of the buckets this show appeared in
+    };
+    std::unordered_map<long long, Acc> merged;
+    std::uint64_t allFloors = 0;   // sum of smallest counts of full buckets
+    {
+        std::lock_guard<std::mutex> guard(mtx_);
+        for (const Summary& sum : ring_) {
+            if (sum.bucket < 0 || sum.bucket > now || sum.bucket <= now - span) continue;
+            const std::uint64_t floor = sum.floor();
+            allFloors += floor;
+            for (const auto& e : sum.heap) {
+                Acc& acc = merged[e.show.showId];
+                acc.count += e.show.count;
+                acc.error += e.show.error;
+                acc.floors += floor;
+            }
+        }
+    }
+
+    std::vector<HotShow> out;
+    out.reserve(merged.size());
+    for (const auto& [id, acc] : merged) {
+        const std::uint64_t missing = allFloors - acc.floors;   // buckets where the show was evicted
+        out.push_back({id, acc.count + missing, acc.error + missing});
+    }
+    const std::size_t n = std::min(k, out.size());
+    std::partial_sort(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(n), out.end(),
+                      [](const HotShow& a, const HotShow& b) {
+                          return a.count != b.count ? a.count > b.count : a.showId < b.showId;
+                      });
+    out.resize(n);
+    return out;
+}
+
+} // namespace booking
@@ -0,0 +1,136 @@
+#include "LocalSocket.hpp"
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <utility>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace booking {
+
+namespace {
+
+// Fills `addr` for `path`; false if the path does not fit sun_path.
+bool makeAddress(const std::string& path, sockaddr_un& addr) {
+    std::memset(&addr, 0, sizeof addr);
+    addr.sun_family = AF_UNIX;
+    if (path.empty() || path.size() >= sizeof addr.sun_path) {
+        std::cerr << "Invalid socket path: " << path << '\n';
+        return false;
+    }
+    std::memcpy(addr.sun_path, path.data(), path.size());
+    return true;
+}
+
+} // namespace
+
+LocalSocket::LocalSocket(LocalSocket&& other) noexcept : fd_(std::exchange(other.fd_, -1)) {}
+
+LocalSocket& LocalSocket::operator=(LocalSocket&& other) noexcept {
+    if (this != &other) {
+        close();
+        fd_ = std::exchange(other.fd_, -1);
+    }
+    return *this;
+}
+
+/**
+ * The function `listen` creates a listening socket bound to `path`. A file already at `path`
+ * (typically left by a previous run) is unlinked first.
+ *
+ * @return The listening socket, or an invalid one (with a message on std::cerr) on failure.
+ */
+LocalSocket LocalSocket::listen(const std::string& path, int backlog) {
+    sockaddr_un addr{};
+    if (!makeAddress(path, addr)) return {};
+    LocalSocket sock(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (!sock.valid()) {
+        std::cerr << "Cannot create socket: " << std::strerror(errno) << '\n';
+        return {};
+    }
+    ::unlink(path.c_str());
+    if (::bind(sock.fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof addr) != 0 ||
+        ::listen(sock.fd_, backlog) != 0) {
+        std::cerr << "Cannot listen on " << path << ": " << std::strerror(errno) << '\n';
+        return {};
+    }
+    return sock;
+}
+
+/**
+ * The function `connect` opens a connection to the socket listening at `path`.
+ *
+ * @return The connected socket, or an invalid one if nobody listens there (no message: callers
+ * usually retry while the peer starts up).
+ */
+LocalSocket LocalSocket::connect(const std::string& path) {
+    sockaddr_un addr{};
+    if (!makeAddress(path, addr)) return {};
+    LocalSocket sock(::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0));
+    if (!sock.valid()) return {};
+    if (::connect(sock.fd_, reinterpret_cast<const sockaddr*>(&addr), sizeof addr) != 0) return {};
+    return sock;
+}
+
+LocalSocket LocalSocket::accept() const {
+    for (;;) {
+        const int fd = ::accept4(fd_, nullptr, nullptr, SOCK_CLOEXEC);
+        if (fd >= 0) return LocalSocket(fd);
+        if (errno != EINTR) return {};
+    }
+}
+
+bool LocalSocket::sendAll(const void* data, std::size_t bytes) const {
+    const char* p = static_cast<const char*>(data);
+    while (bytes > 0) {
+        const ssize_t n = ::send(fd_, p, bytes, MSG_NOSIGNAL);   // A vanished peer is an error, not SIGPIPE
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        bytes -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool LocalSocket::recvAll(void* data, std::size_t bytes) const {
+    char* p = static_cast<char*>(data);
+    while (bytes > 0) {
+        const ssize_t n = ::recv(fd_, p, bytes, 0);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        p += n;
+        bytes -= static_cast<std::size_t>(n);
+    }
+    return true;
+}
+
+bool LocalSocket::sendFrame(std::string_view payload) const {
+    if (payload.size() > MAX_FRAME_BYTES) return false;
+    const auto length = static_cast<std::uint32_t>(payload.size());
+    return sendAll(&length, sizeof length) && sendAll(payload.data(), payload.size());
+}
+
+bool LocalSocket::recvFrame(std::string& payload) const {
+    std::uint32_t length = 0;
+    if (!recvAll(&length, sizeof length) || length > MAX_FRAME_BYTES) return false;
+    payload.resize(length);
+    return recvAll(payload.data(), length);
+}
+
+bool LocalSocket::readable(std::chrono::milliseconds timeout) const {
+    pollfd pfd{fd_, POLLIN, 0};
+    const int ready = ::poll(&pfd, 1, static_cast<int>(timeout.count()));
+    return ready > 0;
+}
+
+void LocalSocket::shutdown() const noexcept {
+    if (fd_ >= 0) ::shutdown(fd_, SHUT_RDWR);
+}
+
+void LocalSocket::close() noexcept {
+    if (fd_ >= 0) ::close(std::exchange(fd_, -1));
+}
+
+} // namespace booking
@@ -0,0 +1,250 @@
+#include "MutationLog.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace booking {
+
+// ----------------- Mutation Log -----------------
+namespace {
+
+// Encoded record: fixed-size scalars in host order, then the text bytes.
+constexpr std::size_t FIXED_BYTES = 1 + 8 + 8 + 8 + 4 + 4 + 8 + 8 + 4 + 4;
+
+template <typename T>
+void put(std::string& out, T value) {
+    char bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    out.append(bytes, sizeof(T));
+}
+
+template <typename T>
+T take(const char*& p) {
+    T value;
+    std::memcpy(&value, p, sizeof(T));
+    p += sizeof(T);
+    return value;
+}
+
+} // namespace
+
+void MutationLog::reserveLocked(Writer& writer, std::size_t count) {
+    writer.next_ = nextLsn_;
+    nextLsn_ += count;
+    writer.end_ = nextLsn_;
+    records_.resize(records_.size() + count);
+}
+
+// Reservations of one Writer stay contiguous: LSNs still unused are given up (as Noop) first.
+void MutationLog::Writer::reserve(std::size_t count) {
+    if (!log_ || count == 0) return;
+    fillUnused();
+    std::lock_guard lock(log_->mtx_);
+    log_->reserveLocked(*this, count);
+}
+
+void MutationLog::Writer::fillUnused() {
+    while (next_ != end_) {
+        Record noop{.type = Record::Type::Noop};
+        noop.lsn = next_;
+        log_->fill(next_++, encode(noop));
+    }
+}
+
+/**
+ * The function `append` stamps `record` with the oldest LSN this Writer reserved (reserving one
+ * now if none is left) and the current time, encodes it outside the log's lock and stores it.
+ *
+ * Time complexity: O(size of record)
+ * Space complexity: O(size of record)
+ */
+std::uint64_t MutationLog::Writer::append(Record record) {
+    if (!log_) return 0;
+    if (next_ == end_) reserve(1);
+    record.lsn = next_++;
+    record.timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    log_->fill(record.lsn, encode(record));
+    return record.lsn;
+}
+
+MutationLog::Writer::~Writer() {
+    if (log_) fillUnused();
+}
+
+/**
+ * The function `fill` stores the encoded record of a reserved LSN and advances lastLsn() over
+ * the records now gap-free, waking readers if it moved. Past the retention bound, the oldest
+ * records are trimmed unless another thread is already trimming.
+ *
+ * Time complexity: O(1) amortized; O(TRIM_BATCH) when it trims.
+ * Space complexity: O(1)
+ */
+void MutationLog::fill(std::uint64_t lsn, std::string bytes) {
+    bool advanced = false;
+    std::uint64_t last = 0;
+    std::size_t held = 0;
+    {
+        std::lock_guard lock(mtx_);
+        records_[lsn - firstLsn_] = std::move(bytes);
+        last = lastLsn_.load(std::memory_order_relaxed);
+        while (last + 1 < nextLsn_ && !records_[last + 1 - firstLsn_].empty()) {
+            ++last;
+            advanced = true;
+        }
+        if (advanced) lastLsn_.store(last, std::memory_order_release);
+        held = records_.size();
+    }
+    if (advanced) appended_.notify_all();
+    if (held > retain_ + TRIM_BATCH) trimTo(last - std::min<std::uint64_t>(last, retain_), false);
+}
+
+std::uint64_t MutationLog::firstLsn() const {
+    std::lock_guard lock(mtx_);
+    return firstLsn_;
+}
+
+std::size_t MutationLog::size() const {
+    std::lock_guard lock(mtx_);
+    return records_.size();
+}
+
+/**
+ * The function `readFrom` copies the encoded records from `fromLsn` on into `out`, for shipping.
+ * If there are none yet it waits up to `timeout` for a writer to append one.
+ *
+ * @return The number of records copied, or std::nullopt if `fromLsn` has been trimmed.
+ *
+ * Time complexity: O(k) for k records copied.
+ * Space complexity: O(bytes copied)
+ */
+std::optional<std::size_t> MutationLog::readFrom(std::uint64_t fromLsn, std::vector<std::string>& out,
+                                                 std::size_t maxRecords, std::chrono::milliseconds timeout) const {
+    fromLsn = std::max<std::uint64_t>(fromLsn, 1);
+    std::unique_lock lock(mtx_);
+    appended_.wait_for(lock, timeout, [&] { return lastLsn_.load(std::memory_order_relaxed) >= fromLsn || fromLsn < firstLsn_; });
+    if (fromLsn < firstLsn_) return std::nullopt;
+    const std::uint64_t last = lastLsn_.load(std::memory_order_relaxed);
+    std::size_t copied = 0;
+    for (std::uint64_t lsn = fromLsn; lsn <= last && copied < maxRecords; ++lsn, ++copied)
+        out.push_back(records_[lsn - firstLsn_]);
+    return copied;
+}
+
+void MutationLog::trim(std::uint64_t throughLsn) {
+    trimTo(throughLsn, true);
+}
+
+/**
+ * The function `trimTo` drops the records up to `throughLsn` (never beyond lastLsn()) and folds
+ * them into the base state. Records are only moved out under the log's lock; decoding and
+ * folding happen under baseMtx_ alone, so writers are not held up. Trims shorter than TRIM_BATCH
+ * are skipped to keep the work per record constant.
+ *
+ * Time complexity: O(k) for k records trimmed, plus O(log S) per record for S live shows.
+ * Space complexity: O(k) while folding.
+ */
+bool MutationLog::trimTo(std::uint64_t throughLsn, bool wait) {
+    std::unique_lock base(baseMtx_, std::defer_lock);
+    if (wait) base.lock();
+    else if (!base.try_lock()) return false;
+
+    std::vector<std::string> dropped;
+    {
+        std::lock_guard lock(mtx_);
+        throughLsn = std::min(throughLsn, lastLsn_.load(std::memory_order_relaxed));
+        if (throughLsn < firstLsn_ || throughLsn - firstLsn_ + 1 < TRIM_BATCH) return true;
+        const auto count = static_cast<std::size_t>(throughLsn - firstLsn_ + 1);
+        dropped.reserve(count);
+        for (std::size_t i = 0; i < count; ++i) dropped.push_back(std::move(records_[i]));
+        records_.erase(records_.begin(), records_.begin() + static_cast<std::ptrdiff_t>(count));
+        firstLsn_ = throughLsn + 1;
+    }
+
+    for (const std::string& bytes : dropped) {
+        const auto record = decode(bytes);
+        if (!record) continue;
+        switch (record->type) {
+        case Record::Type::AddMovie: baseMovies_.emplace_back(static_cast<int>(record->id), record->text); break;
+        case Record::Type::AddTheater: baseTheaters_.emplace_back(static_cast<int>(record->id), record->text); break;
+        case Record::Type::CreateShow: baseShows_[record->id] = {record->movieId, record->theaterId, 0}; break;
+        case Record::Type::RemoveShow: baseShows_.erase(record->id); break;
+        case Record::Type::Book: {
+            auto it = baseShows_.find(record->id);
+            if (it != baseShows_.end()) it->second.seatMask |= record->seatMask;
+            baseLastTicket_ = std::max(baseLastTicket_, record->ticketId);
+            break;
+        }
+        default: break;
+        }
+    }
+    return true;
+}
+
+/**
+ * The function `snapshot` encodes the base state, i.e. the effect of every trimmed record, as
+ * records a follower applies before resuming at firstLsn().
+ *
+ * Time complexity: O(M + T + S) for the movies, theaters and live shows in the base state.
+ * Space complexity: O(M + T + S)
+ */
+MutationLog::Snapshot MutationLog::snapshot() const {
+    std::lock_guard base(baseMtx_);
+    Snapshot out;
+    {
+        std::lock_guard lock(mtx_);
+        out.lsn = firstLsn_ - 1;
+    }
+    const auto add = [&](Record record) {
+        record.lsn = out.lsn;
+        out.records.push_back(encode(record));
+    };
+    for (const auto& [id, title] : baseMovies_) add({.type = Record::Type::AddMovie, .id = id, .text = title});
+    for (const auto& [id, name] : baseTheaters_) add({.type = Record::Type::AddTheater, .id = id, .text = name});
+    for (const auto& [id, show] : baseShows_) {
+        add({.type = Record::Type::CreateShow, .id = id, .movieId = show.movieId, .theaterId = show.theaterId});
+        if (show.seatMask) add({.type = Record::Type::ShowSeats, .id = id, .seatMask = show.seatMask});
+    }
+    add({.type = Record::Type::Snapshot, .ticketId = baseLastTicket_});
+    return out;
+}
+
+std::string MutationLog::encode(const Record& record) {
+    std::string out;
+    out.reserve(FIXED_BYTES + record.text.size());
+    put(out, static_cast<std::uint8_t>(record.type));
+    put(out, record.lsn);
+    put(out, record.timestampNs);
+    put(out, static_cast<std::int64_t>(record.id));
+    put(out, static_cast<std::int32_t>(record.movieId));
+    put(out, static_cast<std::int32_t>(record.theaterId));
+    put(out, static_cast<std::int64_t>(record.ticketId));
+    put(out, static_cast<std::int64_t>(record.customerId));
+    put(out, record.seatMask);
+    put(out, static_cast<std::uint32_t>(record.text.size()));
+    out += record.text;
+    return out;
+}
+
+std::optional<MutationLog::Record> MutationLog::decode(std::string_view bytes) {
+    if (bytes.size() < FIXED_BYTES) return std::nullopt;
+    const char* p = bytes.data();
+    Record record;
+    const auto type = take<std::uint8_t>(p);
+    if (type < static_cast<std::uint8_t>(Record::Type::AddMovie) || type > static_cast<std::uint8_t>(Record::Type::Snapshot))
+        return std::nullopt;
+    record.type = static_cast<Record::Type>(type);
+    record.lsn = take<std::uint64_t>(p);
+    record.timestampNs = take<std::int64_t>(p);
+    record.id = take<std::int64_t>(p);
+    record.movieId = take<std::int32_t>(p);
+    record.theaterId = take<std::int32_t>(p);
+    record.ticketId = take<std::int64_t>(p);
+    record.customerId = take<std::int64_t>(p);
+    record.seatMask = take<std::uint32_t>(p);
+    const auto textBytes = take<std::uint32_t>(p);
+    if (bytes.size() - FIXED_BYTES != textBytes) return std::nullopt;
+    record.text.assign(p, textBytes);
+    return record;
+}
+
+} // namespace booking
@@ -0,0 +1,269 @@
+#include "ReadOnlyBookingView.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace booking {
+
+// ----------------- Read-Only Booking View -----------------
+namespace {
+
+// Checks the header against this build and every section against the file size, so that all
+// column accesses after open() stay inside the mapping.
+bool validHeader(const catalog_file::Header& h, std::size_t fileSize) {
+    using namespace catalog_file;
+    if (std::memcmp(h.magic, MAGIC, sizeof h.magic) != 0 || h.version != VERSION) return false;
+    if (h.byteOrder != BYTE_ORDER_MARK) return false;
+    if (h.totalSeats != BookingService::TOTAL_SEATS || h.seatWords != BookingService::SEAT_WORDS) return false;
+    // Counts bounded by the file size keep the products below from overflowing
+    if (h.movieCount > fileSize || h.theaterCount > fileSize || h.showCount > fileSize || h.stringBytes > fileSize)
+        return false;
+
+    const std::uint64_t expected[SECTION_COUNT] = {
+        h.movieCount * sizeof(std::int32_t),            // MOVIE_IDS
+        (h.movieCount + 1) * sizeof(std::uint64_t),     // MOVIE_NAMES
+        h.theaterCount * sizeof(std::int32_t),          // THEATER_IDS
+        (h.theaterCount + 1) * sizeof(std::uint64_t),   // THEATER_NAMES
+        h.showCount * sizeof(std::int64_t),             // SHOW_IDS
+        h.showCount * sizeof(std::uint32_t),            // SHOW_MOVIE
+        h.showCount * sizeof(std::uint32_t),            // SHOW_THEATER
+        h.showCount * sizeof(std::int32_t),             // SHOW_AVAILABLE
+        h.showCount * h.seatWords * sizeof(std::uint32_t), // SHOW_SEATS
+        h.stringBytes                                   // STRINGS
+    };
+    for (std::uint32_t s = 0; s < SECTION_COUNT; ++s) {
+        const SectionRef& ref = h.sections[s];
+        if (ref.bytes != expected[s] || ref.offset % ALIGNMENT != 0) return false;
+        if (ref.offset < sizeof(Header) || ref.offset > fileSize || ref.bytes > fileSize - ref.offset) return false;
+    }
+    return true;
+}
+
+} // namespace
+
+/**
+ * The function `open` maps a catalog file written by `BookingService::exportCatalog` read-only.
+ *
+ * @param path Catalog file to map.
+ *
+ * @return The view, or std::nullopt (with a message on std::cerr) if the file cannot be mapped or
+ * its header does not describe a well-formed catalog for this build (magic, version, byte order,
+ * seat layout, section bounds).
+ *
+ * Time complexity: O(1) — only the header is read; column pages fault in on first use.
+ * Space complexity: O(1) beyond the mapping.
+ */
+std::optional<ReadOnlyBookingView> ReadOnlyBookingView::open(const std::string& path) {
+    const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        std::cerr << "Cannot open catalog file: " << path << '\n';
+        return std::nullopt;
+    }
+    struct stat st{};
+    if (::fstat(fd, &st) != 0 || static_cast<std::size_t>(st.st_size) < sizeof(catalog_file::Header)) {
+        std::cerr << "Not a catalog file: " << path << '\n';
+        ::close(fd);
+        return std::nullopt;
+    }
+    const auto size = static_cast<std::size_t>(st.st_size);
+    void* base = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);                                     // The mapping keeps the file alive
+    if (base == MAP_FAILED) {
+        std::cerr << "Cannot map catalog file: " << path << '\n';
+        return std::nullopt;
+    }
+    if (!validHeader(*static_cast<const catalog_file::Header*>(base), size)) {
+        std::cerr << "Not a catalog file: " << path << '\n';
+        ::munmap(base, size);
+        return std::nullopt;
+    }
+    return ReadOnlyBookingView(base, size);
+}
+
+ReadOnlyBookingView::ReadOnlyBookingView(const void* base, std::size_t size) noexcept
+    : base_(static_cast<const char*>(base)), size_(size),
+      header_(static_cast<const catalog_file::Header*>(base)) {}
+
+ReadOnlyBookingView::~ReadOnlyBookingView() {
+    if (base_) ::munmap(const_cast<char*>(base_), size_);
+}
+
+ReadOnlyBookingView::ReadOnlyBookingView(ReadOnlyBookingView&& other) noexcept
+    : base_(std::exchange(other.base_, nullptr)), size_(std::exchange(other.size_, 0)),
+      header_(std::exchange(other.header_, nullptr)) {}
+
+ReadOnlyBookingView& ReadOnlyBookingView::operator=(ReadOnlyBookingView&& other) noexcept {
+    if (this != &other) {
+        if (base_) ::munmap(const_cast<char*>(base_), size_);
+        base_ = std::exchange(other.base_, nullptr);
+        size_ = std::exchange(other.size_, 0);
+        header_ = std::exchange(other.header_, nullptr);
+    }
+    return *this;
+}
+
+/**
+ * The function `findShow` returns the row of `showId` in the show columns by binary search over
+ * the sorted SHOW_IDS column.
+ *
+ * Time complexity: O(log S)
+ * Space complexity: O(1)
+ */
+std::size_t ReadOnlyBookingView::findShow(long long showId) const {
+    const auto* ids = column<std::int64_t>(catalog_file::SHOW_IDS);
+    const auto* end = ids + header_->showCount;
+    const auto* it = std::lower_bound(ids, end, showId);
+    if (it == end || *it != showId) throw std::invalid_argument("Invalid show ID");
+    return static_cast<std::size_t>(it - ids);
+}
+
+// View of entry `row` of a MOVIE_NAMES / THEATER_NAMES offset column; empty if the offsets are corrupt.
+std::string_view ReadOnlyBookingView::name(catalog_file::Section offsets, std::size_t row) const noexcept {
+    const auto* bounds = column<std::uint64_t>(offsets);
+    const std::uint64_t begin = bounds[row], end = bounds[row + 1];
+    if (begin > end || end > header_->stringBytes) return {};
+    return {column<char>(catalog_file::STRINGS) + begin, static_cast<std::size_t>(end - begin)};
+}
+
+ReadOnlyBookingView::ShowView ReadOnlyBookingView::showViewAt(std::size_t row) const noexcept {
+    const std::uint32_t movieRow = column<std::uint32_t>(catalog_file::SHOW_MOVIE)[row];
+    const std::uint32_t theaterRow = column<std::uint32_t>(catalog_file::SHOW_THEATER)[row];
+    const bool movieOk = movieRow < header_->movieCount, theaterOk = theaterRow < header_->theaterCount;
+    return {
+        column<std::int64_t>(catalog_file::SHOW_IDS)[row],
+        movieOk ? column<std::int32_t>(catalog_file::MOVIE_IDS)[movieRow] : 0,
+        theaterOk ? column<std::int32_t>(catalog_file::THEATER_IDS)[theaterRow] : 0,
+        movieOk ? name(catalog_file::MOVIE_NAMES, movieRow) : std::string_view{},
+        theaterOk ? name(catalog_file::THEATER_NAMES, theaterRow) : std::string_view{},
+        column<std::int32_t>(catalog_file::SHOW_AVAILABLE)[row]
+    };
+}
+
+/**
+ * The function `getAvailableSeats` returns the labels of the seats that were free in the snapshot
+ * for `showId`, decoded straight from the mapped seat bitmap.
+ *
+ * @return Seat labels as BookingService::getAvailableSeats would have returned them at export time.
+ * Throws std::invalid_argument for an ID that is not in the file.
+ *
+ * Time complexity: O(log S + TOTAL_SEATS)
+ * Space complexity: O(TOTAL_SEATS)
+ */
+std::vector<std::string> ReadOnlyBookingView::getAvailableSeats(long long showId) const {
+    const std::size_t row = findShow(showId);
+    const std::uint32_t* words = column<std::uint32_t>(catalog_file::SHOW_SEATS) + row * header_->seatWords;
+    std::vector<std::string> available;
+    available.reserve(BookingService::TOTAL_SEATS);
+    for (int i = 0; i < BookingService::TOTAL_SEATS; ++i)
+        if (!((words[i / 32] >> (i % 32)) & 1u))
+            available.emplace_back(BookingService::seatLabelFromIndex(i));
+    return available;
+}
+
+/**
+ * The function `getAvailableSeatCount` returns the number of free seats of `showId` in the snapshot.
+ * Throws std::invalid_argument for an ID that is not in the file.
+ *
+ * Time complexity: O(log S)
+ * Space complexity: O(1)
+ */
+int ReadOnlyBookingView::getAvailableSeatCount(long long showId) const {
+    return column<std::int32_t>(catalog_file::SHOW_AVAILABLE)[findShow(showId)];
+}
+
+/**
+ * The function `getAllShows` lists every show in the snapshot like BookingService::getAllShows,
+ * in show ID order.
+ *
+ * Time complexity: O(S)
+ * Space complexity: O(S) plus two string copies per show.
+ */
+std::vector<ReadOnlyBookingView::ShowInfo> ReadOnlyBookingView::getAllShows() const {
+    std::vector<ShowInfo> result;
+    result.reserve(header_->showCount);
+    for (std::size_t row = 0; row < header_->showCount; ++row) {
+        const ShowView v = showViewAt(row);
+        result.push_back({v.id, std::string(v.movieTitle), std::string(v.theaterName), v.availableSeats});
+    }
+    return result;
+}
+
+/**
+ * The function `getAllShowViews` lists every show in the snapshot with names as views into the
+ * mapping, in show ID order. The views stay valid as long as this object lives.
+ *
+ * Time complexity: O(S)
+ * Space complexity: O(S) for the result vector, zero string allocations.
+ */
+std::vector<ReadOnlyBookingView::ShowView> ReadOnlyBookingView::getAllShowViews() const {
+    std::vector<ShowView> result;
+    result.reserve(header_->showCount);
+    for (std::size_t row = 0; row < header_->showCount; ++row)
+        result.push_back(showViewAt(row));
+    return result;
+}
+
+/**
+ * The function `getAllMovieViews` returns (movieId, title) pairs in movie ID order.
+ *
+ * Time complexity: O(M)
+ * Space complexity: O(M) for the result vector, zero string allocations.
+ */
+std::vector<std::pair<int, std::string_view>> ReadOnlyBookingView::getAllMovieViews() const {
+    std::vector<std::pair<int, std::string_view>> result;
+    result.reserve(header_->movieCount);
+    const auto* ids = column<std::int32_t>(catalog_file::MOVIE_IDS);
+    for (std::size_t row = 0; row < header_->movieCount; ++row)
+        result.emplace_back(ids[row], name(catalog_file::MOVIE_NAMES, row));
+    return result;
+}
+
+/**
+ * The function `getAllTheaterViews` returns (theaterId, name) pairs in theater ID order.
+ *
+ * Time complexity: O(T)
+ * Space complexity: O(T) for the result vector, zero string allocations.
+ */
+std::vector<std::pair<int, std::string_view>> ReadOnlyBookingView::getAllTheaterViews() const {
+    std::vector<std::pair<int, std::string_view>> result;
+    result.reserve(header_->theaterCount);
+    const auto* ids = column<std::int32_t>(catalog_file::THEATER_IDS);
+    for (std::size_t row = 0; row < header_->theaterCount; ++row)
+        result.emplace_back(ids[row], name(catalog_file::THEATER_NAMES, row));
+    return result;
+}
+
+/**
+ * The function `getMovieTitle` returns the title of `movieId`, or "Unknown Movie".
+ *
+ * Time complexity: O(log M)
+ * Space complexity: O(1)
+ */
+std::string_view ReadOnlyBookingView::getMovieTitle(int movieId) const {
+    const auto* ids = column<std::int32_t>(catalog_file::MOVIE_IDS);
+    const auto* end = ids + header_->movieCount;
+    const auto* it = std::lower_bound(ids, end, movieId);
+    if (it == end || *it != movieId) return "Unknown Movie";
+    return name(catalog_file::MOVIE_NAMES, static_cast<std::size_t>(it - ids));
+}
+
+/**
+ * The function `getTheaterName` returns the name of `theaterId`, or "Unknown Theater".
+ *
+ * Time complexity: O(log T)
+ * Space complexity: O(1)
+ */
+std::string_view ReadOnlyBookingView::getTheaterName(int theaterId) const {
+    const auto* ids = column<std::int32_t>(catalog_file::THEATER_IDS);
+    const auto* end = ids + header_->theaterCount;
+    const auto* it = std::lower_bound(ids, end, theaterId);
+    if (it == end || *it != theaterId) return "Unknown Theater";
+    return name(catalog_file::THEATER_NAMES, static_cast<std::size_t>(it - ids));
+}
+
+} // namespace booking
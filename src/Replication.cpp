@@ -0,0 +1,439 @@
+#include "Replication.hpp"
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <unordered_map>
+#include <unordered_set>
+#include <unistd.h>
+
+namespace booking {
+
+namespace {
+
+std::int64_t steadyNowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// Control message: type byte + one u64.
+std::string controlMessage(replication::MessageType type, std::uint64_t value) {
+    std::string payload(1 + sizeof value, '\0');
+    payload[0] = static_cast<char>(type);
+    std::memcpy(payload.data() + 1, &value, sizeof value);
+    return payload;
+}
+
+std::vector<std::string> seatLabels(std::uint32_t seatMask) {
+    std::vector<std::string> labels;
+    for (int i = 0; i < BookingService::TOTAL_SEATS; ++i)
+        if (seatMask & (std::uint32_t{1} << i)) labels.push_back(BookingService::seatLabelFromIndex(i));
+    return labels;
+}
+
+bool parseControl(const std::string& payload, replication::MessageType type, std::uint64_t& value) {
+    if (payload.size() != 1 + sizeof value || static_cast<std::uint8_t>(payload[0]) != type) return false;
+    std::memcpy(&value, payload.data() + 1, sizeof value);
+    return true;
+}
+
+} // namespace
+
+// ----------------- Replication Primary -----------------
+ReplicationPrimary::ReplicationPrimary(MutationLog& log, std::string socketPath)
+    : log_(log), path_(std::move(socketPath)) {}
+
+ReplicationPrimary::~ReplicationPrimary() {
+    stop();
+}
+
+/**
+ * The function `start` binds the replication socket and starts accepting followers; each follower
+ * is served by its own thread.
+ *
+ * @return false (with a message on std::cerr) if the socket cannot be bound.
+ */
+bool ReplicationPrimary::start() {
+    listener_ = LocalSocket::listen(path_);
+    if (!listener_.valid()) return false;
+    stopping_ = false;
+    acceptThread_ = std::thread([this] { acceptLoop(); });
+    return true;
+}
+
+void ReplicationPrimary::stop() {
+    if (!acceptThread_.joinable()) return;
+    stopping_ = true;
+    listener_.shutdown();
+    acceptThread_.join();
+    listener_.close();
+    ::unlink(path_.c_str());
+
+    std::lock_guard lock(mtx_);
+    for (auto& follower : followers_) follower->socket.shutdown();
+    for (auto& follower : followers_)
+        if (follower->thread.joinable()) follower->thread.join();
+    followers_.clear();
+}
+
+void ReplicationPrimary::acceptLoop() {
+    while (!stopping_) {
+        LocalSocket socket = listener_.accept();
+        if (!socket.valid()) continue;               // shut down (loop exits) or transient error
+        std::lock_guard lock(mtx_);
+        if (stopping_) return;
+        auto follower = std::make_unique<Follower>();
+        follower->id = followers_.size() + 1;
+        follower->socket = std::move(socket);
+        follower->ackedAtNs = steadyNowNs();
+        Follower& ref = *follower;
+        followers_.push_back(std::move(follower));
+        ref.thread = std::thread([this, &ref] { serve(ref); });
+    }
+}
+
+/**
+ * The function `serve` streams the log to one follower: after the follower's HELLO it ships
+ * records in batches from the requested LSN on, sends a heartbeat whenever the log stays idle for
+ * HEARTBEAT_INTERVAL, and records the follower's acknowledgements, trimming the log up to what
+ * every follower has applied. If the next LSN has been trimmed, the follower gets a snapshot and
+ * the stream continues after it. Returns when the follower disconnects or the primary stops.
+ */
+void ReplicationPrimary::serve(Follower& follower) {
+    std::string payload;
+    std::uint64_t next = 0;
+    if (!follower.socket.recvFrame(payload) || !parseControl(payload, replication::HELLO, next)) {
+        follower.connected = false;
+        return;
+    }
+
+    std::vector<std::string> batch;
+    batch.reserve(replication::BATCH_RECORDS);
+    while (!stopping_) {
+        batch.clear();
+        const auto n = log_.readFrom(next, batch, replication::BATCH_RECORDS, replication::HEARTBEAT_INTERVAL);
+        bool ok = true;
+        if (!n) {
+            MutationLog::Snapshot snapshot = log_.snapshot();
+            ok = follower.socket.sendFrame(controlMessage(replication::SNAPSHOT, snapshot.lsn));
+            for (const std::string& record : snapshot.records)
+                ok = ok && follower.socket.sendFrame(record);
+            next = snapshot.lsn + 1;
+        } else {
+            for (const std::string& record : batch)
+                ok = ok && follower.socket.sendFrame(record);
+            if (*n == 0) ok = ok && follower.socket.sendFrame(controlMessage(replication::HEARTBEAT, log_.lastLsn()));
+            next = std::max<std::uint64_t>(next, 1) + *n;
+        }
+        if (!ok) break;
+
+        // Drain acknowledgements without blocking the stream
+        while (ok && follower.socket.readable(std::chrono::milliseconds(0))) {
+            std::uint64_t acked = 0;
+            ok = follower.socket.recvFrame(payload) && parseControl(payload, replication::ACK, acked);
+            if (ok) {
+                follower.ackedLsn.store(acked, std::memory_order_relaxed);
+                follower.ackedAtNs.store(steadyNowNs(), std::memory_order_relaxed);
+            }
+        }
+        if (!ok) break;
+        trimAcknowledged();
+    }
+    follower.connected = false;
+}
+
+/**
+ * The function `trimAcknowledged` drops the log records every connected follower has applied.
+ * Disconnected followers do not hold the log back; if they return behind the trimmed point they
+ * re-sync from a snapshot. Without any connected follower only the log's retention bound applies.
+ *
+ * Time complexity: O(F) for F followers, plus the trim itself (at least TRIM_BATCH records or nothing).
+ * Space complexity: O(1)
+ */
+void ReplicationPrimary::trimAcknowledged() {
+    std::uint64_t lowest = 0;
+    bool any = false;
+    {
+        std::lock_guard lock(mtx_);
+        for (const auto& follower : followers_) {
+            if (!follower->connected.load()) continue;
+            const std::uint64_t acked = follower->ackedLsn.load(std::memory_order_relaxed);
+            lowest = any ? std::min(lowest, acked) : acked;
+            any = true;
+        }
+    }
+    if (any && lowest >= log_.firstLsn() + MutationLog::TRIM_BATCH) log_.trim(lowest);
+}
+
+/**
+ * The function `followers` reports, per follower, the last LSN it acknowledged and how far that
+ * is behind the log.
+ *
+ * Time complexity: O(F)
+ * Space complexity: O(F)
+ */
+std::vector<ReplicationPrimary::FollowerStatus> ReplicationPrimary::followers() const {
+    const std::uint64_t last = log_.lastLsn();
+    const std::int64_t now = steadyNowNs();
+    std::lock_guard lock(mtx_);
+    std::vector<FollowerStatus> result;
+    result.reserve(followers_.size());
+    for (const auto& follower : followers_) {
+        const std::uint64_t acked = follower->ackedLsn.load(std::memory_order_relaxed);
+        result.push_back({follower->id, follower->connected.load(), acked, last > acked ? last - acked : 0,
+                          std::chrono::nanoseconds(now - follower->ackedAtNs.load(std::memory_order_relaxed))});
+    }
+    return result;
+}
+
+// ----------------- Replication Follower -----------------
+ReplicationFollower::ReplicationFollower(BookingService& replica, std::string socketPath)
+    : replica_(replica), path_(std::move(socketPath)) {}
+
+ReplicationFollower::~ReplicationFollower() {
+    stop();
+}
+
+bool ReplicationFollower::start(std::chrono::milliseconds connectTimeout) {
+    if (thread_.joinable()) return true;
+    stopping_ = false;
+    if (!connect(connectTimeout)) {
+        std::cerr << "Cannot reach replication primary at " << path_ << '\n';
+        return false;
+    }
+    thread_ = std::thread([this] { applyLoop(); });
+    return true;
+}
+
+void ReplicationFollower::stop() {
+    stopping_ = true;
+    {
+        std::lock_guard lock(socketMtx_);
+        socket_.shutdown();
+    }
+    if (thread_.joinable()) thread_.join();
+    socket_.close();
+    connected_ = false;
+    notifyProgress();
+}
+
+// Connects and asks for the first LSN not applied yet; retries until `timeout` or stop().
+bool ReplicationFollower::connect(std::chrono::milliseconds timeout) {
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    for (;;) {
+        LocalSocket socket = LocalSocket::connect(path_);
+        if (socket.valid() && socket.sendFrame(controlMessage(replication::HELLO, appliedLsn_.load() + 1))) {
+            std::lock_guard lock(socketMtx_);
+            if (stopping_) return false;
+            socket_ = std::move(socket);
+            connected_ = true;
+            return true;
+        }
+        if (stopping_ || std::chrono::steady_clock::now() >= deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+}
+
+/**
+ * The function `applyLoop` receives frames until stop(): records are applied in LSN order,
+ * heartbeats advance the known primary LSN, snapshot records are collected and applied together
+ * once the Snapshot record arrives, and an ACK is sent whenever the socket has been drained. A lost connection is re-established and resumed from the next LSN; a record that
+ * cannot be applied marks the follower diverged and ends replication.
+ */
+void ReplicationFollower::applyLoop() {
+    std::string payload;
+    std::uint64_t snapshotLsn = 0;                   // Nonzero while a snapshot is being received
+    std::vector<BookingService::LogRecord> snapshot;
+    while (!stopping_) {
+        if (!socket_.recvFrame(payload) || payload.empty()) {
+            connected_ = false;
+            snapshotLsn = 0;                         // the primary resends it after HELLO
+            if (stopping_ || !connect(std::chrono::hours(24 * 365))) break;
+            continue;
+        }
+
+        std::uint64_t announced = 0;
+        if (parseControl(payload, replication::HEARTBEAT, announced)) {
+            primaryLsn_.store(std::max(primaryLsn_.load(), announced));
+        } else if (parseControl(payload, replication::SNAPSHOT, announced)) {
+            snapshotLsn = announced;
+            snapshot.clear();
+        } else if (snapshotLsn != 0) {
+            auto record = MutationLog::decode(payload);
+            const bool last = record && record->type == BookingService::LogRecord::Type::Snapshot;
+            if (record && record->lsn == snapshotLsn) snapshot.push_back(std::move(*record));
+            if (!record || record->lsn != snapshotLsn || snapshotLsn <= appliedLsn_.load() ||
+                (last && !applySnapshot(snapshot))) {
+                std::cerr << "Replication diverged applying snapshot at LSN " << snapshotLsn << '\n';
+                diverged_ = true;
+                break;
+            }
+            if (last) {
+                appliedLsn_.store(snapshotLsn);
+                primaryLsn_.store(std::max(primaryLsn_.load(), snapshotLsn));
+                snapshotsApplied_.fetch_add(1);
+                snapshotLsn = 0;
+                snapshot.clear();
+            }
+        } else {
+            const auto record = MutationLog::decode(payload);
+            if (!record || record->lsn != appliedLsn_.load() + 1 || !apply(*record)) {
+                std::cerr << "Replication diverged at LSN " << appliedLsn_.load() + 1 << '\n';
+                diverged_ = true;
+                break;
+            }
+            appliedLsn_.store(record->lsn);
+            primaryLsn_.store(std::max(primaryLsn_.load(), record->lsn));
+        }
+
+        // No ACK while a snapshot arrives: the primary reads ACKs only after sending all of it,
+        // so ACKs on every drained frame could fill our send buffer and stall both sides.
+        if (snapshotLsn == 0 && !socket_.readable(std::chrono::milliseconds(0))) {
+            const std::uint64_t applied = appliedLsn_.load();
+            if (applied >= primaryLsn_.load()) caughtUp();
+            (void)socket_.sendFrame(controlMessage(replication::ACK, applied));   // a failure shows on the next recv
+            notifyProgress();
+        }
+    }
+    connected_ = false;
+    notifyProgress();
+}
+
+void ReplicationFollower::notifyProgress() {
+    { std::lock_guard lock(waitMtx_); }      // a waiter between its check and its wait cannot miss this
+    progressed_.notify_all();
+}
+
+void ReplicationFollower::caughtUp() {
+    caughtUpAtNs_.store(steadyNowNs(), std::memory_order_release);
+}
+
+// Replays one record through the public API and checks the replica assigned the primary's IDs.
+bool ReplicationFollower::apply(const BookingService::LogRecord& record) {
+    using Type = BookingService::LogRecord::Type;
+    switch (record.type) {
+    case Type::AddMovie:
+        return replica_.addMovie(record.text) == record.id;
+    case Type::AddTheater:
+        return replica_.addTheater(record.text) == record.id;
+    case Type::CreateShow:
+        return replica_.createShow(record.movieId, record.theaterId, record.id) == record.id;
+    case Type::RemoveShow:
+        return replica_.removeShow(record.id);
+    case Type::Book:
+        return replica_.bookTicket(record.id, seatLabels(record.seatMask), record.customerId) == record.ticketId;
+    case Type::Noop:
+        return true;
+    case Type::ShowSeats:
+    case Type::Snapshot:
+        return false;                                // only valid inside a snapshot
+    }
+    return false;
+}
+
+/**
+ * The function `applySnapshot` brings the replica to the state of a snapshot. The replica holds
+ * a prefix of the primary's history, so the difference is: movies and theaters added since (IDs
+ * are dense, so they must get the same IDs here), shows removed or created since, seats booked
+ * since, and the ticket IDs issued since. Seats the replica has booked that the snapshot does not
+ * mean the histories differ.
+ *
+ * @return false if the snapshot cannot be reconciled with the replica.
+ *
+ * Time complexity: O(M + T + S * TOTAL_SEATS) for the catalog sizes of the snapshot and the replica.
+ * Space complexity: O(M + T + S)
+ */
+bool ReplicationFollower::applySnapshot(const std::vector<BookingService::LogRecord>& records) {
+    using Type = BookingService::LogRecord::Type;
+    if (records.empty() || records.back().type != Type::Snapshot) return false;
+    const long long lastTicket = records.back().ticketId;
+
+    std::unordered_set<int> movies, theaters;
+    for (const auto& [id, title] : replica_.getAllMovies()) movies.insert(id);
+    for (const auto& [id, name] : replica_.getAllTheaters()) theaters.insert(id);
+    std::unordered_map<long long, std::uint32_t> wanted;     // Show ID -> booked seats in the snapshot
+    for (const auto& record : records) {
+        if (record.type == Type::CreateShow) wanted.emplace(record.id, 0);
+        else if (record.type == Type::ShowSeats) wanted[record.id] |= record.seatMask;
+    }
+
+    std::unordered_map<long long, std::pair<int, int>> present;   // Show ID -> (movie, theater)
+    for (const auto& show : replica_.getAllShowViews()) {
+        if (!wanted.count(show.id)) {
+            if (!replica_.removeShow(show.id)) return false;
+        } else {
+            present.emplace(show.id, std::make_pair(show.movieId, show.theaterId));
+        }
+    }
+
+    for (const auto& record : records) {
+        switch (record.type) {
+        case Type::AddMovie:
+            if (!movies.count(static_cast<int>(record.id)) && replica_.addMovie(record.text) != record.id) return false;
+            break;
+        case Type::AddTheater:
+            if (!theaters.count(static_cast<int>(record.id)) && replica_.addTheater(record.text) != record.id) return false;
+            break;
+        case Type::CreateShow: {
+            const auto it = present.find(record.id);
+            if (it != present.end() ? it->second != std::make_pair(record.movieId, record.theaterId)
+                                    : replica_.createShow(record.movieId, record.theaterId, record.id) != record.id)
+                return false;
+            break;
+        }
+        default:
+            break;
+        }
+    }
+
+    for (const auto& [showId, seatMask] : wanted) {
+        std::uint32_t booked = ~std::uint32_t{0} >> (32 - BookingService::TOTAL_SEATS);
+        for (const std::string& label : replica_.getAvailableSeats(showId))
+            booked &= ~(std::uint32_t{1} << BookingService::seatIndexFromLabel(label));
+        if (booked & ~seatMask) return false;
+        if (seatMask & ~booked) {
+            const long long ticketId = replica_.bookTicket(showId, seatLabels(seatMask & ~booked), TicketStore::ANONYMOUS_CUSTOMER);
+            if (ticketId < 1 || ticketId > lastTicket) return false;
+        }
+    }
+    return replica_.skipTicketIds(lastTicket);
+}
+
+/**
+ * The function `status` reports how far the follower is behind the primary, in records and as
+ * staleness (time since it last knew it was fully caught up; maximal before the first time).
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+ReplicationFollower::Status ReplicationFollower::status() const {
+    Status s;
+    s.connected = connected_.load();
+    s.diverged = diverged_.load();
+    s.appliedLsn = appliedLsn_.load();
+    s.primaryLsn = std::max(primaryLsn_.load(), s.appliedLsn);
+    s.lagRecords = s.primaryLsn - s.appliedLsn;
+    s.snapshotsApplied = snapshotsApplied_.load();
+    const std::int64_t at = caughtUpAtNs_.load(std::memory_order_acquire);
+    s.staleness = at == 0 ? std::chrono::steady_clock::duration::max()
+                          : std::chrono::steady_clock::duration(std::chrono::nanoseconds(steadyNowNs() - at));
+    return s;
+}
+
+bool ReplicationFollower::withinStaleness(std::chrono::steady_clock::duration bound) const {
+    return !diverged_.load() && status().staleness <= bound;
+}
+
+/**
+ * The function `waitForLsn` blocks until the follower has applied `lsn` (e.g. the primary's
+ * lastLsn() right after a write), giving read-your-writes on the follower.
+ *
+ * @return true once applied; false on timeout or if replication stopped first.
+ */
+bool ReplicationFollower::waitForLsn(std::uint64_t lsn, std::chrono::milliseconds timeout) const {
+    std::unique_lock lock(waitMtx_);
+    return progressed_.wait_for(lock, timeout, [&] {
+        return appliedLsn_.load() >= lsn || diverged_.load() || stopping_.load();
+    }) && appliedLsn_.load() >= lsn;
+}
+
+} // namespace booking
@@ -0,0 +1,645 @@
+#include "ShardRouter.hpp"
+#include "ShardServer.hpp"
+#include <algorithm>
+#include <bit>
+#include <cctype>
+#include <iostream>
+#include <stdexcept>
+
+namespace booking {
+
+namespace {
+
+std::string toLower(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c) { return std::tolower(c); });
+    return s;
+}
+
+long long showKey(int movieId, int theaterId) {
+    return (static_cast<long long>(movieId) << 32) | static_cast<unsigned>(theaterId);
+}
+
+std::string catalogRequest(shard_protocol::Op op, int id, std::string_view text) {
+    return FrameWriter().put<std::uint8_t>(op).put<std::int32_t>(id).putString(text).take();
+}
+
+std::string adoptRequest(long long id, long long lastId, int movieId, int theaterId, std::uint32_t booked) {
+    return FrameWriter().put<std::uint8_t>(shard_protocol::ADOPT_SHOW)
+        .put<std::int64_t>(id).put<std::int64_t>(lastId).put<std::int32_t>(movieId).put<std::int32_t>(theaterId)
+        .put(booked).take();
+}
+
+std::string showRequest(shard_protocol::Op op, long long id) {
+    return FrameWriter().put<std::uint8_t>(op).put<std::int64_t>(id).take();
+}
+
+std::string txRequest(shard_protocol::Op op, std::uint64_t txId) {
+    return FrameWriter().put<std::uint8_t>(op).put(txId).take();
+}
+
+std::string prepareRequest(std::uint64_t txId, long long customerId, const CoordinatorLog::Participant& participant) {
+    FrameWriter out;
+    out.put<std::uint8_t>(shard_protocol::PREPARE).put(txId).put<std::int64_t>(customerId)
+       .put(static_cast<std::uint32_t>(participant.legs.size()));
+    for (const auto& leg : participant.legs) out.put<std::int64_t>(leg.showId).put(leg.seatMask);
+    return out.take();
+}
+
+// Seat bitmap for labels, reporting the first invalid or repeated one; nullopt if any.
+std::optional<std::uint32_t> seatMaskOf(const std::vector<std::string>& seatLabels) {
+    std::uint32_t mask = 0;
+    for (const auto& lbl : seatLabels) {
+        const int idx = BookingService::seatIndexFromLabel(lbl);
+        if (idx < 0 || (mask & (std::uint32_t{1} << idx))) {
+            std::cerr << (idx < 0 ? "Invalid seat: " : "Duplicate seat: ") << lbl << '\n';
+            return std::nullopt;
+        }
+        mask |= std::uint32_t{1} << idx;
+    }
+    return mask;
+}
+
+} // namespace
+
+// ----------------- Shard RPC -----------------
+std::optional<std::string> ShardRouter::call(Shard& shard, const std::string& request) const {
+    std::lock_guard lock(shard.mtx);
+    std::string response;
+    if (!shard.socket.sendFrame(request) || !shard.socket.recvFrame(response)) {
+        std::cerr << "Shard unavailable: " << shard.path << '\n';
+        return std::nullopt;
+    }
+    return response;
+}
+
+std::string ShardRouter::withDeadline(std::string request) const {
+    const std::uint32_t budget = deadlineMicros_.load(std::memory_order_relaxed);
+    if (budget == 0) return request;
+    return FrameWriter().put<std::uint8_t>(shard_protocol::DEADLINE).put(budget).take() + request;
+}
+
+void ShardRouter::setRequestDeadline(std::chrono::microseconds budget) noexcept {
+    deadlineMicros_.store(static_cast<std::uint32_t>(std::clamp<long long>(budget.count(), 0, UINT32_MAX)), std::memory_order_relaxed);
+}
+
+std::optional<long long> ShardRouter::callForId(Shard& shard, const std::string& request) const {
+    const auto response = call(shard, request);
+    if (!response) return std::nullopt;
+    FrameReader in(*response);
+    const auto id = in.get<std::int64_t>();
+    if (in.failed()) return std::nullopt;
+    return id;
+}
+
+// Reaches a participant by socket path: through its router connection if it is one of ours,
+// otherwise (a transaction logged before a restart) over a connection of its own.
+std::optional<std::string> ShardRouter::callPath(const std::string& path, const std::string& request) const {
+    for (const auto& shard : shards_)
+        if (shard->path == path) return call(*shard, request);
+    LocalSocket socket = LocalSocket::connect(path);
+    std::string response;
+    if (!socket.valid() || !socket.sendFrame(request) || !socket.recvFrame(response)) {
+        std::cerr << "Shard unavailable: " << path << '\n';
+        return std::nullopt;
+    }
+    return response;
+}
+
+std::optional<std::vector<ShardRouter::ShardShow>> ShardRouter::listShard(Shard& shard) const {
+    const auto response = call(shard, FrameWriter().put<std::uint8_t>(shard_protocol::LIST).take());
+    if (!response) return std::nullopt;
+    return parseList(*response);
+}
+
+std::optional<std::vector<ShardRouter::ShardShow>> ShardRouter::parseList(std::string_view response) {
+    FrameReader in(response);
+    const auto n = in.get<std::int64_t>();
+    std::vector<ShardShow> shows;
+    shows.reserve(in.failed() || n < 0 ? 0 : static_cast<std::size_t>(std::min<std::int64_t>(n, response.size())));
+    for (std::int64_t i = 0; i < n && !in.failed(); ++i) {
+        ShardShow show{};
+        show.id = in.get<std::int64_t>();
+        show.movieId = in.get<std::int32_t>();
+        show.theaterId = in.get<std::int32_t>();
+        show.booked = in.get<std::uint32_t>();
+        shows.push_back(show);
+    }
+    if (in.failed()) return std::nullopt;
+    return shows;
+}
+
+ShardRouter::Shard& ShardRouter::ownerOf(long long showId) const {
+    return *shards_[ring_.owner(static_cast<std::uint64_t>(showId))];
+}
+
+// ----------------- Topology -----------------
+/**
+ * The function `addShard` connects a new shard, replays the catalog to it and moves to it the
+ * shows it owns on the extended ring. Shows are first copied (seat state included); only when
+ * every copy succeeded are the originals removed and the ring switched, so a failure leaves the
+ * deployment as it was. Requests wait while this runs.
+ *
+ * @param socketPath Socket of a ShardServer with an empty BookingService.
+ *
+ * @return Shows moved to the new shard, or std::nullopt if it could not be added.
+ *
+ * Time complexity: O(S) listing + O(K log K) for the K ~ S / (N + 1) shows copied, for S shows on N shards.
+ * Space complexity: O(S / N) for one shard's listing at a time plus the shows moved.
+ */
+std::optional<std::size_t> ShardRouter::addShard(const std::string& socketPath) {
+    auto shard = std::make_unique<Shard>();
+    shard->path = socketPath;
+    shard->socket = LocalSocket::connect(socketPath);
+    if (!shard->socket.valid()) {
+        std::cerr << "Cannot connect to shard: " << socketPath << '\n';
+        return std::nullopt;
+    }
+
+    std::unique_lock topology(topologyMtx_);
+    long long lastShow = 0;                                     // createShow waits for topologyMtx_
+    {
+        std::shared_lock catalog(catalogMtx_);
+        lastShow = showCounter_;
+        for (std::size_t i = 0; i < movies_.size(); ++i)
+            if (callForId(*shard, catalogRequest(shard_protocol::ADD_MOVIE, static_cast<int>(i + 1), movies_[i])) !=
+                static_cast<long long>(i + 1)) {
+                std::cerr << "Shard rejected the catalog: " << socketPath << '\n';
+                return std::nullopt;
+            }
+        for (std::size_t i = 0; i < theaters_.size(); ++i)
+            if (callForId(*shard, catalogRequest(shard_protocol::ADD_THEATER, static_cast<int>(i + 1), theaters_[i])) !=
+                static_cast<long long>(i + 1)) {
+                std::cerr << "Shard rejected the catalog: " << socketPath << '\n';
+                return std::nullopt;
+            }
+    }
+
+    const auto node = static_cast<std::uint32_t>(shards_.size());
+    ConsistentHashRing next = ring_;
+    next.addNode(node);
+
+    // Copy phase: the new owner adopts each show it takes over, in ascending ID order so that its
+    // highest ID grows step by step (createShow refuses IDs far above it)
+    std::vector<std::pair<std::size_t, ShardShow>> taken;       // (old shard, show)
+    bool ok = true;
+    for (std::size_t s = 0; s < shards_.size() && ok; ++s) {
+        const auto shows = listShard(*shards_[s]);
+        ok = shows.has_value();
+        if (!ok) break;
+        for (const ShardShow& show : *shows)
+            if (next.owner(static_cast<std::uint64_t>(show.id)) == node) taken.emplace_back(s, show);
+    }
+    std::sort(taken.begin(), taken.end(), [](const auto& a, const auto& b) { return a.second.id < b.second.id; });
+    std::vector<std::pair<std::size_t, long long>> moved;       // (old shard, show ID)
+    for (std::size_t i = 0; ok && i < taken.size(); ++i) {
+        const auto& [from, show] = taken[i];
+        ok = callForId(*shard, adoptRequest(show.id, lastShow, show.movieId, show.theaterId, show.booked)) == show.id;
+        if (ok) moved.emplace_back(from, show.id);
+    }
+    if (!ok) {
+        std::cerr << "Adding shard " << socketPath << " failed; keeping the current layout\n";
+        for (const auto& [from, id] : moved) (void)callForId(*shard, showRequest(shard_protocol::REMOVE_SHOW, id));
+        return std::nullopt;
+    }
+
+    // Switch phase: drop the originals, then route to the new layout
+    for (const auto& [from, id] : moved)
+        if (callForId(*shards_[from], showRequest(shard_protocol::REMOVE_SHOW, id)) != 1)
+            std::cerr << "Shard " << shards_[from]->path << " kept a stale copy of show " << id << '\n';
+    shards_.push_back(std::move(shard));
+    ring_ = std::move(next);
+    return moved.size();
+}
+
+std::size_t ShardRouter::shardCount() const {
+    std::shared_lock topology(topologyMtx_);
+    return shards_.size();
+}
+
+std::size_t ShardRouter::shardOf(long long showId) const {
+    std::shared_lock topology(topologyMtx_);
+    return ring_.owner(static_cast<std::uint64_t>(showId));
+}
+
+// ----------------- Catalog -----------------
+/**
+ * The function `addMovie` assigns the next movie ID and adds the movie under that ID on every
+ * shard, so the IDs agree across shards even if one shard misses a request. A movie some shard
+ * did not take stays pending: shows cannot use it, and adding the same title again resends it
+ * (shards that already have it answer with its ID) until every shard has it.
+ *
+ * @return The movie ID; -1 for a duplicate title (case-insensitive) or if a shard did not take it.
+ *
+ * Time complexity: O(N) shard round trips.
+ * Space complexity: O(1)
+ */
+int ShardRouter::addMovie(const std::string& title) {
+    std::string lowerTitle = toLower(title);
+    std::shared_lock topology(topologyMtx_);
+    std::unique_lock catalog(catalogMtx_);
+    int id = 0;
+    if (auto it = movieNameToId_.find(lowerTitle); it != movieNameToId_.end()) {
+        if (!pendingMovies_.count(it->second)) {
+            std::cerr << "Movie \"" << title << "\" already exists (ID: " << it->second << ")\n";
+            return -1;
+        }
+        id = it->second;
+    } else {
+        movies_.push_back(title);
+        id = static_cast<int>(movies_.size());
+        movieNameToId_.emplace(std::move(lowerTitle), id);
+    }
+
+    bool ok = true;
+    for (const auto& shard : shards_)
+        ok = callForId(*shard, catalogRequest(shard_protocol::ADD_MOVIE, id, movies_[id - 1])) == id && ok;
+    if (ok) pendingMovies_.erase(id);
+    else pendingMovies_.insert(id);
+    return ok ? id : -1;
+}
+
+int ShardRouter::addTheater(const std::string& name) {
+    std::string lowerName = toLower(name);
+    std::shared_lock topology(topologyMtx_);
+    std::unique_lock catalog(catalogMtx_);
+    int id = 0;
+    if (auto it = theaterNameToId_.find(lowerName); it != theaterNameToId_.end()) {
+        if (!pendingTheaters_.count(it->second)) {
+            std::cerr << "Theater \"" << name << "\" already exists (ID: " << it->second << ")\n";
+            return -1;
+        }
+        id = it->second;
+    } else {
+        theaters_.push_back(name);
+        id = static_cast<int>(theaters_.size());
+        theaterNameToId_.emplace(std::move(lowerName), id);
+    }
+
+    bool ok = true;
+    for (const auto& shard : shards_)
+        ok = callForId(*shard, catalogRequest(shard_protocol::ADD_THEATER, id, theaters_[id - 1])) == id && ok;
+    if (ok) pendingTheaters_.erase(id);
+    else pendingTheaters_.insert(id);
+    return ok ? id : -1;
+}
+
+/**
+ * The function `createShow` assigns the next show ID and creates the show on the shard that owns
+ * that ID on the ring.
+ *
+ * @return The show ID, or -1 for an unknown movie/theater, a duplicate pair, no shards, or a
+ * shard failure.
+ *
+ * Time complexity: O(log(N * VIRTUAL_NODES)) + one shard round trip.
+ * Space complexity: O(1)
+ */
+long long ShardRouter::createShow(int movieId, int theaterId) {
+    std::shared_lock topology(topologyMtx_);
+    if (shards_.empty()) {
+        std::cerr << "No shards to place the show on\n";
+        return -1;
+    }
+    std::unique_lock catalog(catalogMtx_);
+    if (movieId < 1 || static_cast<std::size_t>(movieId) > movies_.size() || pendingMovies_.count(movieId)) {
+        std::cerr << "Invalid movie ID: " << movieId << '\n';
+        return -1;
+    }
+    if (theaterId < 1 || static_cast<std::size_t>(theaterId) > theaters_.size() || pendingTheaters_.count(theaterId)) {
+        std::cerr << "Invalid theater ID: " << theaterId << '\n';
+        return -1;
+    }
+    const long long key = showKey(movieId, theaterId);
+    if (!showKeys_.insert(key).second) {
+        std::cerr << "Duplicate show for movie " << movieId << " and theater " << theaterId << '\n';
+        return -1;
+    }
+    const long long id = ++showCounter_;
+    if (callForId(ownerOf(id), adoptRequest(id, id, movieId, theaterId, 0)) != id) {
+        showKeys_.erase(key);
+        return -1;
+    }
+    return id;
+}
+
+std::vector<std::pair<int, std::string>> ShardRouter::getAllMovies() const {
+    std::shared_lock catalog(catalogMtx_);
+    std::vector<std::pair<int, std::string>> result;
+    result.reserve(movies_.size());
+    for (std::size_t i = 0; i < movies_.size(); ++i) result.emplace_back(static_cast<int>(i + 1), movies_[i]);
+    return result;
+}
+
+std::vector<std::pair<int, std::string>> ShardRouter::getAllTheaters() const {
+    std::shared_lock catalog(catalogMtx_);
+    std::vector<std::pair<int, std::string>> result;
+    result.reserve(theaters_.size());
+    for (std::size_t i = 0; i < theaters_.size(); ++i) result.emplace_back(static_cast<int>(i + 1), theaters_[i]);
+    return result;
+}
+
+// ----------------- Seats -----------------
+/**
+ * The function `bookSeats` validates the labels locally and books them on the owning shard.
+ *
+ * @return true if every seat was free and is now booked.
+ *
+ * Time complexity: O(k) for k labels + one shard round trip.
+ * Space complexity: O(1)
+ */
+bool ShardRouter::bookSeats(long long showId, const std::vector<std::string>& seatLabels) {
+    const auto seatMask = seatMaskOf(seatLabels);
+    if (!seatMask || *seatMask == 0) return false;
+    const std::uint32_t mask = *seatMask;
+
+    std::shared_lock topology(topologyMtx_);
+    if (shards_.empty()) return false;
+    const auto request = FrameWriter().put<std::uint8_t>(shard_protocol::BOOK).put<std::int64_t>(showId).put(mask).take();
+    const auto ticket = callForId(ownerOf(showId), withDeadline(request));
+    if (ticket == shard_protocol::SHED) std::cerr << "Shard overloaded; booking for show " << showId << " shed\n";
+    return ticket && *ticket > 0;
+}
+
+/**
+ * The function `getAvailableSeats` asks the owning shard for the show's seat map.
+ *
+ * @return Available seat labels. Throws std::invalid_argument for an unknown show and
+ * std::runtime_error if the owning shard is unreachable or shed the request.
+ *
+ * Time complexity: O(TOTAL_SEATS) + one shard round trip.
+ * Space complexity: O(TOTAL_SEATS)
+ */
+std::vector<std::string> ShardRouter::getAvailableSeats(long long showId) const {
+    std::shared_lock topology(topologyMtx_);
+    if (shards_.empty()) throw std::invalid_argument("Invalid show ID");
+    const auto response = call(ownerOf(showId), withDeadline(showRequest(shard_protocol::SEATS, showId)));
+    if (!response) throw std::runtime_error("Shard unavailable");
+    FrameReader in(*response);
+    const auto status = in.get<std::int64_t>();
+    if (status == shard_protocol::SHED) throw std::runtime_error("Shard overloaded");
+    if (status != 1) throw std::invalid_argument("Invalid show ID");
+    const auto booked = in.get<std::uint32_t>();
+
+    std::vector<std::string> available;
+    available.reserve(BookingService::TOTAL_SEATS - std::popcount(booked));
+    for (int i = 0; i < BookingService::TOTAL_SEATS; ++i)
+        if (!(booked & (std::uint32_t{1} << i))) available.emplace_back(BookingService::seatLabelFromIndex(i));
+    return available;
+}
+
+/**
+ * The function `getAllShows` scatters a LIST request to every shard, then gathers the replies:
+ * all requests are sent before any reply is read, so the shards list in parallel. Rows are
+ * merged in show ID order and named from the router's catalog. Shards that do not answer are
+ * left out (with a message on std::cerr).
+ *
+ * Time complexity: O(S log S) for S shows.
+ * Space complexity: O(S)
+ */
+std::vector<ShardRouter::ShowInfo> ShardRouter::getAllShows() const {
+    std::shared_lock topology(topologyMtx_);
+    std::vector<std::unique_lock<std::mutex>> locks;             // Index order, as every multi-shard path
+    locks.reserve(shards_.size());
+    for (const auto& shard : shards_) locks.emplace_back(shard->mtx);
+
+    const std::string request = FrameWriter().put<std::uint8_t>(shard_protocol::LIST).take();
+    std::vector<bool> sent(shards_.size());
+    for (std::size_t s = 0; s < shards_.size(); ++s) sent[s] = shards_[s]->socket.sendFrame(request);
+
+    std::vector<ShardShow> rows;
+    std::string response;
+    for (std::size_t s = 0; s < shards_.size(); ++s) {
+        if (!sent[s] || !shards_[s]->socket.recvFrame(response)) {
+            std::cerr << "Shard unavailable: " << shards_[s]->path << '\n';
+            continue;
+        }
+        if (auto shows = parseList(response))
+            rows.insert(rows.end(), shows->begin(), shows->end());
+        else
+            std::cerr << "Malformed listing from shard: " << shards_[s]->path << '\n';
+    }
+    locks.clear();
+    topology.unlock();
+
+    std::sort(rows.begin(), rows.end(), [](const ShardShow& a, const ShardShow& b) { return a.id < b.id; });
+    std::shared_lock catalog(catalogMtx_);
+    std::vector<ShowInfo> result;
+    result.reserve(rows.size());
+    for (const ShardShow& row : rows)
+        result.push_back({row.id, movies_.at(row.movieId - 1), theaters_.at(row.theaterId - 1),
+                          BookingService::TOTAL_SEATS - std::popcount(row.booked)});
+    return result;
+}
+
+// ----------------- Transactions -----------------
+/**
+ * The function `openTransactionLog` makes the router a two-phase commit coordinator backed by
+ * the log at `path`, then finishes the transactions a previous run left in doubt (see
+ * resolveInDoubt). Call it after the shards have been added.
+ *
+ * @return false if the log cannot be opened; bookAcrossShows() then keeps failing.
+ */
+bool ShardRouter::openTransactionLog(const std::string& path) {
+    auto log = CoordinatorLog::open(path);
+    if (!log) return false;
+    {
+        std::unique_lock topology(topologyMtx_);
+        txLog_ = std::move(log);
+    }
+    if (const std::size_t left = resolveInDoubt(); left > 0)
+        std::cerr << left << " transaction(s) still in doubt in " << path << '\n';
+    return true;
+}
+
+/**
+ * The function `bookAcrossShows` books seats in shows that may live on different shards, all or
+ * nothing, by two-phase commit:
+ *  1. BEGIN is logged (and synced) with every participant and the seats it will hold;
+ *  2. each participant is asked to PREPARE, i.e. hold its seats; one refusal aborts;
+ *  3. with every vote yes, COMMIT is logged (and synced), and only then sent to the participants;
+ *     otherwise ABORT is sent;
+ *  4. once every participant acknowledged, END is logged.
+ * A transaction that cannot complete step 4 stays in doubt; its seats stay held (if aborting) or
+ * its tickets unissued (if committing) until resolveInDoubt() reaches the participants.
+ *
+ * @param legs Show IDs and the seats wanted in each; at least one, and a show may appear only once.
+ *
+ * @return One ticket ID per leg, in the order of `legs`, or an empty vector on failure: `legs` is
+ * empty, or the transaction aborted (unknown show, bad label, seat taken, shard unreachable before
+ * the decision, or no transaction log). After a commit, a leg whose shard could not be reached has ticket -1 for now.
+ *
+ * Time complexity: O(K) for K seats + 2 round trips per participant + 2 log syncs.
+ * Space complexity: O(L), L = legs.
+ */
+std::vector<long long> ShardRouter::bookAcrossShows(std::span<const ShowSeats> legs, long long customerId) {
+    if (legs.empty()) {
+        std::cerr << "No shows to book\n";
+        return {};
+    }
+    std::vector<std::uint32_t> masks;
+    std::unordered_set<long long> seen;
+    for (const ShowSeats& leg : legs) {
+        const auto mask = seatMaskOf(leg.seatLabels);
+        if (!mask) return {};
+        if (!seen.insert(leg.showId).second) {
+            std::cerr << "Duplicate show: " << leg.showId << '\n';
+            return {};
+        }
+        masks.push_back(*mask);
+    }
+
+    std::shared_lock topology(topologyMtx_);
+    if (!txLog_) {
+        std::cerr << "No transaction log; call openTransactionLog() first\n";
+        return {};
+    }
+    if (shards_.empty()) {
+        std::cerr << "No shards to book on\n";
+        return {};
+    }
+
+    // One participant per owning shard, legs kept in request order within it
+    CoordinatorLog::Transaction tx;
+    tx.customerId = customerId;
+    std::vector<std::size_t> shardOfParticipant;
+    std::vector<std::pair<std::size_t, std::size_t>> placement;     // Per leg: (participant, index in it)
+    for (std::size_t i = 0; i < legs.size(); ++i) {
+        const std::size_t shard = ring_.owner(static_cast<std::uint64_t>(legs[i].showId));
+        auto it = std::find(shardOfParticipant.begin(), shardOfParticipant.end(), shard);
+        const auto p = static_cast<std::size_t>(it - shardOfParticipant.begin());
+        if (it == shardOfParticipant.end()) {
+            shardOfParticipant.push_back(shard);
+            tx.participants.push_back({shards_[shard]->path, {}});
+        }
+        placement.emplace_back(p, tx.participants[p].legs.size());
+        tx.participants[p].legs.push_back({legs[i].showId, masks[i]});
+    }
+
+    const auto txId = txLog_->begin(customerId, tx.participants);
+    if (!txId) return {};
+    tx.id = *txId;
+    {
+        std::lock_guard lock(txMtx_);
+        activeTx_.insert(tx.id);
+    }
+
+    bool votedYes = true;
+    for (std::size_t p = 0; p < tx.participants.size() && votedYes; ++p)
+        votedYes = callForId(*shards_[shardOfParticipant[p]], prepareRequest(tx.id, customerId, tx.participants[p])) == 1;
+    tx.decision = votedYes && txLog_->decide(tx.id, CoordinatorLog::Decision::Commit)
+                      ? CoordinatorLog::Decision::Commit : CoordinatorLog::Decision::Abort;
+    if (tx.decision == CoordinatorLog::Decision::Abort) (void)txLog_->decide(tx.id, tx.decision);
+
+    std::vector<long long> participantTickets;
+    const bool finished = finish(tx, &participantTickets);
+    const bool ended = finished && txLog_->end(tx.id);
+    {
+        std::lock_guard lock(txMtx_);
+        activeTx_.erase(tx.id);
+        endedSinceForget_ += ended ? 1 : 0;
+    }
+    forgetEnded();
+    if (tx.decision == CoordinatorLog::Decision::Abort) return {};
+
+    // participantTickets holds each participant's tickets in turn, -1 where none came back
+    std::vector<std::size_t> firstLeg(tx.participants.size(), 0);
+    for (std::size_t p = 1; p < tx.participants.size(); ++p)
+        firstLeg[p] = firstLeg[p - 1] + tx.participants[p - 1].legs.size();
+    std::vector<long long> tickets;
+    tickets.reserve(legs.size());
+    for (const auto& [p, index] : placement) tickets.push_back(participantTickets[firstLeg[p] + index]);
+    return tickets;
+}
+
+/**
+ * The function `finish` delivers a transaction's outcome to every participant: COMMIT when the
+ * decision is Commit, ABORT otherwise (presumed abort). Participants treat repeats as no-ops, so
+ * this is safe to retry. With `tickets`, the tickets returned by the participants are appended in
+ * participant and leg order, -1 for any participant that did not answer.
+ *
+ * @return true once every participant acknowledged; the transaction may then be ended.
+ */
+bool ShardRouter::finish(const CoordinatorLog::Transaction& tx, std::vector<long long>* tickets) {
+    const bool commit = tx.decision == CoordinatorLog::Decision::Commit;
+    bool acknowledged = true;
+    for (const auto& participant : tx.participants) {
+        const auto response = callPath(participant.path, txRequest(commit ? shard_protocol::COMMIT : shard_protocol::ABORT, tx.id));
+        std::vector<long long> issued;
+        bool ok = response.has_value();
+        if (ok) {
+            FrameReader in(*response);
+            const auto n = in.get<std::int64_t>();
+            if (commit) {
+                for (std::int64_t i = 0; i < n && !in.failed(); ++i) issued.push_back(in.get<std::int64_t>());
+                ok = !in.failed() && issued.size() == participant.legs.size();
+            } else {
+                ok = !in.failed() && n == 1;
+            }
+            if (!ok) std::cerr << "Shard " << participant.path << " did not apply the outcome of transaction " << tx.id << '\n';
+        }
+        if (!ok) issued.assign(participant.legs.size(), -1);
+        if (tickets) tickets->insert(tickets->end(), issued.begin(), issued.end());
+        acknowledged = acknowledged && ok;
+    }
+    return acknowledged;
+}
+
+/**
+ * The function `resolveInDoubt` finishes transactions that were begun but never ended, whether
+ * by this router (a participant was unreachable) or by one that crashed: those with a logged
+ * COMMIT are committed on every participant, all others aborted. Transactions still in flight
+ * in bookAcrossShows() are left alone.
+ *
+ * @return The number of transactions still unfinished (some participant is unreachable).
+ *
+ * Time complexity: O(T * P) round trips for T unfinished transactions of P participants.
+ * Space complexity: O(T)
+ */
+std::size_t ShardRouter::resolveInDoubt() {
+    std::shared_lock topology(topologyMtx_);
+    if (!txLog_) return 0;
+    std::size_t remaining = 0;
+    for (const auto& tx : txLog_->unfinished()) {
+        {
+            std::lock_guard lock(txMtx_);
+            if (activeTx_.count(tx.id)) continue;
+        }
+        if (!finish(tx, nullptr)) {
+            ++remaining;
+        } else if (txLog_->end(tx.id)) {
+            std::lock_guard lock(txMtx_);
+            ++endedSinceForget_;
+        }
+    }
+    forgetEnded();
+    return remaining;
+}
+
+/**
+ * The function `forgetEnded` lets the shards drop the outcomes of ended transactions: once
+ * FORGET_INTERVAL transactions have ended since the last broadcast, it syncs the log (so those
+ * ENDs survive a crash and recovery never asks about them again) and sends every shard a FORGET
+ * with the log's watermark. A shard that misses one catches up with the next.
+ *
+ * Time complexity: amortized O(N / FORGET_INTERVAL) round trips per ended transaction, N shards.
+ * Space complexity: O(1)
+ */
+void ShardRouter::forgetEnded() {
+    {
+        std::lock_guard lock(txMtx_);
+        if (endedSinceForget_ < FORGET_INTERVAL) return;
+        endedSinceForget_ = 0;
+    }
+    const auto watermark = txLog_->endedBelow();
+    if (!watermark) return;
+    {
+        std::lock_guard lock(txMtx_);
+        if (*watermark <= forgottenBelow_) return;       // a long in-doubt transaction holds it back
+        forgottenBelow_ = *watermark;
+    }
+    const std::string request = txRequest(shard_protocol::FORGET, *watermark);
+    for (const auto& shard : shards_)
+        if (callForId(*shard, request) != 1)
+            std::cerr << "Shard " << shard->path << " did not take FORGET " << *watermark << '\n';
+}
+
+} // namespace booking
@@ -0,0 +1,422 @@
+#include "ShardServer.hpp"
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace booking {
+
+namespace {
+
+std::vector<std::string> labelsFromMask(std::uint32_t mask) {
+    std::vector<std::string> labels;
+    for (int i = 0; i < BookingService::TOTAL_SEATS; ++i)
+        if (mask & (std::uint32_t{1} << i)) labels.push_back(BookingService::seatLabelFromIndex(i));
+    return labels;
+}
+
+} // namespace
+
+// ----------------- Shard Server -----------------
+ShardServer::ShardServer(BookingService& service, std::string socketPath)
+    : service_(service), path_(std::move(socketPath)) {}
+
+ShardServer::~ShardServer() {
+    stop();
+}
+
+bool ShardServer::start() {
+    listener_ = LocalSocket::listen(path_);
+    if (!listener_.valid()) return false;
+    stopping_ = false;
+    acceptThread_ = std::thread([this] { acceptLoop(); });
+    return true;
+}
+
+void ShardServer::stop() {
+    if (!acceptThread_.joinable()) return;
+    stopping_ = true;
+    listener_.shutdown();
+    acceptThread_.join();
+    listener_.close();
+    ::unlink(path_.c_str());
+
+    std::lock_guard lock(mtx_);
+    for (auto& [socket, thread] : connections_) socket->shutdown();
+    for (auto& [socket, thread] : connections_)
+        if (thread.joinable()) thread.join();
+    connections_.clear();
+}
+
+void ShardServer::acceptLoop() {
+    while (!stopping_) {
+        LocalSocket socket = listener_.accept();
+        if (!socket.valid()) continue;
+        std::lock_guard lock(mtx_);
+        if (stopping_) return;
+        auto owned = std::make_unique<LocalSocket>(std::move(socket));
+        LocalSocket& connection = *owned;
+        connections_.emplace_back(std::move(owned), std::thread([this, &connection] { serve(connection); }));
+    }
+}
+
+void ShardServer::enableDeadlines(std::chrono::microseconds budget, std::size_t workers,
+                                  const DeadlineScheduler::Options& options) {
+    pool_ = std::make_unique<WorkStealingPool>(workers);
+    scheduler_ = std::make_unique<DeadlineScheduler>(*pool_, options);
+    defaultBudget_ = budget;
+}
+
+std::optional<DeadlineScheduler::Metrics> ShardServer::schedulerMetrics() const {
+    if (!scheduler_) return std::nullopt;
+    return scheduler_->metrics();
+}
+
+/**
+ * The function `serve` answers one connection's requests in order. With deadlines enabled,
+ * BOOK and SEATS requests (bare or in a DEADLINE envelope) go through the scheduler; the
+ * connection thread waits for their answer. Everything else runs inline.
+ */
+void ShardServer::serve(LocalSocket& connection) {
+    using namespace shard_protocol;
+    std::string request;
+    while (!stopping_ && connection.recvFrame(request)) {
+        const auto arrival = DeadlineScheduler::Clock::now();
+        auto budget = defaultBudget_;
+        FrameReader in(request);
+        std::uint8_t op = in.get<std::uint8_t>();
+        if (op == DEADLINE) {
+            budget = std::chrono::microseconds(in.get<std::uint32_t>());
+            const std::size_t header = sizeof(std::uint8_t) + sizeof(std::uint32_t);
+            request.erase(0, std::min(header, request.size()));
+            op = FrameReader(request).get<std::uint8_t>();
+        }
+        const bool scheduled = scheduler_ && (op == BOOK || op == SEATS);
+        if (!connection.sendFrame(scheduled ? schedule(std::move(request), budget, arrival) : handle(request))) break;
+    }
+}
+
+// Runs a point request through the scheduler and waits for its answer (SHED if dropped).
+std::string ShardServer::schedule(std::string request, std::chrono::microseconds budget,
+                                  DeadlineScheduler::Clock::time_point arrival) {
+    FrameReader in(request);
+    in.get<std::uint8_t>();
+    const auto showId = in.get<std::int64_t>();
+
+    auto answer = std::make_shared<std::promise<std::string>>();
+    auto response = answer->get_future();
+    scheduler_->submit(
+        arrival + budget,
+        [this, answer, request = std::move(request)] { answer->set_value(handle(request)); },
+        [answer](DeadlineScheduler::ShedReason) { answer->set_value(FrameWriter().put<std::int64_t>(shard_protocol::SHED).take()); },
+        static_cast<std::size_t>(showId));
+    return response.get();
+}
+
+std::string ShardServer::stats() const {
+    FrameWriter out;
+    if (!scheduler_) return out.put<std::int64_t>(-1).take();
+    const auto m = scheduler_->metrics();
+    out.put(m.submitted).put(m.completed).put(m.shedDeadline).put(m.shedQueueFull).put(m.lateCompletions)
+       .put(static_cast<std::uint32_t>(m.limit)).put(static_cast<std::uint32_t>(m.queued))
+       .put(m.queueTime.valueAtPercentile(50)).put(m.queueTime.valueAtPercentile(99))
+       .put(m.queueTime.valueAtPercentile(99.9)).put(m.queueTime.max());
+    return out.take();
+}
+
+/**
+ * The function `seatMask` returns the booked-seat bitmap of a show (bit i = seat index i).
+ * Throws std::invalid_argument for an unknown show ID.
+ *
+ * Time complexity: O(TOTAL_SEATS)
+ * Space complexity: O(TOTAL_SEATS)
+ */
+std::uint32_t ShardServer::seatMask(const BookingService& service, long long showId) {
+    std::uint32_t booked = (BookingService::TOTAL_SEATS == 32) ? ~std::uint32_t{0}
+                                                              : (std::uint32_t{1} << BookingService::TOTAL_SEATS) - 1;
+    for (const std::string& label : service.getAvailableSeats(showId))
+        booked &= ~(std::uint32_t{1} << BookingService::seatIndexFromLabel(label));
+    return booked;
+}
+
+// Decodes one request, runs it against the service and encodes the response.
+std::string ShardServer::handle(const std::string& request) {
+    using namespace shard_protocol;
+    FrameReader in(request);
+    FrameWriter out;
+    const auto op = in.get<std::uint8_t>();
+    switch (op) {
+    case ADD_MOVIE: {
+        const auto id = in.get<std::int32_t>();
+        const std::string title(in.getString());
+        out.put<std::int64_t>(in.failed() || id < 1 ? -1 : service_.addMovie(title, id));
+        break;
+    }
+    case ADD_THEATER: {
+        const auto id = in.get<std::int32_t>();
+        const std::string name(in.getString());
+        out.put<std::int64_t>(in.failed() || id < 1 ? -1 : service_.addTheater(name, id));
+        break;
+    }
+    case ADOPT_SHOW: {
+        const auto id = in.get<std::int64_t>();
+        const auto lastId = in.get<std::int64_t>();
+        const auto movieId = in.get<std::int32_t>();
+        const auto theaterId = in.get<std::int32_t>();
+        const auto booked = in.get<std::uint32_t>();
+        // Router IDs are dense, so a valid one is at most the router's counter; createShow also
+        // refuses IDs too far above this shard's highest, bounding what one frame can allocate.
+        long long result = -1;
+        if (in.failed() || id < 1 || id > lastId)
+            std::cerr << "Refusing to adopt show ID " << id << '\n';
+        else
+            result = service_.createShow(movieId, theaterId, id);
+        if (result > 0 && booked && !service_.bookSeats(id, labelsFromMask(booked))) {
+            (void)service_.removeShow(id);
+            result = -1;
+        }
+        out.put<std::int64_t>(result);
+        break;
+    }
+    case REMOVE_SHOW: {
+        const auto id = in.get<std::int64_t>();
+        out.put<std::int64_t>(!in.failed() && service_.removeShow(id) ? 1 : 0);
+        break;
+    }
+    case BOOK: {
+        const auto id = in.get<std::int64_t>();
+        const auto mask = in.get<std::uint32_t>();
+        out.put<std::int64_t>(in.failed() ? -1 : service_.bookTicket(id, labelsFromMask(mask), BookingService::ANONYMOUS_CUSTOMER));
+        break;
+    }
+    case SEATS: {
+        const auto id = in.get<std::int64_t>();
+        try {
+            const std::uint32_t booked = seatMask(service_, id);
+            out.put<std::int64_t>(1).put(booked);
+        } catch (const std::invalid_argument&) {
+            out.put<std::int64_t>(-1);
+        }
+        break;
+    }
+    case LIST: {
+        const auto shows = service_.getAllShowViews();
+        FrameWriter body;
+        std::int64_t n = 0;
+        for (const auto& show : shows) {
+            try {
+                const std::uint32_t booked = seatMask(service_, show.id);
+                body.put<std::int64_t>(show.id).put<std::int32_t>(show.movieId).put<std::int32_t>(show.theaterId).put(booked);
+                ++n;
+            } catch (const std::invalid_argument&) {
+                // removed since the listing was taken
+            }
+        }
+        out.put(n);
+        return out.take() + body.take();
+    }
+    case PREPARE:
+        return prepareTx(in);
+    case COMMIT: {
+        const auto txId = in.get<std::uint64_t>();
+        if (!in.failed()) return commitTx(txId);
+        out.put<std::int64_t>(-1);
+        break;
+    }
+    case ABORT: {
+        const auto txId = in.get<std::uint64_t>();
+        if (!in.failed()) return abortTx(txId);
+        out.put<std::int64_t>(0);
+        break;
+    }
+    case FORGET: {
+        const auto watermark = in.get<std::uint64_t>();
+        if (!in.failed()) return forgetTx(watermark);
+        out.put<std::int64_t>(-1);
+        break;
+    }
+    case STATS:
+        return stats();
+    default:
+        std::cerr << "Unknown shard request: " << static_cast<int>(op) << '\n';
+        out.put<std::int64_t>(-1);
+    }
+    return out.take();
+}
+
+// ----------------- Two-Phase Commit Participant -----------------
+/**
+ * The function `prepareTx` votes on a transaction: it holds every requested seat and votes yes, or
+ * releases whatever it held and votes no. A repeated PREPARE returns the earlier vote; one for a
+ * transaction already decided, or below the FORGET watermark, votes no.
+ *
+ * Time complexity: O(legs)
+ * Space complexity: O(legs)
+ */
+std::string ShardServer::prepareTx(FrameReader& in) {
+    const auto txId = in.get<std::uint64_t>();
+    const auto customerId = in.get<std::int64_t>();
+    const auto n = in.get<std::uint32_t>();
+    std::vector<std::pair<long long, std::uint32_t>> legs;
+    for (std::uint32_t i = 0; i < n && !in.failed(); ++i) {
+        const auto showId = in.get<std::int64_t>();
+        const auto mask = in.get<std::uint32_t>();
+        legs.emplace_back(showId, mask);
+    }
+
+    FrameWriter out;
+    std::lock_guard lock(txMtx_);
+    if (in.failed() || txId < forgottenBelow_ || finished_.count(txId)) return out.put<std::int64_t>(0).take();
+    if (prepared_.count(txId)) return out.put<std::int64_t>(1).take();
+
+    PreparedTx tx{customerId, {}, {}};
+    for (const auto& [showId, mask] : legs) {
+        const long long holdId = service_.holdSeats(showId, labelsFromMask(mask));
+        if (holdId < 0) {
+            for (long long held : tx.holdIds) (void)service_.releaseHold(held);
+            finished_.emplace(txId, std::nullopt);
+            return out.put<std::int64_t>(0).take();
+        }
+        tx.holdIds.push_back(holdId);
+    }
+    prepared_.emplace(txId, std::move(tx));
+    return out.put<std::int64_t>(1).take();
+}
+
+// Confirms the transaction's holds into tickets; a repeated COMMIT returns the same tickets. If a
+// hold cannot be confirmed (e.g. the ticket store is full) the transaction stays prepared and
+// the reply is -1, so the coordinator keeps it in doubt and a later COMMIT resumes from there.
+std::string ShardServer::commitTx(std::uint64_t txId) {
+    FrameWriter out;
+    std::lock_guard lock(txMtx_);
+    if (auto done = finished_.find(txId); done != finished_.end()) {
+        if (!done->second) return out.put<std::int64_t>(-1).take();
+        out.put(static_cast<std::int64_t>(done->second->size()));
+        for (long long ticket : *done->second) out.put<std::int64_t>(ticket);
+        return out.take();
+    }
+    auto it = prepared_.find(txId);
+    if (it == prepared_.end()) return out.put<std::int64_t>(-1).take();
+
+    PreparedTx& tx = it->second;
+    while (tx.tickets.size() < tx.holdIds.size()) {
+        const long long ticket = service_.confirmHold(tx.holdIds[tx.tickets.size()], tx.customerId);
+        if (ticket < 0) {
+            std::cerr << "Cannot commit transaction " << txId << "; it stays prepared\n";
+            return out.put<std::int64_t>(-1).take();
+        }
+        tx.tickets.push_back(ticket);
+    }
+    std::vector<long long> tickets = std::move(tx.tickets);
+    prepared_.erase(it);
+    out.put(static_cast<std::int64_t>(tickets.size()));
+    for (long long ticket : tickets) out.put<std::int64_t>(ticket);
+    finished_.emplace(txId, std::move(tickets));
+    return out.take();
+}
+
+// Releases the transaction's holds, if any. Aborting an unknown transaction records the outcome
+// so that a late PREPARE for it is refused; below the FORGET watermark the watermark does that.
+std::string ShardServer::abortTx(std::uint64_t txId) {
+    FrameWriter out;
+    std::lock_guard lock(txMtx_);
+    if (auto done = finished_.find(txId); done != finished_.end())
+        return out.put<std::int64_t>(done->second ? 0 : 1).take();
+    if (auto it = prepared_.find(txId); it != prepared_.end()) {
+        for (long long holdId : it->second.holdIds) (void)service_.releaseHold(holdId);
+        prepared_.erase(it);
+    }
+    if (txId >= forgottenBelow_) finished_.emplace(txId, std::nullopt);
+    return out.put<std::int64_t>(1).take();
+}
+
+// Drops the outcomes of transactions below `watermark`, all of which have ended at the coordinator,
+// which will not ask about them again. Watermarks only move up.
+std::string ShardServer::forgetTx(std::uint64_t watermark) {
+    std::lock_guard lock(txMtx_);
+    if (watermark > forgottenBelow_) {
+        forgottenBelow_ = watermark;
+        std::erase_if(finished_, [watermark](const auto& entry) { return entry.first < watermark; });
+    }
+    return FrameWriter().put<std::int64_t>(1).take();
+}
+
+/**
+ * The function `runUntilSignal` runs a shard process: it serves a fresh BookingService on
+ * `socketPath` until SIGINT or SIGTERM, then shuts down cleanly. A non-zero `budget` enables
+ * deadline scheduling with that default budget.
+ *
+ * @return 0 after a clean shutdown, 1 if the socket cannot be bound.
+ */
+int ShardServer::runUntilSignal(const std::string& socketPath, std::chrono::microseconds budget) {
+    // Block the signals before any thread exists so that only sigwait() below receives them.
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGINT);
+    sigaddset(&signals, SIGTERM);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    BookingService service;
+    ShardServer server(service, socketPath);
+    if (budget.count() > 0) server.enableDeadlines(budget);
+    if (!server.start()) return 1;
+    int received = 0;
+    sigwait(&signals, &received);
+    server.stop();
+    return 0;
+}
+
+// ----------------- Local Shard Launcher -----------------
+LocalShardLauncher::LocalShardLauncher(std::string directory) : directory_(std::move(directory)) {
+    std::error_code ec;
+    std::filesystem::create_directories(directory_, ec);
+}
+
+LocalShardLauncher::~LocalShardLauncher() {
+    stopAll();
+}
+
+/**
+ * The function `launch` forks one shard process and waits (up to 5 s) until it accepts
+ * connections.
+ *
+ * @return The shard's socket path, or std::nullopt (with a message on std::cerr) if the process
+ * could not be started or never came up.
+ */
+std::optional<std::string> LocalShardLauncher::launch() {
+    const std::string path = directory_ + "/shard-" + std::to_string(paths_.size() + 1) + ".sock";
+    std::cout.flush();              // the child would otherwise flush our buffered output again
+    std::fflush(nullptr);
+    const pid_t pid = ::fork();
+    if (pid < 0) {
+        std::cerr << "Cannot start shard process\n";
+        return std::nullopt;
+    }
+    if (pid == 0) ::_exit(ShardServer::runUntilSignal(path));   // child: never returns into the caller
+
+    pids_.push_back(pid);
+    paths_.push_back(path);
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (!LocalSocket::connect(path).valid()) {
+        int status = 0;
+        if (::waitpid(pid, &status, WNOHANG) == pid || std::chrono::steady_clock::now() >= deadline) {
+            std::cerr << "Shard process did not start on " << path << '\n';
+            return std::nullopt;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return path;
+}
+
+void LocalShardLauncher::stopAll() {
+    for (pid_t pid : pids_) ::kill(pid, SIGTERM);
+    for (pid_t pid : pids_) ::waitpid(pid, nullptr, 0);
+    pids_.clear();
+}
+
+} // namespace booking
@@ -0,0 +1,323 @@
+#include "ShardedBookingService.hpp"
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cctype>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <stdexcept>
+
+namespace booking {
+
+struct ShardedBookingService::Completion {
+    std::atomic<bool> ready{false};
+    bool ok{false};
+    long long showId{-1};
+    std::uint32_t booked{0};
+    std::vector<ShowSummary>* list{nullptr};
+};
+
+namespace {
+std::string toLower(const std::string& s) {
+    std::string out = s;
+    std::transform(out.begin(), out.end(), out.begin(),
+                   [](unsigned char c){ return std::tolower(c); });
+    return out;
+}
+
+constexpr int SPIN_POLLS  = 256;   // Empty polls before a shard starts yielding
+constexpr int YIELD_POLLS = 1024;  // Yielding polls before a shard naps
+constexpr auto IDLE_NAP   = std::chrono::microseconds(50);
+constexpr std::size_t POLL_BATCH = 64;   // Requests drained per client queue per pass
+} // namespace
+
+ShardedBookingService::ShardedBookingService(std::size_t shards, std::size_t maxClients) {
+    if (shards == 0) shards = 1;
+    if (maxClients == 0) maxClients = 1;
+
+    clients_.reserve(maxClients);
+    for (std::size_t c = 0; c < maxClients; ++c) {
+        auto slot = std::make_unique<ClientSlot>();
+        for (std::size_t s = 0; s < shards; ++s)
+            slot->queues.push_back(std::make_unique<SpscQueue<Request>>(QUEUE_CAPACITY));
+        clients_.push_back(std::move(slot));
+    }
+
+    shards_.reserve(shards);
+    for (std::size_t s = 0; s < shards; ++s)
+        shards_.push_back(std::make_unique<Shard>());
+    for (std::size_t s = 0; s < shards; ++s)
+        shards_[s]->thread = std::thread([this, s] { shardLoop(s); });
+}
+
+ShardedBookingService::~ShardedBookingService() {
+    stopping_.store(true, std::memory_order_release);
+    for (auto& shard : shards_) shard->thread.join();
+}
+
+// ----------------- Catalog -----------------
+/**
+ * The function `addMovie` adds a movie to the shared catalog, rejecting duplicate titles
+ * case-insensitively like BookingService::addMovie.
+ *
+ * Time complexity: O(1) average
+ * Space complexity: O(1) per entry.
+ */
+int ShardedBookingService::addMovie(const std::string& title) {
+    const std::string lowerTitle = toLower(title);
+    std::unique_lock unqLock(catalogMtx_);
+    if (movieNameToId_.count(lowerTitle)) {
+        std::cerr << "Movie \"" << title << "\" already exists (ID: "
+                  << movieNameToId_.at(lowerTitle) << ")\n";
+        return -1;
+    }
+    const int id = ++movieCounter_;
+    movies_.emplace(id, strings_.intern(title));
+    movieNameToId_.emplace(lowerTitle, id);
+    return id;
+}
+
+/**
+ * The function `addTheater` adds a theater to the shared catalog, rejecting duplicate names.
+ *
+ * Time complexity: O(1) average
+ * Space complexity: O(1) per entry.
+ */
+int ShardedBookingService::addTheater(const std::string& name) {
+    const std::string lowerName = toLower(name);
+    std::unique_lock unqLock(catalogMtx_);
+    if (theaterNameToId_.count(lowerName)) {
+        std::cerr << "Theater \"" << name << "\" already exists (ID: "
+                  << theaterNameToId_.at(lowerName) << ")\n";
+        return -1;
+    }
+    const int id = ++theaterCounter_;
+    theaters_.emplace(id, strings_.intern(name));
+    theaterNameToId_.emplace(lowerName, id);
+    return id;
+}
+
+// ----------------- Clients -----------------
+/**
+ * The function `connect` hands out a client slot with its own SPSC queue to every shard.
+ * Slots (and their queues) are reused after a Client is destroyed.
+ *
+ * @return A Client for the calling thread. Throws std::runtime_error if all slots are taken.
+ *
+ * Time complexity: O(maxClients)
+ * Space complexity: O(1)
+ */
+ShardedBookingService::Client ShardedBookingService::connect() {
+    for (std::size_t c = 0; c < clients_.size(); ++c) {
+        bool expected = false;
+        if (clients_[c]->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+            std::size_t hw = clientHighWater_.load(std::memory_order_relaxed);
+            while (hw < c + 1 &&
+                   !clientHighWater_.compare_exchange_weak(hw, c + 1, std::memory_order_release)) {}
+            return Client(this, c);
+        }
+    }
+    throw std::runtime_error("ShardedBookingService: too many clients");
+}
+
+void ShardedBookingService::releaseClient(std::size_t slot) noexcept {
+    clients_[slot]->inUse.store(false, std::memory_order_release);
+}
+
+ShardedBookingService::Client::~Client() {
+    if (service_) service_->releaseClient(slot_);
+}
+
+void ShardedBookingService::Client::send(std::size_t shard, const Request& req) {
+    auto& queue = *service_->clients_[slot_]->queues[shard];
+    while (!queue.tryPush(req)) std::this_thread::yield();
+}
+
+void ShardedBookingService::Client::await(const Completion& done) noexcept {
+    for (int spins = 0; !done.ready.load(std::memory_order_acquire); ++spins)
+        if (spins > SPIN_POLLS) std::this_thread::yield();
+}
+
+/**
+ * The function `createShow` validates the movie, theater and (movie, theater) uniqueness against
+ * the catalog, assigns the show ID, and has the owning shard create the seat map.
+ *
+ * @return The new show ID, or -1 for an invalid or duplicate show.
+ *
+ * Time complexity: O(1) average + one shard round trip.
+ * Space complexity: O(1)
+ */
+long long ShardedBookingService::Client::createShow(int movieId, int theaterId) {
+    long long id = 0;
+    {
+        std::unique_lock unqLock(service_->catalogMtx_);
+        if (!service_->movies_.count(movieId)) {
+            std::cerr << "Invalid movie ID: " << movieId << '\n';
+            return -1;
+        }
+        if (!service_->theaters_.count(theaterId)) {
+            std::cerr << "Invalid theater ID: " << theaterId << '\n';
+            return -1;
+        }
+        const long long key = (static_cast<long long>(movieId) << 32) | static_cast<unsigned>(theaterId);
+        if (!service_->showKeys_.insert(key).second) {
+            std::cerr << "Duplicate show for movie " << movieId
+                      << " and theater " << theaterId << '\n';
+            return -1;
+        }
+        id = ++service_->showCounter_;
+    }
+
+    Completion done;
+    send(service_->shardOf(id), Request{Request::Op::Create, id, movieId, theaterId, 0, &done});
+    await(done);
+    return id;
+}
+
+/**
+ * The function `bookSeats` parses the labels on the caller's thread and sends one request to the
+ * show's owner, which checks and sets the seats without any synchronization.
+ *
+ * @return true if every seat was free and is now booked; false for unknown shows, invalid or
+ * duplicate labels, or already booked seats.
+ *
+ * Time complexity: O(k) for k labels + one shard round trip.
+ * Space complexity: O(1)
+ */
+bool ShardedBookingService::Client::bookSeats(long long showId, const std::vector<std::string>& seatLabels) {
+    std::uint32_t mask = 0;
+    for (const auto& lbl : seatLabels) {
+        const int idx = BookingService::seatIndexFromLabel(lbl);
+        if (idx < 0) {
+            std::cerr << "Invalid seat: " << lbl << '\n';
+            return false;
+        }
+        if (mask & (std::uint32_t{1} << idx)) {
+            std::cerr << "Duplicate seat: " << lbl << '\n';
+            return false;
+        }
+        mask |= std::uint32_t{1} << idx;
+    }
+
+    Completion done;
+    send(service_->shardOf(showId), Request{Request::Op::Book, showId, 0, 0, mask, &done});
+    await(done);
+    return done.ok;
+}
+
+/**
+ * The function `getAvailableSeats` asks the owning shard for the show's booked-seat mask and
+ * returns the labels of the free seats.
+ *
+ * Time complexity: O(TOTAL_SEATS) + one shard round trip.
+ * Space complexity: O(TOTAL_SEATS)
+ */
+std::vector<std::string> ShardedBookingService::Client::getAvailableSeats(long long showId) {
+    Completion done;
+    send(service_->shardOf(showId), Request{Request::Op::Query, showId, 0, 0, 0, &done});
+    await(done);
+    if (!done.ok) throw std::invalid_argument("Invalid show ID");
+
+    std::vector<std::string> available;
+    for (int i = 0; i < BookingService::TOTAL_SEATS; ++i)
+        if (!(done.booked & (std::uint32_t{1} << i)))
+            available.push_back(BookingService::seatLabelFromIndex(i));
+    return available;
+}
+
+/**
+ * The function `getAllShows` scatters a listing request to every shard, gathers the partial lists
+ * (shards work in parallel), and resolves names from the catalog.
+ *
+ * @return All shows sorted by show ID, with interned title/name views.
+ *
+ * Time complexity: O(S log S) for S shows.
+ * Space complexity: O(S)
+ */
+std::vector<ShardedBookingService::ShowView> ShardedBookingService::Client::getAllShows() {
+    const std::size_t n = service_->shardCount();
+    std::vector<std::vector<ShowSummary>> parts(n);
+    std::vector<Completion> done(n);
+    for (std::size_t s = 0; s < n; ++s) {
+        done[s].list = &parts[s];
+        send(s, Request{Request::Op::List, 0, 0, 0, 0, &done[s]});
+    }
+    for (const auto& d : done) await(d);
+
+    std::vector<ShowView> views;
+    std::shared_lock shrLock(service_->catalogMtx_);
+    for (const auto& part : parts)
+        for (const auto& s : part)
+            views.push_back({s.id, s.movieId, s.theaterId, service_->movies_.at(s.movieId),
+                             service_->theaters_.at(s.theaterId), s.availableSeats});
+    std::sort(views.begin(), views.end(), [](const ShowView& a, const ShowView& b) { return a.id < b.id; });
+    return views;
+}
+
+// ----------------- Shards -----------------
+/**
+ * The function `handle` executes one request on the owning shard. It runs only on that shard's
+ * thread, so the seat map is read and written with plain loads and stores.
+ */
+void ShardedBookingService::handle(Shard& shard, Request& req) {
+    Completion& done = *req.done;
+    switch (req.op) {
+    case Request::Op::Create:
+        shard.shows.emplace(req.showId, ShardShow{req.movieId, req.theaterId, 0, BookingService::TOTAL_SEATS});
+        done.ok = true;
+        break;
+    case Request::Op::Book: {
+        auto it = shard.shows.find(req.showId);
+        if (it == shard.shows.end() || (it->second.booked & req.seatMask)) {
+            done.ok = false;
+            break;
+        }
+        it->second.booked |= req.seatMask;
+        it->second.availableCount -= static_cast<int>(std::bitset<32>(req.seatMask).count());
+        done.ok = true;
+        break;
+    }
+    case Request::Op::Query: {
+        auto it = shard.shows.find(req.showId);
+        done.ok = it != shard.shows.end();
+        if (done.ok) done.booked = it->second.booked;
+        break;
+    }
+    case Request::Op::List:
+        done.list->reserve(shard.shows.size());
+        for (const auto& [id, show] : shard.shows)
+            done.list->push_back({id, show.movieId, show.theaterId, show.availableCount});
+        done.ok = true;
+        break;
+    }
+    done.ready.store(true, std::memory_order_release);
+}
+
+/**
+ * The function `shardLoop` polls every connected client's queue for this shard, draining a bounded
+ * batch per queue (one index publication per batch) for fairness. When idle it spins, then yields, then naps briefly.
+ */
+void ShardedBookingService::shardLoop(std::size_t index) {
+    Shard& shard = *shards_[index];
+    std::array<Request, POLL_BATCH> batch;
+    int idle = 0;
+    while (!stopping_.load(std::memory_order_acquire)) {
+        bool worked = false;
+        const std::size_t clients = clientHighWater_.load(std::memory_order_acquire);
+        for (std::size_t c = 0; c < clients; ++c) {
+            const std::size_t n = clients_[c]->queues[index]->tryPopBatch(batch.begin(), batch.size());
+            for (std::size_t i = 0; i < n; ++i) handle(shard, batch[i]);
+            worked |= n > 0;
+        }
+        if (worked) {
+            idle = 0;
+        } else if (++idle > SPIN_POLLS + YIELD_POLLS) {
+            std::this_thread::sleep_for(IDLE_NAP);
+        } else if (idle > SPIN_POLLS) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace booking
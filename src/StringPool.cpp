@@ -0,0 +1,56 @@
+#include "StringPool.hpp"
+#include <cstring>
+
+namespace booking {
+
+StringPool::StringPool(std::size_t blockSize) : blockSize_(blockSize ? blockSize : 1) {}
+
+/**
+ * The function `allocate` carves `n` bytes out of the current block, starting a new block when
+ * it does not fit. Strings larger than a block get a dedicated block of their own.
+ *
+ * Time complexity: O(1) amortized
+ * Space complexity: O(n)
+ */
+char* StringPool::allocate(std::size_t n) {
+    if (n > blockSize_) {
+        // Oversized string: give it a block of its own and keep filling the current one.
+        blocks_.push_back(std::make_unique<char[]>(n));
+        return blocks_.back().get();
+    }
+    if (!current_ || blockUsed_ + n > blockSize_) {
+        blocks_.push_back(std::make_unique<char[]>(blockSize_));
+        current_ = blocks_.back().get();
+        blockUsed_ = 0;
+    }
+    char* p = current_ + blockUsed_;
+    blockUsed_ += n;
+    return p;
+}
+
+/**
+ * The function `intern` returns the pooled copy of `s`, copying it into the arena the first
+ * time it is seen. Equal strings always yield views with the same data pointer.
+ *
+ * Time complexity: O(n) for hashing, O(1) average table operations.
+ * Space complexity: O(n) only for a new distinct string.
+ */
+std::string_view StringPool::intern(std::string_view s) {
+    auto it = index_.find(s);
+    if (it != index_.end()) return *it;
+
+    char* p = allocate(s.size());
+    if (!s.empty()) std::memcpy(p, s.data(), s.size());
+    bytesUsed_ += s.size();
+    return *index_.emplace(p, s.size()).first;
+}
+
+std::size_t StringPool::size() const noexcept {
+    return index_.size();
+}
+
+std::size_t StringPool::bytesUsed() const noexcept {
+    return bytesUsed_;
+}
+
+} // namespace booking
@@ -0,0 +1,224 @@
+#include "TicketStore.hpp"
+#include <chrono>
+
+namespace booking {
+
+TicketStore::TicketStore()
+    : chunks_(std::make_unique<std::atomic<Record*>[]>(MAX_CHUNKS)) {}
+
+TicketStore::~TicketStore() {
+    for (std::size_t c = 0; c < MAX_CHUNKS; ++c)
+        delete[] chunks_[c].load(std::memory_order_relaxed);
+}
+
+/**
+ * Mixes a 64-bit key (splitmix64 finalizer) so that sequential customer IDs spread
+ * evenly across stripes and slots.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1)
+ */
+std::size_t TicketStore::mix(long long key) noexcept {
+    auto x = static_cast<std::uint64_t>(key);
+    x ^= x >> 30; x *= 0xbf58476d1ce4e5b9ULL;
+    x ^= x >> 27; x *= 0x94d049bb133111ebULL;
+    x ^= x >> 31;
+    return static_cast<std::size_t>(x);
+}
+
+/**
+ * The function `chunkFor` returns the chunk holding record `index`, allocating it on first use.
+ * Racing allocators publish with a CAS; the loser frees its chunk and uses the winner's.
+ *
+ * Time complexity: O(1), one allocation per CHUNK_SIZE records.
+ * Space complexity: O(CHUNK_SIZE) when a chunk is allocated.
+ */
+TicketStore::Record* TicketStore::chunkFor(std::size_t index) {
+    auto& slot = chunks_[index >> CHUNK_BITS];
+    Record* chunk = slot.load(std::memory_order_acquire);
+    if (chunk) return chunk;
+
+    Record* fresh = new Record[CHUNK_SIZE]();   // value-init: every timestamp starts at 0
+    if (slot.compare_exchange_strong(chunk, fresh, std::memory_order_acq_rel))
+        return fresh;
+    delete[] fresh;
+    return chunk;
+}
+
+const TicketStore::Record* TicketStore::recordAt(std::size_t index) const noexcept {
+    const Record* chunk = chunks_[index >> CHUNK_BITS].load(std::memory_order_acquire);
+    if (!chunk) return nullptr;
+    const Record* rec = &chunk[index & (CHUNK_SIZE - 1)];
+    return rec->timestampNs.load(std::memory_order_acquire) != 0 ? rec : nullptr;
+}
+
+/**
+ * The function `headSlot` finds (or inserts) the list head for `customerId` in a stripe's
+ * open-addressing table. The table doubles when half full, so growth is amortized and
+ * never per record. Caller must hold the stripe mutex.
+ *
+ * Time complexity: O(1) average
+ * Space complexity: O(1) amortized
+ */
+std::uint32_t* TicketStore::headSlot(CustomerStripe& stripe, long long customerId) {
+    if ((stripe.used + 1) * 2 > stripe.slots.size()) {
+        std::vector<CustomerStripe::Slot> old = std::move(stripe.slots);
+        stripe.slots.assign(old.empty() ? 64 : old.size() * 2, CustomerStripe::Slot{0, 0});
+        const std::size_t mask = stripe.slots.size() - 1;
+        for (const auto& s : old) {
+            if (!s.head) continue;
+            std::size_t i = mix(s.customerId) & mask;
+            while (stripe.slots[i].head) i = (i + 1) & mask;
+            stripe.slots[i] = s;
+        }
+    }
+
+    const std::size_t mask = stripe.slots.size() - 1;
+    std::size_t i = mix(customerId) & mask;
+    while (stripe.slots[i].head && stripe.slots[i].customerId != customerId)
+        i = (i + 1) & mask;
+    if (!stripe.slots[i].head) {
+        stripe.slots[i].customerId = customerId;
+        ++stripe.used;
+    }
+    return &stripe.slots[i].head;
+}
+
+/**
+ * The function `append` writes a new booking record and returns its ticket ID.
+ *
+ * The slot is reserved with a single fetch_add, so concurrent bookers of different shows
+ * never serialize on the record arena. Customer linking takes only the customer's stripe lock.
+ * The timestamp is stored last (release) and acts as the publication flag for readers.
+ *
+ * @return Ticket ID (>= 1), or -1 when the store is at CAPACITY.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1) amortized, no per-record heap allocation.
+ */
+long long TicketStore::append(long long showId, long long customerId, std::uint32_t seatMask) {
+    const std::size_t index = next_.fetch_add(1, std::memory_order_relaxed);
+    if (index >= CAPACITY - 1) return -1;   // index + 1 must fit the 32-bit list links
+    write(static_cast<long long>(index) + 1, showId, customerId, seatMask);
+    return static_cast<long long>(index) + 1;
+}
+
+/**
+ * The function `reserve` takes `count` consecutive ticket IDs for records written later with
+ * write(), all or none: a booking of several tickets checks for room before it commits anything.
+ * Unlike append it needs a CAS, because a failed reservation must leave the counter unchanged.
+ *
+ * @return The first reserved ticket ID, or -1 if `count` more records do not fit.
+ *
+ * Time complexity: O(1) expected; a CAS loop against concurrent appends.
+ * Space complexity: O(1)
+ */
+long long TicketStore::reserve(std::size_t count) {
+    std::size_t next = next_.load(std::memory_order_relaxed);
+    do {
+        if (next >= CAPACITY - 1 || count > CAPACITY - 1 - next) return -1;
+    } while (!next_.compare_exchange_weak(next, next + count, std::memory_order_relaxed));
+    return static_cast<long long>(next) + 1;
+}
+
+/**
+ * The function `write` stores and publishes the record of a ticket ID taken by append or reserve.
+ *
+ * Time complexity: O(1)
+ * Space complexity: O(1) amortized, no per-record heap allocation.
+ */
+void TicketStore::write(long long ticketId, long long showId, long long customerId, std::uint32_t seatMask) {
+    const auto index = static_cast<std::size_t>(ticketId) - 1;
+    Record& rec = chunkFor(index)[index & (CHUNK_SIZE - 1)];
+    rec.showId = showId;
+    rec.customerId = customerId;
+    rec.seatMask = seatMask;
+    rec.prevForCustomer = 0;
+
+    const auto now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    const std::int64_t stamp = now > 0 ? now : 1;
+
+    if (customerId == ANONYMOUS_CUSTOMER) {
+        rec.timestampNs.store(stamp, std::memory_order_release);
+    } else {
+        auto& stripe = customers_[mix(customerId) % CUSTOMER_STRIPES];
+        std::lock_guard<std::mutex> guard(stripe.mtx);
+        std::uint32_t* head = headSlot(stripe, customerId);
+        rec.prevForCustomer = *head;
+        rec.timestampNs.store(stamp, std::memory_order_release);
+        *head = static_cast<std::uint32_t>(index + 1);
+    }
+    published_.fetch_add(1, std::memory_order_relaxed);
+}
+
+/**
+ * The function `skipTo` makes the IDs up to `lastTicketId` unused, so the next append returns a
+ * higher one; a replica uses it to continue the primary's numbering after a re-sync. Skipped IDs
+ * are never published and find() reports them as unknown.
+ *
+ * Time complexity: O(1) expected; a CAS loop against concurrent appends.
+ * Space complexity: O(1)
+ */
+bool TicketStore::skipTo(long long lastTicketId) {
+    if (lastTicketId < 0 || static_cast<std::size_t>(lastTicketId) >= CAPACITY - 1) return false;
+    const auto target = static_cast<std::size_t>(lastTicketId);
+    std::size_t next = next_.load(std::memory_order_relaxed);
+    while (next < target && !next_.compare_exchange_weak(next, target, std::memory_order_relaxed)) {}
+    return true;
+}
+
+/**
+ * The function `find` returns the record for `ticketId`, or std::nullopt when no such
+ * ticket has been published.
+ *
+ * Time complexity: O(1) — directory load + record load.
+ * Space complexity: O(1)
+ */
+std::optional<TicketStore::Ticket> TicketStore::find(long long ticketId) const {
+    if (ticketId < 1 || static_cast<std::size_t>(ticketId) > CAPACITY) return std::nullopt;
+    const std::size_t index = static_cast<std::size_t>(ticketId) - 1;
+    const Record* rec = recordAt(index);
+    if (!rec) return std::nullopt;
+    return Ticket{ticketId, rec->showId, rec->customerId,
+                  rec->timestampNs.load(std::memory_order_relaxed), rec->seatMask};
+}
+
+/**
+ * The function `findByCustomer` walks the customer's record list, newest first.
+ *
+ * Time complexity: O(1) head lookup + O(k) for k tickets.
+ * Space complexity: O(k) for the result vector.
+ */
+std::vector<TicketStore::Ticket> TicketStore::findByCustomer(long long customerId) const {
+    std::vector<Ticket> out;
+    if (customerId == ANONYMOUS_CUSTOMER) return out;
+
+    const auto& stripe = customers_[mix(customerId) % CUSTOMER_STRIPES];
+    std::uint32_t link = 0;
+    {
+        std::lock_guard<std::mutex> guard(stripe.mtx);
+        if (stripe.slots.empty()) return out;
+        const std::size_t mask = stripe.slots.size() - 1;
+        std::size_t i = mix(customerId) & mask;
+        while (stripe.slots[i].head && stripe.slots[i].customerId != customerId)
+            i = (i + 1) & mask;
+        link = stripe.slots[i].head;
+    }
+
+    // Linked records are immutable once published, so the walk needs no lock.
+    while (link) {
+        const Record* rec = recordAt(link - 1);
+        if (!rec) break;
+        out.push_back({static_cast<long long>(link), rec->showId, rec->customerId,
+                       rec->timestampNs.load(std::memory_order_relaxed), rec->seatMask});
+        link = rec->prevForCustomer;
+    }
+    return out;
+}
+
+std::size_t TicketStore::size() const noexcept {
+    return published_.load(std::memory_order_relaxed);
+}
+
+} // namespace booking
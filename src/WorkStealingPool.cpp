@@ -0,0 +1,174 @@
+#include "WorkStealingPool.hpp"
+#include <iostream>
+
+namespace booking {
+
+namespace {
+thread_local const WorkStealingPool* t_pool = nullptr;
+thread_local std::size_t t_workerIndex = WorkStealingPool::NO_AFFINITY;
+constexpr int SPIN_ROUNDS = 64;   // Steal attempts before parking
+} // namespace
+
+WorkStealingPool::WorkStealingPool(std::size_t workers) {
+    if (workers == 0) workers = 1;
+    workers_.reserve(workers);
+    for (std::size_t i = 0; i < workers; ++i)
+        workers_.push_back(std::make_unique<Worker>());
+    for (std::size_t i = 0; i < workers; ++i)
+        workers_[i]->thread = std::thread([this, i] { workerLoop(i); });
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    waitIdle();
+    {
+        std::lock_guard<std::mutex> guard(parkMtx_);
+        stopping_.store(true, std::memory_order_release);
+    }
+    parkCv_.notify_all();
+    for (auto& w : workers_) w->thread.join();
+}
+
+std::size_t WorkStealingPool::currentWorker() noexcept {
+    return t_workerIndex;
+}
+
+/**
+ * The function `submit` queues a task. From one of this pool's workers without a foreign affinity,
+ * the task is pushed onto the worker's own deque (no lock). Otherwise it lands in the inbox of worker
+ * `affinity % size()` (or the next worker round-robin) and a parked worker is woken.
+ *
+ * Time complexity: O(1) amortized
+ * Space complexity: O(1) — one heap-allocated task.
+ */
+void WorkStealingPool::submit(Job job, std::size_t affinity) {
+    auto* task = new Task{std::move(job)};
+    pending_.fetch_add(1, std::memory_order_relaxed);
+    queued_.fetch_add(1, std::memory_order_seq_cst);   // pairs with sleepers_ in wakeOne()
+
+    const bool onOwnPool = (t_pool == this);
+    std::size_t target = affinity == NO_AFFINITY ? (onOwnPool ? t_workerIndex : NO_AFFINITY)
+                                                 : affinity % workers_.size();
+    if (onOwnPool && target == t_workerIndex) {
+        workers_[target]->deque.push(task);
+    } else {
+        if (target == NO_AFFINITY)
+            target = nextExternal_.fetch_add(1, std::memory_order_relaxed) % workers_.size();
+        Worker& w = *workers_[target];
+        std::lock_guard<std::mutex> guard(w.inboxMtx);
+        w.inbox.push_back(task);
+        w.hasInbox.store(true, std::memory_order_release);
+    }
+    wakeOne();
+}
+
+void WorkStealingPool::wakeOne() {
+    if (sleepers_.load(std::memory_order_seq_cst) == 0) return;
+    std::lock_guard<std::mutex> guard(parkMtx_);
+    parkCv_.notify_one();
+}
+
+/**
+ * The function `findTask` returns the next task for worker `index`: its own deque first, then
+ * its inbox (moved into the deque in one batch), then a steal from the other workers.
+ *
+ * Time complexity: O(W) for W workers in the worst case.
+ * Space complexity: O(1)
+ */
+WorkStealingPool::Task* WorkStealingPool::findTask(std::size_t index) {
+    Worker& self = *workers_[index];
+    if (auto t = self.deque.pop()) return *t;
+
+    if (self.hasInbox.load(std::memory_order_acquire)) {
+        std::vector<Task*> batch;
+        {
+            std::lock_guard<std::mutex> guard(self.inboxMtx);
+            batch.swap(self.inbox);
+            self.hasInbox.store(false, std::memory_order_relaxed);
+        }
+        for (Task* t : batch) self.deque.push(t);
+        if (auto t = self.deque.pop()) return *t;
+    }
+
+    const std::size_t n = workers_.size();
+    for (std::size_t k = 1; k < n; ++k) {
+        Worker& victim = *workers_[(index + k) % n];
+        if (auto t = victim.deque.steal()) {
+            stolen_.fetch_add(1, std::memory_order_relaxed);
+            return *t;
+        }
+        // An inbox that its owner has not drained yet can be stolen from as well.
+        if (victim.hasInbox.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> guard(victim.inboxMtx);
+            if (!victim.inbox.empty()) {
+                Task* t = victim.inbox.back();
+                victim.inbox.pop_back();
+                if (victim.inbox.empty()) victim.hasInbox.store(false, std::memory_order_relaxed);
+                stolen_.fetch_add(1, std::memory_order_relaxed);
+                return t;
+            }
+        }
+    }
+    return nullptr;
+}
+
+void WorkStealingPool::execute(Task* task) {
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    try {
+        task->fn();
+    } catch (const std::exception& e) {
+        std::cerr << "Pool task failed: " << e.what() << '\n';
+    } catch (...) {
+        std::cerr << "Pool task failed with an unknown error\n";
+    }
+    delete task;
+    if (pending_.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        std::lock_guard<std::mutex> guard(parkMtx_);
+        idleCv_.notify_all();
+    }
+}
+
+/**
+ * The function `workerLoop` runs tasks until the pool stops. After SPIN_ROUNDS failed searches
+ * the worker parks; `queued_` is re-checked under the park mutex so a submit racing with parking
+ * is never lost.
+ */
+void WorkStealingPool::workerLoop(std::size_t index) {
+    t_pool = this;
+    t_workerIndex = index;
+    int idleRounds = 0;
+    for (;;) {
+        if (Task* task = findTask(index)) {
+            execute(task);
+            idleRounds = 0;
+            continue;
+        }
+        if (++idleRounds < SPIN_ROUNDS) {
+            std::this_thread::yield();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lk(parkMtx_);
+        sleepers_.fetch_add(1, std::memory_order_seq_cst);
+        parkCv_.wait(lk, [this] {
+            return stopping_.load(std::memory_order_acquire) ||
+                   queued_.load(std::memory_order_seq_cst) > 0;
+        });
+        sleepers_.fetch_sub(1, std::memory_order_relaxed);
+        idleRounds = 0;
+        if (stopping_.load(std::memory_order_acquire) && queued_.load(std::memory_order_acquire) == 0)
+            break;
+    }
+    t_pool = nullptr;
+    t_workerIndex = NO_AFFINITY;
+}
+
+/**
+ * The function `waitIdle` blocks the caller until every task submitted so far (and every task those
+ * tasks submitted) has finished. Must not be called from a worker of this pool.
+ */
+void WorkStealingPool::waitIdle() {
+    std::unique_lock<std::mutex> lk(parkMtx_);
+    idleCv_.wait(lk, [this] { return pending_.load(std::memory_order_acquire) == 0; });
+}
+
+} // namespace booking
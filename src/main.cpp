@@ -1,10 +1,13 @@
 #include "BookingService.hpp"
+#include "Replication.hpp"
 #include <iostream>
 #include <sstream>
 #include <algorithm>
 #include <atomic>
 #include <csignal>
 #include <cctype>
+#include <cstring>
+#include <memory>
 
 using namespace booking;
 
@@ -59,14 +62,57 @@ static bool safeReadLong(const std::string& prompt, long long& value) {
     }
 }
 
+static void printReplicationStatus(const ReplicationPrimary* primary, const ReplicationFollower* follower) {
+    if (primary) {
+        std::cout << "Primary at LSN " << primary->lastLsn() << "\n";
+        for (const auto& f : primary->followers())
+            std::cout << "  Follower " << f.followerId << (f.connected ? "" : " (disconnected)")
+                      << " | acked LSN " << f.ackedLsn << " | lag " << f.lagRecords << " record(s)"
+                      << " | last ack " << std::chrono::duration_cast<std::chrono::milliseconds>(f.sinceAck).count()
+                      << " ms ago\n";
+    } else if (follower) {
+        const auto st = follower->status();
+        std::cout << "Follower " << (st.connected ? "connected" : "disconnected") << (st.diverged ? " (DIVERGED)" : "")
+                  << " | applied LSN " << st.appliedLsn << " of " << st.primaryLsn
+                  << " | lag " << st.lagRecords << " record(s)";
+        if (st.snapshotsApplied) std::cout << " | re-synced " << st.snapshotsApplied << "x from snapshot";
+        if (st.staleness != std::chrono::steady_clock::duration::max())
+            std::cout << " | stale by <= "
+                      << std::chrono::duration_cast<std::chrono::milliseconds>(st.staleness).count() << " ms";
+        std::cout << "\n";
+    } else {
+        std::cout << "Replication is off (start with --primary <socket> or --follower <socket>).\n";
+    }
+}
+
 // -------------------------------------------------------------
 // Main CLI
 // -------------------------------------------------------------
-int main() {
+// Usage: booking_cli [--primary <socket> | --follower <socket>]
+//   --primary   streams every change to followers connecting on the Unix socket
+//   --follower  replicates from a primary; the menu then only offers reads
+int main(int argc, char** argv) {
     // Register Ctrl+C signal handler
     std::signal(SIGINT, handleSigInt);
 
     BookingService service;
+    MutationLog log;
+    std::unique_ptr<ReplicationPrimary> primary;
+    std::unique_ptr<ReplicationFollower> follower;
+
+    if (argc == 3 && std::strcmp(argv[1], "--primary") == 0) {
+        service.setMutationLog(&log);
+        primary = std::make_unique<ReplicationPrimary>(log, argv[2]);
+        if (!primary->start()) return 1;
+        std::cout << "Primary: streaming changes on " << argv[2] << "\n";
+    } else if (argc == 3 && std::strcmp(argv[1], "--follower") == 0) {
+        follower = std::make_unique<ReplicationFollower>(service, argv[2]);
+        if (!follower->start()) return 1;
+        std::cout << "Follower: replicating from " << argv[2] << " (read-only)\n";
+    } else if (argc != 1) {
+        std::cerr << "Usage: " << argv[0] << " [--primary <socket> | --follower <socket>]\n";
+        return 1;
+    }
 
     while (!g_exitRequested) {
         std::cout << "\n===== Movie Booking CLI =====\n"
@@ -77,7 +123,8 @@ int main() {
                   << "5. List Theaters for a Movie\n"
                   << "6. View Available Seats\n"
                   << "7. Book Seats\n"
-                  << "8. Exit\n";
+                  << "8. Exit\n"
+                  << "9. Replication Status\n";
 
         int choice = 0;
         if (!safeReadInt("Select option: ", choice)) {
@@ -88,6 +135,11 @@ int main() {
             continue; // re-prompt on invalid input
         }
 
+        if (follower && (choice == 1 || choice == 2 || choice == 3 || choice == 7)) {
+            std::cerr << "This follower is read-only; make changes on the primary.\n";
+            continue;
+        }
+
         switch (choice) {
         case 1: {
             std::string title;
@@ -122,7 +174,7 @@ int main() {
         case 3: { // Create Show
             auto movies = service.getAllMovies();
             auto theaters = service.getAllTheaters();
-            auto shows = service.getAllShows();
+            auto shows = service.getAllShowViews();
 
             if (movies.empty() || theaters.empty()) {
                 std::cerr << "Please add at least one movie and theater before creating a show.\n";
@@ -179,7 +231,7 @@ int main() {
         }
 
          case 6: { // View Available Seats
-            auto shows = service.getAllShows();
+            auto shows = service.getAllShowViews();
             if (shows.empty()) {
                 std::cout << "No shows available.\n";
                 continue;
@@ -196,7 +248,7 @@ int main() {
         }
 
         case 7: { // Book Seats
-            auto shows = service.getAllShows();
+            auto shows = service.getAllShowViews();
             if (shows.empty()) {
                 std::cout << "No shows available.\n";
                 continue;
@@ -253,16 +305,23 @@ int main() {
                 continue;
             }
 
-            bool success = service.bookSeats(showId, seatsToBook);
-            std::cout << (success ? "Booking successful.\n" : "Booking failed.\n");
+            long long ticketId = service.bookTicket(showId, seatsToBook, BookingService::ANONYMOUS_CUSTOMER);
+            if (ticketId > 0)
+                std::cout << "Booking successful. Ticket ID[" << ticketId << "]\n";
+            else
+                std::cout << "Booking failed.\n";
             break;
         }
         case 8:
             std::cout << "Exiting Movie Booking CLI.\n";
             return 0;
 
+        case 9:
+            printReplicationStatus(primary.get(), follower.get());
+            break;
+
         default:
-            std::cerr << "Invalid option. Please choose 1–8.\n";
+            std::cerr << "Invalid option. Please choose 1–9.\n";
         }
     }
 
@@ -0,0 +1,49 @@
+#include "ShardServer.hpp"
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+using namespace booking;
+
+// -------------------------------------------------------------
+// Shard process / local cluster launcher
+// -------------------------------------------------------------
+// Usage:
+//   booking_shard --socket <path> [budget_ms]   serve one shard until Ctrl+C / SIGTERM; with a
+//                                               budget, shed BOOK/SEATS requests that cannot meet it
+//   booking_shard --launch <n> <dir>            start n shards on <dir>/shard-<i>.sock, stop them on Ctrl+C
+int main(int argc, char** argv) {
+    if ((argc == 3 || argc == 4) && std::strcmp(argv[1], "--socket") == 0)
+        return ShardServer::runUntilSignal(argv[2], std::chrono::milliseconds(argc == 4 ? std::atoi(argv[3]) : 0));
+
+    if (argc == 4 && std::strcmp(argv[1], "--launch") == 0) {
+        const int n = std::atoi(argv[2]);
+        if (n <= 0) {
+            std::cerr << "Shard count must be positive\n";
+            return 1;
+        }
+        // Block before forking: children inherit the mask and wait for the signal themselves.
+        sigset_t signals;
+        sigemptyset(&signals);
+        sigaddset(&signals, SIGINT);
+        sigaddset(&signals, SIGTERM);
+        pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+        LocalShardLauncher launcher(argv[3]);
+        for (int i = 0; i < n; ++i) {
+            const auto path = launcher.launch();
+            if (!path) return 1;
+            std::cout << *path << std::endl;
+        }
+        std::cout << n << " shard(s) running; Ctrl+C to stop." << std::endl;
+        int received = 0;
+        sigwait(&signals, &received);
+        launcher.stopAll();
+        return 0;
+    }
+
+    std::cerr << "Usage: " << argv[0] << " --socket <path> [budget_ms] | --launch <n> <dir>\n";
+    return 1;
+}
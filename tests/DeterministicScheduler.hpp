@@ -0,0 +1,93 @@
+#pragma once
+
+#include "../include/SchedulePoint.hpp"
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace booking::testing {
+// ----------------- Deterministic Scheduler -----------------
+// Runs test threads one at a time and switches between them only at schedule points (see
+// SchedulePoint.hpp), choosing the next thread with a PRNG seeded by the caller. Every run with
+// the same seed and the same thread bodies therefore takes the same interleaving, which makes a
+// failing interleaving reproducible from its seed. The bodies must not block on anything other
+// than locks taken with lockCooperatively(), and must draw their own randomness from the seed.
+//
+// One scheduler may run at a time (the hook is process-wide).
+class DeterministicScheduler {
+public:
+    explicit DeterministicScheduler(std::uint64_t seed) : rng_(seed) {}
+
+    void run(const std::vector<std::function<void()>>& bodies) {
+        finished_.assign(bodies.size(), false);
+        trace_.clear();
+        instance_ = this;
+        scheduleHook.store(&hook, std::memory_order_relaxed);
+        {
+            std::lock_guard lock(mtx_);
+            running_ = pickLocked();
+        }
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < bodies.size(); ++i)
+            threads.emplace_back([this, i, &bodies] {
+                self_ = i;
+                {
+                    std::unique_lock lock(mtx_);
+                    cv_.wait(lock, [&] { return running_ == i; });
+                }
+                bodies[i]();
+                std::lock_guard lock(mtx_);
+                finished_[i] = true;
+                running_ = pickLocked();
+                cv_.notify_all();
+            });
+        for (auto& t : threads) t.join();
+        scheduleHook.store(nullptr, std::memory_order_relaxed);
+        instance_ = nullptr;
+    }
+
+    // Thread chosen at every switch; equal seeds give equal traces.
+    [[nodiscard]] const std::vector<std::size_t>& trace() const noexcept { return trace_; }
+
+private:
+    static constexpr std::size_t NONE = static_cast<std::size_t>(-1);
+
+    static void hook() noexcept {
+        if (instance_ && self_ != NONE) instance_->yield(self_);
+    }
+
+    void yield(std::size_t self) {
+        std::unique_lock lock(mtx_);
+        running_ = pickLocked();
+        cv_.notify_all();
+        cv_.wait(lock, [&] { return running_ == self; });
+    }
+
+    // Caller holds mtx_. Uniform choice among the threads that have not finished.
+    std::size_t pickLocked() {
+        std::vector<std::size_t> live;
+        for (std::size_t i = 0; i < finished_.size(); ++i)
+            if (!finished_[i]) live.push_back(i);
+        if (live.empty()) return NONE;
+        const std::size_t next = live[rng_() % live.size()];
+        trace_.push_back(next);
+        return next;
+    }
+
+    inline static DeterministicScheduler* instance_{nullptr};
+    inline static thread_local std::size_t self_{NONE};
+
+    std::mt19937_64 rng_;
+    std::mutex mtx_;
+    std::condition_variable cv_;
+    std::size_t running_{NONE};
+    std::vector<bool> finished_;
+    std::vector<std::size_t> trace_;
+};
+
+} // namespace booking::testing
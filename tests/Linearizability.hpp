@@ -0,0 +1,186 @@
+#pragma once
+
+#include "../include/BookingService.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <sstream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace booking::testing {
+// ----------------- Linearizability Checking -----------------
+// History records what every thread called on a BookingService and what came back, stamped with
+// a shared logical clock at invocation and at response. findViolation() then checks that the
+// history is linearizable against the sequential model of a show (a bitmap of booked seats):
+// that some total order of the operations, consistent with real time (an operation that
+// responded before another was invoked comes first), gives every operation the result it
+// actually returned.
+//
+// Operations on different shows never interact and linearizability is compositional, so each
+// show is checked on its own; getAllShows() is recorded as one count read per listed show. The
+// search per show is Wing & Gong's with memoization of (linearized set, state), as in Lowe's
+// "Testing for linearizability"; it is exponential only in the number of overlapping operations.
+struct Operation {
+    enum class Kind { Book, ReadSeats, ReadCount };
+
+    Kind kind{Kind::Book};
+    std::size_t thread{};
+    long long showId{};
+    std::uint32_t seats{};       // Book: requested seats. ReadSeats: seats reported available
+    bool ok{};                   // Book: result
+    int count{};                 // ReadCount: availableSeats reported
+    std::uint64_t invoke{};
+    std::uint64_t response{};
+};
+
+class History {
+public:
+    explicit History(std::size_t threads) : perThread_(threads) {}
+
+    // Calls wrapping the service; each records one operation (or one per show for listAll).
+    bool book(BookingService& svc, std::size_t thread, long long showId, std::uint32_t seats) {
+        std::vector<std::string> labels;
+        for (int i = 0; i < BookingService::TOTAL_SEATS; ++i)
+            if (seats & (std::uint32_t{1} << i)) labels.push_back(BookingService::seatLabelFromIndex(i));
+        Operation op{Operation::Kind::Book, thread, showId, seats};
+        op.invoke = now();
+        op.ok = svc.bookSeats(showId, labels);
+        op.response = now();
+        perThread_[thread].push_back(op);
+        return op.ok;
+    }
+
+    void readSeats(const BookingService& svc, std::size_t thread, long long showId) {
+        Operation op{Operation::Kind::ReadSeats, thread, showId};
+        op.invoke = now();
+        for (const auto& label : svc.getAvailableSeats(showId))
+            op.seats |= std::uint32_t{1} << BookingService::seatIndexFromLabel(label);
+        op.response = now();
+        perThread_[thread].push_back(op);
+    }
+
+    void listAll(const BookingService& svc, std::size_t thread) {
+        const std::uint64_t invoke = now();
+        const auto shows = svc.getAllShows();
+        const std::uint64_t response = now();
+        for (const auto& show : shows) {
+            Operation op{Operation::Kind::ReadCount, thread, show.id};
+            op.count = show.availableSeats;
+            op.invoke = invoke;
+            op.response = response;
+            perThread_[thread].push_back(op);
+        }
+    }
+
+    // For composite operations built by a test: stamp invoke/response with now(), then add().
+    std::uint64_t now() noexcept { return clock_.fetch_add(1, std::memory_order_seq_cst); }
+    void add(const Operation& op) { perThread_[op.thread].push_back(op); }
+
+    [[nodiscard]] std::vector<Operation> operations() const {
+        std::vector<Operation> all;
+        for (const auto& ops : perThread_) all.insert(all.end(), ops.begin(), ops.end());
+        std::sort(all.begin(), all.end(), [](const Operation& a, const Operation& b) { return a.invoke < b.invoke; });
+        return all;
+    }
+
+private:
+    std::atomic<std::uint64_t> clock_{1};
+    std::vector<std::vector<Operation>> perThread_;   // Written only by its own thread
+};
+
+namespace detail {
+
+constexpr std::uint32_t ALL_SEATS = (BookingService::TOTAL_SEATS == 32)
+                                        ? ~std::uint32_t{0}
+                                        : (std::uint32_t{1} << BookingService::TOTAL_SEATS) - 1;
+
+// Sequential specification of one show. Applies `op` to `booked` and says whether the model
+// would have returned what the operation returned.
+inline bool apply(std::uint32_t& booked, const Operation& op) {
+    switch (op.kind) {
+    case Operation::Kind::Book:
+        if ((booked & op.seats) != 0) return !op.ok;     // a conflicting booking must fail...
+        if (!op.ok) return false;                       // ...and a free one must succeed
+        booked |= op.seats;
+        return true;
+    case Operation::Kind::ReadSeats:
+        return op.seats == (ALL_SEATS & ~booked);
+    case Operation::Kind::ReadCount:
+        return op.count == BookingService::TOTAL_SEATS - std::popcount(booked);
+    }
+    return false;
+}
+
+class ShowChecker {
+public:
+    explicit ShowChecker(std::vector<Operation> ops) : ops_(std::move(ops)), done_((ops_.size() + 63) / 64, 0) {}
+
+    bool linearizable() { return search(0, 0); }
+
+private:
+    bool isDone(std::size_t i) const { return (done_[i / 64] >> (i % 64)) & 1u; }
+    void flip(std::size_t i) { done_[i / 64] ^= std::uint64_t{1} << (i % 64); }
+
+    std::string key(std::uint32_t booked) const {
+        std::string k(reinterpret_cast<const char*>(done_.data()), done_.size() * sizeof(std::uint64_t));
+        k.append(reinterpret_cast<const char*>(&booked), sizeof booked);
+        return k;
+    }
+
+    bool search(std::size_t linearized, std::uint32_t booked) {
+        if (linearized == ops_.size()) return true;
+        // The next operation must have been invoked before every pending one responded.
+        std::uint64_t firstResponse = UINT64_MAX;
+        for (std::size_t i = 0; i < ops_.size(); ++i)
+            if (!isDone(i)) firstResponse = std::min(firstResponse, ops_[i].response);
+        for (std::size_t i = 0; i < ops_.size() && ops_[i].invoke < firstResponse; ++i) {
+            if (isDone(i)) continue;
+            std::uint32_t next = booked;
+            if (!apply(next, ops_[i])) continue;
+            flip(i);
+            if (seen_.insert(key(next)).second && search(linearized + 1, next)) return true;
+            flip(i);
+        }
+        return false;
+    }
+
+    std::vector<Operation> ops_;          // Sorted by invocation
+    std::vector<std::uint64_t> done_;     // Bitset of linearized operations
+    std::unordered_set<std::string> seen_;
+};
+
+} // namespace detail
+
+// Returns the operations of the first show whose history is not linearizable, or std::nullopt.
+inline std::optional<std::vector<Operation>> findViolation(const std::vector<Operation>& history) {
+    std::map<long long, std::vector<Operation>> byShow;
+    for (const auto& op : history) byShow[op.showId].push_back(op);
+    for (auto& [show, ops] : byShow) {
+        std::sort(ops.begin(), ops.end(), [](const Operation& a, const Operation& b) { return a.invoke < b.invoke; });
+        if (!detail::ShowChecker(ops).linearizable()) return ops;
+    }
+    return std::nullopt;
+}
+
+// One line per operation, for failure reports.
+inline std::string describe(const std::vector<Operation>& ops) {
+    std::ostringstream os;
+    for (const auto& op : ops) {
+        os << "  [" << op.invoke << ", " << op.response << "] thread " << op.thread << " show " << op.showId << ": ";
+        switch (op.kind) {
+        case Operation::Kind::Book: os << "book 0x" << std::hex << op.seats << std::dec << " -> " << (op.ok ? "ok" : "fail"); break;
+        case Operation::Kind::ReadSeats: os << "available 0x" << std::hex << op.seats << std::dec; break;
+        case Operation::Kind::ReadCount: os << "count " << op.count; break;
+        }
+        os << '\n';
+    }
+    return os.str();
+}
+
+} // namespace booking::testing
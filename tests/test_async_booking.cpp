@@ -0,0 +1,100 @@
+#include "../include/AsyncBookingService.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+    Task<void> bookOne(AsyncBookingService& async, long long showId, std::string seat, std::atomic<int>& ok) {
+        std::vector<std::string> seats{std::move(seat)};
+        if (co_await async.bookSeatsAsync(showId, std::move(seats))) ok++;
+    }
+
+    Task<int> bookThenCount(AsyncBookingService& async, long long showId) {
+        std::vector<std::string> pair{"A1", "A2"};
+        bool booked = co_await async.bookSeatsAsync(showId, std::move(pair));
+        auto seats = co_await async.getAvailableSeatsAsync(showId);
+        co_return booked ? static_cast<int>(seats.size()) : -1;
+    }
+
+    Task<void> holdAndYield(AsyncMutex& m, EventLoop& loop, std::vector<int>& order, int id) {
+        co_await m.lock(loop);
+        order.push_back(id);
+        co_await loop.yield();       // keep holding while others queue up
+        m.unlock();
+    }
+}
+
+TEST_CASE("Async: awaiting bookings on one event loop") {
+    BookingService svc;
+    auto showId = svc.createShow(svc.addMovie("Up"), svc.addTheater("Loop"));
+    AsyncBookingService async(svc);
+    EventLoop loop;
+
+    REQUIRE(loop.runUntilComplete(bookThenCount(async, showId)) == BookingService::TOTAL_SEATS - 2);
+    REQUIRE(loop.runUntilComplete(bookThenCount(async, showId)) == -1);   // A1/A2 taken
+}
+
+TEST_CASE("Async: AsyncMutex queues waiters in FIFO order") {
+    AsyncMutex m;
+    EventLoop loop;
+    std::vector<int> order;
+    for (int i = 0; i < 5; ++i) loop.spawn(holdAndYield(m, loop, order, i));
+    loop.run();
+    REQUIRE((order == std::vector<int>{0, 1, 2, 3, 4}));
+    REQUIRE(m.tryLock());
+}
+
+TEST_CASE("Async: loops on several threads never double-book") {
+    BookingService svc;
+    auto showId = svc.createShow(svc.addMovie("Ran"), svc.addTheater("Multi"));
+    AsyncBookingService async(svc);
+    std::atomic<int> ok{0};
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&] {
+            EventLoop loop;
+            for (int i = 0; i < 50; ++i)
+                loop.spawn(bookOne(async, showId, BookingService::seatLabelFromIndex(i % BookingService::TOTAL_SEATS), ok));
+            loop.run();
+        });
+    for (auto& th : threads) th.join();
+
+    REQUIRE(ok == BookingService::TOTAL_SEATS);
+    REQUIRE(svc.getAvailableSeats(showId).empty());
+    REQUIRE(async.activeShowLocks() == 0);       // the last request dropped the show's mutex
+}
+
+TEST_CASE("Async: exceptions reach the awaiting coroutine") {
+    BookingService svc;
+    AsyncBookingService async(svc);
+    EventLoop loop;
+    REQUIRE_THROWS_AS(loop.runUntilComplete(async.getAvailableSeatsAsync(12345)), std::invalid_argument);
+}
+
+TEST_CASE("Async: show mutexes exist only for listed shows with requests in flight") {
+    BookingService svc;
+    auto showId = svc.createShow(svc.addMovie("Ran"), svc.addTheater("Idle"));
+    AsyncBookingService async(svc);
+    EventLoop loop;
+    std::atomic<int> ok{0};
+
+    for (long long id = 1000; id < 1100; ++id) loop.spawn(bookOne(async, id, "A1", ok));
+    loop.run();
+    REQUIRE(ok == 0);
+    REQUIRE(async.activeShowLocks() == 0);       // unknown IDs never get an entry
+
+    for (int i = 0; i < 3; ++i) loop.spawn(bookOne(async, showId, BookingService::seatLabelFromIndex(i), ok));
+    loop.run();
+    REQUIRE(ok == 3);
+    REQUIRE(async.activeShowLocks() == 0);
+
+    REQUIRE(svc.removeShow(showId));
+    loop.spawn(bookOne(async, showId, "A5", ok));
+    loop.run();
+    REQUIRE(ok == 3);
+    REQUIRE(async.activeShowLocks() == 0);
+}
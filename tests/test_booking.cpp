@@ -126,4 +126,420 @@ TEST_CASE("Concurrency stress test: configurable thread count") {
               << " | Remaining: " << remaining.size() << std::endl;
 }
 
+TEST_CASE("Booking records a ticket per successful booking") {
+    BookingService svc;
+    int m = svc.addMovie("Dune");
+    int t = svc.addTheater("Odeon");
+    auto showId = svc.createShow(m, t);
+
+    long long t1 = svc.bookTicket(showId, {"A1", "A3"}, 501);
+    REQUIRE(t1 > 0);
+    REQUIRE(svc.bookTicket(showId, {"A3"}, 502) == -1);   // already booked, no record
+    REQUIRE(svc.bookSeats(showId, {"A5"}));                // anonymous ticket
+    long long t2 = svc.bookTicket(showId, {"A2"}, 501);
+
+    auto rec = svc.getTicket(t1);
+    REQUIRE(rec.has_value());
+    REQUIRE(rec->showId == showId);
+    REQUIRE(rec->customerId == 501);
+    REQUIRE(rec->seatMask == ((1u << BookingService::seatIndexFromLabel("A1")) |
+                              (1u << BookingService::seatIndexFromLabel("A3"))));
+
+    auto mine = svc.getTicketsForCustomer(501);
+    REQUIRE(mine.size() == 2);
+    REQUIRE(mine[0].ticketId == t2);
+    REQUIRE(mine[1].ticketId == t1);
+    REQUIRE(svc.getTicketsForCustomer(502).empty());
+}
+
+TEST_CASE("View listings return interned names without copies") {
+    BookingService svc;
+    int m = svc.addMovie("Interstellar");
+    int t1 = svc.addTheater("Regal");
+    int t2 = svc.addTheater("AMC");
+    auto s1 = svc.createShow(m, t1);
+    auto s2 = svc.createShow(m, t2);
+    const auto epoch = svc.catalogEpoch();
+
+    auto views = svc.getAllShowViews();
+    REQUIRE(views.size() == 2);
+    REQUIRE(views[0].movieTitle.data() == views[1].movieTitle.data()); // one interned copy
+    for (const auto& v : views) {
+        REQUIRE(v.id == s1 || v.id == s2);
+        REQUIRE(v.movieId == m);
+        REQUIRE(v.movieTitle == "Interstellar");
+        REQUIRE(v.theaterName == (v.theaterId == t1 ? "Regal" : "AMC"));
+        REQUIRE(v.availableSeats == BookingService::TOTAL_SEATS);
+    }
+    REQUIRE(svc.getAllMovieViews().size() == 1);
+    REQUIRE(svc.getAllTheaterViews().size() == 2);
+
+    REQUIRE(svc.catalogEpoch() == epoch);
+    (void)svc.addMovie("Tenet");
+    REQUIRE(svc.catalogEpoch() > epoch);
+}
+
+TEST_CASE("scanShows pages through shows with a stable cursor") {
+    BookingService svc;
+    int m1 = svc.addMovie("Alien");
+    int m2 = svc.addMovie("Aliens");
+    std::vector<long long> ids;
+    for (int i = 0; i < 10; ++i) {
+        int t = svc.addTheater("Screen " + std::to_string(i));
+        ids.push_back(svc.createShow(i % 2 ? m2 : m1, t));
+    }
+
+    std::vector<long long> seen;
+    long long cursor = 0;
+    int pages = 0;
+    for (;;) {
+        auto page = svc.scanShows(cursor, 3);
+        REQUIRE(page.shows.size() <= 3);
+        for (const auto& s : page.shows) seen.push_back(s.id);
+        cursor = page.nextCursor;
+        ++pages;
+        if (pages == 2) {   // insert mid-scan: must appear exactly once, later
+            int t = svc.addTheater("Late screen");
+            ids.push_back(svc.createShow(m1, t));
+        }
+        if (page.done) break;
+    }
+    REQUIRE(seen == ids);
+
+    auto filtered = svc.scanShows(0, 100, BookingService::ShowFilter{m2, 0, 0});
+    REQUIRE(filtered.done);
+    REQUIRE(filtered.shows.size() == 5);
+    for (const auto& s : filtered.shows) REQUIRE(s.movieId == m2);
+
+    REQUIRE(svc.bookSeats(ids[0], {"A1"}));
+    auto full = svc.scanShows(0, 100, BookingService::ShowFilter{0, 0, BookingService::TOTAL_SEATS});
+    REQUIRE(full.shows.size() == ids.size() - 1);
+}
+
+TEST_CASE("scanShows probes at most SCAN_BUDGET IDs even for a large limit") {
+    BookingService svc;
+    const int m = svc.addMovie("Alien");
+    const std::size_t total = BookingService::SCAN_BUDGET * 2 + 5;
+    for (std::size_t i = 0; i < total; ++i)
+        REQUIRE(svc.createShow(m, svc.addTheater("Screen " + std::to_string(i))) > 0);
+
+    auto page = svc.scanShows(0, total * 10);
+    REQUIRE(page.shows.size() == BookingService::SCAN_BUDGET);
+    REQUIRE(!page.done);
+    std::size_t seen = page.shows.size();
+    int pages = 1;
+    while (!page.done) {
+        page = svc.scanShows(page.nextCursor, total * 10);
+        REQUIRE(page.shows.size() <= BookingService::SCAN_BUDGET);
+        seen += page.shows.size();
+        ++pages;
+    }
+    REQUIRE(seen == total);
+    REQUIRE(pages == 3);
+}
+
+TEST_CASE("Per-movie and per-theater seat totals track bookings") {
+    BookingService svc;
+    int m = svc.addMovie("Heat");
+    int t1 = svc.addTheater("North");
+    int t2 = svc.addTheater("South");
+    auto s1 = svc.createShow(m, t1);
+    auto s2 = svc.createShow(m, t2);
+    const long long total = BookingService::TOTAL_SEATS;
+
+    REQUIRE(svc.getMovieAvailability(m).availableSeats == 2 * total);
+    REQUIRE(svc.getMovieAvailability(m).soldSeats == 0);
+
+    std::vector<std::thread> pool;
+    for (int i = 0; i < 4; ++i)
+        pool.emplace_back([&, i] {
+            (void)svc.bookSeats(i % 2 ? s2 : s1, {BookingService::seatLabelFromIndex(i)});
+        });
+    for (auto& th : pool) th.join();
+    REQUIRE(!svc.bookSeats(s1, {"A1"}));   // failed booking leaves totals alone
+
+    auto movie = svc.getMovieAvailability(m);
+    REQUIRE(movie.soldSeats == 4);
+    REQUIRE(movie.availableSeats == 2 * total - 4);
+    REQUIRE(svc.getTheaterAvailability(t1).soldSeats == 2);
+    REQUIRE(svc.getTheaterAvailability(t2).availableSeats == total - 2);
+    REQUIRE_THROWS_AS(svc.getMovieAvailability(999), std::invalid_argument);
+}
+
+TEST_CASE("topShows reports the most requested show") {
+    BookingService svc;
+    int m = svc.addMovie("Barbie");
+    int t1 = svc.addTheater("Hall 1");
+    int t2 = svc.addTheater("Hall 2");
+    auto hot = svc.createShow(m, t1);
+    auto cold = svc.createShow(m, t2);
+
+    for (int i = 0; i < 4000; ++i) (void)svc.getAvailableSeats(hot);
+    (void)svc.bookSeats(hot, {"A1"});
+    for (int i = 0; i < 100; ++i) (void)svc.getAvailableSeats(cold);
+
+    auto top = svc.topShows(2, std::chrono::seconds(10));   // sampled: counts are estimates
+    REQUIRE(!top.empty());
+    REQUIRE(top[0].showId == hot);
+    REQUIRE(top[0].count > 3000 && top[0].count < 5000);
+    if (top.size() > 1) REQUIRE(top[1].showId == cold);
+}
+
+TEST_CASE("Seat reads see whole bookings while bookers run") {
+    BookingService svc;
+    auto showId = svc.createShow(svc.addMovie("Tenet"), svc.addTheater("Palindrome"));
+
+    std::atomic<bool> done{false};
+    std::atomic<bool> torn{false};
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+        readers.emplace_back([&] {
+            std::size_t last = BookingService::TOTAL_SEATS;
+            while (!done) {
+                const auto seats = svc.getAvailableSeats(showId);
+                // Seats are booked two at a time, so a consistent snapshot never has an odd count,
+                // and availability never grows back.
+                if (seats.size() % 2 != 0 || seats.size() > last) torn = true;
+                last = seats.size();
+            }
+        });
+
+    for (int i = 1; i < BookingService::TOTAL_SEATS; i += 2)
+        REQUIRE(svc.bookSeats(showId, {"A" + std::to_string(i), "A" + std::to_string(i + 1)}));
+    done = true;
+    for (auto& th : readers) th.join();
+
+    REQUIRE(!torn);
+    REQUIRE(svc.getAvailableSeats(showId).empty());
+    REQUIRE(svc.getAllShowViews()[0].availableSeats == 0);
+}
+
+TEST_CASE("removeShow unlists a show and rejects later bookings") {
+    BookingService svc;
+    int m = svc.addMovie("Heat");
+    int t1 = svc.addTheater("Downtown");
+    int t2 = svc.addTheater("Uptown");
+    auto s1 = svc.createShow(m, t1);
+    auto s2 = svc.createShow(m, t2);
+    long long ticket = svc.bookTicket(s1, {"A1", "A2"}, 77);
+    REQUIRE(ticket > 0);
+    const auto epoch = svc.catalogEpoch();
+
+    REQUIRE(svc.removeShow(s1));
+    REQUIRE(!svc.removeShow(s1));
+    REQUIRE(svc.catalogEpoch() != epoch);
+    REQUIRE_THROWS_AS(svc.getAvailableSeats(s1), std::invalid_argument);
+    REQUIRE(!svc.bookSeats(s1, {"A3"}));
+    REQUIRE(svc.getAllShowViews().size() == 1);
+    REQUIRE(svc.getTicket(ticket).has_value());           // history is kept
+
+    auto totals = svc.getMovieAvailability(m);            // only s2 is left
+    REQUIRE(totals.availableSeats == BookingService::TOTAL_SEATS);
+    REQUIRE(totals.soldSeats == 0);
+    REQUIRE(svc.getTheaterAvailability(t1).availableSeats == 0);
+
+    auto again = svc.createShow(m, t1);                   // the pair is free again
+    REQUIRE(again > s2);
+    REQUIRE(svc.removeShow(s2));
+    REQUIRE(svc.removeShow(again));
+    REQUIRE(!svc.listMovies());                           // no active movies left
+}
+
+TEST_CASE("removeShow races safely with bookers and readers") {
+    BookingService svc;
+    int m = svc.addMovie("Ronin");
+    std::vector<long long> shows;
+    for (int i = 0; i < 8; ++i) shows.push_back(svc.createShow(m, svc.addTheater("Race " + std::to_string(i))));
+
+    std::atomic<bool> done{false};
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 3; ++w)
+        workers.emplace_back([&, w] {
+            for (int i = 0; !done; ++i) {
+                const long long id = shows[static_cast<std::size_t>(i + w) % shows.size()];
+                (void)svc.bookSeats(id, {BookingService::seatLabelFromIndex(i % BookingService::TOTAL_SEATS)});
+                try { (void)svc.getAvailableSeats(id); } catch (const std::invalid_argument&) {}
+            }
+        });
+    for (long long id : shows) {
+        std::this_thread::yield();
+        REQUIRE(svc.removeShow(id));
+    }
+    done = true;
+    for (auto& th : workers) th.join();
+
+    auto totals = svc.getMovieAvailability(m);
+    REQUIRE(totals.availableSeats == 0);
+    REQUIRE(totals.soldSeats == 0);
+}
+
+TEST_CASE("Show listings come back in show ID order") {
+    BookingService svc;
+    int m = svc.addMovie("Memento");
+    std::vector<long long> ids;
+    for (int i = 0; i < 40; ++i) ids.push_back(svc.createShow(m, svc.addTheater("Order " + std::to_string(i))));
+    REQUIRE(svc.removeShow(ids[7]));
+    ids.erase(ids.begin() + 7);
+
+    auto views = svc.getAllShowViews();
+    auto infos = svc.getAllShows();
+    REQUIRE(views.size() == ids.size());
+    REQUIRE(infos.size() == ids.size());
+    for (std::size_t i = 0; i < ids.size(); ++i) {
+        REQUIRE(views[i].id == ids[i]);
+        REQUIRE(infos[i].id == ids[i]);
+    }
+}
+
+TEST_CASE("bookAcrossShows books every leg or none") {
+    BookingService svc;
+    int m = svc.addMovie("Kill Bill");
+    long long vol1 = svc.createShow(m, svc.addTheater("Screen 1"));
+    long long vol2 = svc.createShow(m, svc.addTheater("Screen 2"));
+    REQUIRE(svc.bookSeats(vol2, {"A5"}));
+
+    std::vector<BookingService::ShowSeats> legs{{vol2, {"A4", "A5"}}, {vol1, {"A4", "A5"}}};
+    REQUIRE(svc.bookAcrossShows(legs, 7).empty());                      // A5 taken in vol2
+    REQUIRE(svc.getAvailableSeats(vol1).size() == BookingService::TOTAL_SEATS);
+
+    legs[0].seatLabels = {"A6", "A7"};
+    auto tickets = svc.bookAcrossShows(legs, 7);
+    REQUIRE(tickets.size() == 2);
+    REQUIRE(svc.getTicket(tickets[0])->showId == vol2);                // ticket order follows the legs
+    REQUIRE(svc.getTicket(tickets[1])->showId == vol1);
+    REQUIRE(svc.getTicketsForCustomer(7).size() == 2);
+    REQUIRE(svc.getAvailableSeats(vol1).size() == BookingService::TOTAL_SEATS - 2);
+    REQUIRE(svc.getMovieAvailability(m).soldSeats == 5);
+
+    std::vector<BookingService::ShowSeats> same{{vol1, {"A1"}}, {vol1, {"A2"}}};
+    REQUIRE(svc.bookAcrossShows(same).empty());
+    std::vector<BookingService::ShowSeats> unknown{{vol1, {"A1"}}, {999, {"A1"}}};
+    REQUIRE(svc.bookAcrossShows(unknown).empty());
+    std::vector<BookingService::ShowSeats> invalid{{vol1, {"A1"}}, {vol2, {"Z9"}}};
+    REQUIRE(svc.bookAcrossShows(invalid).empty());
+    REQUIRE(svc.bookAcrossShows({}).empty());                            // no legs is an error too
+    REQUIRE(svc.getAvailableSeats(vol1).size() == BookingService::TOTAL_SEATS - 2);
+}
+
+TEST_CASE("bookAcrossShows takes no ticket ID unless every leg fits in the store") {
+    MutationLog log;
+    BookingService svc;
+    svc.setMutationLog(&log);
+    int m = svc.addMovie("Kill Bill");
+    long long vol1 = svc.createShow(m, svc.addTheater("Screen 1"));
+    long long vol2 = svc.createShow(m, svc.addTheater("Screen 2"));
+    const auto last = static_cast<long long>(TicketStore::CAPACITY) - 1;   // Highest ticket ID
+    REQUIRE(svc.skipTicketIds(last - 1));                                  // room for one ticket
+    const auto lsn = log.lastLsn();
+
+    std::vector<BookingService::ShowSeats> legs{{vol1, {"A1"}}, {vol2, {"A1"}}};
+    REQUIRE(svc.bookAcrossShows(legs, 7).empty());
+    REQUIRE(svc.getAvailableSeats(vol1).size() == BookingService::TOTAL_SEATS);
+    REQUIRE(svc.getTicketsForCustomer(7).empty());
+    REQUIRE(log.lastLsn() == lsn);
+    REQUIRE(svc.bookTicket(vol2, {"A1"}, 7) == last);                      // the ID is still free
+    REQUIRE(log.lastLsn() == lsn + 1);
+}
+
+TEST_CASE("bookAcrossShows in opposite orders neither deadlocks nor double-books") {
+    BookingService svc;
+    int m = svc.addMovie("Grindhouse");
+    std::vector<long long> shows;
+    for (int i = 0; i < 3; ++i) shows.push_back(svc.createShow(m, svc.addTheater("Double " + std::to_string(i))));
+
+    std::atomic<int> booked{0};
+    std::vector<std::thread> workers;
+    for (int w = 0; w < 4; ++w)
+        workers.emplace_back([&, w] {
+            for (int seat = 0; seat < BookingService::TOTAL_SEATS; ++seat) {
+                const std::string label = BookingService::seatLabelFromIndex(seat);
+                std::vector<BookingService::ShowSeats> legs{{shows[0], {label}}, {shows[1], {label}}, {shows[2], {label}}};
+                if (w % 2) std::reverse(legs.begin(), legs.end());
+                if (w == 3) legs.pop_back();
+                if (!svc.bookAcrossShows(legs).empty()) booked += static_cast<int>(legs.size());
+                if (svc.bookSeats(shows[static_cast<std::size_t>(w) % 3], {label})) ++booked;
+            }
+        });
+    for (auto& th : workers) th.join();
+
+    int available = 0;
+    for (long long id : shows) available += static_cast<int>(svc.getAvailableSeats(id).size());
+    REQUIRE(booked + available == 3 * BookingService::TOTAL_SEATS);
+}
+
+TEST_CASE("Seat holds block seats until confirmed or released") {
+    BookingService svc;
+    int m = svc.addMovie("Tenet");
+    long long show = svc.createShow(m, svc.addTheater("Holdover"));
+
+    long long hold = svc.holdSeats(show, {"A1", "A2"});
+    REQUIRE(hold > 0);
+    REQUIRE(svc.getAvailableSeats(show).size() == BookingService::TOTAL_SEATS - 2);
+    REQUIRE(!svc.bookSeats(show, {"A2"}));
+    REQUIRE(svc.holdSeats(show, {"A1"}) == -1);
+    REQUIRE(svc.getMovieAvailability(m).soldSeats == 2);
+
+    long long ticket = svc.confirmHold(hold, 11);
+    REQUIRE(ticket > 0);
+    REQUIRE(svc.getTicket(ticket)->seatMask == 0b11u);
+    REQUIRE(svc.getTicketsForCustomer(11).size() == 1);
+    REQUIRE(svc.confirmHold(hold, 11) == -1);                           // consumed
+    REQUIRE(!svc.releaseHold(hold));
+
+    long long other = svc.holdSeats(show, {"A3"});
+    REQUIRE(svc.releaseHold(other));
+    REQUIRE(svc.getAvailableSeats(show).size() == BookingService::TOTAL_SEATS - 2);
+    REQUIRE(svc.getMovieAvailability(m).soldSeats == 2);
+    REQUIRE(svc.bookSeats(show, {"A3"}));
+}
+
+TEST_CASE("confirmHold keeps the hold when the ticket store is full") {
+    BookingService svc;
+    long long show = svc.createShow(svc.addMovie("Tenet"), svc.addTheater("Holdover"));
+    REQUIRE(svc.skipTicketIds(static_cast<long long>(TicketStore::CAPACITY) - 2));
+    REQUIRE(svc.bookTicket(show, {"A20"}, 11) > 0);                    // the last ticket ID
+
+    long long hold = svc.holdSeats(show, {"A1", "A2"});
+    REQUIRE(svc.confirmHold(hold, 11) == -1);
+    REQUIRE(svc.getTicketsForCustomer(11).size() == 1);
+    REQUIRE(svc.getAvailableSeats(show).size() == BookingService::TOTAL_SEATS - 3);
+    REQUIRE(svc.releaseHold(hold));                                     // still held, so it can be given back
+    REQUIRE(svc.getAvailableSeats(show).size() == BookingService::TOTAL_SEATS - 1);
+}
+
+TEST_CASE("Seat categories track availability and book the cheapest seats first") {
+    using Category = BookingService::SeatCategory;
+    BookingService svc;
+    long long show = svc.createShow(svc.addMovie("Dune"), svc.addTheater("Imax"));
+    REQUIRE(svc.getAvailability(show, Category::Standard) == 12);
+    REQUIRE(svc.getAvailability(show, Category::Premium) == 5);
+    REQUIRE(svc.getAvailability(show, Category::Recliner) == 3);
+    REQUIRE(BookingService::seatCategory(BookingService::seatIndexFromLabel("A13")) == Category::Premium);
+    REQUIRE_THROWS_AS((void)svc.getAvailability(show + 1, Category::Standard), std::invalid_argument);
+
+    REQUIRE(svc.quoteSeats({"A1", "A13", "A20"}) == 1200 + 1800 + 2600);
+    REQUIRE(svc.quoteSeats({"A1", "A1"}) == -1);
+
+    // Standard seats go first, lowest numbers first, then the next cheapest category.
+    REQUIRE(svc.bookSeats(show, {"A2", "A13"}));
+    long long ticket = svc.bookCheapestSeats(show, 12, 5);
+    REQUIRE(ticket > 0);
+    REQUIRE(svc.getTicket(ticket)->seatMask == 0x00002FFDu);            // A1, A3-A12, A14
+    REQUIRE(svc.getAvailability(show, Category::Standard) == 0);
+    REQUIRE(svc.getAvailability(show, Category::Premium) == 3);
+
+    // Repricing changes the order: recliners on offer below premium.
+    svc.setCategoryPrice(Category::Recliner, 900);
+    ticket = svc.bookCheapestSeats(show, 4);
+    REQUIRE(svc.getTicket(ticket)->seatMask == 0x000E4000u);            // A15, A18-A20
+    REQUIRE(svc.getAvailability(show, Category::Recliner) == 0);
+    REQUIRE(svc.bookCheapestSeats(show, 3) == -1);                        // only 2 left
+    REQUIRE(svc.bookCheapestSeats(show, 0) == -1);
+
+    long long hold = svc.holdSeats(show, {"A16"});
+    REQUIRE(svc.getAvailability(show, Category::Premium) == 1);
+    REQUIRE(svc.releaseHold(hold));
+    REQUIRE(svc.getAvailability(show, Category::Premium) == 2);
+}
+
 //ToDO: Add more tests for edge cases, invalid inputs, listing functions, etc.
\ No newline at end of file
@@ -0,0 +1,117 @@
+#include "../include/BookingService.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using namespace booking;
+
+namespace {
+std::string writeTemp(const std::string& name, const std::string& content) {
+    const std::string path = "/tmp/booking_import_" + name;
+    std::ofstream(path, std::ios::binary) << content;
+    return path;
+}
+} // namespace
+
+TEST_CASE("importCatalog loads a CSV schedule with dedup against file and catalog") {
+    BookingService svc;
+    const int existing = svc.addMovie("Alien");
+    const auto path = writeTemp("basic.csv",
+        "movie,theater\n"
+        "Alien,Roxy\n"
+        "Aliens,Roxy\r\n"
+        "ALIEN , roxy\n"                    // same show, different case and padding
+        "\"Crouching \"\"Tiger\"\"\",Rialto,ignored column\n"
+        "\n"
+        "Aliens,Rialto\n"
+        "no theater\n"
+        "\"unterminated,Roxy\n");
+
+    auto stats = svc.importCatalog(path, true);
+    std::remove(path.c_str());
+    REQUIRE(stats.has_value());
+    REQUIRE(stats->rows == 7);
+    REQUIRE(stats->moviesCreated == 2);         // Alien already existed
+    REQUIRE(stats->theatersCreated == 2);
+    REQUIRE(stats->showsCreated == 4);
+    REQUIRE(stats->duplicateShows == 1);
+    REQUIRE(stats->malformedRows == 2);
+    REQUIRE(stats->rejectedCapacity == 0);
+
+    auto movies = svc.getAllMovieViews();
+    REQUIRE(movies.size() == 3);
+    auto shows = svc.getAllShowViews();          // ID order = file order
+    REQUIRE(shows.size() == 4);
+    REQUIRE(shows[0].movieId == existing);
+    REQUIRE(shows[0].theaterName == "Roxy");
+    REQUIRE(shows[1].movieTitle == "Aliens");
+    REQUIRE(shows[2].movieTitle == "Crouching \"Tiger\"");
+    REQUIRE(shows[2].theaterName == "Rialto");
+    REQUIRE(svc.addTheater("RIALTO") == -1);     // imported names dedup later adds
+    REQUIRE(svc.getMovieAvailability(existing).availableSeats == BookingService::TOTAL_SEATS);
+    REQUIRE(svc.bookSeats(shows[3].id, {"A1"}));
+}
+
+TEST_CASE("importCatalog loads JSONL with escapes and skips bad lines") {
+    BookingService svc;
+    const auto path = writeTemp("basic.jsonl",
+        "{\"movie\": \"Am\\u00e9lie\", \"theater\": \"Odeon\", \"slot\": 1900}\n"
+        "{\"theater\":\"Odeon\",\"movie\":\"Heat\",\"premium\":true}\n"
+        "{\"movie\": \"Heat\\n2\", \"theater\": \"Odeon\\\\East\"}\n"
+        "{\"movie\": \"Heat\", \"theater\": \"odeon\"}\n"
+        "{\"movie\": \"Heat\"}\n"
+        "not json\n");
+
+    auto stats = svc.importCatalog(path);
+    std::remove(path.c_str());
+    REQUIRE(stats.has_value());
+    REQUIRE(stats->rows == 6);
+    REQUIRE(stats->showsCreated == 3);
+    REQUIRE(stats->duplicateShows == 1);
+    REQUIRE(stats->malformedRows == 2);
+
+    auto shows = svc.getAllShowViews();
+    REQUIRE(shows[0].movieTitle == "Am\xC3\xA9lie");
+    REQUIRE(shows[2].movieTitle == "Heat\n2");
+    REQUIRE(shows[2].theaterName == "Odeon\\East");
+}
+
+TEST_CASE("importCatalog matches sequential adds on a larger file") {
+    std::string csv;
+    for (int i = 0; i < 20000; ++i)
+        csv += "Movie " + std::to_string(i % 97) + ",Theater " + std::to_string(i % 89) + "\n";
+    const auto path = writeTemp("large.csv", csv);
+
+    BookingService bulk;
+    auto stats = bulk.importCatalog(path);
+    std::remove(path.c_str());
+    REQUIRE(stats.has_value());
+    REQUIRE(stats->moviesCreated == 97);
+    REQUIRE(stats->theatersCreated == 89);
+    REQUIRE(stats->showsCreated == 8633);        // 97 * 89 pairs, all distinct since gcd = 1
+    REQUIRE(stats->duplicateShows == 20000 - 8633);
+
+    auto views = bulk.getAllShowViews();
+    REQUIRE(views.size() == 8633);
+    for (std::size_t i = 0; i < views.size(); ++i) {
+        REQUIRE(views[i].movieTitle == "Movie " + std::to_string(i % 97));
+        REQUIRE(views[i].theaterName == "Theater " + std::to_string(i % 89));
+    }
+    REQUIRE(!bulk.importCatalog("/tmp/booking_import_missing.csv").has_value());
+}
+
+TEST_CASE("importCatalog reads a movie,theater first row as data unless told it is a header") {
+    const auto path = writeTemp("header.csv", "\n  \nMovie,Theater\nHeat,Roxy\n");
+    BookingService data, headed;
+    auto stats = data.importCatalog(path);
+    auto skipped = headed.importCatalog(path, true);
+    std::remove(path.c_str());
+    REQUIRE(stats.has_value());
+    REQUIRE(stats->rows == 2);
+    REQUIRE(stats->showsCreated == 2);
+    REQUIRE(data.getMovieTitle(1) == "Movie");
+    REQUIRE(skipped.has_value());
+    REQUIRE(skipped->rows == 1);
+    REQUIRE(headed.getAllShowViews().front().movieTitle == "Heat");
+}
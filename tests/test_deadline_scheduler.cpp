@@ -0,0 +1,123 @@
+#include "../include/DeadlineScheduler.hpp"
+#include "../include/ShardRouter.hpp"
+#include "../include/ShardServer.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace booking;
+using namespace std::chrono_literals;
+using Clock = DeadlineScheduler::Clock;
+
+TEST_CASE("DeadlineScheduler: runs or sheds every request exactly once") {
+    WorkStealingPool pool(1);
+    std::atomic<int> ran{0}, shed{0}, otherReason{0};   // callbacks may run on pool workers: assert here
+    {
+        DeadlineScheduler scheduler(pool, {.initialLimit = 1, .minLimit = 1, .maxLimit = 1});
+        // An already-expired request is shed inside submit().
+        REQUIRE(!scheduler.submit(Clock::now() - 1ms, [&] { ++ran; }, [&](DeadlineScheduler::ShedReason) { ++shed; }));
+        REQUIRE(shed.load() == 1);
+
+        // One slot, 2 ms jobs, 10 ms deadlines: only the first few can make it.
+        const auto deadline = Clock::now() + 10ms;
+        for (int i = 0; i < 40; ++i)
+            scheduler.submit(deadline, [&] { std::this_thread::sleep_for(2ms); ++ran; },
+                             [&](DeadlineScheduler::ShedReason reason) {
+                                 otherReason += reason != DeadlineScheduler::ShedReason::Deadline;
+                                 ++shed;
+                             });
+        pool.waitIdle();
+        std::this_thread::sleep_for(20ms);
+        pool.waitIdle();
+        REQUIRE(otherReason.load() == 0);
+        const auto m = scheduler.metrics();
+        REQUIRE(m.submitted == 41);
+        REQUIRE(m.completed + m.shedDeadline + m.queued == 41);
+        REQUIRE(m.completed >= 1);
+        REQUIRE(m.completed <= 6);
+        REQUIRE(m.queueTime.count() == m.completed);
+    }
+    REQUIRE(ran.load() + shed.load() == 41);                           // destructor sheds the rest
+    REQUIRE(otherReason.load() == 0);
+}
+
+TEST_CASE("DeadlineScheduler: full queue sheds arrivals and the limit adapts") {
+    WorkStealingPool pool(2);
+    std::atomic<bool> release{false};
+    std::atomic<int> queueFull{0};
+    {
+        DeadlineScheduler scheduler(pool, {.initialLimit = 1, .minLimit = 1, .maxLimit = 8, .maxQueued = 2});
+        const auto far = Clock::now() + 10s;
+        auto countFull = [&](DeadlineScheduler::ShedReason reason) { queueFull += reason == DeadlineScheduler::ShedReason::QueueFull; };
+        scheduler.submit(far, [&] { while (!release) std::this_thread::yield(); }, countFull);
+        scheduler.submit(far, [] {}, countFull);
+        scheduler.submit(far, [] {}, countFull);
+        REQUIRE(!scheduler.submit(far, [] {}, countFull));
+        REQUIRE(queueFull.load() == 1);
+        release = true;
+        pool.waitIdle();
+
+        // Quick jobs with no queueing raise the limit...
+        for (int i = 0; i < 200; ++i) {
+            scheduler.submit(far, [] {}, countFull);
+            pool.waitIdle();
+        }
+        const std::size_t raised = scheduler.limit();
+        REQUIRE(raised > 1);
+        // ...and requests that wait longer than the target (queued in the pool) lower it again.
+        for (int i = 0; i < 10; ++i) {
+            for (int j = 0; j < 8; ++j) scheduler.submit(far, [] { std::this_thread::sleep_for(6ms); }, countFull);
+            pool.waitIdle();
+        }
+        REQUIRE(scheduler.limit() < raised);
+    }
+}
+
+TEST_CASE("ShardServer with deadlines sheds hopeless requests and reports stats") {
+    BookingService service;
+    const std::string path = "/tmp/booking_deadline_" + std::to_string(::getpid()) + ".sock";
+    ShardServer server(service, path);
+    server.enableDeadlines(std::chrono::milliseconds(500), 2);
+    REQUIRE(server.start());
+
+    ShardRouter router;
+    REQUIRE(router.addShard(path) == std::size_t{0});
+    router.setRequestDeadline(std::chrono::milliseconds(200));
+    const long long show = router.createShow(router.addMovie("Rush"), router.addTheater("Hall"));
+    REQUIRE(router.bookSeats(show, {"A1"}));
+    REQUIRE(router.getAvailableSeats(show).size() == BookingService::TOTAL_SEATS - 1);
+
+    // A zero budget cannot be met once a service time has been measured.
+    LocalSocket socket = LocalSocket::connect(path);
+    const auto seats = FrameWriter().put<std::uint8_t>(shard_protocol::DEADLINE).put<std::uint32_t>(0)
+                           .put<std::uint8_t>(shard_protocol::SEATS).put<std::int64_t>(show).take();
+    std::string response;
+    REQUIRE(socket.sendFrame(seats));
+    REQUIRE(socket.recvFrame(response));
+    REQUIRE(FrameReader(response).get<std::int64_t>() == shard_protocol::SHED);
+
+    // A completion is counted just after its response is sent; give the last one a moment.
+    std::uint64_t submitted = 0, completed = 0, shedDeadline = 0;
+    for (int attempt = 0; attempt < 100 && completed < 2; ++attempt) {
+        std::this_thread::sleep_for(1ms);
+        REQUIRE(socket.sendFrame(FrameWriter().put<std::uint8_t>(shard_protocol::STATS).take()));
+        REQUIRE(socket.recvFrame(response));
+        FrameReader stats(response);
+        submitted = stats.get<std::uint64_t>();
+        completed = stats.get<std::uint64_t>();
+        shedDeadline = stats.get<std::uint64_t>();
+        REQUIRE(!stats.failed());
+    }
+    REQUIRE(submitted == 3);
+    REQUIRE(completed == 2);
+    REQUIRE(shedDeadline == 1);
+
+    const auto metrics = server.schedulerMetrics();
+    REQUIRE(metrics.has_value());
+    REQUIRE(metrics->queueTime.count() == 2);
+    server.stop();
+}
@@ -0,0 +1,81 @@
+#include "../include/EpochManager.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+struct Tracked {
+    static inline std::atomic<int> live{0};
+    long long value;
+    explicit Tracked(long long v) : value(v) { live++; }
+    ~Tracked() { value = -1; live--; }
+};
+} // namespace
+
+TEST_CASE("EpochManager: retired objects outlive pinned readers") {
+    EpochManager epochs;
+    auto* obj = new Tracked(7);
+    const int before = Tracked::live;
+
+    {
+        auto outer = epochs.pin();
+        {
+            auto inner = epochs.pin();     // nested guard does not end the section early
+        }
+        epochs.retire(obj);
+        epochs.reclaim();
+        epochs.reclaim();
+        REQUIRE(Tracked::live == before);  // still reachable by this thread
+        REQUIRE(obj->value == 7);
+    }
+
+    epochs.reclaim();
+    epochs.reclaim();
+    REQUIRE(Tracked::live == before - 1);
+    REQUIRE(epochs.pending() == 0);
+}
+
+TEST_CASE("EpochManager: destruction frees everything still retired") {
+    const int before = Tracked::live;
+    {
+        EpochManager epochs;
+        auto guard = epochs.pin();
+        epochs.retire(new Tracked(1));
+        epochs.retire(new Tracked(2));
+        REQUIRE(epochs.pending() == 2);
+    }
+    REQUIRE(Tracked::live == before);
+}
+
+TEST_CASE("EpochManager: concurrent readers never see a freed object") {
+    EpochManager epochs;
+    std::atomic<Tracked*> current{new Tracked(0)};
+    std::atomic<bool> done{false};
+    std::atomic<bool> sawFreed{false};
+
+    std::vector<std::thread> readers;
+    for (int r = 0; r < 3; ++r)
+        readers.emplace_back([&] {
+            while (!done.load(std::memory_order_relaxed)) {
+                auto guard = epochs.pin();
+                const Tracked* t = current.load(std::memory_order_acquire);
+                if (t->value < 0) sawFreed = true;
+            }
+        });
+
+    for (long long i = 1; i <= 5000; ++i) {
+        Tracked* old = current.exchange(new Tracked(i), std::memory_order_acq_rel);
+        epochs.retire(old);
+    }
+    done = true;
+    for (auto& th : readers) th.join();
+
+    REQUIRE(!sawFreed);
+    epochs.retire(current.load());
+    epochs.reclaim();
+    epochs.reclaim();
+    REQUIRE(epochs.pending() == 0);
+}
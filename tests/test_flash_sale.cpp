@@ -0,0 +1,116 @@
+#include "../include/FlashSaleGate.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+using namespace std::chrono_literals;
+using Status = FlashSaleGate::Status;
+
+namespace {
+long long makeShow(BookingService& svc) {
+    return svc.createShow(svc.addMovie("Opening Night"), svc.addTheater("Grand"));
+}
+
+std::vector<std::string> seat(int idx) { return {BookingService::seatLabelFromIndex(idx)}; }
+} // namespace
+
+TEST_CASE("FlashSaleGate: admits positions in order at the configured rate") {
+    BookingService svc;
+    const long long show = makeShow(svc);
+    FlashSaleGate gate(svc);
+    const auto t0 = FlashSaleGate::Clock::now();
+    REQUIRE(gate.enableQueue(show, {.capacity = 100, .admitPerSecond = 10, .burst = 2}, t0));
+    REQUIRE(!gate.enableQueue(show, {}, t0));                    // already flagged
+    REQUIRE(!gate.enableQueue(show + 1, {}, t0));                // unknown show
+    REQUIRE(!gate.bookSeats(show, seat(0)));                     // flagged shows need a token
+
+    std::vector<FlashSaleGate::Token> tokens;
+    for (int i = 0; i < 6; ++i) {
+        auto a = gate.join(show, t0);
+        REQUIRE(a.token.position == static_cast<std::uint64_t>(i));
+        REQUIRE(a.status == (i < 2 ? Status::Admitted : Status::Waiting));   // burst of 2
+        tokens.push_back(a.token);
+    }
+    auto last = gate.poll(tokens[5], t0);
+    REQUIRE(last.ahead == 3);
+    REQUIRE(last.estimatedWait == 400ms);
+
+    REQUIRE(gate.poll(tokens[2], t0 + 100ms).status == Status::Admitted);   // 10/s: one per 100 ms
+    REQUIRE(gate.poll(tokens[3], t0 + 100ms).status == Status::Waiting);
+    REQUIRE(gate.poll(tokens[5], t0 + 400ms).status == Status::Admitted);
+
+    REQUIRE(!gate.bookSeats(FlashSaleGate::Token{show, 1, tokens[1].tag + 1}, seat(0), t0 + 400ms)); // forged tag
+    REQUIRE(gate.poll(FlashSaleGate::Token{show, 99, 0}, t0).status == Status::Invalid);
+
+    REQUIRE(gate.bookSeats(tokens[0], seat(0), t0 + 400ms));
+    REQUIRE(!gate.bookSeats(tokens[0], seat(1), t0 + 400ms));              // spent
+    REQUIRE(gate.poll(tokens[0], t0 + 400ms).status == Status::Expired);
+    REQUIRE(!gate.bookSeats(tokens[1], seat(0), t0 + 400ms));              // seat taken: token survives
+    REQUIRE(gate.bookSeats(tokens[1], seat(1), t0 + 400ms));
+}
+
+TEST_CASE("FlashSaleGate: bounded queue, lapsed admissions and sold-out rejection") {
+    BookingService svc;
+    const long long show = makeShow(svc);
+    FlashSaleGate gate(svc);
+    const auto t0 = FlashSaleGate::Clock::now();
+    REQUIRE(gate.enableQueue(show, {.capacity = 3, .admitPerSecond = 1, .burst = 1, .admitWindow = 5s}, t0));
+
+    auto first = gate.join(show, t0);
+    REQUIRE(first.status == Status::Admitted);
+    for (int i = 0; i < 3; ++i) REQUIRE(gate.join(show, t0).status == Status::Waiting);
+    REQUIRE(gate.join(show, t0).status == Status::QueueFull);
+    REQUIRE(gate.join(show, t0 + 1s).status == Status::Waiting);             // one admitted, one slot free
+
+    REQUIRE(gate.poll(first.token, t0 + 5s).status == Status::Expired);      // never used within the window
+    REQUIRE(!gate.bookSeats(first.token, seat(0), t0 + 5s));
+
+    // Sell the rest directly (as if through other channels), then nobody queues or books.
+    for (int i = 0; i < BookingService::TOTAL_SEATS; ++i) REQUIRE(svc.bookSeats(show, seat(i)));
+    REQUIRE(gate.join(show, t0 + 6s).status == Status::SoldOut);
+    auto waiting = FlashSaleGate::Token{show, 4, 0};
+    REQUIRE(gate.poll(waiting, t0 + 6s).status == Status::Invalid);          // tags are not guessable
+
+    REQUIRE(gate.disableQueue(show));
+    REQUIRE(!gate.isQueued(show));
+    REQUIRE(gate.join(show, t0).status == Status::Invalid);
+}
+
+TEST_CASE("FlashSaleGate: concurrent clients never exceed admissions or double-book") {
+    BookingService svc;
+    const long long show = makeShow(svc);
+    FlashSaleGate gate(svc);
+    REQUIRE(gate.enableQueue(show, {.capacity = 1000, .admitPerSecond = 2000, .burst = 4}));
+
+    std::atomic<int> booked{0}, soldOut{0};
+    std::vector<std::thread> clients;
+    for (int c = 0; c < 8; ++c)
+        clients.emplace_back([&, c] {
+            for (int attempt = 0; attempt < 20; ++attempt) {
+                auto a = gate.join(show);
+                while (a.status == Status::Waiting) {
+                    std::this_thread::sleep_for(200us);
+                    a = gate.poll(a.token);
+                }
+                if (a.status == Status::SoldOut) {
+                    ++soldOut;
+                    return;
+                }
+                if (a.status != Status::Admitted) continue;
+                // Try seats until one sticks or the show is gone.
+                for (int s = (c * 3 + attempt) % BookingService::TOTAL_SEATS, n = 0; n < BookingService::TOTAL_SEATS; ++n)
+                    if (gate.bookSeats(a.token, seat((s + n) % BookingService::TOTAL_SEATS))) {
+                        ++booked;
+                        break;
+                    }
+            }
+        });
+    for (auto& t : clients) t.join();
+    REQUIRE(booked.load() == BookingService::TOTAL_SEATS);
+    REQUIRE(svc.getAvailableSeatCount(show) == 0);
+    REQUIRE(soldOut.load() > 0);
+}
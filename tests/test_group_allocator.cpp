@@ -0,0 +1,99 @@
+#include "../include/GroupAllocator.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <stdexcept>
+
+using namespace booking;
+
+namespace {
+int seated(const GroupPlacement& p) {
+    int n = 0;
+    for (const auto& b : p.blocks) n += b.count;
+    return n;
+}
+} // namespace
+
+TEST_CASE("SeatMap: booking, release and orphan counting") {
+    REQUIRE_THROWS_AS(SeatMap(0, 10), std::invalid_argument);
+    REQUIRE_THROWS_AS(SeatMap(2, 65), std::invalid_argument);
+
+    SeatMap map(2, 10);
+    REQUIRE(map.freeSeats() == 20);
+    REQUIRE(map.orphanSeats() == 0);
+    REQUIRE(map.book(0, 0b0000000101));         // seats 0 and 2: seat 1 is stranded
+    REQUIRE(!map.book(0, 0b0000000011));        // seat 0 taken, nothing booked
+    REQUIRE(map.isFree(0, 1));
+    REQUIRE(!map.book(0, 1ull << 10));          // outside the row
+    REQUIRE(map.orphanSeats() == 1);
+    REQUIRE(map.book(1, 0b0111111110));         // seats 0 and 9 left, each against an aisle
+    REQUIRE(map.orphanSeats() == 3);
+    map.release(0, 0b0000000101);
+    REQUIRE(map.orphanSeats() == 2);
+    REQUIRE(map.freeSeats() == 12);
+
+    SeatMap wide(1, 64);
+    REQUIRE(wide.book(0, ~0ull));
+    REQUIRE(wide.freeSeats() == 0);
+}
+
+TEST_CASE("GroupAllocator: fewest adjacent rows, split evenly and aligned") {
+    SeatMap map(5, 10);
+    auto one = GroupAllocator::place(map, 6);
+    REQUIRE(one.has_value());
+    REQUIRE(one->blocks.size() == 1);
+    REQUIRE(one->blocks[0].row == 0);
+    REQUIRE(one->blocks[0].firstSeat == 2);     // centred in the row
+    REQUIRE(one->orphans == 0);
+
+    auto big = GroupAllocator::place(map, 25);
+    REQUIRE(big.has_value());
+    REQUIRE(big->blocks.size() == 3);           // 25 seats need three 10-seat rows
+    REQUIRE(seated(*big) == 25);
+    for (std::size_t i = 0; i < big->blocks.size(); ++i) REQUIRE(big->blocks[i].row == static_cast<int>(i));
+    REQUIRE(GroupAllocator::apply(map, *big));
+    REQUIRE(map.freeSeats() == 25);
+
+    // Rows 3 and 4 are the only adjacent pair left with room for 20.
+    auto rest = GroupAllocator::place(map, 20);
+    REQUIRE(rest.has_value());
+    REQUIRE(rest->blocks.size() == 2);
+    REQUIRE(rest->blocks[0].row == 3);
+    REQUIRE(!GroupAllocator::place(map, 26).has_value());
+    REQUIRE(!GroupAllocator::place(map, 0).has_value());
+}
+
+TEST_CASE("GroupAllocator: avoids orphan seats that first-fit leaves") {
+    // Free runs: seats 0..4 and 6..9. A party of 4 in the first run strands a seat.
+    SeatMap map(1, 12);
+    REQUIRE(map.book(0, 0b110000100000));
+    auto naive = GroupAllocator::firstFit(map, 4);
+    REQUIRE(naive.has_value());
+    REQUIRE(naive->blocks[0].firstSeat == 0);
+    REQUIRE(naive->orphans == 1);
+    auto best = GroupAllocator::place(map, 4);
+    REQUIRE(best.has_value());
+    REQUIRE(best->blocks[0].firstSeat == 6);
+    REQUIRE(best->orphans == 0);
+    REQUIRE(GroupAllocator::apply(map, *best));
+    REQUIRE(map.orphanSeats() == 0);
+
+    // Across rows: row 1's free run is seats 1..9, so its block of 7 goes flush against one end
+    // of it rather than straight under the front row's block, which would strand seat 1.
+    SeatMap rows(2, 10);
+    REQUIRE(rows.book(1, 0b0000000001));
+    auto group = GroupAllocator::place(rows, 14);
+    REQUIRE(group.has_value());
+    REQUIRE(group->blocks.size() == 2);
+    REQUIRE(group->orphans == 0);
+    REQUIRE(GroupAllocator::apply(rows, *group));
+    REQUIRE(rows.orphanSeats() == 0);
+}
+
+TEST_CASE("GroupAllocator: apply books every block or none") {
+    SeatMap map(2, 8);
+    auto p = GroupAllocator::place(map, 12);
+    REQUIRE(p.has_value());
+    REQUIRE(p->blocks.size() == 2);
+    REQUIRE(map.book(p->blocks[1].row, std::uint64_t{1} << p->blocks[1].firstSeat));   // someone got there first
+    REQUIRE(!GroupAllocator::apply(map, *p));
+    REQUIRE(map.freeSeats() == 15);             // the first block was rolled back
+}
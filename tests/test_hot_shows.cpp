@@ -0,0 +1,62 @@
+#include "../include/HotShowTracker.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+TEST_CASE("HotShowTracker: finds heavy hitters among many cold shows") {
+    HotShowTracker tracker;
+    for (int round = 0; round < 200; ++round) {
+        for (int i = 0; i < 10; ++i) tracker.record(1);      // hottest
+        for (int i = 0; i < 5; ++i) tracker.record(2);
+        for (long long cold = 0; cold < 5; ++cold)
+            tracker.record(1000 + round * 5 + cold);          // 1000 distinct one-off shows
+    }
+    tracker.flush();
+
+    auto top = tracker.topShows(2, std::chrono::seconds(60));
+    REQUIRE(top.size() == 2);
+    REQUIRE(top[0].showId == 1);
+    REQUIRE(top[1].showId == 2);
+    REQUIRE(top[0].count >= 2000);                     // never under-estimates
+    REQUIRE(top[0].count - top[0].error <= 2000);      // lower bound holds
+}
+
+TEST_CASE("HotShowTracker: merges buffers from several threads") {
+    HotShowTracker tracker;
+    std::vector<std::thread> pool;
+    for (int t = 0; t < 4; ++t)
+        pool.emplace_back([&] {
+            for (int i = 0; i < 1000; ++i) tracker.record(i % 4 == 0 ? 7 : 8 + i % 3);
+            tracker.flush();
+        });
+    for (auto& th : pool) th.join();
+
+    auto top = tracker.topShows(1, std::chrono::seconds(5));
+    REQUIRE(top.size() == 1);
+    REQUIRE(top[0].showId == 7);
+    REQUIRE(top[0].count == 1000);
+    REQUIRE(top[0].error == 0);
+}
+
+TEST_CASE("HotShowTracker: flush folds other live threads' buffers") {
+    HotShowTracker tracker;
+    std::atomic<bool> recorded{false}, done{false};
+    std::thread worker([&] {
+        for (int i = 0; i < 10; ++i) tracker.record(42);   // well under a buffer's flush threshold
+        recorded = true;
+        while (!done) std::this_thread::yield();
+    });
+    while (!recorded) std::this_thread::yield();
+
+    tracker.flush();                                        // from this thread, worker still alive
+    auto top = tracker.topShows(1, std::chrono::seconds(5));
+    done = true;
+    worker.join();
+    REQUIRE(top.size() == 1);
+    REQUIRE(top[0].showId == 42);
+    REQUIRE(top[0].count == 10);
+}
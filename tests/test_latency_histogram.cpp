@@ -0,0 +1,51 @@
+#include "../include/LatencyHistogram.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <cstdint>
+
+using namespace booking;
+
+namespace {
+bool near(std::uint64_t actual, std::uint64_t expected) {
+    const double diff = actual > expected ? double(actual - expected) : double(expected - actual);
+    return diff <= double(expected) / 128.0 + 1.0;
+}
+} // namespace
+
+TEST_CASE("LatencyHistogram: percentiles stay within the bucket resolution") {
+    LatencyHistogram h;
+    for (std::uint64_t v = 1; v <= 100000; ++v) h.record(v * 1000);   // 1 us .. 100 ms
+    REQUIRE(h.count() == 100000);
+    REQUIRE(h.min() == 1000);
+    REQUIRE(h.max() == 100000000);
+    REQUIRE(near(h.valueAtPercentile(50), 50000000));
+    REQUIRE(near(h.valueAtPercentile(99), 99000000));
+    REQUIRE(near(h.valueAtPercentile(99.9), 99900000));
+    REQUIRE(h.valueAtPercentile(100) == 100000000);
+    REQUIRE(near(static_cast<std::uint64_t>(h.mean()), 50000500));
+
+    LatencyHistogram small;
+    for (std::uint64_t v = 0; v < 200; ++v) small.record(v);          // exact below SUB_BUCKETS
+    REQUIRE(small.valueAtPercentile(50) == 99);
+    small.record(std::uint64_t{1} << 50);                            // clamped into the top bucket
+    REQUIRE(small.max() == std::uint64_t{1} << 50);
+}
+
+TEST_CASE("LatencyHistogram: merge and coordinated-omission correction") {
+    LatencyHistogram a, b;
+    for (int i = 0; i < 990; ++i) a.record(1000);
+    for (int i = 0; i < 10; ++i) b.record(1000000);
+    a.merge(b);
+    REQUIRE(a.count() == 1000);
+    REQUIRE(near(a.valueAtPercentile(99), 1000));
+    REQUIRE(near(a.valueAtPercentile(99.5), 1000000));
+
+    // One 10 ms stall with a request due every 1 ms hides 9 delayed requests.
+    LatencyHistogram corrected;
+    for (int i = 0; i < 90; ++i) corrected.recordCorrected(100, 1000000);
+    corrected.recordCorrected(10000000, 1000000);
+    REQUIRE(corrected.count() == 100);
+    REQUIRE(near(corrected.valueAtPercentile(95), 5000000));
+    corrected.reset();
+    REQUIRE(corrected.count() == 0);
+    REQUIRE(corrected.valueAtPercentile(50) == 0);
+}
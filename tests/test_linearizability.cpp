@@ -0,0 +1,194 @@
+#include "../include/BookingService.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include "DeterministicScheduler.hpp"
+#include "Linearizability.hpp"
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+using namespace booking::testing;
+
+namespace {
+
+using Kind = Operation::Kind;
+constexpr std::uint32_t ALL = detail::ALL_SEATS;
+
+Operation op(Kind kind, std::uint64_t invoke, std::uint64_t response, std::uint32_t seats = 0, bool ok = false, int count = 0) {
+    Operation o{kind, 0, 1, seats, ok, count};
+    o.invoke = invoke;
+    o.response = response;
+    return o;
+}
+
+std::vector<long long> makeShows(BookingService& svc, int n) {
+    const int m = svc.addMovie("Rashomon");
+    std::vector<long long> shows;
+    for (int i = 0; i < n; ++i) shows.push_back(svc.createShow(m, svc.addTheater("Gate " + std::to_string(i))));
+    return shows;
+}
+
+// Random mix of 1-2 seat bookings, seat reads and listings against `shows`.
+void randomOps(BookingService& svc, History& history, std::size_t thread, const std::vector<long long>& shows,
+               std::uint64_t seed, int count) {
+    std::mt19937_64 rng(seed);
+    for (int i = 0; i < count; ++i) {
+        const long long show = shows[rng() % shows.size()];
+        switch (rng() % 4) {
+        case 0:
+        case 1: {
+            std::uint32_t seats = std::uint32_t{1} << (rng() % BookingService::TOTAL_SEATS);
+            if (rng() % 2) seats |= std::uint32_t{1} << (rng() % BookingService::TOTAL_SEATS);
+            history.book(svc, thread, show, seats);
+            break;
+        }
+        case 2: history.readSeats(svc, thread, show); break;
+        default: history.listAll(svc, thread); break;
+        }
+    }
+}
+
+// Runs `threads` random workers under the scheduler with `seed`; returns the history.
+std::vector<Operation> scheduledRun(std::uint64_t seed, std::size_t threads, int opsPerThread) {
+    BookingService svc;
+    const auto shows = makeShows(svc, 2);
+    History history(threads);
+    std::vector<std::function<void()>> bodies;
+    for (std::size_t t = 0; t < threads; ++t)
+        bodies.push_back([&, t] { randomOps(svc, history, t, shows, seed * 1000003 + t, opsPerThread); });
+    DeterministicScheduler(seed).run(bodies);
+    return history.operations();
+}
+
+bool sameOutcome(const std::vector<Operation>& a, const std::vector<Operation>& b) {
+    if (a.size() != b.size()) return false;
+    for (std::size_t i = 0; i < a.size(); ++i)
+        if (a[i].thread != b[i].thread || a[i].invoke != b[i].invoke || a[i].response != b[i].response ||
+            a[i].seats != b[i].seats || a[i].ok != b[i].ok || a[i].count != b[i].count)
+            return false;
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("Linearizability checker accepts real orders and rejects impossible ones") {
+    // book A1 ok, then a read that still sees A1 free: impossible
+    REQUIRE(findViolation({op(Kind::Book, 1, 2, 0b1, true), op(Kind::ReadSeats, 3, 4, ALL)}).has_value());
+    // the same read overlapping the booking may see either state
+    REQUIRE(!findViolation({op(Kind::Book, 1, 3, 0b1, true), op(Kind::ReadSeats, 2, 4, ALL)}).has_value());
+    REQUIRE(!findViolation({op(Kind::Book, 1, 3, 0b1, true), op(Kind::ReadSeats, 2, 4, ALL & ~1u)}).has_value());
+    // two overlapping bookings of one seat cannot both succeed, and one must
+    REQUIRE(findViolation({op(Kind::Book, 1, 3, 0b1, true), op(Kind::Book, 2, 4, 0b11, true)}).has_value());
+    REQUIRE(findViolation({op(Kind::Book, 1, 3, 0b1, false), op(Kind::Book, 2, 4, 0b11, false)}).has_value());
+    REQUIRE(!findViolation({op(Kind::Book, 1, 3, 0b1, false), op(Kind::Book, 2, 4, 0b11, true)}).has_value());
+    // a count must match some state the reads around it allow
+    REQUIRE(findViolation({op(Kind::Book, 1, 2, 0b11, true), op(Kind::ReadCount, 3, 4, 0, false, BookingService::TOTAL_SEATS - 1)}).has_value());
+    REQUIRE(!findViolation({op(Kind::Book, 1, 4, 0b11, true), op(Kind::ReadCount, 2, 3, 0, false, BookingService::TOTAL_SEATS)}).has_value());
+}
+
+TEST_CASE("Concurrent bookings, seat reads and listings are linearizable") {
+    constexpr std::size_t THREADS = 4;
+    for (std::uint64_t round = 0; round < 20; ++round) {
+        BookingService svc;
+        const auto shows = makeShows(svc, 2);
+        History history(THREADS);
+        std::vector<std::thread> workers;
+        for (std::size_t t = 0; t < THREADS; ++t)
+            workers.emplace_back([&, t] { randomOps(svc, history, t, shows, round * 7919 + t, 150); });
+        for (auto& w : workers) w.join();
+
+        const auto violation = findViolation(history.operations());
+        if (violation) std::cerr << "Not linearizable (round " << round << "):\n" << describe(*violation);
+        REQUIRE(!violation);
+    }
+}
+
+TEST_CASE("Deterministic scheduler replays the same interleaving for a seed") {
+    DeterministicScheduler first(42), second(42), other(43);
+    std::vector<Operation> a, b, c;
+    {
+        BookingService svc;
+        const auto shows = makeShows(svc, 2);
+        History history(3);
+        std::vector<std::function<void()>> bodies;
+        for (std::size_t t = 0; t < 3; ++t) bodies.push_back([&, t] { randomOps(svc, history, t, shows, t, 40); });
+        first.run(bodies);
+        a = history.operations();
+    }
+    {
+        BookingService svc;
+        const auto shows = makeShows(svc, 2);
+        History history(3);
+        std::vector<std::function<void()>> bodies;
+        for (std::size_t t = 0; t < 3; ++t) bodies.push_back([&, t] { randomOps(svc, history, t, shows, t, 40); });
+        second.run(bodies);
+        b = history.operations();
+    }
+    {
+        BookingService svc;
+        const auto shows = makeShows(svc, 2);
+        History history(3);
+        std::vector<std::function<void()>> bodies;
+        for (std::size_t t = 0; t < 3; ++t) bodies.push_back([&, t] { randomOps(svc, history, t, shows, t, 40); });
+        other.run(bodies);
+        c = history.operations();
+    }
+    REQUIRE(first.trace() == second.trace());
+    REQUIRE(sameOutcome(a, b));
+    REQUIRE(first.trace() != other.trace());
+    REQUIRE(!sameOutcome(a, c));
+}
+
+// Set BOOKING_SIM_SEED=<n> to replay one seed, e.g. one reported by a failure below.
+TEST_CASE("Scheduled interleavings are linearizable for every seed") {
+    std::uint64_t from = 1, to = 150;
+    if (const char* seed = std::getenv("BOOKING_SIM_SEED")) from = to = std::strtoull(seed, nullptr, 10);
+    for (std::uint64_t seed = from; seed <= to; ++seed) {
+        const auto violation = findViolation(scheduledRun(seed, 3, 30));
+        if (violation) std::cerr << "Not linearizable; replay with BOOKING_SIM_SEED=" << seed << ":\n" << describe(*violation);
+        REQUIRE(!violation);
+    }
+}
+
+TEST_CASE("Scheduler finds and replays a torn composite read") {
+    // Reading seats in two calls is not atomic: a booking between them can produce a seat map
+    // that never existed. Some seed must expose it, and that seed must expose it every time.
+    constexpr std::uint32_t LOW = (std::uint32_t{1} << (BookingService::TOTAL_SEATS / 2)) - 1;
+    auto run = [&](std::uint64_t seed) {
+        BookingService svc;
+        const auto shows = makeShows(svc, 1);
+        History history(2);
+        std::vector<std::function<void()>> bodies{
+            [&] {
+                for (int i = 0; i < 5; ++i) {
+                    const std::uint32_t seats = (std::uint32_t{1} << i) | (std::uint32_t{1} << (BookingService::TOTAL_SEATS - 1 - i));
+                    history.book(svc, 0, shows[0], seats);
+                }
+            },
+            [&] {
+                for (int i = 0; i < 5; ++i) {
+                    Operation read{Kind::ReadSeats, 1, shows[0]};
+                    read.invoke = history.now();
+                    std::uint32_t first = 0, second = 0;
+                    for (const auto& l : svc.getAvailableSeats(shows[0])) first |= std::uint32_t{1} << BookingService::seatIndexFromLabel(l);
+                    for (const auto& l : svc.getAvailableSeats(shows[0])) second |= std::uint32_t{1} << BookingService::seatIndexFromLabel(l);
+                    read.seats = (first & LOW) | (second & ~LOW);
+                    read.response = history.now();
+                    history.add(read);
+                }
+            }};
+        DeterministicScheduler(seed).run(bodies);
+        return findViolation(history.operations()).has_value();
+    };
+
+    std::uint64_t failing = 0;
+    for (std::uint64_t seed = 1; seed <= 500 && failing == 0; ++seed)
+        if (run(seed)) failing = seed;
+    REQUIRE(failing != 0);
+    REQUIRE(run(failing));
+    REQUIRE(run(failing));
+}
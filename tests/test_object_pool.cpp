@@ -0,0 +1,53 @@
+#include "../include/ObjectPool.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <cstdint>
+#include <set>
+#include <stdexcept>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+struct alignas(64) Padded {
+    int value;
+    explicit Padded(int v) : value(v) {}
+};
+
+struct Throws {
+    long long unused;
+    explicit Throws(bool fail) : unused(0) { if (fail) throw std::runtime_error("ctor"); }
+};
+} // namespace
+
+TEST_CASE("ObjectPool: objects are aligned, slab-packed and reused") {
+    ObjectPool<Padded, 8> pool;
+    std::vector<Padded*> objects;
+    for (int i = 0; i < 20; ++i) objects.push_back(pool.create(i));
+
+    for (auto* p : objects) REQUIRE(reinterpret_cast<std::uintptr_t>(p) % 64 == 0);
+    REQUIRE(objects[1] - objects[0] == 1);                   // adjacent in one slab, no headers
+    REQUIRE(pool.live() == 20);
+    REQUIRE(pool.bytesReserved() == 3 * 8 * sizeof(Padded));  // 20 objects -> 3 slabs of 8
+
+    Padded* freed = objects[5];
+    pool.destroy(freed);
+    Padded* reused = pool.create(99);
+    REQUIRE(reused == freed);
+    REQUIRE(reused->value == 99);
+    REQUIRE(pool.bytesReserved() == 3 * 8 * sizeof(Padded));
+
+    objects[5] = reused;
+    std::set<Padded*> unique(objects.begin(), objects.end());
+    REQUIRE(unique.size() == objects.size());
+    for (auto* p : objects) pool.destroy(p);
+    REQUIRE(pool.live() == 0);
+}
+
+TEST_CASE("ObjectPool: a throwing constructor returns its slot") {
+    ObjectPool<Throws, 4> pool;
+    REQUIRE_THROWS_AS(pool.create(true), std::runtime_error);
+    REQUIRE(pool.live() == 0);
+    Throws* ok = pool.create(false);
+    REQUIRE(pool.live() == 1);
+    pool.destroy(ok);
+}
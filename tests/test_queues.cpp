@@ -0,0 +1,126 @@
+#include "../include/BookingService.hpp"
+#include "../include/MpscQueue.hpp"
+#include "../include/SpscQueue.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+TEST_CASE("SpscQueue: FIFO order and full/empty detection") {
+    SpscQueue<int> q(4);
+    for (int i = 0; i < 4; ++i) REQUIRE(q.tryPush(i));
+    REQUIRE(!q.tryPush(99));
+    REQUIRE(q.full());
+    for (int i = 0; i < 4; ++i) REQUIRE(*q.tryPop() == i);
+    REQUIRE(!q.tryPop());
+    REQUIRE(q.empty());
+
+    SpscQueue<std::string> strings(2);
+    REQUIRE(strings.tryPush(std::string(64, 'x')));   // non-trivial payload is destroyed properly
+}
+
+TEST_CASE("SpscQueue: batch push/pop are partial when the ring is nearly full/empty") {
+    SpscQueue<int> q(8);
+    std::vector<int> in{0, 1, 2, 3, 4, 5};
+    REQUIRE(q.tryPushBatch(in.begin(), in.size()) == 6);
+    REQUIRE(q.tryPushBatch(in.begin(), in.size()) == 2);   // only two slots left
+
+    std::vector<int> out(16);
+    REQUIRE(q.tryPopBatch(out.begin(), 5) == 5);
+    REQUIRE(q.tryPopBatch(out.begin() + 5, 16) == 3);
+    REQUIRE(q.tryPopBatch(out.begin(), 16) == 0);
+    REQUIRE(std::vector<int>(out.begin(), out.begin() + 8) == std::vector<int>({0, 1, 2, 3, 4, 5, 0, 1}));
+}
+
+TEST_CASE("MpscQueue: single and batch operations keep FIFO order") {
+    MpscQueue<int> q(8);
+    REQUIRE(q.tryPush(1));
+    std::vector<int> in{2, 3, 4, 5, 6, 7, 8, 9, 10};
+    REQUIRE(q.tryPushBatch(in.begin(), in.size()) == 7);   // capacity 8, one already used
+    REQUIRE(!q.tryPush(11));
+
+    std::vector<int> out(8);
+    REQUIRE(q.tryPopBatch(out.begin(), 3) == 3);
+    REQUIRE(*q.tryPop() == 4);
+    REQUIRE(q.tryPopBatch(out.begin() + 3, 8) == 4);
+    REQUIRE(out[0] == 1);
+    REQUIRE(out[6] == 8);
+    REQUIRE(q.empty());
+}
+
+TEST_CASE("MpscQueue: concurrent producers deliver every item exactly once, in per-producer order") {
+    constexpr int PRODUCERS = 4;
+    constexpr int PER_PRODUCER = 20000;
+    MpscQueue<long long, BlockingWait> q(64);
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p)
+        producers.emplace_back([&, p] {
+            std::vector<long long> batch;
+            for (int i = 0; i < PER_PRODUCER; ++i) {
+                const long long item = static_cast<long long>(p) * PER_PRODUCER + i;
+                if (p % 2 == 0) { q.push(item); continue; }   // half the producers use batches
+                batch.push_back(item);
+                if (batch.size() == 8 || i + 1 == PER_PRODUCER) {
+                    std::size_t sent = 0;
+                    while (sent < batch.size())
+                        sent += q.tryPushBatch(batch.begin() + static_cast<std::ptrdiff_t>(sent), batch.size() - sent);
+                    batch.clear();
+                }
+            }
+        });
+
+    std::vector<long long> last(PRODUCERS, -1);
+    bool ordered = true;
+    for (int received = 0; received < PRODUCERS * PER_PRODUCER; ++received) {
+        const long long item = q.pop();
+        const auto p = static_cast<std::size_t>(item / PER_PRODUCER);
+        ordered &= item > last[p];
+        last[p] = item;
+    }
+    for (auto& t : producers) t.join();
+
+    REQUIRE(ordered);
+    REQUIRE(q.empty());
+    for (int p = 0; p < PRODUCERS; ++p)
+        REQUIRE(last[p] == static_cast<long long>(p + 1) * PER_PRODUCER - 1);
+}
+
+TEST_CASE("MpscQueue: ingress pipeline in front of BookingService") {
+    BookingService svc;
+    auto show = svc.createShow(svc.addMovie("Ingress"), svc.addTheater("Queue Hall"));
+
+    struct BookingRequest {
+        long long showId;
+        int seat;              // -1 = stop
+        long long customerId;
+    };
+    MpscQueue<BookingRequest, BlockingWait> ingress(16);
+
+    std::atomic<int> booked{0};
+    std::thread worker([&] {
+        for (;;) {
+            const BookingRequest req = ingress.pop();
+            if (req.seat < 0) break;
+            if (svc.bookTicket(req.showId, {BookingService::seatLabelFromIndex(req.seat)}, req.customerId) > 0)
+                booked++;
+        }
+    });
+
+    std::vector<std::thread> clients;
+    for (int c = 1; c <= 3; ++c)
+        clients.emplace_back([&, c] {
+            for (int seat = 0; seat < BookingService::TOTAL_SEATS; ++seat)
+                ingress.push(BookingRequest{show, seat, c});
+        });
+    for (auto& t : clients) t.join();
+    ingress.push(BookingRequest{0, -1, 0});
+    worker.join();
+
+    REQUIRE(booked == BookingService::TOTAL_SEATS);   // duplicates from other clients were rejected
+    REQUIRE(svc.getAvailableSeats(show).empty());
+}
@@ -0,0 +1,104 @@
+#include "../include/ReadOnlyBookingView.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include "../include/CatalogFile.hpp"
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+using namespace booking;
+
+TEST_CASE("Exported catalog answers the same queries through a mapped view") {
+    BookingService svc;
+    const int m1 = svc.addMovie("Alien");
+    const int m2 = svc.addMovie("Heat");
+    const int t1 = svc.addTheater("Roxy");
+    const int t2 = svc.addTheater("Rialto");
+    const long long s1 = svc.createShow(m1, t1);
+    const long long s2 = svc.createShow(m2, t1);
+    const long long s3 = svc.createShow(m2, t2);
+    REQUIRE(svc.bookSeats(s1, {"A1", "A20"}));
+    REQUIRE(svc.bookSeats(s3, {"A5"}));
+    REQUIRE(svc.removeShow(s2));
+
+    const std::string path = "/tmp/booking_export_basic.cat";
+    REQUIRE(svc.exportCatalog(path));
+    auto view = ReadOnlyBookingView::open(path);
+    std::remove(path.c_str());                   // The mapping outlives the directory entry
+    REQUIRE(view.has_value());
+
+    REQUIRE(view->catalogEpoch() == svc.catalogEpoch());
+    REQUIRE(view->movieCount() == 2);
+    REQUIRE(view->theaterCount() == 2);
+    REQUIRE(view->showCount() == 2);
+    REQUIRE(view->getAvailableSeats(s1) == svc.getAvailableSeats(s1));
+    REQUIRE(view->getAvailableSeats(s3) == svc.getAvailableSeats(s3));
+    REQUIRE(view->getAvailableSeatCount(s1) == BookingService::TOTAL_SEATS - 2);
+    REQUIRE_THROWS_AS(view->getAvailableSeats(s2), std::invalid_argument);   // removed before export
+    REQUIRE_THROWS_AS(view->getAvailableSeatCount(99), std::invalid_argument);
+
+    const auto expected = svc.getAllShows();
+    const auto shows = view->getAllShows();
+    REQUIRE(shows.size() == expected.size());
+    for (std::size_t i = 0; i < shows.size(); ++i) {
+        REQUIRE(shows[i].id == expected[i].id);
+        REQUIRE(shows[i].movieTitle == expected[i].movieTitle);
+        REQUIRE(shows[i].theaterName == expected[i].theaterName);
+        REQUIRE(shows[i].availableSeats == expected[i].availableSeats);
+    }
+    const auto views = view->getAllShowViews();
+    REQUIRE(views[1].movieId == m2);
+    REQUIRE(views[1].theaterId == t2);
+    REQUIRE(views[1].theaterName == "Rialto");
+
+    const auto movies = view->getAllMovieViews();
+    REQUIRE(movies.size() == 2);
+    REQUIRE(movies[0].first == m1);
+    REQUIRE(movies[0].second == "Alien");
+    REQUIRE(view->getMovieTitle(m2) == "Heat");
+    REQUIRE(view->getMovieTitle(42) == "Unknown Movie");
+    REQUIRE(view->getTheaterName(t2) == "Rialto");
+    REQUIRE(view->getTheaterName(42) == "Unknown Theater");
+
+    // Snapshot semantics: later bookings are not visible through the view
+    REQUIRE(svc.bookSeats(s3, {"A6"}));
+    REQUIRE(view->getAvailableSeatCount(s3) == BookingService::TOTAL_SEATS - 1);
+
+    ReadOnlyBookingView moved = std::move(*view);
+    REQUIRE(moved.getTheaterName(t1) == "Roxy");
+}
+
+TEST_CASE("Empty catalog exports and maps") {
+    BookingService svc;
+    const std::string path = "/tmp/booking_export_empty.cat";
+    REQUIRE(svc.exportCatalog(path));
+    auto view = ReadOnlyBookingView::open(path);
+    std::remove(path.c_str());
+    REQUIRE(view.has_value());
+    REQUIRE(view->showCount() == 0);
+    REQUIRE(view->getAllShows().empty());
+    REQUIRE(view->getAllMovieViews().empty());
+    REQUIRE_THROWS_AS(view->getAvailableSeats(1), std::invalid_argument);
+}
+
+TEST_CASE("Mapping rejects missing, foreign and truncated files") {
+    REQUIRE(!ReadOnlyBookingView::open("/tmp/booking_export_does_not_exist.cat").has_value());
+
+    const std::string foreign = "/tmp/booking_export_foreign.cat";
+    std::ofstream(foreign, std::ios::binary) << std::string(sizeof(catalog_file::Header) + 64, 'x');
+    REQUIRE(!ReadOnlyBookingView::open(foreign).has_value());
+    std::remove(foreign.c_str());
+
+    BookingService svc;
+    REQUIRE(svc.createShow(svc.addMovie("Alien"), svc.addTheater("Roxy")) > 0);
+    const std::string path = "/tmp/booking_export_truncated.cat";
+    REQUIRE(svc.exportCatalog(path));
+    std::string bytes;
+    {
+        std::ifstream in(path, std::ios::binary);
+        bytes.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    }
+    std::ofstream(path, std::ios::binary | std::ios::trunc) << bytes.substr(0, bytes.size() - 1);
+    REQUIRE(!ReadOnlyBookingView::open(path).has_value());
+    std::remove(path.c_str());
+}
@@ -0,0 +1,250 @@
+#include "../include/Replication.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <chrono>
+#include <string>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+using namespace booking;
+using namespace std::chrono_literals;
+
+namespace {
+std::string socketPath(const std::string& name) {
+    return "/tmp/booking_repl_" + name + "_" + std::to_string(::getpid()) + ".sock";
+}
+
+// Same listing, seat maps and tickets on both services.
+bool sameState(const BookingService& a, const BookingService& b, long long lastTicket) {
+    const auto showsA = a.getAllShows(), showsB = b.getAllShows();
+    if (showsA.size() != showsB.size()) return false;
+    for (std::size_t i = 0; i < showsA.size(); ++i) {
+        if (showsA[i].id != showsB[i].id || showsA[i].movieTitle != showsB[i].movieTitle ||
+            showsA[i].theaterName != showsB[i].theaterName || showsA[i].availableSeats != showsB[i].availableSeats)
+            return false;
+        if (a.getAvailableSeats(showsA[i].id) != b.getAvailableSeats(showsB[i].id)) return false;
+    }
+    for (long long t = 1; t <= lastTicket; ++t) {
+        const auto ta = a.getTicket(t), tb = b.getTicket(t);
+        if (ta.has_value() != tb.has_value()) return false;
+        if (ta && (ta->showId != tb->showId || ta->customerId != tb->customerId || ta->seatMask != tb->seatMask))
+            return false;
+    }
+    return true;
+}
+} // namespace
+
+TEST_CASE("MutationLog numbers, encodes and serves records in order") {
+    MutationLog log;
+    BookingService svc;
+    svc.setMutationLog(&log);
+    const int m = svc.addMovie("Alien \"Director's Cut\"");
+    const int t = svc.addTheater("Roxy");
+    const long long s = svc.createShow(m, t);
+    REQUIRE(svc.bookTicket(s, {"A3", "A4"}, 7) > 0);
+    REQUIRE(svc.createShow(m, t) == -1);         // failed mutations are not logged
+    REQUIRE(svc.removeShow(s));
+    REQUIRE(log.lastLsn() == 5);
+
+    std::vector<std::string> encoded;
+    REQUIRE(log.readFrom(1, encoded, 100, 0ms) == 5);
+    const auto first = MutationLog::decode(encoded[0]);
+    REQUIRE(first.has_value());
+    REQUIRE(first->lsn == 1);
+    REQUIRE(first->type == MutationLog::Record::Type::AddMovie);
+    REQUIRE(first->text == "Alien \"Director's Cut\"");
+    const auto booking = MutationLog::decode(encoded[3]);
+    REQUIRE(booking->type == MutationLog::Record::Type::Book);
+    REQUIRE(booking->id == s);
+    REQUIRE(booking->customerId == 7);
+    REQUIRE(booking->seatMask == 0b1100u);
+    REQUIRE(!MutationLog::decode(encoded[0].substr(0, 10)).has_value());
+
+    encoded.clear();
+    REQUIRE(log.readFrom(5, encoded, 100, 0ms) == 1);
+    encoded.clear();
+    REQUIRE(log.readFrom(6, encoded, 100, 10ms) == 0);   // nothing new: waits, then returns empty
+}
+
+TEST_CASE("Follower replays the primary's log and reports lag on both sides") {
+    const std::string path = socketPath("local");
+    MutationLog log;
+    BookingService primary;
+    primary.setMutationLog(&log);
+    const int m1 = primary.addMovie("Alien");
+    const int t1 = primary.addTheater("Roxy");
+    const long long s1 = primary.createShow(m1, t1);
+    REQUIRE(primary.bookSeats(s1, {"A1"}));
+
+    auto shipper = std::make_unique<ReplicationPrimary>(log, path);
+    REQUIRE(shipper->start());
+    BookingService replica;
+    ReplicationFollower follower(replica, path);
+    REQUIRE(follower.start(2s));
+
+    // Catch-up from LSN 1, then live changes from several booking threads
+    std::vector<std::thread> bookers;
+    for (int b = 0; b < 4; ++b)
+        bookers.emplace_back([&primary, s1, b] {
+            for (int i = 0; i < 4; ++i)
+                (void)primary.bookTicket(s1, {BookingService::seatLabelFromIndex(1 + b * 4 + i)}, b + 1);
+        });
+    const long long s2 = primary.createShow(primary.addMovie("Heat"), t1);
+    for (auto& th : bookers) th.join();
+    REQUIRE(primary.removeShow(s2));
+
+    REQUIRE(follower.waitForLsn(log.lastLsn(), 5s));
+    REQUIRE(sameState(primary, replica, 17));
+    REQUIRE(follower.status().lagRecords == 0);
+    REQUIRE(follower.withinStaleness(1s));
+
+    // The primary sees the acknowledgement within a heartbeat or two
+    bool acked = false;
+    for (int i = 0; i < 200 && !acked; ++i) {
+        const auto followers = shipper->followers();
+        acked = followers.size() == 1 && followers[0].connected && followers[0].lagRecords == 0;
+        if (!acked) std::this_thread::sleep_for(5ms);
+    }
+    REQUIRE(acked);
+
+    // Primary's shipper restarts: the follower reconnects and resumes at the next LSN
+    shipper.reset();
+    REQUIRE(primary.bookSeats(s1, {"A20"}));
+    shipper = std::make_unique<ReplicationPrimary>(log, path);
+    REQUIRE(shipper->start());
+    REQUIRE(follower.waitForLsn(log.lastLsn(), 5s));
+    REQUIRE(replica.getAvailableSeats(s1) == primary.getAvailableSeats(s1));
+    REQUIRE(!follower.status().diverged);
+}
+
+TEST_CASE("Follower in a second process serves the primary's state") {
+    const std::string path = socketPath("fork");
+    const pid_t child = ::fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        // Follower process: only this thread exists here; report through the exit code.
+        BookingService replica;
+        ReplicationFollower follower(replica, path);
+        bool ok = follower.start(5s);
+        for (int i = 0; ok && i < 500 && replica.getAllShows().size() != 2; ++i)
+            std::this_thread::sleep_for(10ms);
+        ok = ok && follower.waitForLsn(7, 5s);        // 2 movies, 1 theater, 2 shows, 2 bookings
+        ok = ok && replica.getAvailableSeats(1).size() == BookingService::TOTAL_SEATS - 3;
+        ok = ok && replica.getMovieTitle(2) == "Heat";
+        ok = ok && replica.getTicket(2).has_value() && replica.getTicket(2)->customerId == 42;
+        // Stay connected until the primary has seen our acknowledgement
+        for (int i = 0; ok && i < 100; ++i) std::this_thread::sleep_for(10ms);
+        follower.stop();
+        ::_exit(ok ? 0 : 1);
+    }
+
+    MutationLog log;
+    BookingService primary;
+    primary.setMutationLog(&log);
+    ReplicationPrimary shipper(log, path);
+    REQUIRE(shipper.start());
+    const int t = primary.addTheater("Roxy");
+    const long long s1 = primary.createShow(primary.addMovie("Alien"), t);
+    const long long s2 = primary.createShow(primary.addMovie("Heat"), t);
+    REQUIRE(primary.bookTicket(s1, {"A1", "A2"}, 41) > 0);
+    REQUIRE(primary.bookTicket(s1, {"A3"}, 42) > 0);
+    REQUIRE(s2 == 2);
+
+    bool acked = false;
+    for (int i = 0; i < 500 && !acked; ++i) {
+        const auto followers = shipper.followers();
+        acked = !followers.empty() && followers.back().ackedLsn == log.lastLsn();
+        if (!acked) std::this_thread::sleep_for(10ms);
+    }
+    int status = 0;
+    REQUIRE(::waitpid(child, &status, 0) == child);
+    REQUIRE(acked);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+}
+
+TEST_CASE("MutationLog trims past its retention bound into a snapshot") {
+    MutationLog log(100);
+    BookingService svc;
+    svc.setMutationLog(&log);
+    const int t = svc.addTheater("Roxy");
+    std::vector<long long> shows;
+    for (int i = 0; i < 1500; ++i) shows.push_back(svc.createShow(svc.addMovie("Movie " + std::to_string(i)), t));
+    REQUIRE(svc.bookTicket(shows[0], {"A1", "A2"}, 7) > 0);
+    REQUIRE(svc.removeShow(shows[1]));
+    for (int i = 0; i < 1200; ++i) (void)svc.addMovie("Late " + std::to_string(i));
+
+    REQUIRE(log.firstLsn() > 1);
+    REQUIRE(log.size() <= 100 + MutationLog::TRIM_BATCH);
+    std::vector<std::string> encoded;
+    REQUIRE(!log.readFrom(1, encoded, 100, 0ms).has_value());
+
+    const auto snapshot = log.snapshot();
+    REQUIRE(snapshot.lsn == log.firstLsn() - 1);
+    std::size_t movies = 0, createdShows = 0;
+    std::uint32_t seats = 0;
+    for (const std::string& bytes : snapshot.records) {
+        const auto record = MutationLog::decode(bytes);
+        REQUIRE(record.has_value());
+        REQUIRE(record->lsn == snapshot.lsn);
+        movies += record->type == MutationLog::Record::Type::AddMovie;
+        createdShows += record->type == MutationLog::Record::Type::CreateShow;
+        if (record->type == MutationLog::Record::Type::ShowSeats) seats |= record->seatMask;
+    }
+    REQUIRE(movies == snapshot.lsn - 1 - 1500 - 2);      // everything before the snapshot but the theater, shows, booking, removal
+    REQUIRE(createdShows == 1499);
+    REQUIRE(seats == 0b11u);
+    REQUIRE(MutationLog::decode(snapshot.records.back())->type == MutationLog::Record::Type::Snapshot);
+    REQUIRE(MutationLog::decode(snapshot.records.back())->ticketId == 1);
+}
+
+TEST_CASE("Log trims behind connected followers and late followers re-sync from a snapshot") {
+    const std::string path = socketPath("resync");
+    MutationLog log;
+    BookingService primary;
+    primary.setMutationLog(&log);
+    const int t = primary.addTheater("Roxy");
+    const long long s1 = primary.createShow(primary.addMovie("Alien"), t);
+    const long long s2 = primary.createShow(primary.addMovie("Heat"), t);
+    REQUIRE(primary.bookTicket(s1, {"A1"}, 1) > 0);
+    REQUIRE(primary.bookTicket(s2, {"A1"}, 2) > 0);
+
+    ReplicationPrimary shipper(log, path);
+    REQUIRE(shipper.start());
+    BookingService live, lagging, fresh;
+    ReplicationFollower liveFollower(live, path), laggingFollower(lagging, path), freshFollower(fresh, path);
+    REQUIRE(liveFollower.start(2s));
+    REQUIRE(laggingFollower.start(2s));
+    REQUIRE(laggingFollower.waitForLsn(log.lastLsn(), 5s));
+    laggingFollower.stop();
+
+    // While `lagging` is away: a removed show, more seats on a show it has, a new catalog
+    REQUIRE(primary.removeShow(s1));
+    REQUIRE(primary.bookTicket(s2, {"A2", "A3"}, 3) > 0);
+    for (int i = 0; i < 1500; ++i)
+        REQUIRE(primary.createShow(primary.addMovie("Movie " + std::to_string(i)), t) > 0);
+    REQUIRE(primary.bookTicket(s2, {"A4"}, 4) > 0);
+    REQUIRE(liveFollower.waitForLsn(log.lastLsn(), 5s));
+    for (int i = 0; i < 200 && log.firstLsn() == 1; ++i) std::this_thread::sleep_for(10ms);
+    REQUIRE(log.firstLsn() > 1);                          // trimmed up to `live`'s acknowledgement
+
+    REQUIRE(laggingFollower.start(2s));
+    REQUIRE(freshFollower.start(2s));
+    const long long ticket = primary.bookTicket(s2, {"A5"}, 5);
+    REQUIRE(ticket == 5);
+    for (ReplicationFollower* follower : {&liveFollower, &laggingFollower, &freshFollower})
+        REQUIRE(follower->waitForLsn(log.lastLsn(), 5s));
+    REQUIRE(liveFollower.status().snapshotsApplied == 0);
+    REQUIRE(laggingFollower.status().snapshotsApplied >= 1);
+    REQUIRE(freshFollower.status().snapshotsApplied >= 1);
+    for (const BookingService* replica : {&live, &lagging, &fresh}) {
+        REQUIRE(sameState(primary, *replica, 0));
+        REQUIRE(replica->getMovieTitle(1502) == "Movie 1499");
+        const auto booked = replica->getTicket(ticket);  // numbering continues after the snapshot
+        REQUIRE(booked.has_value());
+        REQUIRE(booked->customerId == 5);
+    }
+    REQUIRE(!laggingFollower.status().diverged);
+    REQUIRE(!freshFollower.status().diverged);
+}
@@ -0,0 +1,79 @@
+#include "../include/SegmentedTable.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <thread>
+#include <cstdlib>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using namespace booking;
+
+TEST_CASE("SegmentedTable: publish, find and clear by dense ID") {
+    SegmentedTable<int> table;
+    int a = 1, b = 2;
+    const long long edge = static_cast<long long>(SegmentedTable<int>::CHUNK_SIZE);
+
+    REQUIRE(table.find(1) == nullptr);
+    REQUIRE(table.find(0) == nullptr);
+    REQUIRE(table.find(-5) == nullptr);
+    REQUIRE(table.find(std::numeric_limits<long long>::max()) == nullptr);
+
+    table.publish(1, &a);
+    table.publish(edge + 1, &b);             // first slot of the second chunk
+    REQUIRE(table.find(1) == &a);
+    REQUIRE(table.find(edge) == nullptr);
+    REQUIRE(table.find(edge + 1) == &b);
+
+    REQUIRE(table.clear(1) == &a);
+    REQUIRE(table.clear(1) == nullptr);
+    REQUIRE(table.find(1) == nullptr);
+    REQUIRE(table.clear(10 * edge) == nullptr);   // chunk never allocated
+
+    const long long far = (1LL << 30) + 7;        // beyond any fixed-size directory of the old layout
+    table.publish(far, &a);
+    REQUIRE(table.find(far) == &a);
+    REQUIRE(table.find(far - 1) == nullptr);
+    REQUIRE(table.find(far + static_cast<long long>(SegmentedTable<int>::CHUNK_SIZE)) == nullptr);
+}
+
+TEST_CASE("SegmentedTable: forEach visits published IDs in order, reserve only allocates") {
+    SegmentedTable<int> table;
+    int a = 1, b = 2, c = 3;
+    const long long far = (1LL << 27) + 3;
+    table.reserve(far + 1);
+    REQUIRE(table.find(far + 1) == nullptr);
+    table.publish(far, &c);
+    table.publish(5, &a);
+    table.publish(2000, &b);
+    table.publish(6, &a);
+    table.clear(6);
+
+    std::vector<std::pair<long long, int*>> seen;
+    table.forEach([&](long long id, int* value) { seen.emplace_back(id, value); });
+    REQUIRE(seen.size() == 3);
+    REQUIRE(seen[0] == std::make_pair(5LL, &a));
+    REQUIRE(seen[1] == std::make_pair(2000LL, &b));
+    REQUIRE(seen[2] == std::make_pair(far, &c));
+}
+
+TEST_CASE("SegmentedTable: concurrent writers and readers across chunks") {
+    SegmentedTable<long long> table;
+    constexpr long long PER_THREAD = 3000;
+    std::vector<long long> values(4 * PER_THREAD);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = static_cast<long long>(i) + 1;
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t)
+        threads.emplace_back([&, t] {
+            for (long long i = 0; i < PER_THREAD; ++i) {
+                const long long id = i * 4 + t + 1;           // interleaved: threads race on chunk allocation
+                table.publish(id, &values[static_cast<std::size_t>(id - 1)]);
+                const long long* seen = table.find(id);
+                if (!seen || *seen != id) std::abort();
+            }
+        });
+    for (auto& th : threads) th.join();
+
+    for (long long id = 1; id <= 4 * PER_THREAD; ++id)
+        REQUIRE(*table.find(id) == id);
+}
@@ -0,0 +1,191 @@
+#include "../include/ShardRouter.hpp"
+#include "../include/ShardServer.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <stdexcept>
+#include <string>
+#include <unistd.h>
+#include <vector>
+
+using namespace booking;
+
+TEST_CASE("Consistent hash ring spreads keys and moves only the new node's share") {
+    constexpr std::uint64_t KEYS = 100000;
+    ConsistentHashRing ring;
+    for (std::uint32_t node = 0; node < 4; ++node) ring.addNode(node);
+
+    std::vector<std::uint32_t> before(KEYS);
+    std::vector<std::size_t> perNode(4, 0);
+    for (std::uint64_t k = 0; k < KEYS; ++k) ++perNode[before[k] = ring.owner(k + 1)];
+    for (std::size_t n : perNode) {
+        REQUIRE(n > KEYS / 4 * 6 / 10);
+        REQUIRE(n < KEYS / 4 * 14 / 10);
+    }
+
+    ring.addNode(4);
+    std::size_t moved = 0;
+    for (std::uint64_t k = 0; k < KEYS; ++k) {
+        const std::uint32_t now = ring.owner(k + 1);
+        if (now != before[k]) {
+            REQUIRE(now == 4);                   // keys only move to the new node
+            ++moved;
+        }
+    }
+    REQUIRE(moved > KEYS / 5 * 6 / 10);          // about 1/5 of the keys
+    REQUIRE(moved < KEYS / 5 * 14 / 10);
+
+    ring.removeNode(4);
+    for (std::uint64_t k = 0; k < KEYS; k += 97) REQUIRE(ring.owner(k + 1) == before[k]);
+}
+
+TEST_CASE("BookingService creates shows under caller-chosen IDs") {
+    BookingService svc;
+    const int m = svc.addMovie("Alien");
+    const int t1 = svc.addTheater("Roxy");
+    const int t2 = svc.addTheater("Rialto");
+    REQUIRE(svc.createShow(m, t1, 40) == 40);
+    REQUIRE(svc.createShow(m, t2, 40) == -1);    // taken
+    REQUIRE(svc.createShow(m, t2, -3) == -1);    // out of range
+    REQUIRE(svc.createShow(m, t2) == 41);        // automatic IDs continue above
+    REQUIRE(svc.getAllShows().size() == 2);
+
+    const int t3 = svc.addTheater("Odeon");
+    const long long tooFar = 41 + BookingService::MAX_SHOW_ID_GAP + 1;
+    REQUIRE(svc.createShow(m, t3, tooFar) == -1);
+    REQUIRE(svc.createShow(m, t3, 1LL << 52) == -1);
+    REQUIRE(svc.createShow(m, t3) == 42);         // the refused IDs did not move the counter
+    REQUIRE(svc.createShow(m, svc.addTheater("Plaza"), tooFar - 1) == tooFar - 1);
+    REQUIRE(svc.getAllShows().size() == 4);
+    REQUIRE(svc.getAllShows().back().id == tooFar - 1);
+
+    REQUIRE(svc.addMovie("Heat", 7) == 7);
+    REQUIRE(svc.addMovie("heat", 7) == 7);       // resent
+    REQUIRE(svc.addMovie("Heat", 8) == -1);
+    REQUIRE(svc.addMovie("Dune", 7) == -1);      // taken
+    REQUIRE(svc.addMovie("Dune") == 8);
+    REQUIRE(svc.addTheater("Cinema", 7) == 7);
+    REQUIRE(svc.addTheater("Lido") == 8);
+}
+
+TEST_CASE("Router catalog IDs stay aligned when a shard misses an add") {
+    const std::string base = "/tmp/booking_catalog_" + std::to_string(::getpid());
+    BookingService serviceA, serviceB;
+    ShardServer serverA(serviceA, base + "_a.sock"), serverB(serviceB, base + "_b.sock");
+    REQUIRE(serverA.start());
+    REQUIRE(serverB.start());
+    ShardRouter router;
+    REQUIRE(router.addShard(base + "_a.sock").has_value());
+    REQUIRE(router.addShard(base + "_b.sock").has_value());
+
+    REQUIRE(serviceB.addMovie("Heat", 50) == 50);   // shard B will refuse the router's "Heat"
+    REQUIRE(router.addMovie("Alien") == 1);
+    REQUIRE(router.addMovie("Heat") == -1);
+    REQUIRE(router.addMovie("Dune") == 3);          // not shifted by B's miss
+    REQUIRE(router.addMovie("Heat") == -1);         // resent; A answers with the ID it has
+    const int t = router.addTheater("Roxy");
+    REQUIRE(t == 1);
+    REQUIRE(router.createShow(2, t) == -1);         // not on every shard
+    REQUIRE(router.createShow(3, t) > 0);
+    REQUIRE(router.createShow(1, t) > 0);
+    REQUIRE(serviceA.getMovieTitle(2) == "Heat");
+    REQUIRE(serviceA.getAllMovies().size() == 3);
+    REQUIRE(serviceB.getMovieTitle(3) == "Dune");
+    REQUIRE(router.getAllShows().size() == 2);
+}
+
+TEST_CASE("Shard refuses adopted show IDs outside the router's range") {
+    const std::string path = "/tmp/booking_adopt_" + std::to_string(::getpid()) + ".sock";
+    BookingService service;
+    ShardServer server(service, path);
+    REQUIRE(server.start());
+    const int m = service.addMovie("Alien");
+    const int t = service.addTheater("Roxy");
+
+    LocalSocket socket = LocalSocket::connect(path);
+    const auto adopt = [&](long long id, long long lastId) {
+        std::string response;
+        const auto request = FrameWriter().put<std::uint8_t>(shard_protocol::ADOPT_SHOW).put<std::int64_t>(id)
+            .put<std::int64_t>(lastId).put<std::int32_t>(m).put<std::int32_t>(t).put<std::uint32_t>(0).take();
+        if (!socket.sendFrame(request) || !socket.recvFrame(response)) return -2LL;
+        return static_cast<long long>(FrameReader(response).get<std::int64_t>());
+    };
+    REQUIRE(adopt(0, 10) == -1);
+    REQUIRE(adopt(11, 10) == -1);                                 // above the router's counter
+    REQUIRE(adopt(1LL << 52, 1LL << 52) == -1);                   // far above this shard's highest ID
+    REQUIRE(service.getAllShows().empty());
+    REQUIRE(adopt(7, 10) == 7);
+    REQUIRE(service.getAllShows().size() == 1);
+}
+
+TEST_CASE("Router partitions shows across shard processes and rebalances on a new shard") {
+    LocalShardLauncher launcher("/tmp/booking_shards_" + std::to_string(::getpid()));
+    std::vector<std::string> paths;
+    for (int i = 0; i < 4; ++i) {
+        auto path = launcher.launch();
+        REQUIRE(path.has_value());
+        paths.push_back(*path);
+    }
+
+    ShardRouter router;
+    const int early = router.addMovie("Alien");              // replayed to shards added later
+    for (int i = 0; i < 3; ++i) REQUIRE(router.addShard(paths[i]) == std::size_t{0});
+    REQUIRE(router.shardCount() == 3);
+    REQUIRE(router.addMovie("alien") == -1);
+
+    std::vector<int> theaters;
+    for (int i = 0; i < 100; ++i) theaters.push_back(router.addTheater("Hall " + std::to_string(i)));
+    const int late = router.addMovie("Heat");
+    std::vector<long long> shows;
+    for (int i = 0; i < 100; ++i) {
+        shows.push_back(router.createShow(early, theaters[i]));
+        shows.push_back(router.createShow(late, theaters[i]));
+    }
+    REQUIRE(router.createShow(early, theaters[0]) == -1);
+    REQUIRE(router.createShow(early, 999) == -1);
+
+    std::vector<std::size_t> perShard(3, 0);
+    for (long long id : shows) {
+        REQUIRE(id > 0);
+        ++perShard[router.shardOf(id)];
+        REQUIRE(router.bookSeats(id, {"A" + std::to_string(id % 20 + 1)}));
+    }
+    for (std::size_t n : perShard) REQUIRE(n > 20);
+    REQUIRE(!router.bookSeats(shows[0], {BookingService::seatLabelFromIndex(static_cast<int>(shows[0] % 20))}));
+    REQUIRE(router.getAvailableSeats(shows[5]).size() == BookingService::TOTAL_SEATS - 1);
+    REQUIRE_THROWS_AS(router.getAvailableSeats(100000), std::invalid_argument);
+
+    const auto before = router.getAllShows();
+    REQUIRE(before.size() == shows.size());
+    for (std::size_t i = 0; i < before.size(); ++i) {
+        REQUIRE(before[i].id == static_cast<long long>(i + 1));   // merged in ID order
+        REQUIRE(before[i].availableSeats == BookingService::TOTAL_SEATS - 1);
+    }
+    REQUIRE(before[1].movieTitle == "Heat");
+    REQUIRE(before[1].theaterName == "Hall 0");
+
+    std::vector<std::size_t> ownerBefore;
+    for (long long id : shows) ownerBefore.push_back(router.shardOf(id));
+    const auto moved = router.addShard(paths[3]);
+    REQUIRE(moved.has_value());
+    REQUIRE(*moved > shows.size() / 4 / 2);                   // about a quarter of the shows...
+    REQUIRE(*moved < shows.size() / 4 * 2);
+    std::size_t changed = 0;
+    for (std::size_t i = 0; i < shows.size(); ++i) {
+        if (router.shardOf(shows[i]) == ownerBefore[i]) continue;
+        REQUIRE(router.shardOf(shows[i]) == 3);               // ...and only to the new shard
+        ++changed;
+    }
+    REQUIRE(changed == *moved);
+
+    const auto after = router.getAllShows();
+    REQUIRE(after.size() == before.size());
+    for (std::size_t i = 0; i < after.size(); ++i) {
+        REQUIRE(after[i].id == before[i].id);
+        REQUIRE(after[i].theaterName == before[i].theaterName);
+        REQUIRE(after[i].availableSeats == before[i].availableSeats);
+    }
+    for (long long id : shows)                                 // seat maps moved with the shows
+        REQUIRE(!router.bookSeats(id, {"A" + std::to_string(id % 20 + 1)}));
+    REQUIRE(router.bookSeats(shows[7], {"A20", "A19"}) == (shows[7] % 20 < 18));
+
+    launcher.stopAll();
+}
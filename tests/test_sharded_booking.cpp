@@ -0,0 +1,59 @@
+#include "../include/ShardedBookingService.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+TEST_CASE("Sharded: shows are owned by one shard and behave like BookingService") {
+    ShardedBookingService svc(3);
+    int m = svc.addMovie("Arrival");
+    REQUIRE(svc.addMovie("ARRIVAL") == -1);
+    std::vector<int> theaters;
+    for (int i = 0; i < 6; ++i) theaters.push_back(svc.addTheater("Shard " + std::to_string(i)));
+
+    auto client = svc.connect();
+    std::vector<long long> shows;
+    for (int t : theaters) shows.push_back(client.createShow(m, t));
+    REQUIRE(client.createShow(m, theaters[0]) == -1);
+    REQUIRE(client.createShow(999, theaters[0]) == -1);
+
+    REQUIRE(client.bookSeats(shows[4], {"A1", "A2"}));
+    REQUIRE(!client.bookSeats(shows[4], {"A2"}));
+    REQUIRE(!client.bookSeats(shows[4], {"A3", "A3"}));
+    REQUIRE(!client.bookSeats(shows[4], {"Z1"}));
+    REQUIRE(client.getAvailableSeats(shows[4]).size() == BookingService::TOTAL_SEATS - 2);
+    REQUIRE_THROWS_AS(client.getAvailableSeats(12345), std::invalid_argument);
+
+    auto all = client.getAllShows();     // scatter-gather over 3 shards
+    REQUIRE(all.size() == shows.size());
+    for (std::size_t i = 0; i < all.size(); ++i) {
+        REQUIRE(all[i].id == shows[i]);
+        REQUIRE(all[i].movieTitle == "Arrival");
+        REQUIRE(all[i].availableSeats == BookingService::TOTAL_SEATS - (i == 4 ? 2 : 0));
+    }
+}
+
+TEST_CASE("Sharded: concurrent clients never double-book") {
+    ShardedBookingService svc(2, 8);
+    int m = svc.addMovie("Solaris");
+    auto setup = svc.connect();
+    auto a = setup.createShow(m, svc.addTheater("East"));
+    auto b = setup.createShow(m, svc.addTheater("West"));
+
+    std::atomic<int> ok{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 6; ++t)
+        threads.emplace_back([&] {
+            auto client = svc.connect();
+            for (int i = 0; i < BookingService::TOTAL_SEATS; ++i)
+                for (long long show : {a, b})
+                    if (client.bookSeats(show, {BookingService::seatLabelFromIndex(i)})) ok++;
+        });
+    for (auto& th : threads) th.join();
+
+    REQUIRE(ok == 2 * BookingService::TOTAL_SEATS);
+    REQUIRE(setup.getAvailableSeats(a).empty());
+    REQUIRE(setup.getAvailableSeats(b).empty());
+}
@@ -0,0 +1,29 @@
+#include "../include/StringPool.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <string>
+
+using namespace booking;
+
+TEST_CASE("StringPool: equal strings share storage") {
+    StringPool pool(16);
+    std::string a = "Inception";
+    auto v1 = pool.intern(a);
+    a = "changed";                          // pooled copy is independent of the source
+    auto v2 = pool.intern("Inception");
+    REQUIRE(v1 == "Inception");
+    REQUIRE(v1.data() == v2.data());
+    REQUIRE(pool.size() == 1);
+}
+
+TEST_CASE("StringPool: views survive block growth and oversized strings") {
+    StringPool pool(16);
+    auto first = pool.intern("first");
+    std::string big(100, 'x');
+    auto large = pool.intern(big);
+    for (int i = 0; i < 100; ++i)
+        (void)pool.intern("name-" + std::to_string(i));
+    REQUIRE(first == "first");
+    REQUIRE(large == big);
+    REQUIRE(pool.intern("") == "");
+    REQUIRE(pool.size() == 103);
+}
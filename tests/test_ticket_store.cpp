@@ -0,0 +1,74 @@
+#include "../include/TicketStore.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+TEST_CASE("TicketStore: dense IDs and O(1) lookup") {
+    TicketStore store;
+    long long t1 = store.append(7, 100, 0b11);
+    long long t2 = store.append(8, TicketStore::ANONYMOUS_CUSTOMER, 0b100);
+    REQUIRE(t1 == 1);
+    REQUIRE(t2 == 2);
+    REQUIRE(store.size() == 2);
+
+    auto rec = store.find(t1);
+    REQUIRE(rec.has_value());
+    REQUIRE(rec->showId == 7);
+    REQUIRE(rec->customerId == 100);
+    REQUIRE(rec->seatMask == 0b11u);
+    REQUIRE(rec->timestampNs > 0);
+
+    REQUIRE(!store.find(0).has_value());
+    REQUIRE(!store.find(3).has_value());
+}
+
+TEST_CASE("TicketStore: reserve takes all IDs or none") {
+    TicketStore store;
+    REQUIRE(store.append(7, 100, 0b1) == 1);
+    const long long first = store.reserve(3);
+    REQUIRE(first == 2);
+    REQUIRE(store.append(7, 100, 0b10) == 5);
+    store.write(first + 1, 8, 100, 0b100);
+    REQUIRE(store.find(first + 1)->showId == 8);
+    REQUIRE(!store.find(first).has_value());                // reserved, not written yet
+    REQUIRE(store.findByCustomer(100).size() == 3);
+
+    const auto last = static_cast<long long>(TicketStore::CAPACITY) - 1;
+    REQUIRE(store.skipTo(last - 2));
+    REQUIRE(store.reserve(3) == -1);
+    REQUIRE(store.reserve(2) == last - 1);
+    REQUIRE(store.append(7, 100, 0b1) == -1);
+}
+
+TEST_CASE("TicketStore: customer index across chunk boundary") {
+    TicketStore store;
+    const std::size_t n = TicketStore::CHUNK_SIZE + 10;
+    for (std::size_t i = 0; i < n; ++i)
+        (void)store.append(1, static_cast<long long>(i % 3) + 1, 1);
+
+    auto tickets = store.findByCustomer(2);
+    REQUIRE(tickets.size() == (n + 1) / 3);
+    REQUIRE(tickets.front().ticketId > tickets.back().ticketId); // newest first
+    for (const auto& t : tickets)
+        REQUIRE(t.customerId == 2);
+    REQUIRE(store.findByCustomer(TicketStore::ANONYMOUS_CUSTOMER).empty());
+    REQUIRE(store.findByCustomer(42).empty());
+}
+
+TEST_CASE("TicketStore: concurrent appends get unique IDs") {
+    TicketStore store;
+    const int threads = 8, perThread = 5000;
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; ++t)
+        pool.emplace_back([&, t] {
+            for (int i = 0; i < perThread; ++i)
+                (void)store.append(t, t + 1, 1);
+        });
+    for (auto& th : pool) th.join();
+
+    REQUIRE(store.size() == static_cast<std::size_t>(threads * perThread));
+    for (int t = 0; t < threads; ++t)
+        REQUIRE(store.findByCustomer(t + 1).size() == static_cast<std::size_t>(perThread));
+}
@@ -0,0 +1,245 @@
+#include "../include/CoordinatorLog.hpp"
+#include "../include/ShardRouter.hpp"
+#include "../include/ShardServer.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <csignal>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <vector>
+
+using namespace booking;
+
+namespace {
+
+std::int64_t send(const std::string& path, const std::string& request) {
+    LocalSocket socket = LocalSocket::connect(path);
+    std::string response;
+    if (!socket.sendFrame(request) || !socket.recvFrame(response)) return -2;
+    FrameReader in(response);
+    return in.get<std::int64_t>();
+}
+
+std::string prepare(std::uint64_t txId, long long showId, std::uint32_t mask) {
+    return FrameWriter().put<std::uint8_t>(shard_protocol::PREPARE).put(txId).put<std::int64_t>(0)
+        .put<std::uint32_t>(1).put<std::int64_t>(showId).put(mask).take();
+}
+
+} // namespace
+
+TEST_CASE("Coordinator log keeps unfinished transactions across reopen and drops a torn tail") {
+    const std::string path = "/tmp/booking_coord_" + std::to_string(::getpid()) + ".log";
+    std::remove(path.c_str());
+    std::uint64_t committed = 0, undecided = 0;
+    {
+        auto log = CoordinatorLog::open(path);
+        REQUIRE(log != nullptr);
+        const auto done = log->begin(1, {{"/tmp/a.sock", {{1, 0b1}}}});
+        committed = *log->begin(2, {{"/tmp/a.sock", {{2, 0b10}}}, {"/tmp/b.sock", {{3, 0b100}}}});
+        undecided = *log->begin(3, {{"/tmp/b.sock", {{4, 0b1000}}}});
+        REQUIRE(log->decide(*done, CoordinatorLog::Decision::Abort));
+        REQUIRE(log->end(*done));
+        REQUIRE(log->decide(committed, CoordinatorLog::Decision::Commit));
+    }
+    {
+        std::ofstream(path, std::ios::app | std::ios::binary) << "\x30\x00\x00\x00garbage";
+    }
+    auto log = CoordinatorLog::open(path);
+    REQUIRE(log != nullptr);
+    auto open = log->unfinished();
+    REQUIRE(open.size() == 2);
+    REQUIRE(open[0].id == committed);
+    REQUIRE(open[0].decision == CoordinatorLog::Decision::Commit);
+    REQUIRE(open[0].customerId == 2);
+    REQUIRE(open[0].participants.size() == 2);
+    REQUIRE(open[0].participants[1].path == "/tmp/b.sock");
+    REQUIRE(open[0].participants[1].legs[0].showId == 3);
+    REQUIRE(open[0].participants[1].legs[0].seatMask == 0b100u);
+    REQUIRE(open[1].id == undecided);
+    REQUIRE(open[1].decision == CoordinatorLog::Decision::Undecided);
+    REQUIRE(*log->begin(4, {}) > undecided);                           // IDs are never reused
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Coordinator log cuts off a failed append and stays bounded") {
+    const std::string path = "/tmp/booking_coord_full_" + std::to_string(::getpid()) + ".log";
+    std::remove(path.c_str());
+    std::fflush(nullptr);                                              // the child must not repeat our output
+    const pid_t child = ::fork();
+    REQUIRE(child >= 0);
+    if (child == 0) {
+        // Writes past a small file size limit fail part-way, like a full disk.
+        std::signal(SIGXFSZ, SIG_IGN);
+        auto log = CoordinatorLog::open(path);
+        bool ok = log != nullptr;
+        rlimit limit{};
+        ok = ok && ::getrlimit(RLIMIT_FSIZE, &limit) == 0;
+        const rlim_t unlimited = limit.rlim_cur;
+        limit.rlim_cur = static_cast<rlim_t>(std::filesystem::file_size(path)) + 64;
+        ok = ok && ::setrlimit(RLIMIT_FSIZE, &limit) == 0;
+        ok = ok && !log->begin(1, {{std::string(200, 'x'), {{1, 0b1}}}}).has_value();
+        limit.rlim_cur = unlimited;
+        ok = ok && ::setrlimit(RLIMIT_FSIZE, &limit) == 0;
+        const auto tx = log->begin(2, {{"/tmp/a.sock", {{2, 0b10}}}});
+        ok = ok && tx && log->decide(*tx, CoordinatorLog::Decision::Commit);
+        ::_exit(ok ? 0 : 1);
+    }
+    int status = 0;
+    REQUIRE(::waitpid(child, &status, 0) == child);
+    REQUIRE(WIFEXITED(status));
+    REQUIRE(WEXITSTATUS(status) == 0);
+    auto log = CoordinatorLog::open(path);
+    REQUIRE(log != nullptr);
+    auto open = log->unfinished();
+    REQUIRE(open.size() == 1);                                         // written after the failed one
+    REQUIRE(open[0].customerId == 2);
+    REQUIRE(open[0].decision == CoordinatorLog::Decision::Commit);
+
+    for (int i = 0; i < 2000; ++i) {
+        const auto tx = log->begin(3, {{"/tmp/b.sock", {{3, 0b100}}}});
+        REQUIRE(tx.has_value());
+        REQUIRE(log->decide(*tx, CoordinatorLog::Decision::Abort));
+        REQUIRE(log->end(*tx));
+    }
+    REQUIRE(std::filesystem::file_size(path) < 2 * CoordinatorLog::COMPACT_BYTES);
+    log.reset();
+    log = CoordinatorLog::open(path);
+    REQUIRE(log->unfinished().size() == 1);
+    REQUIRE(log->unfinished()[0].decision == CoordinatorLog::Decision::Commit);
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Two-phase commit books across shard processes and recovers in-doubt transactions") {
+    const std::string dir = "/tmp/booking_2pc_" + std::to_string(::getpid());
+    LocalShardLauncher launcher(dir);
+    std::vector<std::string> paths;
+    for (int i = 0; i < 3; ++i) paths.push_back(*launcher.launch());
+    const std::string logPath = dir + "/coordinator.log";
+    std::remove(logPath.c_str());
+
+    std::vector<long long> shows;
+    std::string pathC, pathD;
+    {
+        ShardRouter router;
+        for (const auto& path : paths) REQUIRE(router.addShard(path) == std::size_t{0});
+        const int m = router.addMovie("Double Feature");
+        for (int i = 0; i < 30; ++i) shows.push_back(router.createShow(m, router.addTheater("Screen " + std::to_string(i))));
+        pathC = paths[router.shardOf(shows[10])];
+        pathD = paths[router.shardOf(shows[11])];
+
+        // Pick one show on each of two different shards
+        long long a = shows[0], b = 0;
+        for (long long id : shows)
+            if (router.shardOf(id) != router.shardOf(a)) b = id;
+        REQUIRE(b != 0);
+
+        std::vector<ShardRouter::ShowSeats> legs{{a, {"A1", "A2"}}, {b, {"A1"}}};
+        REQUIRE(router.bookAcrossShows(legs).empty());                  // no coordinator log yet
+        REQUIRE(router.openTransactionLog(logPath));
+
+        auto tickets = router.bookAcrossShows(legs, 5);
+        REQUIRE(tickets.size() == 2);
+        REQUIRE(tickets[0] > 0);
+        REQUIRE(tickets[1] > 0);
+        REQUIRE(router.getAvailableSeats(a).size() == BookingService::TOTAL_SEATS - 2);
+        REQUIRE(router.getAvailableSeats(b).size() == BookingService::TOTAL_SEATS - 1);
+
+        // b's A1 is taken: a's prepared hold must be released again
+        std::vector<ShardRouter::ShowSeats> conflict{{a, {"A3"}}, {b, {"A1", "A2"}}};
+        REQUIRE(router.bookAcrossShows(conflict).empty());
+        REQUIRE(router.getAvailableSeats(a).size() == BookingService::TOTAL_SEATS - 2);
+        REQUIRE(router.getAvailableSeats(b).size() == BookingService::TOTAL_SEATS - 1);
+        std::vector<ShardRouter::ShowSeats> twice{{a, {"A3"}}, {a, {"A4"}}};
+        REQUIRE(router.bookAcrossShows(twice).empty());
+        REQUIRE(router.bookAcrossShows({}).empty());                    // no legs: refused, nothing logged
+        REQUIRE(router.resolveInDoubt() == 0);
+    }
+
+    // A coordinator that crashed after its participants prepared: one transaction was decided
+    // commit, the other never decided. Neither outcome reached the shards.
+    const long long c = shows[10], d = shows[11];
+    std::uint64_t toCommit = 0, toAbort = 0;
+    {
+        auto log = CoordinatorLog::open(logPath);
+        REQUIRE(log != nullptr);
+        toCommit = *log->begin(0, {{pathC, {{c, 0b10}}}});
+        REQUIRE(send(pathC, prepare(toCommit, c, 0b10)) == 1);
+        REQUIRE(log->decide(toCommit, CoordinatorLog::Decision::Commit));
+        toAbort = *log->begin(0, {{pathD, {{d, 0b10}}}});
+        REQUIRE(send(pathD, prepare(toAbort, d, 0b10)) == 1);
+    }
+
+    ShardRouter recovered;
+    for (const auto& path : paths) REQUIRE(recovered.addShard(path) == std::size_t{0});
+    REQUIRE(recovered.getAvailableSeats(c).size() == BookingService::TOTAL_SEATS - 1);   // held
+    REQUIRE(recovered.getAvailableSeats(d).size() == BookingService::TOTAL_SEATS - 1);
+    REQUIRE(recovered.openTransactionLog(logPath));
+    REQUIRE(recovered.getAvailableSeats(c).size() == BookingService::TOTAL_SEATS - 1);   // committed
+    REQUIRE(recovered.getAvailableSeats(d).size() == BookingService::TOTAL_SEATS);       // hold released
+    REQUIRE(recovered.resolveInDoubt() == 0);
+
+    REQUIRE(send(pathD, prepare(toAbort, d, 0b100)) == 0);             // late PREPARE after ABORT
+    REQUIRE(recovered.getAvailableSeats(d).size() == BookingService::TOTAL_SEATS);
+    REQUIRE(send(pathC, FrameWriter().put<std::uint8_t>(shard_protocol::COMMIT).put(toCommit).take()) == 1);  // repeat: same single ticket
+    launcher.stopAll();
+    std::remove(logPath.c_str());
+}
+
+TEST_CASE("Participant reports a COMMIT it cannot apply and keeps the seats held") {
+    const std::string path = "/tmp/booking_2pc_full_" + std::to_string(::getpid()) + ".sock";
+    BookingService service;
+    const long long show = service.createShow(service.addMovie("Alien"), service.addTheater("Roxy"));
+    REQUIRE(service.skipTicketIds(static_cast<long long>(TicketStore::CAPACITY) - 2));
+    REQUIRE(service.bookTicket(show, {"A20"}, 1) > 0);                  // the store is now full
+    ShardServer server(service, path);
+    REQUIRE(server.start());
+
+    REQUIRE(send(path, prepare(1, show, 0b11)) == 1);
+    const std::string commit = FrameWriter().put<std::uint8_t>(shard_protocol::COMMIT).put<std::uint64_t>(1).take();
+    REQUIRE(send(path, commit) == -1);
+    REQUIRE(service.getAvailableSeats(show).size() == BookingService::TOTAL_SEATS - 3);
+    REQUIRE(send(path, commit) == -1);                                  // still prepared, still not applicable
+    REQUIRE(send(path, FrameWriter().put<std::uint8_t>(shard_protocol::ABORT).put<std::uint64_t>(1).take()) == 1);
+    REQUIRE(service.getAvailableSeats(show).size() == BookingService::TOTAL_SEATS - 1);
+}
+
+TEST_CASE("Participants forget outcomes below the coordinator's watermark") {
+    const std::string base = "/tmp/booking_2pc_forget_" + std::to_string(::getpid());
+    const std::string path = base + ".sock", logPath = base + ".log";
+    std::remove(logPath.c_str());
+    BookingService service;
+    ShardServer server(service, path);
+    REQUIRE(server.start());
+
+    ShardRouter router;
+    REQUIRE(router.addShard(path) == std::size_t{0});
+    REQUIRE(router.openTransactionLog(logPath));
+    const int m = router.addMovie("Alien");
+    std::vector<long long> shows;
+    for (int i = 0; i < 4; ++i) shows.push_back(router.createShow(m, router.addTheater("Screen " + std::to_string(i))));
+
+    const auto commit = [](std::uint64_t txId) {
+        return FrameWriter().put<std::uint8_t>(shard_protocol::COMMIT).put(txId).take();
+    };
+    for (std::uint64_t tx = 1; tx < ShardRouter::FORGET_INTERVAL; ++tx) {
+        const long long show = shows[tx % shows.size()];
+        const std::vector<ShardRouter::ShowSeats> legs{{show, {BookingService::seatLabelFromIndex(static_cast<int>(tx / shows.size()))}}};
+        REQUIRE(router.bookAcrossShows(legs).size() == 1);
+    }
+    REQUIRE(send(path, commit(1)) == 1);                                  // still remembered
+    const std::vector<ShardRouter::ShowSeats> last{{shows[0], {"A20"}}};
+    REQUIRE(router.bookAcrossShows(last).size() == 1);                    // the FORGET_INTERVAL-th end broadcasts
+    REQUIRE(send(path, commit(1)) == -1);                                 // forgotten
+    REQUIRE(send(path, prepare(1, shows[1], 1u << 19)) == 0);             // late PREPARE below the watermark
+    REQUIRE(service.getAvailableSeatCount(shows[1]) > 0);
+
+    const std::uint64_t next = ShardRouter::FORGET_INTERVAL + 1;
+    REQUIRE(send(path, FrameWriter().put<std::uint8_t>(shard_protocol::FORGET).put<std::uint64_t>(2).take()) == 1);
+    REQUIRE(send(path, prepare(next, shows[1], 1u << 19)) == 1);          // a lower watermark changes nothing
+    REQUIRE(send(path, FrameWriter().put<std::uint8_t>(shard_protocol::ABORT).put(next).take()) == 1);
+    std::remove(logPath.c_str());
+}
@@ -0,0 +1,86 @@
+#include "../include/BookingService.hpp"
+#include "../include/WorkStealingPool.hpp"
+#include "../third_party/catch_amalgamated.hpp"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace booking;
+
+TEST_CASE("ChaseLevDeque: owner LIFO, thieves FIFO, grows past capacity") {
+    ChaseLevDeque<int*> dq(2);
+    int items[10];
+    for (auto& i : items) dq.push(&i);
+    REQUIRE(*dq.steal() == &items[0]);
+    REQUIRE(*dq.pop() == &items[9]);
+    int taken = 2;
+    while (dq.pop()) ++taken;
+    REQUIRE(taken == 10);
+    REQUIRE(dq.empty());
+}
+
+TEST_CASE("ChaseLevDeque: concurrent steals take each item once") {
+    ChaseLevDeque<long*> dq;
+    const long n = 20000;
+    std::vector<long> values(n);
+    std::atomic<long> sum{0}, count{0};
+    std::atomic<bool> done{false};
+
+    std::vector<std::thread> thieves;
+    for (int t = 0; t < 3; ++t)
+        thieves.emplace_back([&] {
+            while (!done.load() || !dq.empty())
+                if (auto v = dq.steal()) { sum += **v; count++; }
+        });
+    for (long i = 0; i < n; ++i) {
+        values[i] = i;
+        dq.push(&values[i]);
+        if (i % 3 == 0)
+            if (auto v = dq.pop()) { sum += **v; count++; }
+    }
+    done = true;
+    for (auto& th : thieves) th.join();
+    while (auto v = dq.pop()) { sum += **v; count++; }
+
+    REQUIRE(count == n);
+    REQUIRE(sum == n * (n - 1) / 2);
+}
+
+TEST_CASE("WorkStealingPool: runs nested tasks and respects affinity") {
+    WorkStealingPool pool(4);
+    std::atomic<int> runs{0};
+    std::atomic<int> onHinted{0};
+
+    for (int i = 0; i < 100; ++i)
+        pool.submit([&] {
+            runs++;
+            pool.submit([&] { runs++; });              // nested: goes to own deque
+        });
+    pool.waitIdle();
+    REQUIRE(runs == 200);
+
+    // With affinity, a task runs on the hinted worker unless another worker stole it.
+    for (int i = 0; i < 200; ++i)
+        pool.submit([&] { if (WorkStealingPool::currentWorker() == 2) onHinted++; }, 6);
+    pool.waitIdle();
+    REQUIRE(static_cast<std::uint64_t>(onHinted.load()) + pool.stolenCount() >= 200);
+}
+
+TEST_CASE("WorkStealingPool: drives concurrent bookings by show affinity") {
+    BookingService svc;
+    int m = svc.addMovie("Memento");
+    std::vector<long long> shows;
+    for (int i = 0; i < 8; ++i)
+        shows.push_back(svc.createShow(m, svc.addTheater("Pool " + std::to_string(i))));
+
+    std::atomic<int> ok{0};
+    {
+        WorkStealingPool pool(4);
+        for (long long show : shows)
+            for (int seat = 0; seat < BookingService::TOTAL_SEATS; ++seat)
+                pool.submit([&, show, seat] {
+                    if (svc.bookSeats(show, {BookingService::seatLabelFromIndex(seat)})) ok++;
+                }, static_cast<std::size_t>(show));
+    }   // destructor drains the pool
+    REQUIRE(ok == static_cast<int>(shows.size()) * BookingService::TOTAL_SEATS);
+}